@@ -0,0 +1,20 @@
+#!/bin/sh
+
+mkdir -p build
+cd build
+
+rm -f wombat_main wombat_bench
+
+CXX=${CXX:-clang++}
+FLAGS="-g -msse4.1 -Wall -Wno-unused-function -Wno-unused-variable -Wno-unused-but-set-variable -Wno-unused-parameter -Wno-write-strings -Wno-writable-strings -Wno-unknown-warning-option -Wno-missing-braces -Wno-sign-compare -I../source -I../dependencies/includes"
+
+$CXX $FLAGS ../source/wombat_main.cpp -o wombat_main -lSDL3 -lpthread || exit 1
+$CXX $FLAGS -O2 ../source/wombat_bench.cpp -o wombat_bench -lSDL3 -lpthread || exit 1
+
+cd ..
+
+cp ./build/wombat_main ./output/
+cp ./build/wombat_bench ./output/
+
+cd output
+./wombat_main
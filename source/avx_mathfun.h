@@ -0,0 +1,458 @@
+/* AVX2 implementation of sin, cos, sincos, atan and atan2
+
+   This is a port of sin_ps, cos_ps and sincos_ps from sse_mathfun.h and of
+   atan_ps and atan2_ps from sse_mathfun_extension.h to 8 lanes. Every lane
+   goes through the exact same sequence of single precision operations as
+   the SSE versions (no FMA contraction), so the results are bit identical
+   to the 4 lane functions for every input.
+
+   Requires AVX2 for the 256 bit integer operations, and USE_SSE2 plus
+   sse_mathfun_extension.h to be included first. To build the functions into
+   a binary that isn't compiled for AVX2, define AVX_MATHFUN_TARGET to a
+   target attribute before including this, and only call them after checking
+   that the CPU has AVX2.
+*/
+
+/* Copyright (C) 2007  Julien Pommier
+   Copyright (C) 2016  Tolga Mizrak
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  (this is the zlib license)
+
+  This is an altered version: the AVX2 port is not part of the original
+  sse_mathfun.h or sse_mathfun_extension.h.
+*/
+
+#ifndef _AVX_MATHFUN_H_INCLUDED_
+#define _AVX_MATHFUN_H_INCLUDED_
+
+#ifndef _SSE_MATHFUN_EXTENSION_H_INCLUDED_
+#error avx_mathfun.h needs sse_mathfun_extension.h to be included first
+#endif
+
+#include <immintrin.h>
+
+#ifndef AVX_MATHFUN_TARGET
+#define AVX_MATHFUN_TARGET
+#endif
+
+typedef __m256 v8sf;  // vector of 8 float (avx)
+typedef __m256i v8si; // vector of 8 int (avx2)
+
+#ifdef _MSC_VER /* visual c++ */
+# define ALIGN32_BEG __declspec(align(32))
+# define ALIGN32_END
+#else /* gcc or icc */
+# define ALIGN32_BEG
+# define ALIGN32_END __attribute__((aligned(32)))
+#endif
+
+#define _PS256_CONST(Name, Val)                                            \
+  static const ALIGN32_BEG float _ps256_##Name[8] ALIGN32_END = { Val, Val, Val, Val, Val, Val, Val, Val }
+#define _PI32_CONST256(Name, Val)                                          \
+  static const ALIGN32_BEG int _pi32_256_##Name[8] ALIGN32_END = { Val, Val, Val, Val, Val, Val, Val, Val }
+#define _PS256_CONST_TYPE(Name, Type, Val)                                 \
+  static const ALIGN32_BEG Type _ps256_##Name[8] ALIGN32_END = { Val, Val, Val, Val, Val, Val, Val, Val }
+
+_PS256_CONST(0  , 0.0f);
+_PS256_CONST(1  , 1.0f);
+_PS256_CONST(0p5, 0.5f);
+
+_PS256_CONST_TYPE(sign_mask, int, (int)0x80000000);
+_PS256_CONST_TYPE(inv_sign_mask, int, ~0x80000000);
+
+_PI32_CONST256(1, 1);
+_PI32_CONST256(inv1, ~1);
+_PI32_CONST256(2, 2);
+_PI32_CONST256(4, 4);
+
+_PS256_CONST(minus_cephes_DP1, -0.78515625);
+_PS256_CONST(minus_cephes_DP2, -2.4187564849853515625e-4);
+_PS256_CONST(minus_cephes_DP3, -3.77489497744594108e-8);
+_PS256_CONST(sincof_p0, -1.9515295891E-4);
+_PS256_CONST(sincof_p1,  8.3321608736E-3);
+_PS256_CONST(sincof_p2, -1.6666654611E-1);
+_PS256_CONST(coscof_p0,  2.443315711809948E-005);
+_PS256_CONST(coscof_p1, -1.388731625493765E-003);
+_PS256_CONST(coscof_p2,  4.166664568298827E-002);
+_PS256_CONST(cephes_FOPI, 1.27323954473516); // 4 / M_PI
+
+_PS256_CONST(atanrange_hi, 2.414213562373095);
+_PS256_CONST(atanrange_lo, 0.4142135623730950);
+_PS256_CONST(cephes_PIF, 3.141592653589793238);
+_PS256_CONST(cephes_PIO2F, 1.5707963267948966192);
+_PS256_CONST(cephes_PIO4F, 0.7853981633974483096);
+
+_PS256_CONST(atancof_p0, 8.05374449538e-2);
+_PS256_CONST(atancof_p1, 1.38776856032E-1);
+_PS256_CONST(atancof_p2, 1.99777106478E-1);
+_PS256_CONST(atancof_p3, 3.33329491539E-1);
+
+/* evaluation of 8 sines at once, see sin_ps for the details */
+static inline AVX_MATHFUN_TARGET v8sf sin256_ps(v8sf x) { // any x
+  v8sf xmm1, xmm2, xmm3, sign_bit, y;
+  v8si emm0, emm2;
+
+  sign_bit = x;
+  /* take the absolute value */
+  x = _mm256_and_ps(x, *(v8sf*)_ps256_inv_sign_mask);
+  /* extract the sign bit (upper one) */
+  sign_bit = _mm256_and_ps(sign_bit, *(v8sf*)_ps256_sign_mask);
+
+  /* scale by 4/Pi */
+  y = _mm256_mul_ps(x, *(v8sf*)_ps256_cephes_FOPI);
+
+  /* store the integer part of y in emm2 */
+  emm2 = _mm256_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm256_add_epi32(emm2, *(v8si*)_pi32_256_1);
+  emm2 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_inv1);
+  y = _mm256_cvtepi32_ps(emm2);
+
+  /* get the swap sign flag */
+  emm0 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_4);
+  emm0 = _mm256_slli_epi32(emm0, 29);
+  /* get the polynom selection mask, both branches will be computed */
+  emm2 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_2);
+  emm2 = _mm256_cmpeq_epi32(emm2, _mm256_setzero_si256());
+
+  v8sf swap_sign_bit = _mm256_castsi256_ps(emm0);
+  v8sf poly_mask = _mm256_castsi256_ps(emm2);
+  sign_bit = _mm256_xor_ps(sign_bit, swap_sign_bit);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = *(v8sf*)_ps256_minus_cephes_DP1;
+  xmm2 = *(v8sf*)_ps256_minus_cephes_DP2;
+  xmm3 = *(v8sf*)_ps256_minus_cephes_DP3;
+  xmm1 = _mm256_mul_ps(y, xmm1);
+  xmm2 = _mm256_mul_ps(y, xmm2);
+  xmm3 = _mm256_mul_ps(y, xmm3);
+  x = _mm256_add_ps(x, xmm1);
+  x = _mm256_add_ps(x, xmm2);
+  x = _mm256_add_ps(x, xmm3);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  y = *(v8sf*)_ps256_coscof_p0;
+  v8sf z = _mm256_mul_ps(x,x);
+
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_coscof_p1);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_coscof_p2);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_mul_ps(y, z);
+  v8sf tmp = _mm256_mul_ps(z, *(v8sf*)_ps256_0p5);
+  y = _mm256_sub_ps(y, tmp);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  v8sf y2 = *(v8sf*)_ps256_sincof_p0;
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_add_ps(y2, *(v8sf*)_ps256_sincof_p1);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_add_ps(y2, *(v8sf*)_ps256_sincof_p2);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_mul_ps(y2, x);
+  y2 = _mm256_add_ps(y2, x);
+
+  /* select the correct result from the two polynoms */
+  xmm3 = poly_mask;
+  y2 = _mm256_and_ps(xmm3, y2);
+  y = _mm256_andnot_ps(xmm3, y);
+  y = _mm256_add_ps(y,y2);
+  /* update the sign */
+  y = _mm256_xor_ps(y, sign_bit);
+
+  return y;
+}
+
+/* almost the same as sin256_ps */
+static inline AVX_MATHFUN_TARGET v8sf cos256_ps(v8sf x) { // any x
+  v8sf xmm1, xmm2, xmm3, y;
+  v8si emm0, emm2;
+
+  /* take the absolute value */
+  x = _mm256_and_ps(x, *(v8sf*)_ps256_inv_sign_mask);
+
+  /* scale by 4/Pi */
+  y = _mm256_mul_ps(x, *(v8sf*)_ps256_cephes_FOPI);
+
+  /* store the integer part of y in emm2 */
+  emm2 = _mm256_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm256_add_epi32(emm2, *(v8si*)_pi32_256_1);
+  emm2 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_inv1);
+  y = _mm256_cvtepi32_ps(emm2);
+
+  emm2 = _mm256_sub_epi32(emm2, *(v8si*)_pi32_256_2);
+
+  /* get the swap sign flag */
+  emm0 = _mm256_andnot_si256(emm2, *(v8si*)_pi32_256_4);
+  emm0 = _mm256_slli_epi32(emm0, 29);
+  /* get the polynom selection mask */
+  emm2 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_2);
+  emm2 = _mm256_cmpeq_epi32(emm2, _mm256_setzero_si256());
+
+  v8sf sign_bit = _mm256_castsi256_ps(emm0);
+  v8sf poly_mask = _mm256_castsi256_ps(emm2);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = *(v8sf*)_ps256_minus_cephes_DP1;
+  xmm2 = *(v8sf*)_ps256_minus_cephes_DP2;
+  xmm3 = *(v8sf*)_ps256_minus_cephes_DP3;
+  xmm1 = _mm256_mul_ps(y, xmm1);
+  xmm2 = _mm256_mul_ps(y, xmm2);
+  xmm3 = _mm256_mul_ps(y, xmm3);
+  x = _mm256_add_ps(x, xmm1);
+  x = _mm256_add_ps(x, xmm2);
+  x = _mm256_add_ps(x, xmm3);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  y = *(v8sf*)_ps256_coscof_p0;
+  v8sf z = _mm256_mul_ps(x,x);
+
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_coscof_p1);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_coscof_p2);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_mul_ps(y, z);
+  v8sf tmp = _mm256_mul_ps(z, *(v8sf*)_ps256_0p5);
+  y = _mm256_sub_ps(y, tmp);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  v8sf y2 = *(v8sf*)_ps256_sincof_p0;
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_add_ps(y2, *(v8sf*)_ps256_sincof_p1);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_add_ps(y2, *(v8sf*)_ps256_sincof_p2);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_mul_ps(y2, x);
+  y2 = _mm256_add_ps(y2, x);
+
+  /* select the correct result from the two polynoms */
+  xmm3 = poly_mask;
+  y2 = _mm256_and_ps(xmm3, y2);
+  y = _mm256_andnot_ps(xmm3, y);
+  y = _mm256_add_ps(y,y2);
+  /* update the sign */
+  y = _mm256_xor_ps(y, sign_bit);
+
+  return y;
+}
+
+/* sine and cosine in one pass, see sincos_ps */
+static inline AVX_MATHFUN_TARGET void sincos256_ps(v8sf x, v8sf *s, v8sf *c) {
+  v8sf xmm1, xmm2, xmm3, sign_bit_sin, y;
+  v8si emm0, emm2, emm4;
+
+  sign_bit_sin = x;
+  /* take the absolute value */
+  x = _mm256_and_ps(x, *(v8sf*)_ps256_inv_sign_mask);
+  /* extract the sign bit (upper one) */
+  sign_bit_sin = _mm256_and_ps(sign_bit_sin, *(v8sf*)_ps256_sign_mask);
+
+  /* scale by 4/Pi */
+  y = _mm256_mul_ps(x, *(v8sf*)_ps256_cephes_FOPI);
+
+  /* store the integer part of y in emm2 */
+  emm2 = _mm256_cvttps_epi32(y);
+
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm256_add_epi32(emm2, *(v8si*)_pi32_256_1);
+  emm2 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_inv1);
+  y = _mm256_cvtepi32_ps(emm2);
+
+  emm4 = emm2;
+
+  /* get the swap sign flag for the sine */
+  emm0 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_4);
+  emm0 = _mm256_slli_epi32(emm0, 29);
+  v8sf swap_sign_bit_sin = _mm256_castsi256_ps(emm0);
+
+  /* get the polynom selection mask for the sine*/
+  emm2 = _mm256_and_si256(emm2, *(v8si*)_pi32_256_2);
+  emm2 = _mm256_cmpeq_epi32(emm2, _mm256_setzero_si256());
+  v8sf poly_mask = _mm256_castsi256_ps(emm2);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  xmm1 = *(v8sf*)_ps256_minus_cephes_DP1;
+  xmm2 = *(v8sf*)_ps256_minus_cephes_DP2;
+  xmm3 = *(v8sf*)_ps256_minus_cephes_DP3;
+  xmm1 = _mm256_mul_ps(y, xmm1);
+  xmm2 = _mm256_mul_ps(y, xmm2);
+  xmm3 = _mm256_mul_ps(y, xmm3);
+  x = _mm256_add_ps(x, xmm1);
+  x = _mm256_add_ps(x, xmm2);
+  x = _mm256_add_ps(x, xmm3);
+
+  /* get the sign flag for the cosine */
+  emm4 = _mm256_sub_epi32(emm4, *(v8si*)_pi32_256_2);
+  emm4 = _mm256_andnot_si256(emm4, *(v8si*)_pi32_256_4);
+  emm4 = _mm256_slli_epi32(emm4, 29);
+  v8sf sign_bit_cos = _mm256_castsi256_ps(emm4);
+
+  sign_bit_sin = _mm256_xor_ps(sign_bit_sin, swap_sign_bit_sin);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  v8sf z = _mm256_mul_ps(x,x);
+  y = *(v8sf*)_ps256_coscof_p0;
+
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_coscof_p1);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_coscof_p2);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_mul_ps(y, z);
+  v8sf tmp = _mm256_mul_ps(z, *(v8sf*)_ps256_0p5);
+  y = _mm256_sub_ps(y, tmp);
+  y = _mm256_add_ps(y, *(v8sf*)_ps256_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  v8sf y2 = *(v8sf*)_ps256_sincof_p0;
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_add_ps(y2, *(v8sf*)_ps256_sincof_p1);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_add_ps(y2, *(v8sf*)_ps256_sincof_p2);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_mul_ps(y2, x);
+  y2 = _mm256_add_ps(y2, x);
+
+  /* select the correct result from the two polynoms */
+  xmm3 = poly_mask;
+  v8sf ysin2 = _mm256_and_ps(xmm3, y2);
+  v8sf ysin1 = _mm256_andnot_ps(xmm3, y);
+  y2 = _mm256_sub_ps(y2,ysin2);
+  y = _mm256_sub_ps(y, ysin1);
+
+  xmm1 = _mm256_add_ps(ysin1,ysin2);
+  xmm2 = _mm256_add_ps(y,y2);
+
+  /* update the sign */
+  *s = _mm256_xor_ps(xmm1, sign_bit_sin);
+  *c = _mm256_xor_ps(xmm2, sign_bit_cos);
+}
+
+/* see atan_ps */
+static inline AVX_MATHFUN_TARGET v8sf atan256_ps(v8sf x) {
+  v8sf sign_bit, y;
+
+  sign_bit = x;
+  /* take the absolute value */
+  x = _mm256_and_ps(x, *(v8sf*)_ps256_inv_sign_mask);
+  /* extract the sign bit (upper one) */
+  sign_bit = _mm256_and_ps(sign_bit, *(v8sf*)_ps256_sign_mask);
+
+  /* range reduction, init x and y depending on range */
+  /* x > 2.414213562373095 */
+  v8sf cmp0 = _mm256_cmp_ps(x, *(v8sf*)_ps256_atanrange_hi, _CMP_GT_OS);
+  /* x > 0.4142135623730950 */
+  v8sf cmp1 = _mm256_cmp_ps(x, *(v8sf*)_ps256_atanrange_lo, _CMP_GT_OS);
+
+  /* x > 0.4142135623730950 && !( x > 2.414213562373095 ) */
+  v8sf cmp2 = _mm256_andnot_ps(cmp0, cmp1);
+
+  /* -( 1.0/x ) */
+  v8sf y0 = _mm256_and_ps(cmp0, *(v8sf*)_ps256_cephes_PIO2F);
+  v8sf x0 = _mm256_div_ps(*(v8sf*)_ps256_1, x);
+  x0 = _mm256_xor_ps(x0, *(v8sf*)_ps256_sign_mask);
+
+  v8sf y1 = _mm256_and_ps(cmp2, *(v8sf*)_ps256_cephes_PIO4F);
+  /* (x-1.0)/(x+1.0) */
+  v8sf x1_o = _mm256_sub_ps(x, *(v8sf*)_ps256_1);
+  v8sf x1_u = _mm256_add_ps(x, *(v8sf*)_ps256_1);
+  v8sf x1 = _mm256_div_ps(x1_o, x1_u);
+
+  v8sf x2 = _mm256_and_ps(cmp2, x1);
+  x0 = _mm256_and_ps(cmp0, x0);
+  x2 = _mm256_or_ps(x2, x0);
+  cmp1 = _mm256_or_ps(cmp0, cmp2);
+  x2 = _mm256_and_ps(cmp1, x2);
+  x = _mm256_andnot_ps(cmp1, x);
+  x = _mm256_or_ps(x2, x);
+
+  y = _mm256_or_ps(y0, y1);
+
+  v8sf zz = _mm256_mul_ps(x, x);
+  v8sf acc = *(v8sf*)_ps256_atancof_p0;
+  acc = _mm256_mul_ps(acc, zz);
+  acc = _mm256_sub_ps(acc, *(v8sf*)_ps256_atancof_p1);
+  acc = _mm256_mul_ps(acc, zz);
+  acc = _mm256_add_ps(acc, *(v8sf*)_ps256_atancof_p2);
+  acc = _mm256_mul_ps(acc, zz);
+  acc = _mm256_sub_ps(acc, *(v8sf*)_ps256_atancof_p3);
+  acc = _mm256_mul_ps(acc, zz);
+  acc = _mm256_mul_ps(acc, x);
+  acc = _mm256_add_ps(acc, x);
+  y = _mm256_add_ps(y, acc);
+
+  /* update the sign */
+  y = _mm256_xor_ps(y, sign_bit);
+
+  return y;
+}
+
+/* see atan2_ps */
+static inline AVX_MATHFUN_TARGET v8sf atan2_256_ps(v8sf y, v8sf x) {
+  v8sf x_eq_0 = _mm256_cmp_ps(x, *(v8sf*)_ps256_0, _CMP_EQ_OQ);
+  v8sf x_gt_0 = _mm256_cmp_ps(x, *(v8sf*)_ps256_0, _CMP_GT_OS);
+  v8sf x_le_0 = _mm256_cmp_ps(x, *(v8sf*)_ps256_0, _CMP_LE_OS);
+  v8sf y_eq_0 = _mm256_cmp_ps(y, *(v8sf*)_ps256_0, _CMP_EQ_OQ);
+  v8sf x_lt_0 = _mm256_cmp_ps(x, *(v8sf*)_ps256_0, _CMP_LT_OS);
+  v8sf y_lt_0 = _mm256_cmp_ps(y, *(v8sf*)_ps256_0, _CMP_LT_OS);
+
+  v8sf zero_mask = _mm256_and_ps(x_eq_0, y_eq_0);
+  v8sf zero_mask_other_case = _mm256_and_ps(y_eq_0, x_gt_0);
+  zero_mask = _mm256_or_ps(zero_mask, zero_mask_other_case);
+
+  v8sf pio2_mask = _mm256_andnot_ps(y_eq_0, x_eq_0);
+  v8sf pio2_mask_sign = _mm256_and_ps(y_lt_0, *(v8sf*)_ps256_sign_mask);
+  v8sf pio2_result = *(v8sf*)_ps256_cephes_PIO2F;
+  pio2_result = _mm256_xor_ps(pio2_result, pio2_mask_sign);
+  pio2_result = _mm256_and_ps(pio2_mask, pio2_result);
+
+  v8sf pi_mask = _mm256_and_ps(y_eq_0, x_le_0);
+  v8sf pi = *(v8sf*)_ps256_cephes_PIF;
+  v8sf pi_result = _mm256_and_ps(pi_mask, pi);
+
+  v8sf swap_sign_mask_offset = _mm256_and_ps(x_lt_0, y_lt_0);
+  swap_sign_mask_offset = _mm256_and_ps(swap_sign_mask_offset, *(v8sf*)_ps256_sign_mask);
+
+  v8sf offset1 = *(v8sf*)_ps256_cephes_PIF;
+  offset1 = _mm256_xor_ps(offset1, swap_sign_mask_offset);
+
+  v8sf offset = _mm256_and_ps(x_lt_0, offset1);
+
+  v8sf arg = _mm256_div_ps(y, x);
+  v8sf atan_result = atan256_ps(arg);
+  atan_result = _mm256_add_ps(atan_result, offset);
+
+  /* select between zero_result, pio2_result and atan_result */
+  v8sf result = _mm256_andnot_ps(zero_mask, pio2_result);
+  atan_result = _mm256_andnot_ps(pio2_mask, atan_result);
+  result = _mm256_or_ps(result, atan_result);
+  result = _mm256_or_ps(result, pi_result);
+
+  return result;
+}
+
+#endif
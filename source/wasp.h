@@ -20,7 +20,7 @@
 
   - Error message / is complete / debug log / is valid / wait for result, functions
 
-  - More SIMD, as well as base SIMD requirements
+  - More SIMD
 
   - Something like Debugf() in the string library?
 
@@ -42,8 +42,12 @@
   CONTEXT CRACKING
 */
 
-#if defined(__clang__)
-#  define Compiler_CLANG 1
+#if defined(__clang__) || defined(__GNUC__)
+#  if defined(__clang__)
+#    define Compiler_CLANG 1
+#  else
+#    define Compiler_GCC 1
+#  endif
 
 #  if defined(_WIN32)
 #    define Platform_WIN32 1
@@ -0,0 +1,244 @@
+#ifndef WASP_H
+#error This module depends on wasp.h
+#endif
+
+#ifndef WASP_CPU_H
+#define WASP_CPU_H
+
+// NOTE: Probes the instruction set extensions of the CPU we run on, so one binary can carry kernels for several of
+// them and pick the fastest one that is safe. Call CpuInfoGet once at startup, before anything that could use an
+// instruction the CPU might not have. CpuFeaturesRequired is what the compiler was allowed to assume everywhere, when
+// those aren't all there the program has to stop before it hits an illegal instruction. Kernels for extensions past
+// that are compiled with CpuTarget and only called through a dispatch table filled from the probed features, see
+// MathKernelsGet in wasp_math.h. Everything but x86 reports no features.
+
+/*
+  CONSTANTS
+*/
+
+#define CpuFeaturesCount 13
+
+/*
+  TYPES
+*/
+
+enum cpu_feature
+{
+    CpuFeature_SSE2     = 1 << 0,
+    CpuFeature_SSE3     = 1 << 1,
+    CpuFeature_SSSE3    = 1 << 2,
+    CpuFeature_SSE41    = 1 << 3,
+    CpuFeature_SSE42    = 1 << 4,
+    CpuFeature_POPCNT   = 1 << 5,
+    
+    // NOTE: Only set when the OS also saves the wide registers on context switches
+    CpuFeature_AVX      = 1 << 6,
+    CpuFeature_FMA      = 1 << 7,
+    CpuFeature_AVX2     = 1 << 8,
+    CpuFeature_BMI2     = 1 << 9,
+    CpuFeature_AVX512F  = 1 << 10,
+    CpuFeature_AVX512BW = 1 << 11,
+    CpuFeature_AVX512VL = 1 << 12,
+};
+
+struct cpu_info
+{
+    char Vendor[16];
+    char Brand[52];
+    
+    flag32(cpu_feature) Features;
+};
+
+/*
+  GLOBALS
+*/
+
+global cpu_info GlobalCpu;
+
+// NOTE: Indexed by the bit of the feature
+global char *GlobalCpuFeatureNames[CpuFeaturesCount] =
+{
+    "sse2", "sse3", "ssse3", "sse4.1", "sse4.2", "popcnt", "avx", "fma", "avx2", "bmi2", "avx512f", "avx512bw", "avx512vl",
+};
+
+/*
+  FUNCTIONS
+*/
+
+internal cpu_info CpuInfoGet(void);
+
+internal inline flag32(cpu_feature) CpuFeaturesRequired(void); // NOTE: The features this build was compiled to assume
+internal inline b32 CpuHasFeatures(flag32(cpu_feature) Features); // NOTE: Checks against GlobalCpu
+
+// NOTE: Lets a single function use instructions past what the build was compiled for, as in
+// CpuTarget("avx2") internal void KernelAVX2(...). Only ever call such a function after checking the features
+#if Compiler_MSVC
+#define CpuTarget(Features)
+#else
+#define CpuTarget(Features) __attribute__((target(Features)))
+#endif
+
+/*
+  IMPLEMENTATION
+*/
+
+#if Architecture_X86_64 || Architecture_X86_32
+#if Compiler_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+internal inline void
+CpuId(u32 Leaf, u32 SubLeaf, u32 *Registers)
+{
+#if Compiler_MSVC
+    __cpuidex((int *)Registers, (int)Leaf, (int)SubLeaf);
+#else
+    __cpuid_count(Leaf, SubLeaf, Registers[0], Registers[1], Registers[2], Registers[3]);
+#endif
+}
+
+internal inline u64
+CpuExtendedStateEnabled(void)
+{
+    // NOTE: XCR0, which register state the OS saves. Only valid to read when CPUID reports OSXSAVE
+#if Compiler_MSVC
+    return(_xgetbv(0));
+#else
+    u32 Low, High;
+    __asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+    return(((u64)High << 32) | Low);
+#endif
+}
+#endif
+
+internal cpu_info
+CpuInfoGet(void)
+{
+    cpu_info Result = {};
+    
+#if Architecture_X86_64 || Architecture_X86_32
+    u32 Registers[4];
+    
+    CpuId(0, 0, Registers);
+    u32 LeafMax = Registers[0];
+    
+    // NOTE: The vendor string is spread over EBX, EDX and ECX in that order
+    *(u32 *)(Result.Vendor + 0) = Registers[1];
+    *(u32 *)(Result.Vendor + 4) = Registers[3];
+    *(u32 *)(Result.Vendor + 8) = Registers[2];
+    
+    u32 Leaf1C = 0, Leaf1D = 0, Leaf7B = 0;
+    if(LeafMax >= 1)
+    {
+        CpuId(1, 0, Registers);
+        Leaf1C = Registers[2];
+        Leaf1D = Registers[3];
+    }
+    
+    if(LeafMax >= 7)
+    {
+        CpuId(7, 0, Registers);
+        Leaf7B = Registers[1];
+    }
+    
+    if(Leaf1D & (1 << 26)) Result.Features |= CpuFeature_SSE2;
+    if(Leaf1C & (1 << 0))  Result.Features |= CpuFeature_SSE3;
+    if(Leaf1C & (1 << 9))  Result.Features |= CpuFeature_SSSE3;
+    if(Leaf1C & (1 << 19)) Result.Features |= CpuFeature_SSE41;
+    if(Leaf1C & (1 << 20)) Result.Features |= CpuFeature_SSE42;
+    if(Leaf1C & (1 << 23)) Result.Features |= CpuFeature_POPCNT;
+    if(Leaf7B & (1 << 8))  Result.Features |= CpuFeature_BMI2;
+    
+    // NOTE: The CPU can have AVX while the OS doesn't preserve the upper halves of the registers, using them then
+    // faults. XCR0 bits 1 and 2 are the SSE and AVX state, bits 5 to 7 the AVX-512 mask and upper register state
+    u64 StateEnabled = (Leaf1C & (1 << 27)) ? CpuExtendedStateEnabled() : 0;
+    b32 AVXState = (StateEnabled & 0x06) == 0x06;
+    b32 AVX512State = AVXState && (StateEnabled & 0xE0) == 0xE0;
+    
+    if(AVXState)
+    {
+        if(Leaf1C & (1 << 28)) Result.Features |= CpuFeature_AVX;
+        if(Leaf1C & (1 << 12)) Result.Features |= CpuFeature_FMA;
+        if(Leaf7B & (1 << 5))  Result.Features |= CpuFeature_AVX2;
+    }
+    
+    if(AVX512State)
+    {
+        if(Leaf7B & (1 << 16)) Result.Features |= CpuFeature_AVX512F;
+        if(Leaf7B & (1 << 30)) Result.Features |= CpuFeature_AVX512BW;
+        if(Leaf7B & (1u << 31)) Result.Features |= CpuFeature_AVX512VL;
+    }
+    
+    CpuId(0x80000000, 0, Registers);
+    if(Registers[0] >= 0x80000004)
+    {
+        for(u32 Index = 0;
+            Index < 3;
+            Index++)
+        {
+            CpuId(0x80000002 + Index, 0, (u32 *)(Result.Brand + 16*Index));
+        }
+    }
+#endif
+    
+    return(Result);
+}
+
+internal inline flag32(cpu_feature)
+CpuFeaturesRequired(void)
+{
+    flag32(cpu_feature) Result = 0;
+    
+#if defined(__SSE2__) || (Compiler_MSVC && Architecture_X86_64)
+    Result |= CpuFeature_SSE2;
+#endif
+#if defined(__SSE3__)
+    Result |= CpuFeature_SSE3;
+#endif
+#if defined(__SSSE3__)
+    Result |= CpuFeature_SSSE3;
+#endif
+#if defined(__SSE4_1__)
+    Result |= CpuFeature_SSE41;
+#endif
+#if defined(__SSE4_2__)
+    Result |= CpuFeature_SSE42;
+#endif
+#if defined(__POPCNT__)
+    Result |= CpuFeature_POPCNT;
+#endif
+#if defined(__AVX__)
+    Result |= CpuFeature_AVX;
+#endif
+#if defined(__FMA__)
+    Result |= CpuFeature_FMA;
+#endif
+#if defined(__AVX2__)
+    Result |= CpuFeature_AVX2;
+#endif
+#if defined(__BMI2__)
+    Result |= CpuFeature_BMI2;
+#endif
+#if defined(__AVX512F__)
+    Result |= CpuFeature_AVX512F;
+#endif
+#if defined(__AVX512BW__)
+    Result |= CpuFeature_AVX512BW;
+#endif
+#if defined(__AVX512VL__)
+    Result |= CpuFeature_AVX512VL;
+#endif
+    
+    return(Result);
+}
+
+internal inline b32
+CpuHasFeatures(flag32(cpu_feature) Features)
+{
+    b32 Result = (GlobalCpu.Features & Features) == Features;
+    return(Result);
+}
+
+#endif
@@ -0,0 +1,722 @@
+#ifndef WASP_H
+#error This module depends on wasp.h
+#endif
+
+#ifndef WASP_MEMORY_H
+#error This module depends on wasp_memory.h
+#endif
+
+#ifndef WASP_HASH_H
+#define WASP_HASH_H
+
+// NOTE: Fast non-cryptographic hashing, for hash tables, caches and checksums, never for anything an attacker controls.
+// Built the way xxh3 is, but it's our own constants and it doesn't produce the same values as xxh3. Up to 240 bytes
+// the input is folded 16 bytes at a time with 64x64->128 multiplies. Longer inputs run 8 lanes of accumulators over
+// 64 byte stripes with SSE2 or AVX2, the scalar path produces the same values on every other target. Values are stable
+// across platforms and builds, so they can be stored or sent over the network.
+
+/*
+  CONSTANTS
+*/
+
+#define HashSecretSize 192
+#define HashStripeSize 64
+#define HashStripesPerBlock ((HashSecretSize - HashStripeSize) / 8)
+#define HashBufferSize 256
+#define HashShortSizeMax 240
+
+#define HashPrime32_1 0x9e3779b1u
+#define HashPrime64_1 0x9e3779b185ebca87ull
+#define HashPrime64_2 0xc2b2ae3d27d4eb4full
+#define HashPrime64_3 0x165667b19e3779f9ull
+#define HashPrime64_4 0x85ebca77c2b2ae63ull
+#define HashPrime64_5 0x27d4eb2f165667c5ull
+
+/*
+  TYPES
+*/
+
+struct hash_state
+{
+    AlignAs(64) u64 Accumulators[8];
+    AlignAs(64) u8 Secret[HashSecretSize];
+    AlignAs(64) u8 Buffer[HashBufferSize];
+    
+    u32 BufferSize;
+    u32 StripesInBlock;
+    u64 TotalSize;
+    u64 Seed;
+};
+
+/*
+  GLOBALS
+*/
+
+// NOTE: Generated with splitmix64, changing these changes every hash
+AlignAs(64) global u64 GlobalHashSecret[HashSecretSize / 8] =
+{
+    0x8aea4b1ddf248286ull, 0x15a398d5ddf08623ull, 0x7a133f291200f887ull, 0x6f86f2b1e376c98bull,
+    0xf82974c7b8f4c93aull, 0x81dd9bd2636d9ac0ull, 0x043ab94a8b94d890ull, 0x76c0648e639928c3ull,
+    0x90c867e9a6907638ull, 0x0f883f357adc8adcull, 0xee06d6b070f4bcfdull, 0x88e60dcd4b2db75aull,
+    0x9a765abd8948d46eull, 0x94e985cc2c83ad7full, 0x1d4a51c79ce9cb2bull, 0x3cf9dc19b0248f8dull,
+    0xaddaea79247efd1dull, 0x0ded6410c7d7e5c7ull, 0x9e4c26fc4fce8751ull, 0x3c94cea6e1edf45aull,
+    0xf46f89dc76a8a24full, 0xd69d1c805c57f804ull, 0x773f230800f94e14ull, 0x962a37e94020a1fdull,
+};
+
+/*
+  FUNCTIONS
+*/
+
+internal u64 Hash64(void *Data, umm Size, u64 Seed);
+internal u128 Hash128(void *Data, umm Size, u64 Seed);
+
+internal inline u64 HashU64(u64 Value); // NOTE: A bijective mixer for integer keys, zero maps to zero
+
+#ifdef WASP_STRING_H
+internal inline u64 HashString(string String);
+#endif
+
+// NOTE: Streaming produces the same values as hashing all of the input at once, however it was split up
+internal void HashBegin(hash_state *State, u64 Seed);
+internal void HashUpdate(hash_state *State, void *Data, umm Size);
+internal u64 HashEnd64(hash_state *State);
+internal u128 HashEnd128(hash_state *State);
+
+/*
+  IMPLEMENTATION
+*/
+
+#if Architecture_X86_64 || Architecture_X86_32
+#if Compiler_MSVC
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+internal inline u32
+HashRead32(u8 *Pointer)
+{
+#if Compiler_MSVC
+    u32 Result = *(__unaligned u32 *)Pointer;
+#else
+    u32 Result;
+    __builtin_memcpy(&Result, Pointer, SizeOf(Result));
+#endif
+    
+    return(Result);
+}
+
+internal inline u64
+HashRead64(u8 *Pointer)
+{
+#if Compiler_MSVC
+    u64 Result = *(__unaligned u64 *)Pointer;
+#else
+    u64 Result;
+    __builtin_memcpy(&Result, Pointer, SizeOf(Result));
+#endif
+    
+    return(Result);
+}
+
+internal inline u64
+HashRotateLeft(u64 Value, u32 Shift)
+{
+    u64 Result = (Value << Shift) | (Value >> (64 - Shift));
+    return(Result);
+}
+
+// NOTE: Both halves of the 128 bit product xor'ed together
+internal inline u64
+HashMultiplyFold(u64 A, u64 B)
+{
+#if Compiler_MSVC && Architecture_X86_64
+    u64 High;
+    u64 Low = _umul128(A, B, &High);
+#elif (Compiler_GCC || Compiler_CLANG) && BitSize_64
+    unsigned __int128 Product = (unsigned __int128)A * B;
+    u64 Low = (u64)Product;
+    u64 High = (u64)(Product >> 64);
+#else
+    u64 LowLow = (A & 0xffffffff) * (B & 0xffffffff);
+    u64 HighLow = (A >> 32) * (B & 0xffffffff);
+    u64 LowHigh = (A & 0xffffffff) * (B >> 32);
+    u64 HighHigh = (A >> 32) * (B >> 32);
+    
+    u64 Cross = (LowLow >> 32) + (HighLow & 0xffffffff) + LowHigh;
+    u64 High = (HighLow >> 32) + (Cross >> 32) + HighHigh;
+    u64 Low = (Cross << 32) | (LowLow & 0xffffffff);
+#endif
+    
+    u64 Result = Low ^ High;
+    return(Result);
+}
+
+internal inline u64
+HashAvalanche(u64 Hash)
+{
+    Hash ^= Hash >> 37;
+    Hash *= 0x165667919e3779f9ull;
+    Hash ^= Hash >> 32;
+    return(Hash);
+}
+
+internal inline u64
+HashU64(u64 Value)
+{
+    // NOTE: The murmur3 finalizer
+    u64 Result = Value;
+    Result ^= Result >> 33;
+    Result *= 0xff51afd7ed558ccdull;
+    Result ^= Result >> 33;
+    Result *= 0xc4ceb9fe1a85ec53ull;
+    Result ^= Result >> 33;
+    return(Result);
+}
+
+internal inline u64
+HashMix16(u8 *Data, u8 *Secret, u64 Seed)
+{
+    u64 Low = HashRead64(Data) ^ (HashRead64(Secret) + Seed);
+    u64 High = HashRead64(Data + 8) ^ (HashRead64(Secret + 8) - Seed);
+    
+    u64 Result = HashMultiplyFold(Low, High);
+    return(Result);
+}
+
+// NOTE: Reads at most 136 bytes of the secret, so the 128 bit hash can run it a second time 32 bytes further in
+internal u64
+HashShort(u8 *Data, umm Size, u8 *Secret, u64 Seed)
+{
+    Assert(Size <= HashShortSizeMax);
+    
+    u64 Result;
+    
+    if(Size > 128)
+    {
+        u64 Accumulator = Size * HashPrime64_1;
+        u32 RoundsCount = (u32)(Size / 16);
+        
+        for(u32 Round = 0;
+            Round < 8;
+            Round++)
+        {
+            Accumulator += HashMix16(Data + 16 * Round, Secret + 16 * Round, Seed);
+        }
+        
+        // NOTE: Only the first 128 bytes of the secret get used for the rounds, the rest start at a different offset
+        Accumulator = HashAvalanche(Accumulator);
+        
+        for(u32 Round = 8;
+            Round < RoundsCount;
+            Round++)
+        {
+            Accumulator += HashMix16(Data + 16 * Round, Secret + 16 * (Round - 8) + 3, Seed);
+        }
+        
+        Accumulator += HashMix16(Data + Size - 16, Secret + 119, Seed);
+        
+        Result = HashAvalanche(Accumulator);
+    }
+    else if(Size > 16)
+    {
+        // NOTE: Pairs from both ends overlap in the middle, so every byte is read without a tail loop
+        u64 Accumulator = Size * HashPrime64_1;
+        
+        if(Size > 32)
+        {
+            if(Size > 64)
+            {
+                if(Size > 96)
+                {
+                    Accumulator += HashMix16(Data + 48, Secret + 96, Seed);
+                    Accumulator += HashMix16(Data + Size - 64, Secret + 112, Seed);
+                }
+                
+                Accumulator += HashMix16(Data + 32, Secret + 64, Seed);
+                Accumulator += HashMix16(Data + Size - 48, Secret + 80, Seed);
+            }
+            
+            Accumulator += HashMix16(Data + 16, Secret + 32, Seed);
+            Accumulator += HashMix16(Data + Size - 32, Secret + 48, Seed);
+        }
+        
+        Accumulator += HashMix16(Data, Secret, Seed);
+        Accumulator += HashMix16(Data + Size - 16, Secret + 16, Seed);
+        
+        Result = HashAvalanche(Accumulator);
+    }
+    else if(Size > 8)
+    {
+        u64 Low = HashRead64(Data) ^ ((HashRead64(Secret + 24) ^ HashRead64(Secret + 32)) + Seed);
+        u64 High = HashRead64(Data + Size - 8) ^ ((HashRead64(Secret + 40) ^ HashRead64(Secret + 48)) - Seed);
+        
+        Result = HashAvalanche(Size + HashRotateLeft(Low, 32) + High + HashMultiplyFold(Low, High));
+    }
+    else if(Size >= 4)
+    {
+        u64 Input = (u64)HashRead32(Data + Size - 4) | ((u64)HashRead32(Data) << 32);
+        u64 Key = (HashRead64(Secret + 8) ^ HashRead64(Secret + 16)) - Seed;
+        
+        // NOTE: rrmxmx, since only one multiply of the input would leave the high bits weak
+        u64 Hash = Input ^ Key;
+        Hash ^= HashRotateLeft(Hash, 49) ^ HashRotateLeft(Hash, 24);
+        Hash *= 0x9fb21c651e98df25ull;
+        Hash ^= (Hash >> 35) + Size;
+        Hash *= 0x9fb21c651e98df25ull;
+        Hash ^= Hash >> 28;
+        
+        Result = Hash;
+    }
+    else if(Size)
+    {
+        u32 Combined = ((u32)Data[0] << 16) | ((u32)Data[Size >> 1] << 24) | (u32)Data[Size - 1] | ((u32)Size << 8);
+        u64 Key = (u64)(HashRead32(Secret) ^ HashRead32(Secret + 4)) + Seed;
+        
+        u64 Hash = (u64)Combined ^ Key;
+        Hash ^= Hash >> 33;
+        Hash *= HashPrime64_2;
+        Hash ^= Hash >> 29;
+        Hash *= HashPrime64_3;
+        Hash ^= Hash >> 32;
+        
+        Result = Hash;
+    }
+    else
+    {
+        Result = HashAvalanche(Seed ^ HashRead64(Secret + 56) ^ HashRead64(Secret + 64));
+    }
+    
+    return(Result);
+}
+
+internal inline void
+HashAccumulatorsInit(u64 *Accumulators)
+{
+    Accumulators[0] = HashPrime32_1;
+    Accumulators[1] = HashPrime64_1;
+    Accumulators[2] = HashPrime64_2;
+    Accumulators[3] = HashPrime64_3;
+    Accumulators[4] = HashPrime64_4;
+    Accumulators[5] = HashPrime64_5;
+    Accumulators[6] = ~HashPrime64_1;
+    Accumulators[7] = ~HashPrime64_2;
+}
+
+#if (Architecture_X86_64 || Architecture_X86_32) && !defined(__AVX2__)
+internal inline __m128i
+HashAccumulateLane(__m128i Accumulator, __m128i *Stripe, __m128i *Key)
+{
+    __m128i Value = _mm_loadu_si128(Stripe);
+    __m128i Keyed = _mm_xor_si128(Value, _mm_loadu_si128(Key));
+    
+    __m128i Product = _mm_mul_epu32(Keyed, _mm_shuffle_epi32(Keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+    __m128i Swapped = _mm_shuffle_epi32(Value, _MM_SHUFFLE(1, 0, 3, 2));
+    
+    __m128i Result = _mm_add_epi64(Accumulator, _mm_add_epi64(Product, Swapped));
+    return(Result);
+}
+#endif
+
+// NOTE: Every lane adds the product of the two halves of its keyed input, and its neighbour adds the input itself,
+// so no input bits get lost to a multiply by zero. Each stripe is keyed 8 bytes further into the secret
+internal inline void
+HashAccumulate(u64 *Accumulators, u8 *Data, umm StripesCount, u8 *Secret)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+#if defined(__AVX2__)
+    __m256i Accumulator0 = _mm256_load_si256((__m256i *)Accumulators + 0);
+    __m256i Accumulator1 = _mm256_load_si256((__m256i *)Accumulators + 1);
+    
+    for(umm StripeIndex = 0;
+        StripeIndex < StripesCount;
+        StripeIndex++)
+    {
+        __m256i *Stripe = (__m256i *)(Data + StripeIndex * HashStripeSize);
+        __m256i *Key = (__m256i *)(Secret + StripeIndex * 8);
+        
+        __m256i Value0 = _mm256_loadu_si256(Stripe + 0);
+        __m256i Value1 = _mm256_loadu_si256(Stripe + 1);
+        __m256i Keyed0 = _mm256_xor_si256(Value0, _mm256_loadu_si256(Key + 0));
+        __m256i Keyed1 = _mm256_xor_si256(Value1, _mm256_loadu_si256(Key + 1));
+        
+        __m256i Product0 = _mm256_mul_epu32(Keyed0, _mm256_shuffle_epi32(Keyed0, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m256i Product1 = _mm256_mul_epu32(Keyed1, _mm256_shuffle_epi32(Keyed1, _MM_SHUFFLE(0, 3, 0, 1)));
+        
+        Accumulator0 = _mm256_add_epi64(Accumulator0, _mm256_add_epi64(Product0, _mm256_shuffle_epi32(Value0, _MM_SHUFFLE(1, 0, 3, 2))));
+        Accumulator1 = _mm256_add_epi64(Accumulator1, _mm256_add_epi64(Product1, _mm256_shuffle_epi32(Value1, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+    
+    _mm256_store_si256((__m256i *)Accumulators + 0, Accumulator0);
+    _mm256_store_si256((__m256i *)Accumulators + 1, Accumulator1);
+#else
+    __m128i Accumulator0 = _mm_load_si128((__m128i *)Accumulators + 0);
+    __m128i Accumulator1 = _mm_load_si128((__m128i *)Accumulators + 1);
+    __m128i Accumulator2 = _mm_load_si128((__m128i *)Accumulators + 2);
+    __m128i Accumulator3 = _mm_load_si128((__m128i *)Accumulators + 3);
+    
+    for(umm StripeIndex = 0;
+        StripeIndex < StripesCount;
+        StripeIndex++)
+    {
+        __m128i *Stripe = (__m128i *)(Data + StripeIndex * HashStripeSize);
+        __m128i *Key = (__m128i *)(Secret + StripeIndex * 8);
+        
+        Accumulator0 = HashAccumulateLane(Accumulator0, Stripe + 0, Key + 0);
+        Accumulator1 = HashAccumulateLane(Accumulator1, Stripe + 1, Key + 1);
+        Accumulator2 = HashAccumulateLane(Accumulator2, Stripe + 2, Key + 2);
+        Accumulator3 = HashAccumulateLane(Accumulator3, Stripe + 3, Key + 3);
+    }
+    
+    _mm_store_si128((__m128i *)Accumulators + 0, Accumulator0);
+    _mm_store_si128((__m128i *)Accumulators + 1, Accumulator1);
+    _mm_store_si128((__m128i *)Accumulators + 2, Accumulator2);
+    _mm_store_si128((__m128i *)Accumulators + 3, Accumulator3);
+#endif
+#else
+    for(umm StripeIndex = 0;
+        StripeIndex < StripesCount;
+        StripeIndex++)
+    {
+        u8 *Stripe = Data + StripeIndex * HashStripeSize;
+        u8 *Key = Secret + StripeIndex * 8;
+        
+        for(u32 Lane = 0;
+            Lane < 8;
+            Lane++)
+        {
+            u64 Value = HashRead64(Stripe + 8 * Lane);
+            u64 Keyed = Value ^ HashRead64(Key + 8 * Lane);
+            
+            Accumulators[Lane ^ 1] += Value;
+            Accumulators[Lane] += (Keyed & 0xffffffff) * (Keyed >> 32);
+        }
+    }
+#endif
+}
+
+internal inline void
+HashScramble(u64 *Accumulators, u8 *Secret)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+#if defined(__AVX2__)
+    __m256i Prime = _mm256_set1_epi32((int)HashPrime32_1);
+    
+    for(u32 Lane = 0;
+        Lane < 2;
+        Lane++)
+    {
+        __m256i Accumulator = _mm256_load_si256((__m256i *)Accumulators + Lane);
+        Accumulator = _mm256_xor_si256(Accumulator, _mm256_srli_epi64(Accumulator, 47));
+        Accumulator = _mm256_xor_si256(Accumulator, _mm256_loadu_si256((__m256i *)Secret + Lane));
+        
+        __m256i Low = _mm256_mul_epu32(Accumulator, Prime);
+        __m256i High = _mm256_mul_epu32(_mm256_shuffle_epi32(Accumulator, _MM_SHUFFLE(0, 3, 0, 1)), Prime);
+        
+        _mm256_store_si256((__m256i *)Accumulators + Lane, _mm256_add_epi64(Low, _mm256_slli_epi64(High, 32)));
+    }
+#else
+    __m128i Prime = _mm_set1_epi32((int)HashPrime32_1);
+    
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        __m128i Accumulator = _mm_load_si128((__m128i *)Accumulators + Lane);
+        Accumulator = _mm_xor_si128(Accumulator, _mm_srli_epi64(Accumulator, 47));
+        Accumulator = _mm_xor_si128(Accumulator, _mm_loadu_si128((__m128i *)Secret + Lane));
+        
+        __m128i Low = _mm_mul_epu32(Accumulator, Prime);
+        __m128i High = _mm_mul_epu32(_mm_shuffle_epi32(Accumulator, _MM_SHUFFLE(0, 3, 0, 1)), Prime);
+        
+        _mm_store_si128((__m128i *)Accumulators + Lane, _mm_add_epi64(Low, _mm_slli_epi64(High, 32)));
+    }
+#endif
+#else
+    for(u32 Lane = 0;
+        Lane < 8;
+        Lane++)
+    {
+        u64 Accumulator = Accumulators[Lane];
+        Accumulator ^= Accumulator >> 47;
+        Accumulator ^= HashRead64(Secret + 8 * Lane);
+        Accumulator *= HashPrime32_1;
+        
+        Accumulators[Lane] = Accumulator;
+    }
+#endif
+}
+
+// NOTE: The accumulators are scrambled after every block of HashStripesPerBlock stripes
+internal void
+HashConsumeStripes(u64 *Accumulators, u32 *StripesInBlock, u8 *Data, umm StripesCount, u8 *Secret)
+{
+    while(StripesCount)
+    {
+        umm Count = Min(StripesCount, HashStripesPerBlock - *StripesInBlock);
+        HashAccumulate(Accumulators, Data, Count, Secret + *StripesInBlock * 8);
+        
+        Data += Count * HashStripeSize;
+        StripesCount -= Count;
+        *StripesInBlock += (u32)Count;
+        
+        if(*StripesInBlock == HashStripesPerBlock)
+        {
+            HashScramble(Accumulators, Secret + HashSecretSize - HashStripeSize);
+            *StripesInBlock = 0;
+        }
+    }
+}
+
+internal inline void
+HashConsumeLastStripe(u64 *Accumulators, u8 *Stripe, u8 *Secret)
+{
+    HashAccumulate(Accumulators, Stripe, 1, Secret + HashSecretSize - HashStripeSize - 7);
+}
+
+internal inline u64
+HashMerge(u64 *Accumulators, u8 *Secret, u64 Start)
+{
+    u64 Result = Start;
+    
+    for(u32 Pair = 0;
+        Pair < 4;
+        Pair++)
+    {
+        Result += HashMultiplyFold(Accumulators[2 * Pair] ^ HashRead64(Secret + 16 * Pair),
+                                   Accumulators[2 * Pair + 1] ^ HashRead64(Secret + 16 * Pair + 8));
+    }
+    
+    Result = HashAvalanche(Result);
+    return(Result);
+}
+
+internal inline u64
+HashMergeLow(u64 *Accumulators, u8 *Secret, u64 Size)
+{
+    u64 Result = HashMerge(Accumulators, Secret + 11, Size * HashPrime64_1);
+    return(Result);
+}
+
+internal inline u64
+HashMergeHigh(u64 *Accumulators, u8 *Secret, u64 Size)
+{
+    u64 Result = HashMerge(Accumulators, Secret + HashSecretSize - HashStripeSize - 11, ~(Size * HashPrime64_2));
+    return(Result);
+}
+
+// NOTE: Long inputs take the seed through the secret, so every lane is keyed with it
+internal void
+HashSecretDerive(u8 *Secret, u64 Seed)
+{
+    u64 *Destination = (u64 *)Secret;
+    
+    for(u32 Index = 0;
+        Index < HashSecretSize / 8;
+        Index += 2)
+    {
+        Destination[Index] = GlobalHashSecret[Index] + Seed;
+        Destination[Index + 1] = GlobalHashSecret[Index + 1] - Seed;
+    }
+}
+
+internal void
+HashLong(u64 *Accumulators, u8 *Data, umm Size, u64 Seed, u8 *SecretBuffer, u8 **Secret)
+{
+    Assert(Size > HashShortSizeMax);
+    
+    *Secret = (u8 *)GlobalHashSecret;
+    if(Seed)
+    {
+        HashSecretDerive(SecretBuffer, Seed);
+        *Secret = SecretBuffer;
+    }
+    
+    // NOTE: The last stripe always ends at the end of the input and can overlap the one before it
+    u32 StripesInBlock = 0;
+    HashAccumulatorsInit(Accumulators);
+    HashConsumeStripes(Accumulators, &StripesInBlock, Data, (Size - 1) / HashStripeSize, *Secret);
+    HashConsumeLastStripe(Accumulators, Data + Size - HashStripeSize, *Secret);
+}
+
+internal u64
+Hash64(void *Data, umm Size, u64 Seed)
+{
+    u64 Result;
+    
+    if(Size <= HashShortSizeMax)
+    {
+        Result = HashShort((u8 *)Data, Size, (u8 *)GlobalHashSecret, Seed);
+    }
+    else
+    {
+        AlignAs(64) u64 Accumulators[8];
+        AlignAs(64) u8 SecretBuffer[HashSecretSize];
+        u8 *Secret;
+        
+        HashLong(Accumulators, (u8 *)Data, Size, Seed, SecretBuffer, &Secret);
+        Result = HashMergeLow(Accumulators, Secret, Size);
+    }
+    
+    return(Result);
+}
+
+internal u128
+Hash128(void *Data, umm Size, u64 Seed)
+{
+    u128 Result;
+    
+    if(Size <= HashShortSizeMax)
+    {
+        Result.Low = HashShort((u8 *)Data, Size, (u8 *)GlobalHashSecret, Seed);
+        Result.High = HashShort((u8 *)Data, Size, (u8 *)GlobalHashSecret + 32, Seed ^ HashPrime64_4);
+    }
+    else
+    {
+        AlignAs(64) u64 Accumulators[8];
+        AlignAs(64) u8 SecretBuffer[HashSecretSize];
+        u8 *Secret;
+        
+        HashLong(Accumulators, (u8 *)Data, Size, Seed, SecretBuffer, &Secret);
+        Result.Low = HashMergeLow(Accumulators, Secret, Size);
+        Result.High = HashMergeHigh(Accumulators, Secret, Size);
+    }
+    
+    return(Result);
+}
+
+#ifdef WASP_STRING_H
+internal inline u64
+HashString(string String)
+{
+    u64 Result = Hash64(String.Data, String.Size, 0);
+    return(Result);
+}
+#endif
+
+internal void
+HashBegin(hash_state *State, u64 Seed)
+{
+    Assert(State);
+    
+    HashAccumulatorsInit(State->Accumulators);
+    HashSecretDerive(State->Secret, Seed);
+    
+    State->BufferSize = 0;
+    State->StripesInBlock = 0;
+    State->TotalSize = 0;
+    State->Seed = Seed;
+}
+
+// NOTE: The buffer is only consumed once more input follows it, so the last stripe is always still around at the end
+internal void
+HashUpdate(hash_state *State, void *Data, umm Size)
+{
+    Assert(State);
+    
+    u8 *Input = (u8 *)Data;
+    State->TotalSize += Size;
+    
+    if(State->BufferSize + Size <= HashBufferSize)
+    {
+        MemoryCopy(State->Buffer + State->BufferSize, Input, Size);
+        State->BufferSize += (u32)Size;
+    }
+    else
+    {
+        if(State->BufferSize)
+        {
+            umm FillSize = HashBufferSize - State->BufferSize;
+            MemoryCopy(State->Buffer + State->BufferSize, Input, FillSize);
+            Input += FillSize;
+            Size -= FillSize;
+            
+            HashConsumeStripes(State->Accumulators, &State->StripesInBlock, State->Buffer, HashBufferSize / HashStripeSize, State->Secret);
+        }
+        
+        if(Size > HashBufferSize)
+        {
+            umm StripesCount = (Size - 1) / HashStripeSize;
+            HashConsumeStripes(State->Accumulators, &State->StripesInBlock, Input, StripesCount, State->Secret);
+            Input += StripesCount * HashStripeSize;
+            Size -= StripesCount * HashStripeSize;
+            
+            // NOTE: At most a stripe is left, the end of the buffer keeps the input before it for the last stripe
+            MemoryCopy(State->Buffer + HashBufferSize - HashStripeSize, Input - HashStripeSize, HashStripeSize);
+        }
+        
+        MemoryCopy(State->Buffer, Input, Size);
+        State->BufferSize = (u32)Size;
+    }
+}
+
+internal void
+HashEndLong(hash_state *State, u64 *Accumulators)
+{
+    MemoryCopy(Accumulators, State->Accumulators, SizeOf(State->Accumulators));
+    u32 StripesInBlock = State->StripesInBlock;
+    
+    if(State->BufferSize >= HashStripeSize)
+    {
+        HashConsumeStripes(Accumulators, &StripesInBlock, State->Buffer, (State->BufferSize - 1) / HashStripeSize, State->Secret);
+        HashConsumeLastStripe(Accumulators, State->Buffer + State->BufferSize - HashStripeSize, State->Secret);
+    }
+    else
+    {
+        u8 LastStripe[HashStripeSize];
+        umm PreviousSize = HashStripeSize - State->BufferSize;
+        MemoryCopy(LastStripe, State->Buffer + HashBufferSize - PreviousSize, PreviousSize);
+        MemoryCopy(LastStripe + PreviousSize, State->Buffer, State->BufferSize);
+        
+        HashConsumeLastStripe(Accumulators, LastStripe, State->Secret);
+    }
+}
+
+internal u64
+HashEnd64(hash_state *State)
+{
+    Assert(State);
+    
+    u64 Result;
+    
+    if(State->TotalSize <= HashShortSizeMax)
+    {
+        Result = HashShort(State->Buffer, State->TotalSize, (u8 *)GlobalHashSecret, State->Seed);
+    }
+    else
+    {
+        AlignAs(64) u64 Accumulators[8];
+        HashEndLong(State, Accumulators);
+        
+        Result = HashMergeLow(Accumulators, State->Secret, State->TotalSize);
+    }
+    
+    return(Result);
+}
+
+internal u128
+HashEnd128(hash_state *State)
+{
+    Assert(State);
+    
+    u128 Result;
+    
+    if(State->TotalSize <= HashShortSizeMax)
+    {
+        Result.Low = HashShort(State->Buffer, State->TotalSize, (u8 *)GlobalHashSecret, State->Seed);
+        Result.High = HashShort(State->Buffer, State->TotalSize, (u8 *)GlobalHashSecret + 32, State->Seed ^ HashPrime64_4);
+    }
+    else
+    {
+        AlignAs(64) u64 Accumulators[8];
+        HashEndLong(State, Accumulators);
+        
+        Result.Low = HashMergeLow(Accumulators, State->Secret, State->TotalSize);
+        Result.High = HashMergeHigh(Accumulators, State->Secret, State->TotalSize);
+    }
+    
+    return(Result);
+}
+
+#endif // WASP_HASH_H
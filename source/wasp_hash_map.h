@@ -0,0 +1,592 @@
+#ifndef WASP_H
+#error This module depends on wasp.h
+#endif
+
+#ifndef WASP_MEMORY_H
+#error This module depends on wasp_memory.h
+#endif
+
+#ifndef WASP_STRING_H
+#error This module depends on wasp_string.h
+#endif
+
+#ifndef WASP_HASH_H
+#error This module depends on wasp_hash.h
+#endif
+
+#ifndef WASP_HASH_MAP_H
+#define WASP_HASH_MAP_H
+
+// NOTE: Open addressing over groups of 16 slots, every slot has a control byte that is either empty or the top 7 bits
+// of its key's hash, so a whole group is matched against a key with a couple of SSE2 instructions. Groups are probed
+// in triangular steps. There are no tombstones, instead every group counts the entries that had to probe past it
+// because it was full. A lookup stops at the first group where that count is zero, and a remove walks its key's probe
+// path again to decrement the counts, then marks the slot as empty.
+//
+// The table lives in its own reservation that is swapped for a twice as large one on every grow, so the old arrays
+// are given back right away. String keys are copied into the caller's arena and stay there after a remove, since the
+// strings HashMapInternString hands out have to stay valid for as long as the arena.
+
+/*
+  CONSTANTS
+*/
+
+#define HashMapGroupSize 16
+#define HashMapControlEmpty 0x80
+
+// NOTE: Grows when more than 7/8 of the slots are in use
+#define HashMapLoadNumerator 7
+#define HashMapLoadDenominator 8
+
+#define HashMapSlotNone MaxU32
+
+/*
+  TYPES
+*/
+
+enum hash_map_key_type
+{
+    HashMapKey_U64,
+    HashMapKey_String, // NOTE: Keys are copied into the map's arena on insert
+};
+
+struct hash_map
+{
+    memory_arena *Arena; // NOTE: Only holds the copies of string keys
+    memory_arena Table;
+    
+    enum32(hash_map_key_type) KeyType;
+    umm KeySize;
+    umm ValueSize;
+    
+    u32 GroupsCount; // NOTE: Always a power of two
+    u32 Count;
+    u32 CountMax;
+    
+    u8 *Controls;
+    u32 *Overflows;
+    u8 *Keys;
+    u8 *Values;
+};
+
+/*
+  GLOBALS
+*/
+
+/*
+  FUNCTIONS
+*/
+
+// NOTE: Capacity is how many entries fit before the first grow. The arena is only needed for string keys. Values are
+// zeroed on insert. Pointers to values are only valid until the next insert, since it might grow the map
+internal hash_map HashMapCreateSized(memory_arena *Arena, enum32(hash_map_key_type) KeyType, umm ValueSize, u32 Capacity);
+internal void HashMapDestroy(hash_map *Map); // NOTE: Releases the table, string keys stay in the arena
+
+internal void *HashMapFindU64(hash_map *Map, umm ValueSize, u64 Key); // NOTE: Zero when missing
+internal void *HashMapFindString(hash_map *Map, umm ValueSize, string Key);
+internal void *HashMapInsertU64(hash_map *Map, umm ValueSize, u64 Key, b32 *Inserted); // NOTE: Finds or inserts
+internal void *HashMapInsertString(hash_map *Map, umm ValueSize, string Key, b32 *Inserted);
+internal b32 HashMapRemoveU64(hash_map *Map, u64 Key);
+internal b32 HashMapRemoveString(hash_map *Map, string Key);
+internal string HashMapInternString(hash_map *Map, string Key); // NOTE: The map's own copy of the key
+internal void HashMapClear(hash_map *Map);
+
+// NOTE: Iterate over every slot up to HashMapSlotsCount and skip the ones without a value
+internal inline u32 HashMapSlotsCount(hash_map *Map);
+internal inline void *HashMapValueAt(hash_map *Map, umm ValueSize, u32 Slot);
+internal inline u64 HashMapKeyU64At(hash_map *Map, u32 Slot);
+internal inline string HashMapKeyStringAt(hash_map *Map, u32 Slot);
+
+#define HashMapCreateU64(Arena, Type, Capacity) HashMapCreateSized(Arena, HashMapKey_U64, SizeOf(Type), Capacity)
+#define HashMapCreateString(Arena, Type, Capacity) HashMapCreateSized(Arena, HashMapKey_String, SizeOf(Type), Capacity)
+#define HashMapFindU64Type(Map, Type, Key) ((Type *)HashMapFindU64(Map, SizeOf(Type), Key))
+#define HashMapFindStringType(Map, Type, Key) ((Type *)HashMapFindString(Map, SizeOf(Type), Key))
+#define HashMapInsertU64Type(Map, Type, Key, Inserted) ((Type *)HashMapInsertU64(Map, SizeOf(Type), Key, Inserted))
+#define HashMapInsertStringType(Map, Type, Key, Inserted) ((Type *)HashMapInsertString(Map, SizeOf(Type), Key, Inserted))
+#define HashMapValueAtType(Map, Type, Slot) ((Type *)HashMapValueAt(Map, SizeOf(Type), Slot))
+
+/*
+  IMPLEMENTATION
+*/
+
+#if Architecture_X86_64 || Architecture_X86_32
+#if Compiler_MSVC
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+internal inline u64
+HashMapHashKey(hash_map *Map, void *Key)
+{
+    u64 Result;
+    if(Map->KeyType == HashMapKey_U64)
+    {
+        Result = HashU64(*(u64 *)Key);
+    }
+    else
+    {
+        Result = HashString(*(string *)Key);
+    }
+    
+    return(Result);
+}
+
+internal inline b32
+HashMapKeyEquals(hash_map *Map, u32 Slot, void *Key)
+{
+    b32 Result;
+    if(Map->KeyType == HashMapKey_U64)
+    {
+        Result = *(u64 *)(Map->Keys + Slot * Map->KeySize) == *(u64 *)Key;
+    }
+    else
+    {
+        Result = StringEquals(*(string *)(Map->Keys + Slot * Map->KeySize), *(string *)Key);
+    }
+    
+    return(Result);
+}
+
+internal inline u8
+HashMapControl(u64 Hash)
+{
+    u8 Result = (u8)(Hash >> 57);
+    return(Result);
+}
+
+internal inline u32
+HashMapFirstBit(u32 Mask)
+{
+    Assert(Mask);
+    
+#if Compiler_MSVC
+    unsigned long Result;
+    _BitScanForward(&Result, Mask);
+#else
+    u32 Result = __builtin_ctz(Mask);
+#endif
+    
+    return((u32)Result);
+}
+
+// NOTE: One bit per slot of the group whose control byte equals Control
+internal inline u32
+HashMapGroupMatch(u8 *Group, u8 Control)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    __m128i Controls = _mm_load_si128((__m128i *)Group);
+    u32 Result = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(Controls, _mm_set1_epi8((char)Control)));
+#else
+    u32 Result = 0;
+    for(u32 Index = 0;
+        Index < HashMapGroupSize;
+        Index++)
+    {
+        Result |= (u32)(Group[Index] == Control) << Index;
+    }
+#endif
+    
+    return(Result);
+}
+
+// NOTE: Empty is the only control byte with the top bit set
+internal inline u32
+HashMapGroupMatchEmpty(u8 *Group)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    u32 Result = (u32)_mm_movemask_epi8(_mm_load_si128((__m128i *)Group));
+#else
+    u32 Result = HashMapGroupMatch(Group, HashMapControlEmpty);
+#endif
+    
+    return(Result);
+}
+
+internal void
+HashMapAllocate(hash_map *Map, u32 GroupsCount)
+{
+    Assert(IsPowerOfTwo(GroupsCount));
+    
+    u32 SlotsCount = GroupsCount * HashMapGroupSize;
+    
+    Map->GroupsCount = GroupsCount;
+    Map->Count = 0;
+    Map->CountMax = (u32)((u64)SlotsCount * HashMapLoadNumerator / HashMapLoadDenominator);
+    
+    // NOTE: The reservation starts on a page, the slack covers aligning the keys and values
+    umm TableSize = SlotsCount + SizeOf(u32) * GroupsCount + (Map->KeySize + Map->ValueSize) * SlotsCount + 32;
+    TableSize = AlignUp(TableSize, GetPageSize());
+    Map->Table = MemoryArenaCreate(TableSize, TableSize, 0);
+    MemoryArenaName(&Map->Table, "hash map");
+    
+    Map->Controls = (u8 *)MemoryArenaPush(&Map->Table, SlotsCount, HashMapGroupSize);
+    Map->Overflows = MemoryArenaPushArray(&Map->Table, u32, 1, GroupsCount);
+    Map->Keys = (u8 *)MemoryArenaPush(&Map->Table, Map->KeySize * SlotsCount, 8);
+    Map->Values = (u8 *)MemoryArenaPush(&Map->Table, Map->ValueSize * SlotsCount, 16);
+    
+    MemorySet(Map->Controls, HashMapControlEmpty, SlotsCount);
+    MemorySet(Map->Overflows, 0, SizeOf(u32) * GroupsCount);
+}
+
+internal hash_map
+HashMapCreateSized(memory_arena *Arena, enum32(hash_map_key_type) KeyType, umm ValueSize, u32 Capacity)
+{
+    Assert(Arena || KeyType == HashMapKey_U64);
+    Assert(ValueSize);
+    
+    hash_map Result = {};
+    Result.Arena = Arena;
+    Result.KeyType = KeyType;
+    Result.KeySize = KeyType == HashMapKey_U64 ? SizeOf(u64) : SizeOf(string);
+    Result.ValueSize = ValueSize;
+    
+    u64 SlotsCount = ((u64)Max(Capacity, 1) * HashMapLoadDenominator + HashMapLoadNumerator - 1) / HashMapLoadNumerator;
+    u32 GroupsCount = (u32)AlignUpToPowerOfTwo((umm)((SlotsCount + HashMapGroupSize - 1) / HashMapGroupSize));
+    
+    HashMapAllocate(&Result, GroupsCount);
+    
+    return(Result);
+}
+
+internal void
+HashMapDestroy(hash_map *Map)
+{
+    Assert(Map);
+    
+    MemoryArenaDestroy(&Map->Table);
+    ZeroStruct(Map);
+}
+
+internal u32
+HashMapLookup(hash_map *Map, u64 Hash, void *Key, u32 *ProbesCount)
+{
+    u32 Result = HashMapSlotNone;
+    *ProbesCount = 0;
+    
+    u8 Control = HashMapControl(Hash);
+    u32 GroupMask = Map->GroupsCount - 1;
+    u32 Group = (u32)Hash & GroupMask;
+    
+    for(u32 Probe = 0;
+        Probe < Map->GroupsCount;
+        Probe++)
+    {
+        u8 *Controls = Map->Controls + Group * HashMapGroupSize;
+        
+        u32 Matches = HashMapGroupMatch(Controls, Control);
+        while(Matches)
+        {
+            u32 Slot = Group * HashMapGroupSize + HashMapFirstBit(Matches);
+            if(HashMapKeyEquals(Map, Slot, Key))
+            {
+                Result = Slot;
+                *ProbesCount = Probe;
+                break;
+            }
+            
+            Matches &= Matches - 1;
+        }
+        
+        // NOTE: Nothing with this key was pushed past a group that never overflowed
+        if(Result != HashMapSlotNone || !Map->Overflows[Group])
+        {
+            break;
+        }
+        
+        Group = (Group + Probe + 1) & GroupMask;
+    }
+    
+    return(Result);
+}
+
+// NOTE: Expects the key to be missing and a free slot to exist
+internal u32
+HashMapInsertNew(hash_map *Map, u64 Hash, void *Key)
+{
+    u32 Result = HashMapSlotNone;
+    
+    u32 GroupMask = Map->GroupsCount - 1;
+    u32 Group = (u32)Hash & GroupMask;
+    
+    for(u32 Probe = 0;
+        Probe < Map->GroupsCount;
+        Probe++)
+    {
+        u32 Empty = HashMapGroupMatchEmpty(Map->Controls + Group * HashMapGroupSize);
+        if(Empty)
+        {
+            Result = Group * HashMapGroupSize + HashMapFirstBit(Empty);
+            break;
+        }
+        
+        Map->Overflows[Group]++;
+        Group = (Group + Probe + 1) & GroupMask;
+    }
+    
+    Assert(Result != HashMapSlotNone);
+    
+    Map->Controls[Result] = HashMapControl(Hash);
+    MemoryCopy(Map->Keys + Result * Map->KeySize, Key, Map->KeySize);
+    MemorySet(Map->Values + Result * Map->ValueSize, 0, Map->ValueSize);
+    Map->Count++;
+    
+    return(Result);
+}
+
+internal void
+HashMapGrow(hash_map *Map)
+{
+    hash_map Old = *Map;
+    HashMapAllocate(Map, Old.GroupsCount * 2);
+    
+    for(u32 Slot = 0;
+        Slot < Old.GroupsCount * HashMapGroupSize;
+        Slot++)
+    {
+        if(!(Old.Controls[Slot] & HashMapControlEmpty))
+        {
+            void *Key = Old.Keys + Slot * Old.KeySize;
+            u32 NewSlot = HashMapInsertNew(Map, HashMapHashKey(Map, Key), Key);
+            MemoryCopy(Map->Values + NewSlot * Map->ValueSize, Old.Values + Slot * Old.ValueSize, Old.ValueSize);
+        }
+    }
+    
+    MemoryArenaDestroy(&Old.Table);
+}
+
+internal u32
+HashMapInsertSlot(hash_map *Map, void *Key, b32 *Inserted)
+{
+    u64 Hash = HashMapHashKey(Map, Key);
+    
+    u32 ProbesCount;
+    u32 Result = HashMapLookup(Map, Hash, Key, &ProbesCount);
+    
+    b32 WasInserted = Result == HashMapSlotNone;
+    if(WasInserted)
+    {
+        if(Map->Count >= Map->CountMax)
+        {
+            HashMapGrow(Map);
+        }
+        
+        Result = HashMapInsertNew(Map, Hash, Key);
+    }
+    
+    if(Inserted)
+    {
+        *Inserted = WasInserted;
+    }
+    
+    return(Result);
+}
+
+// NOTE: The key is stored as the caller passed it, only now that it's known to be new does it get its own copy
+internal u32
+HashMapInsertStringSlot(hash_map *Map, string Key, b32 *Inserted)
+{
+    b32 WasInserted;
+    u32 Result = HashMapInsertSlot(Map, &Key, &WasInserted);
+    
+    if(WasInserted)
+    {
+        string Copy = {(u8 *)MemoryArenaPush(Map->Arena, Key.Size, 1), Key.Size};
+        MemoryCopy(Copy.Data, Key.Data, Key.Size);
+        MemoryCopy(Map->Keys + Result * Map->KeySize, &Copy, SizeOf(string));
+    }
+    
+    if(Inserted)
+    {
+        *Inserted = WasInserted;
+    }
+    
+    return(Result);
+}
+
+internal b32
+HashMapRemoveKey(hash_map *Map, void *Key)
+{
+    u64 Hash = HashMapHashKey(Map, Key);
+    
+    u32 ProbesCount;
+    u32 Slot = HashMapLookup(Map, Hash, Key, &ProbesCount);
+    
+    b32 Result = Slot != HashMapSlotNone;
+    if(Result)
+    {
+        // NOTE: Undo the overflow counts the insert left on the groups it skipped
+        u32 GroupMask = Map->GroupsCount - 1;
+        u32 Group = (u32)Hash & GroupMask;
+        
+        for(u32 Probe = 0;
+            Probe < ProbesCount;
+            Probe++)
+        {
+            Assert(Map->Overflows[Group]);
+            Map->Overflows[Group]--;
+            Group = (Group + Probe + 1) & GroupMask;
+        }
+        
+        Map->Controls[Slot] = HashMapControlEmpty;
+        Map->Count--;
+    }
+    
+    return(Result);
+}
+
+internal void *
+HashMapFindU64(hash_map *Map, umm ValueSize, u64 Key)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_U64);
+    Assert(Map->ValueSize == ValueSize);
+    
+    void *Result = 0;
+    
+    u32 ProbesCount;
+    u32 Slot = HashMapLookup(Map, HashU64(Key), &Key, &ProbesCount);
+    if(Slot != HashMapSlotNone)
+    {
+        Result = Map->Values + Slot * ValueSize;
+    }
+    
+    return(Result);
+}
+
+internal void *
+HashMapFindString(hash_map *Map, umm ValueSize, string Key)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_String);
+    Assert(Map->ValueSize == ValueSize);
+    
+    void *Result = 0;
+    
+    u32 ProbesCount;
+    u32 Slot = HashMapLookup(Map, HashString(Key), &Key, &ProbesCount);
+    if(Slot != HashMapSlotNone)
+    {
+        Result = Map->Values + Slot * ValueSize;
+    }
+    
+    return(Result);
+}
+
+internal void *
+HashMapInsertU64(hash_map *Map, umm ValueSize, u64 Key, b32 *Inserted)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_U64);
+    Assert(Map->ValueSize == ValueSize);
+    
+    u32 Slot = HashMapInsertSlot(Map, &Key, Inserted);
+    
+    void *Result = Map->Values + Slot * ValueSize;
+    return(Result);
+}
+
+internal void *
+HashMapInsertString(hash_map *Map, umm ValueSize, string Key, b32 *Inserted)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_String);
+    Assert(Map->ValueSize == ValueSize);
+    
+    u32 Slot = HashMapInsertStringSlot(Map, Key, Inserted);
+    
+    void *Result = Map->Values + Slot * ValueSize;
+    return(Result);
+}
+
+internal b32
+HashMapRemoveU64(hash_map *Map, u64 Key)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_U64);
+    
+    b32 Result = HashMapRemoveKey(Map, &Key);
+    return(Result);
+}
+
+internal b32
+HashMapRemoveString(hash_map *Map, string Key)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_String);
+    
+    b32 Result = HashMapRemoveKey(Map, &Key);
+    return(Result);
+}
+
+internal string
+HashMapInternString(hash_map *Map, string Key)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_String);
+    
+    u32 Slot = HashMapInsertStringSlot(Map, Key, 0);
+    
+    string Result = *(string *)(Map->Keys + Slot * Map->KeySize);
+    return(Result);
+}
+
+internal void
+HashMapClear(hash_map *Map)
+{
+    Assert(Map);
+    
+    MemorySet(Map->Controls, HashMapControlEmpty, Map->GroupsCount * HashMapGroupSize);
+    MemorySet(Map->Overflows, 0, SizeOf(u32) * Map->GroupsCount);
+    Map->Count = 0;
+}
+
+internal inline u32
+HashMapSlotsCount(hash_map *Map)
+{
+    Assert(Map);
+    
+    u32 Result = Map->GroupsCount * HashMapGroupSize;
+    return(Result);
+}
+
+internal inline void *
+HashMapValueAt(hash_map *Map, umm ValueSize, u32 Slot)
+{
+    Assert(Map);
+    Assert(Map->ValueSize == ValueSize);
+    Assert(Slot < HashMapSlotsCount(Map));
+    
+    void *Result = 0;
+    if(!(Map->Controls[Slot] & HashMapControlEmpty))
+    {
+        Result = Map->Values + Slot * ValueSize;
+    }
+    
+    return(Result);
+}
+
+internal inline u64
+HashMapKeyU64At(hash_map *Map, u32 Slot)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_U64);
+    Assert(!(Map->Controls[Slot] & HashMapControlEmpty));
+    
+    u64 Result = *(u64 *)(Map->Keys + Slot * Map->KeySize);
+    return(Result);
+}
+
+internal inline string
+HashMapKeyStringAt(hash_map *Map, u32 Slot)
+{
+    Assert(Map);
+    Assert(Map->KeyType == HashMapKey_String);
+    Assert(!(Map->Controls[Slot] & HashMapControlEmpty));
+    
+    string Result = *(string *)(Map->Keys + Slot * Map->KeySize);
+    return(Result);
+}
+
+#endif // WASP_HASH_MAP_H
@@ -0,0 +1,1079 @@
+/* TODO:
+
+  - DNS, window and vulkan surface modules are not implemented here yet
+
+*/
+
+#ifndef WASP_H
+#error This module depends on wasp.h
+#endif
+
+#ifndef WASP_LINUX_H
+#define WASP_LINUX_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+global volatile u32 GlobalLinuxAssertLock;
+
+internal inline u32
+LinuxGetThreadID(void)
+{
+    u32 Result = (u32)syscall(SYS_gettid);
+    return(Result);
+}
+
+internal void
+AssertHandler(char *Expression, char *File, int LineNumber, char *Function)
+{
+    // NOTE: No thread identifier will ever be 0
+    
+    u32 ThreadID = LinuxGetThreadID();
+    u32 OwningID = __sync_val_compare_and_swap(&GlobalLinuxAssertLock, 0, ThreadID);
+    if(OwningID)
+    {
+        if(OwningID != ThreadID)
+        {
+            syscall(SYS_exit, 2); // NOTE: Someone else asserted before us, so just exit our thread
+        }
+        else
+        {
+            // NOTE: Deadlock, we asserted somewhere in the assert callback, so just exit
+        }
+    }
+    else
+    {
+        AssertCallback(Expression, File, LineNumber, Function);
+    }
+    
+    raise(SIGTRAP);
+    _exit(1);
+}
+
+internal umm
+GetPageSize(void)
+{
+    umm Result = (umm)sysconf(_SC_PAGESIZE);
+    return(Result);
+}
+
+internal void
+StandardOutput(u8 *Buffer, umm Size)
+{
+    ssize_t Ignored = write(STDOUT_FILENO, Buffer, Size);
+    (void)Ignored;
+}
+
+internal void
+StandardError(u8 *Buffer, umm Size)
+{
+    ssize_t Ignored = write(STDERR_FILENO, Buffer, Size);
+    (void)Ignored;
+}
+
+#ifndef WASP_LOG_H
+
+global log_entry GlobalLogEntrySentinel;
+
+internal void Logf(enum32(log_severity) Severity, char *Format, ...) {(void)(Format);(void)(Severity);}
+internal void LogRegionBegin(void) {}
+internal void LogRegionEnd(void) {}
+internal void LogRegionClear(void) {}
+
+internal inline log_entry *LogRegionGetEntries(void)
+{
+    log_entry *Result = &GlobalLogEntrySentinel;
+    
+    if(!Result->Next)
+    {
+        DoublyLinkedListInit(Result);
+    }
+    
+    return(Result);
+}
+
+internal inline enum32(log_severity)
+LogRegionGetHighestSeverity(void)
+{
+    return(0);
+}
+
+#endif // WASP_LOG_H
+
+#ifdef WASP_CRYPTO_H
+#include <sys/random.h>
+
+internal void
+CryptoRandomFill(void *Data, umm Size)
+{
+    Assert(Data);
+    Assert(Size);
+    Assert(Size < MaxU32); // TODO: Assert min size across platforms
+    
+    u8 *Destination = (u8 *)Data;
+    
+    while(Size)
+    {
+        ssize_t Filled = getrandom(Destination, Size, 0);
+        Assert(Filled > 0);
+        
+        Destination += Filled;
+        Size -= (umm)Filled;
+    }
+}
+
+// NOTE: There is no system hashing library we can rely on here, so SHA-1 and SHA-256 are our own, straight from
+// FIPS 180-4. Fine for checksums and protocol digests, nothing here is hardened against timing attacks
+
+typedef void crypto_block_function(u32 *State, u8 *Block);
+
+global u32 GlobalCryptoSHA256K[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+internal inline u32
+CryptoRotateLeft(u32 Value, u32 Shift)
+{
+    u32 Result = (Value << Shift) | (Value >> (32 - Shift));
+    return(Result);
+}
+
+internal inline u32
+CryptoReadBigEndian32(u8 *Pointer)
+{
+    u32 Result = ((u32)Pointer[0] << 24) | ((u32)Pointer[1] << 16) | ((u32)Pointer[2] << 8) | (u32)Pointer[3];
+    return(Result);
+}
+
+internal inline void
+CryptoWriteBigEndian32(u8 *Pointer, u32 Value)
+{
+    Pointer[0] = (u8)(Value >> 24);
+    Pointer[1] = (u8)(Value >> 16);
+    Pointer[2] = (u8)(Value >> 8);
+    Pointer[3] = (u8)Value;
+}
+
+// NOTE: Both digests pad the same way, a single 1 bit, zeros, and the size in bits as a big endian u64 at the end of
+// the last 64 byte block, which takes a second block when fewer than 9 bytes are left in the first one
+internal void
+CryptoDigest(crypto_block_function *BlockFunction, u32 *State, u32 StateCount, u8 *Source, umm SourceSize, u8 *Destination)
+{
+    umm Offset = 0;
+    for(;
+        Offset + 64 <= SourceSize;
+        Offset += 64)
+    {
+        BlockFunction(State, Source + Offset);
+    }
+    
+    u8 Tail[128] = {};
+    umm Remaining = SourceSize - Offset;
+    for(umm Index = 0;
+        Index < Remaining;
+        Index++)
+    {
+        Tail[Index] = Source[Offset + Index];
+    }
+    
+    Tail[Remaining] = 0x80;
+    
+    umm TailSize = (Remaining < 56) ? 64 : 128;
+    u64 Bits = (u64)SourceSize * 8;
+    for(u32 Index = 0;
+        Index < 8;
+        Index++)
+    {
+        Tail[TailSize - 1 - Index] = (u8)(Bits >> (8 * Index));
+    }
+    
+    for(umm TailOffset = 0;
+        TailOffset < TailSize;
+        TailOffset += 64)
+    {
+        BlockFunction(State, Tail + TailOffset);
+    }
+    
+    for(u32 Index = 0;
+        Index < StateCount;
+        Index++)
+    {
+        CryptoWriteBigEndian32(Destination + 4 * Index, State[Index]);
+    }
+}
+
+internal void
+CryptoSHA1Block(u32 *State, u8 *Block)
+{
+    u32 W[80];
+    for(u32 Index = 0;
+        Index < 16;
+        Index++)
+    {
+        W[Index] = CryptoReadBigEndian32(Block + 4 * Index);
+    }
+    
+    for(u32 Index = 16;
+        Index < 80;
+        Index++)
+    {
+        W[Index] = CryptoRotateLeft(W[Index - 3] ^ W[Index - 8] ^ W[Index - 14] ^ W[Index - 16], 1);
+    }
+    
+    u32 A = State[0], B = State[1], C = State[2], D = State[3], E = State[4];
+    
+    for(u32 Index = 0;
+        Index < 80;
+        Index++)
+    {
+        u32 F, K;
+        if(Index < 20)
+        {
+            F = (B & C) | (~B & D);
+            K = 0x5a827999;
+        }
+        else if(Index < 40)
+        {
+            F = B ^ C ^ D;
+            K = 0x6ed9eba1;
+        }
+        else if(Index < 60)
+        {
+            F = (B & C) | (B & D) | (C & D);
+            K = 0x8f1bbcdc;
+        }
+        else
+        {
+            F = B ^ C ^ D;
+            K = 0xca62c1d6;
+        }
+        
+        u32 Temp = CryptoRotateLeft(A, 5) + F + E + K + W[Index];
+        E = D;
+        D = C;
+        C = CryptoRotateLeft(B, 30);
+        B = A;
+        A = Temp;
+    }
+    
+    State[0] += A;
+    State[1] += B;
+    State[2] += C;
+    State[3] += D;
+    State[4] += E;
+}
+
+internal void
+CryptoSHA256Block(u32 *State, u8 *Block)
+{
+    u32 *K = GlobalCryptoSHA256K;
+    
+    u32 W[64];
+    for(u32 Index = 0;
+        Index < 16;
+        Index++)
+    {
+        W[Index] = CryptoReadBigEndian32(Block + 4 * Index);
+    }
+    
+    for(u32 Index = 16;
+        Index < 64;
+        Index++)
+    {
+        u32 S0 = CryptoRotateLeft(W[Index - 15], 25) ^ CryptoRotateLeft(W[Index - 15], 14) ^ (W[Index - 15] >> 3);
+        u32 S1 = CryptoRotateLeft(W[Index - 2], 15) ^ CryptoRotateLeft(W[Index - 2], 13) ^ (W[Index - 2] >> 10);
+        W[Index] = W[Index - 16] + S0 + W[Index - 7] + S1;
+    }
+    
+    u32 A = State[0], B = State[1], C = State[2], D = State[3];
+    u32 E = State[4], F = State[5], G = State[6], H = State[7];
+    
+    // NOTE: The rotations right by 2, 13, 22 and 6, 11, 25 written as rotations left
+    for(u32 Index = 0;
+        Index < 64;
+        Index++)
+    {
+        u32 S1 = CryptoRotateLeft(E, 26) ^ CryptoRotateLeft(E, 21) ^ CryptoRotateLeft(E, 7);
+        u32 Choice = (E & F) ^ (~E & G);
+        u32 Temp1 = H + S1 + Choice + K[Index] + W[Index];
+        u32 S0 = CryptoRotateLeft(A, 30) ^ CryptoRotateLeft(A, 19) ^ CryptoRotateLeft(A, 10);
+        u32 Majority = (A & B) ^ (A & C) ^ (B & C);
+        u32 Temp2 = S0 + Majority;
+        
+        H = G;
+        G = F;
+        F = E;
+        E = D + Temp1;
+        D = C;
+        C = B;
+        B = A;
+        A = Temp1 + Temp2;
+    }
+    
+    State[0] += A;
+    State[1] += B;
+    State[2] += C;
+    State[3] += D;
+    State[4] += E;
+    State[5] += F;
+    State[6] += G;
+    State[7] += H;
+}
+
+internal void
+CryptoSHA1Fill(void *SourceData, umm SourceSize, void *DestinationData, umm DestinationSize)
+{
+    Assert(SourceData);
+    Assert(SourceSize);
+    Assert(SourceSize < MaxU32);
+    
+    Assert(DestinationData);
+    Assert(DestinationSize >= CryptoDigestSizeSHA1);
+    
+    u32 State[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+    CryptoDigest(CryptoSHA1Block, State, ArrayCount(State), (u8 *)SourceData, SourceSize, (u8 *)DestinationData);
+}
+
+internal void
+CryptoSHA256Fill(void *SourceData, umm SourceSize, void *DestinationData, umm DestinationSize)
+{
+    Assert(SourceData);
+    Assert(SourceSize);
+    Assert(SourceSize < MaxU32);
+    
+    Assert(DestinationData);
+    Assert(DestinationSize >= CryptoDigestSizeSHA256);
+    
+    u32 State[8] =
+    {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    CryptoDigest(CryptoSHA256Block, State, ArrayCount(State), (u8 *)SourceData, SourceSize, (u8 *)DestinationData);
+}
+
+#endif // WASP_CRYPTO_H
+
+#ifdef WASP_THREAD_H
+#include <pthread.h>
+
+#if Architecture_X86_64 || Architecture_X86_32
+#include <x86intrin.h>
+#endif
+
+#define WriteBarrier() __asm__ __volatile__("" ::: "memory")
+#define ReadBarrier() __asm__ __volatile__("" ::: "memory")
+
+internal inline void
+ThreadYield(void)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    _mm_pause();
+#elif Architecture_ARM_64 || Architecture_ARM_32
+    __asm__ __volatile__("yield");
+#endif
+}
+
+internal inline u32
+ThreadAtomicLoadU32(volatile u32 *Source)
+{
+    return(__atomic_load_n(Source, __ATOMIC_ACQUIRE));
+}
+
+internal inline u64
+ThreadAtomicLoadU64(volatile u64 *Source)
+{
+    return(__atomic_load_n(Source, __ATOMIC_ACQUIRE));
+}
+
+internal inline void
+ThreadAtomicStoreU32(volatile u32 *Destination, u32 Value)
+{
+    __atomic_store_n(Destination, Value, __ATOMIC_RELEASE);
+}
+
+internal inline void
+ThreadAtomicStoreU64(volatile u64 *Destination, u64 Value)
+{
+    __atomic_store_n(Destination, Value, __ATOMIC_RELEASE);
+}
+
+internal inline u32
+ThreadAtomicAddU32(volatile u32 *Destination, u32 Value)
+{
+    u32 Result = __atomic_fetch_add(Destination, Value, __ATOMIC_SEQ_CST);
+    return(Result);
+}
+
+internal inline u64
+ThreadAtomicAddU64(volatile u64 *Destination, u64 Value)
+{
+    u64 Result = __atomic_fetch_add(Destination, Value, __ATOMIC_SEQ_CST);
+    return(Result);
+}
+
+internal u64
+ThreadCreate(umm StackSize, thread_proc *ThreadProc, void *Parameter)
+{
+    if(!StackSize)
+    {
+        StackSize = MB(1);
+    }
+    
+    umm PageSize = GetPageSize();
+    StackSize = AlignUp(StackSize, PageSize);
+    
+    u64 Result = 0;
+    
+    pthread_attr_t Attributes;
+    if(pthread_attr_init(&Attributes) == 0)
+    {
+        pthread_attr_setstacksize(&Attributes, StackSize);
+        pthread_attr_setdetachstate(&Attributes, PTHREAD_CREATE_DETACHED);
+        
+        pthread_t Thread;
+        if(pthread_create(&Thread, &Attributes, (void *(*)(void *))ThreadProc, Parameter) == 0)
+        {
+            Result = (u64)Thread;
+        }
+        
+        pthread_attr_destroy(&Attributes);
+    }
+    
+    return(Result);
+}
+
+internal u64
+ThreadGetID(void)
+{
+    u64 Result = (u64)LinuxGetThreadID();
+    return(Result);
+}
+
+internal u32
+ThreadGetCPUCount(void)
+{
+    u32 Result = (u32)sysconf(_SC_NPROCESSORS_ONLN);
+    return(Result);
+}
+
+#endif // WASP_THREAD_H
+
+#ifdef WASP_MEMORY_H
+
+internal void *
+MemoryReserveAndCommit(umm Size)
+{
+    void *Result = 0;
+    
+    if(Size)
+    {
+        Result = mmap(0, Size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if(Result == MAP_FAILED)
+        {
+            Result = 0;
+        }
+    }
+    
+    return(Result);
+}
+
+internal void *
+MemoryReserve(umm Size)
+{
+    void *Result = 0;
+    
+    if(Size)
+    {
+        // NOTE: Reserved pages are not accessible and don't count towards the commit charge until we commit them
+        Result = mmap(0, Size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+        if(Result == MAP_FAILED)
+        {
+            Result = 0;
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryRelease(void *Memory, umm Size)
+{
+    if(Size)
+    {
+        Assert(Memory);
+        Assert(munmap(Memory, Size) == 0);
+    }
+}
+
+internal b32
+MemoryCommit(void *Memory, umm Size)
+{
+    Assert(Memory);
+    Assert(Size);
+    
+    b32 Result = mprotect(Memory, Size, PROT_READ|PROT_WRITE) == 0;
+    return(Result);
+}
+
+internal void
+MemoryDecommit(void *Memory, umm Size)
+{
+    Assert(Memory);
+    Assert(Size);
+    
+    // NOTE: Hand the physical pages back to the kernel, then make the range inaccessible like a fresh reservation
+    Assert(madvise(Memory, Size, MADV_DONTNEED) == 0);
+    Assert(mprotect(Memory, Size, PROT_NONE) == 0);
+}
+
+internal umm
+GetHugePageSize(void)
+{
+    // NOTE: The PMD size, which is what both transparent huge pages and the default hugetlb pool use with 4K pages
+    umm Result = MB(2);
+    return(Result);
+}
+
+internal void *
+MemoryReserveHuge(umm Size, b32 Explicit)
+{
+    void *Result = 0;
+    
+    umm HugePageSize = GetHugePageSize();
+    Assert(IsAligned(Size, HugePageSize));
+    
+    if(Size)
+    {
+        if(Explicit)
+        {
+            Result = mmap(0, Size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB|MAP_POPULATE, -1, 0);
+            if(Result == MAP_FAILED)
+            {
+                Result = 0;
+            }
+        }
+        else
+        {
+            // NOTE: Over-reserve and trim, so the range starts on a huge page boundary and every page can be huge
+            u8 *Memory = (u8 *)mmap(0, Size + HugePageSize, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+            if(Memory != MAP_FAILED)
+            {
+                u8 *Aligned = (u8 *)AlignUp((umm)Memory, HugePageSize);
+                umm Head = (umm)(Aligned - Memory);
+                
+                if(Head)
+                {
+                    Assert(munmap(Memory, Head) == 0);
+                }
+                if(HugePageSize - Head)
+                {
+                    Assert(munmap(Aligned + Size, HugePageSize - Head) == 0);
+                }
+                
+                // NOTE: Only a hint, it fails when transparent huge pages are disabled and we get regular pages
+                madvise(Aligned, Size, MADV_HUGEPAGE);
+                
+                Result = Aligned;
+            }
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryPrefault(void *Memory, umm Size)
+{
+    Assert(Memory);
+    
+#ifdef MADV_POPULATE_WRITE
+    if(madvise(Memory, Size, MADV_POPULATE_WRITE) == 0)
+    {
+        return;
+    }
+#endif
+    
+    // NOTE: Kernels before 5.14, touch a byte of every page without changing it
+    umm PageSize = GetPageSize();
+    for(umm Offset = 0;
+        Offset < Size;
+        Offset += PageSize)
+    {
+        volatile u8 *At = (volatile u8 *)Memory + Offset;
+        *At = *At;
+    }
+}
+
+internal umm
+GetMemoryMirrorGranularity(void)
+{
+    umm Result = GetPageSize();
+    return(Result);
+}
+
+internal void *
+MemoryMirrorCreate(umm Size)
+{
+    void *Result = 0;
+    
+    Assert(IsAligned(Size, GetMemoryMirrorGranularity()));
+    
+    if(Size)
+    {
+        int Descriptor = memfd_create("wasp mirror", MFD_CLOEXEC);
+        if(Descriptor != -1)
+        {
+            if(ftruncate(Descriptor, (off_t)Size) == 0)
+            {
+                // NOTE: Reserve room for both copies first, so nothing else can get mapped in between them
+                u8 *Memory = (u8 *)mmap(0, 2 * Size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+                if(Memory != MAP_FAILED)
+                {
+                    void *First = mmap(Memory, Size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, Descriptor, 0);
+                    void *Second = mmap(Memory + Size, Size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, Descriptor, 0);
+                    
+                    if(First == Memory && Second == Memory + Size)
+                    {
+                        Result = Memory;
+                    }
+                    else
+                    {
+                        Assert(munmap(Memory, 2 * Size) == 0);
+                    }
+                }
+            }
+            
+            close(Descriptor); // NOTE: The mappings keep the memory alive
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryMirrorRelease(void *Memory, umm Size)
+{
+    if(Size)
+    {
+        Assert(Memory);
+        Assert(munmap(Memory, 2 * Size) == 0);
+    }
+}
+
+internal buffer
+MemoryMapFile(char *FileName)
+{
+    buffer Result = {};
+    
+    int Descriptor = open(FileName, O_RDONLY|O_CLOEXEC);
+    if(Descriptor != -1)
+    {
+        struct stat Stat;
+        if(fstat(Descriptor, &Stat) == 0 && Stat.st_size)
+        {
+            void *Memory = mmap(0, (umm)Stat.st_size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+            if(Memory != MAP_FAILED)
+            {
+                Result.Data = (u8 *)Memory;
+                Result.Size = (umm)Stat.st_size;
+            }
+        }
+        
+        close(Descriptor); // NOTE: The mapping keeps the file alive
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryUnmapFile(buffer *Buffer)
+{
+    Assert(Buffer);
+    
+    if(IsValid(*Buffer))
+    {
+        Assert(munmap(Buffer->Data, Buffer->Size) == 0);
+    }
+    
+    ZeroStruct(Buffer);
+}
+
+#if WASP_MEMORY_INSTRUMENT
+internal void
+MemoryInstrumentRegister(memory_arena_stats *Stats)
+{
+    memory_arena_stats *Head = __atomic_load_n(&GlobalMemoryArenaStats, __ATOMIC_ACQUIRE);
+    do
+    {
+        Stats->Next = Head;
+    } while(!__atomic_compare_exchange_n(&GlobalMemoryArenaStats, &Head, Stats, 1, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+}
+#endif
+
+#endif // WASP_MEMORY_H
+
+#ifdef WASP_FILE_H
+#include <dirent.h>
+
+internal void
+LinuxCopyDirectoryEntry(struct dirent *Data, directory_entry *Entry)
+{
+    ZeroStruct(Entry);
+    
+    Entry->NameSize = StringLengthZ(Data->d_name);
+    MemoryCopy(Entry->NameData, Data->d_name, Entry->NameSize);
+    
+    if(Data->d_type == DT_DIR)
+    {
+        Entry->Flags |= DirectoryEntryFlag_Directory;
+    }
+}
+
+internal inline b32
+IsValid(file_handle_ Handle)
+{
+    return((s32)Handle.Value != -1);
+}
+
+internal inline b32
+IsValid(directory_handle Handle)
+{
+    return(Handle.Value != 0);
+}
+
+internal file_handle_
+FileOpen(char *FileName, b32 ForWriting)
+{
+    int Descriptor = open(FileName, ForWriting ? (O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC) : (O_RDONLY|O_CLOEXEC), 0644);
+    
+    file_handle_ Result = {(u64)(s64)Descriptor};
+    return(Result);
+}
+
+internal void
+FileClose(file_handle_ *Handle)
+{
+    if(IsValid(*Handle))
+    {
+        Assert(close((int)Handle->Value) == 0);
+        Handle->Value = (u64)(s64)-1;
+    }
+}
+
+internal b32
+FileRead(file_handle_ Handle, buffer Buffer)
+{
+    b32 Result = 0;
+    
+    if(IsValid(Handle) &&
+       IsValid(Buffer))
+    {
+        // NOTE: Unlike ReadFile a single read can come back short, so keep going until we have it all
+        
+        u8 *Destination = Buffer.Data;
+        umm Remaining = Buffer.Size;
+        
+        while(Remaining)
+        {
+            ssize_t BytesRead = read((int)Handle.Value, Destination, Remaining);
+            if(BytesRead <= 0)
+            {
+                break;
+            }
+            
+            Destination += BytesRead;
+            Remaining -= (umm)BytesRead;
+        }
+        
+        Result = Remaining == 0;
+    }
+    
+    return(Result);
+}
+
+internal b32
+FileReadAt(file_handle_ Handle, u64 Offset, buffer Buffer)
+{
+    b32 Result = 0;
+    
+    if(IsValid(Handle) &&
+       IsValid(Buffer))
+    {
+        u8 *Destination = Buffer.Data;
+        umm Remaining = Buffer.Size;
+        
+        while(Remaining)
+        {
+            ssize_t BytesRead = pread((int)Handle.Value, Destination, Remaining, (off_t)Offset);
+            if(BytesRead <= 0)
+            {
+                break;
+            }
+            
+            Destination += BytesRead;
+            Remaining -= (umm)BytesRead;
+            Offset += (u64)BytesRead;
+        }
+        
+        Result = Remaining == 0;
+    }
+    
+    return(Result);
+}
+
+internal b32
+FileWrite(file_handle_ Handle, buffer Buffer)
+{
+    b32 Result = 0;
+    
+    if(IsValid(Handle) &&
+       IsValid(Buffer))
+    {
+        u8 *Source = Buffer.Data;
+        umm Remaining = Buffer.Size;
+        
+        while(Remaining)
+        {
+            ssize_t BytesWritten = write((int)Handle.Value, Source, Remaining);
+            if(BytesWritten <= 0)
+            {
+                break;
+            }
+            
+            Source += BytesWritten;
+            Remaining -= (umm)BytesWritten;
+        }
+        
+        Result = Remaining == 0;
+    }
+    
+    return(Result);
+}
+
+internal u64
+FileGetSizeU64(file_handle_ Handle)
+{
+    u64 Result = 0;
+    
+    if(IsValid(Handle))
+    {
+        struct stat Stat;
+        if(fstat((int)Handle.Value, &Stat) == 0)
+        {
+            Result = (u64)Stat.st_size;
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+DirectoryClose(directory_handle *Handle)
+{
+    if(IsValid(*Handle))
+    {
+        Assert(closedir((DIR *)Handle->Value) == 0);
+        Handle->Value = 0;
+    }
+}
+
+internal void
+Advance(directory_iterator *Iterator)
+{
+    if(IsValid(Iterator->Handle))
+    {
+        struct dirent *Data = readdir((DIR *)Iterator->Handle.Value);
+        if(Data)
+        {
+            LinuxCopyDirectoryEntry(Data, &Iterator->Entry);
+        }
+        else
+        {
+            DirectoryClose(&Iterator->Handle);
+        }
+    }
+}
+
+internal directory_iterator
+DirectoryIterate(char *FileName)
+{
+    directory_iterator Result = {};
+    
+    // NOTE: The win32 layer takes a search pattern like "path/*", opendir wants the directory itself, so strip a trailing wildcard
+    
+    char Path[1024];
+    umm PathSize = StringLengthZ(FileName);
+    Assert(PathSize < SizeOf(Path));
+    
+    MemoryCopy(Path, FileName, PathSize);
+    
+    if(PathSize && Path[PathSize - 1] == '*')
+    {
+        PathSize--;
+        
+        if(PathSize && (Path[PathSize - 1] == '/' || Path[PathSize - 1] == '\\'))
+        {
+            PathSize--;
+        }
+        
+        if(!PathSize)
+        {
+            Path[PathSize++] = '.';
+        }
+    }
+    
+    Path[PathSize] = 0;
+    
+    Result.Handle.Value = (u64)opendir(Path);
+    
+    Advance(&Result);
+    
+    return(Result);
+}
+
+#endif // WASP_FILE_H
+
+#ifdef WASP_DNS_H
+#error The DNS module is not implemented on linux yet
+#endif
+
+#ifdef WASP_WINDOW_H
+#error The window module is not implemented on linux yet
+#endif
+
+#ifdef WASP_RENDERER_VULKAN_H
+#error The vulkan renderer module is not implemented on linux yet
+#endif
+
+// TODO: Try to not have this duplicated in all platform layers...
+
+struct thread_context
+{
+    u32 ThreadIndex;
+    thread_context *NextFree;
+    
+#ifdef WASP_MEMORY_H
+    memory_arena Arenas[2];
+#endif
+    
+#ifdef WASP_LOG_H
+    log Log;
+#endif
+};
+
+// NOTE: Released contexts are kept with their thread index and handed to the next thread that starts, so thread
+// indices only go as high as the number of threads alive at once
+
+global __thread thread_context *GlobalThreadContext;
+global volatile u32 GlobalLinuxThreadContextCount;
+global volatile u32 GlobalLinuxThreadContextLock;
+global thread_context *GlobalLinuxThreadContextFree;
+
+// NOTE: Only taken when a thread starts or exits, a spin lock keeps this from depending on pthread
+internal void
+LinuxThreadContextLock(void)
+{
+    while(__atomic_exchange_n(&GlobalLinuxThreadContextLock, 1, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+}
+
+internal void
+LinuxThreadContextUnlock(void)
+{
+    __atomic_store_n(&GlobalLinuxThreadContextLock, 0, __ATOMIC_RELEASE);
+}
+
+internal thread_context *
+ThreadContextGet()
+{
+    thread_context *Result = GlobalThreadContext;
+    
+    if(!Result)
+    {
+        LinuxThreadContextLock();
+        Result = GlobalLinuxThreadContextFree;
+        if(Result)
+        {
+            GlobalLinuxThreadContextFree = Result->NextFree;
+            Result->NextFree = 0;
+        }
+        LinuxThreadContextUnlock();
+        
+        // NOTE: The arenas and the log of a reused context are set up again below
+        if(!Result)
+        {
+            Result = (thread_context *)mmap(0, SizeOf(*Result), PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+            Assert(Result != MAP_FAILED);
+            
+            Result->ThreadIndex = __atomic_fetch_add(&GlobalLinuxThreadContextCount, 1, __ATOMIC_SEQ_CST);
+        }
+        
+        GlobalThreadContext = Result;
+        
+#ifdef WASP_MEMORY_H
+        MemoryInit(); // NOTE: It's important that this happens first so that the log can allocate in it's init
+#endif
+        
+#ifdef WASP_LOG_H
+        LogInit();
+#endif
+    }
+    
+    return(Result);
+}
+
+// NOTE: Call before a thread exits, otherwise its scratch arenas leak and its thread index is never reused
+internal void
+ThreadContextRelease(void)
+{
+    thread_context *Context = GlobalThreadContext;
+    
+    if(Context)
+    {
+#ifdef WASP_MEMORY_H
+        for(u32 Index = 0;
+            Index < ArrayCount(Context->Arenas);
+            Index++)
+        {
+            MemoryArenaDestroy(&Context->Arenas[Index]);
+        }
+#endif
+        
+        GlobalThreadContext = 0;
+        
+        LinuxThreadContextLock();
+        Context->NextFree = GlobalLinuxThreadContextFree;
+        GlobalLinuxThreadContextFree = Context;
+        LinuxThreadContextUnlock();
+    }
+}
+
+#ifdef WASP_MEMORY_H
+internal memory_arena *MemoryArenasGet(void) {return(ThreadContextGet()->Arenas);}
+internal u32 ThreadIndexGet(void) {return(ThreadContextGet()->ThreadIndex);}
+#endif
+
+#ifdef WASP_LOG_H
+internal log *LogGet(void) {return(&ThreadContextGet()->Log);}
+#endif
+
+#endif // WASP_LINUX_H
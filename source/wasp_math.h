@@ -27,10 +27,66 @@
 #define D2R (Pi / 180.0f)
 #define R2D (180.0f / Pi)
 
+// NOTE: Everything is built on a 4 lane register, SSE on x86 and NEON on ARM64. Other targets, or any target compiled
+// with WASP_MATH_SCALAR=1, get 4 plain floats that go through the same operations lane by lane. All of them give the
+// same bits as long as the compiler doesn't fuse multiplies and adds, so build with -ffp-contract=off on ARM
+#ifndef WASP_MATH_SCALAR
+#define WASP_MATH_SCALAR 0
+#endif
+
+#if !WASP_MATH_SCALAR && (Architecture_X86_64 || Architecture_X86_32)
+#define MathSSE 1
+#else
+#define MathSSE 0
+#endif
+
+#if !WASP_MATH_SCALAR && Architecture_ARM_64
+#define MathNEON 1
+#else
+#define MathNEON 0
+#endif
+
+#define MathScalar (!MathSSE && !MathNEON)
+
+#if MathSSE && Platform_WIN32
+#include <intrin.h>
+#elif MathSSE
+#include <x86intrin.h>
+#elif MathNEON
+#include <arm_neon.h>
+#endif
+
+// NOTE: The 8 lane types are one AVX2 register when compiled with AVX2, and a pair of 4 lane registers otherwise
+#if defined(__AVX2__) && MathSSE
+#define MathWideAVX2 1
+#else
+#define MathWideAVX2 0
+#endif
+
+// NOTE: With wasp_cpu.h included first, builds without AVX2 also carry AVX2 versions of the batch kernels, picked at
+// runtime through MathKernelsGet
+#if defined(WASP_CPU_H) && !MathWideAVX2 && MathSSE
+#define MathDispatchAVX2 1
+#else
+#define MathDispatchAVX2 0
+#endif
+
 /*
   TYPES
 */
 
+#if MathSSE
+typedef __m128 simd128;
+#elif MathNEON
+typedef float32x4_t simd128;
+#else
+union simd128
+{
+    f32 F[4];
+    u32 U[4];
+};
+#endif
+
 union v2
 {
     struct
@@ -74,7 +130,7 @@ union v4
         f32 R, G, B, A;
     };
     
-    // __m128 Values;
+    simd128 Values;
 };
 
 union m4
@@ -87,7 +143,7 @@ union m4
         M30, M31, M32, M33;
     };
     
-    // __m128 Rows[4];
+    simd128 Rows[4];
 };
 
 union m2
@@ -98,7 +154,93 @@ union m2
             M10, M11;
     };
     
-    // __m128 Rows[4];
+    // simd128 Rows[4];
+};
+
+// NOTE: Lane-wide types in structure of arrays form, a v2x4 holds the X of four vectors in one register and their Y
+// in another, so the math of 4 or 8 entities runs in the instructions one entity would take. Comparisons give masks
+// with every bit of a lane either set or clear, Select picks between two values per lane with one of them.
+// Entity arrays are usually arrays of structures, the strided gathers and scatters load and store one member of
+// consecutive elements, and only the first Count lanes when the array runs out.
+
+struct f32x4
+{
+    simd128 V;
+};
+
+struct b32x4
+{
+    simd128 V;
+};
+
+struct f32x8
+{
+#if MathWideAVX2
+    __m256 V;
+#else
+    f32x4 Low;
+    f32x4 High;
+#endif
+};
+
+struct b32x8
+{
+#if MathWideAVX2
+    __m256 V;
+#else
+    b32x4 Low;
+    b32x4 High;
+#endif
+};
+
+struct v2x4
+{
+    f32x4 X;
+    f32x4 Y;
+};
+
+struct v2x8
+{
+    f32x8 X;
+    f32x8 Y;
+};
+
+struct v3x4
+{
+    f32x4 X;
+    f32x4 Y;
+    f32x4 Z;
+};
+
+struct v3x8
+{
+    f32x8 X;
+    f32x8 Y;
+    f32x8 Z;
+};
+
+// NOTE: Precise goes through the cephes kernels and matches Sin, Cos and Atan2 bit for bit. Fast trades that for shorter
+// polynomials, about 1.3e-5 max abs error for sin/cos and about 2e-5 radians for atan2
+enum math_accuracy
+{
+    MathAccuracy_Precise,
+    MathAccuracy_Fast,
+};
+
+typedef void sin_cos_array_kernel(f32 *Angles, f32 *Sines, f32 *Cosines, u32 Count, enum32(math_accuracy) Accuracy);
+typedef void atan2_array_kernel(f32 *Ys, f32 *Xs, f32 *Angles, u32 Count, enum32(math_accuracy) Accuracy);
+typedef void v2_rotate_array_kernel(v2 *Vectors, f32 *Angles, v2 *Results, u32 Count, enum32(math_accuracy) Accuracy);
+typedef void m4_transform_points_kernel(m4 Matrix, v3 *Points, u32 Count);
+
+// NOTE: Every set of kernels gives the same bits for the same input, they only differ in speed
+struct math_kernels
+{
+    char *Name;
+    
+    sin_cos_array_kernel *SinCosArray;
+    atan2_array_kernel *Atan2Array;
+    v2_rotate_array_kernel *V2RotateArray;
+    m4_transform_points_kernel *M4TransformPoints;
 };
 
 /*
@@ -121,6 +263,7 @@ internal inline f32 Atan2(f32 A, f32 B);
 internal inline f32 Asin(f32 Value);
 internal inline f32 Acos(f32 Value);
 internal inline f32 Sqrt(f32 Value);
+internal inline f32 InverseSqrtFast(f32 Value); // NOTE: About 22 bits and not the same bits on every CPU, zero is not guarded
 internal inline f32 Power(f32 Value, f32 Exponent);
 internal inline f32 Exponent(f32 Value);
 internal inline f32 Logarithm(f32 Value);
@@ -191,10 +334,14 @@ internal inline m2 operator-(m2 A);
 internal inline m4 Transpose(m4 A);
 internal inline m2 Transpose(m2 A);
 
+internal inline m4 Inverse(m4 A); // NOTE: Nothing checks for a singular matrix, the result is inf or NaN then
 internal inline m2 Inverse(m2 A);
 internal inline m2 EigenVectors(m2 A, v2 *B);
 internal inline m2 M2Identity();
 
+internal inline v3 M4Transform(m4 Matrix, v3 Point); // NOTE: The point as (X, Y, Z, 1), divided by W after
+internal void M4TransformPoints(m4 Matrix, v3 *Points, u32 Count); // NOTE: M4Transform on every point, in place
+
 internal inline f32 Distance(v2 A, v2 B);
 internal inline f32 Distance(v3 A, v3 B);
 internal inline f32 Distance(v4 A, v4 B);
@@ -207,6 +354,17 @@ internal inline v2 Normalize(v2 A);
 internal inline v3 Normalize(v3 A);
 internal inline v4 Normalize(v4 A);
 
+// NOTE: Through InverseSqrtFast instead of a square root and a divide, a few ULPs off. Only a win where those are slow,
+// recent x86 pipelines them well enough that LengthFast loses, see the normalize bench. Vectors no longer than Epsilon
+// have a length of 0 and are not normalized
+internal inline f32 LengthFast(v2 A);
+internal inline f32 LengthFast(v3 A);
+internal inline f32 LengthFast(v4 A);
+
+internal inline v2 NormalizeFast(v2 A);
+internal inline v3 NormalizeFast(v3 A);
+internal inline v4 NormalizeFast(v4 A);
+
 internal inline f32 DistanceSquare(v2 A, v2 B);
 internal inline f32 DistanceSquare(v3 A, v3 B);
 internal inline f32 DistanceSquare(v4 A, v4 B);
@@ -232,20 +390,203 @@ internal inline v3 Cross(v3 A, v3 B);
 
 internal inline f32 Determinant(v2 A, v2 B);
 
+internal inline f32x4 F32x4(f32 Value);
+internal inline f32x4 F32x4(f32 E0, f32 E1, f32 E2, f32 E3);
+internal inline f32x4 F32x4Load(f32 *Source);
+internal inline void F32x4Store(f32 *Destination, f32x4 Value);
+internal inline f32x4 F32x4GatherStrided(void *First, umm Stride, u32 Count); // NOTE: Lanes past Count are zero
+internal inline void F32x4ScatterStrided(void *First, umm Stride, u32 Count, f32x4 Value);
+internal inline f32 F32x4Lane(f32x4 Value, u32 Lane);
+
+internal inline b32x4 B32x4GatherStrided(void *First, umm Stride, u32 Count); // NOTE: Set where the b32 is not zero
+internal inline b32x4 B32x4LanesBelow(u32 Count);
+internal inline b32 B32x4Any(b32x4 Mask);
+internal inline b32 B32x4All(b32x4 Mask);
+internal inline u32 B32x4Bits(b32x4 Mask); // NOTE: Bit N is lane N
+
+internal inline f32x4 operator+(f32x4 A, f32x4 B);
+internal inline f32x4 operator-(f32x4 A, f32x4 B);
+internal inline f32x4 operator*(f32x4 A, f32x4 B);
+internal inline f32x4 operator/(f32x4 A, f32x4 B);
+internal inline f32x4 operator*(f32x4 A, f32 B);
+internal inline f32x4 operator*(f32 A, f32x4 B);
+internal inline f32x4 operator/(f32x4 A, f32 B);
+internal inline f32x4 operator-(f32x4 A);
+internal inline f32x4 &operator+=(f32x4 &A, f32x4 B);
+internal inline f32x4 &operator-=(f32x4 &A, f32x4 B);
+internal inline f32x4 &operator*=(f32x4 &A, f32x4 B);
+internal inline f32x4 &operator/=(f32x4 &A, f32x4 B);
+internal inline f32x4 &operator*=(f32x4 &A, f32 B);
+internal inline f32x4 &operator/=(f32x4 &A, f32 B);
+
+internal inline b32x4 operator<(f32x4 A, f32x4 B);
+internal inline b32x4 operator<=(f32x4 A, f32x4 B);
+internal inline b32x4 operator>(f32x4 A, f32x4 B);
+internal inline b32x4 operator>=(f32x4 A, f32x4 B);
+internal inline b32x4 operator==(f32x4 A, f32x4 B);
+internal inline b32x4 operator!=(f32x4 A, f32x4 B);
+
+internal inline b32x4 operator&(b32x4 A, b32x4 B);
+internal inline b32x4 operator|(b32x4 A, b32x4 B);
+internal inline b32x4 operator^(b32x4 A, b32x4 B);
+internal inline b32x4 operator~(b32x4 A);
+
+internal inline f32x4 F32x4Min(f32x4 A, f32x4 B);
+internal inline f32x4 F32x4Max(f32x4 A, f32x4 B);
+internal inline f32x4 F32x4Abs(f32x4 A);
+internal inline f32x4 Floor(f32x4 Value);
+internal inline f32x4 Sqrt(f32x4 Value);
+internal inline f32x4 InverseSqrtFast(f32x4 Value);
+internal inline f32x4 Sin(f32x4 Value);
+internal inline f32x4 Cos(f32x4 Value);
+internal inline f32x4 Select(b32x4 Mask, f32x4 A, f32x4 B); // NOTE: A where the mask is set, B elsewhere
+
+internal inline v2x4 V2x4(v2 Value);
+internal inline v2x4 V2x4(f32x4 X, f32x4 Y);
+internal inline v2x4 V2x4GatherStrided(v2 *First, umm Stride, u32 Count);
+internal inline void V2x4ScatterStrided(v2 *First, umm Stride, u32 Count, v2x4 Value);
+internal inline v2 V2x4Lane(v2x4 Value, u32 Lane);
+
+internal inline v2x4 operator+(v2x4 A, v2x4 B);
+internal inline v2x4 operator-(v2x4 A, v2x4 B);
+internal inline v2x4 operator*(v2x4 A, f32x4 B);
+internal inline v2x4 operator*(f32x4 A, v2x4 B);
+internal inline v2x4 operator*(v2x4 A, f32 B);
+internal inline v2x4 operator/(v2x4 A, f32x4 B);
+internal inline v2x4 operator/(v2x4 A, f32 B);
+internal inline v2x4 operator-(v2x4 A);
+internal inline v2x4 &operator+=(v2x4 &A, v2x4 B);
+internal inline v2x4 &operator-=(v2x4 &A, v2x4 B);
+internal inline v2x4 &operator*=(v2x4 &A, f32x4 B);
+internal inline v2x4 &operator*=(v2x4 &A, f32 B);
+internal inline v2x4 &operator/=(v2x4 &A, f32x4 B);
+
+internal inline f32x4 Dot(v2x4 A, v2x4 B);
+internal inline f32x4 LengthSquare(v2x4 A);
+internal inline f32x4 Length(v2x4 A);
+internal inline f32x4 DistanceSquare(v2x4 A, v2x4 B);
+internal inline f32x4 Distance(v2x4 A, v2x4 B);
+internal inline v2x4 Normalize(v2x4 A); // NOTE: Lanes no longer than Epsilon are left as they are
+internal inline f32x4 LengthFast(v2x4 A);
+internal inline v2x4 NormalizeFast(v2x4 A);
+internal inline v2x4 Hadamard(v2x4 A, v2x4 B);
+internal inline v2x4 Lerp(v2x4 A, v2x4 B, f32x4 T);
+internal inline v2x4 Select(b32x4 Mask, v2x4 A, v2x4 B);
+
+internal inline f32x8 F32x8(f32 Value);
+internal inline f32x8 F32x8(f32 E0, f32 E1, f32 E2, f32 E3, f32 E4, f32 E5, f32 E6, f32 E7);
+internal inline f32x8 F32x8Load(f32 *Source);
+internal inline void F32x8Store(f32 *Destination, f32x8 Value);
+internal inline f32x8 F32x8GatherStrided(void *First, umm Stride, u32 Count); // NOTE: Lanes past Count are zero
+internal inline void F32x8ScatterStrided(void *First, umm Stride, u32 Count, f32x8 Value);
+internal inline f32 F32x8Lane(f32x8 Value, u32 Lane);
+
+internal inline b32x8 B32x8GatherStrided(void *First, umm Stride, u32 Count); // NOTE: Set where the b32 is not zero
+internal inline b32x8 B32x8LanesBelow(u32 Count);
+internal inline b32 B32x8Any(b32x8 Mask);
+internal inline b32 B32x8All(b32x8 Mask);
+internal inline u32 B32x8Bits(b32x8 Mask); // NOTE: Bit N is lane N
+
+internal inline f32x8 operator+(f32x8 A, f32x8 B);
+internal inline f32x8 operator-(f32x8 A, f32x8 B);
+internal inline f32x8 operator*(f32x8 A, f32x8 B);
+internal inline f32x8 operator/(f32x8 A, f32x8 B);
+internal inline f32x8 operator*(f32x8 A, f32 B);
+internal inline f32x8 operator*(f32 A, f32x8 B);
+internal inline f32x8 operator/(f32x8 A, f32 B);
+internal inline f32x8 operator-(f32x8 A);
+internal inline f32x8 &operator+=(f32x8 &A, f32x8 B);
+internal inline f32x8 &operator-=(f32x8 &A, f32x8 B);
+internal inline f32x8 &operator*=(f32x8 &A, f32x8 B);
+internal inline f32x8 &operator/=(f32x8 &A, f32x8 B);
+internal inline f32x8 &operator*=(f32x8 &A, f32 B);
+internal inline f32x8 &operator/=(f32x8 &A, f32 B);
+
+internal inline b32x8 operator<(f32x8 A, f32x8 B);
+internal inline b32x8 operator<=(f32x8 A, f32x8 B);
+internal inline b32x8 operator>(f32x8 A, f32x8 B);
+internal inline b32x8 operator>=(f32x8 A, f32x8 B);
+internal inline b32x8 operator==(f32x8 A, f32x8 B);
+internal inline b32x8 operator!=(f32x8 A, f32x8 B);
+
+internal inline b32x8 operator&(b32x8 A, b32x8 B);
+internal inline b32x8 operator|(b32x8 A, b32x8 B);
+internal inline b32x8 operator^(b32x8 A, b32x8 B);
+internal inline b32x8 operator~(b32x8 A);
+
+internal inline f32x8 F32x8Min(f32x8 A, f32x8 B);
+internal inline f32x8 F32x8Max(f32x8 A, f32x8 B);
+internal inline f32x8 F32x8Abs(f32x8 A);
+internal inline f32x8 Floor(f32x8 Value);
+internal inline f32x8 Sqrt(f32x8 Value);
+internal inline f32x8 InverseSqrtFast(f32x8 Value);
+internal inline f32x8 Sin(f32x8 Value);
+internal inline f32x8 Cos(f32x8 Value);
+internal inline f32x8 Select(b32x8 Mask, f32x8 A, f32x8 B); // NOTE: A where the mask is set, B elsewhere
+
+internal inline v2x8 V2x8(v2 Value);
+internal inline v2x8 V2x8(f32x8 X, f32x8 Y);
+internal inline v2x8 V2x8GatherStrided(v2 *First, umm Stride, u32 Count);
+internal inline void V2x8ScatterStrided(v2 *First, umm Stride, u32 Count, v2x8 Value);
+internal inline v2 V2x8Lane(v2x8 Value, u32 Lane);
+
+internal inline v2x8 operator+(v2x8 A, v2x8 B);
+internal inline v2x8 operator-(v2x8 A, v2x8 B);
+internal inline v2x8 operator*(v2x8 A, f32x8 B);
+internal inline v2x8 operator*(f32x8 A, v2x8 B);
+internal inline v2x8 operator*(v2x8 A, f32 B);
+internal inline v2x8 operator/(v2x8 A, f32x8 B);
+internal inline v2x8 operator/(v2x8 A, f32 B);
+internal inline v2x8 operator-(v2x8 A);
+internal inline v2x8 &operator+=(v2x8 &A, v2x8 B);
+internal inline v2x8 &operator-=(v2x8 &A, v2x8 B);
+internal inline v2x8 &operator*=(v2x8 &A, f32x8 B);
+internal inline v2x8 &operator*=(v2x8 &A, f32 B);
+internal inline v2x8 &operator/=(v2x8 &A, f32x8 B);
+
+internal inline f32x8 Dot(v2x8 A, v2x8 B);
+internal inline f32x8 LengthSquare(v2x8 A);
+internal inline f32x8 Length(v2x8 A);
+internal inline f32x8 DistanceSquare(v2x8 A, v2x8 B);
+internal inline f32x8 Distance(v2x8 A, v2x8 B);
+internal inline v2x8 Normalize(v2x8 A); // NOTE: Lanes no longer than Epsilon are left as they are
+internal inline f32x8 LengthFast(v2x8 A);
+internal inline v2x8 NormalizeFast(v2x8 A);
+internal inline v2x8 Hadamard(v2x8 A, v2x8 B);
+internal inline v2x8 Lerp(v2x8 A, v2x8 B, f32x8 T);
+internal inline v2x8 Select(b32x8 Mask, v2x8 A, v2x8 B);
+
+internal inline void SinCos(f32x4 Value, f32x4 *Sin, f32x4 *Cos);
+internal inline void SinCosFast(f32x4 Value, f32x4 *Sin, f32x4 *Cos);
+internal inline f32x4 Atan2(f32x4 Y, f32x4 X);
+internal inline f32x4 Atan2Fast(f32x4 Y, f32x4 X);
+internal inline void SinCos(f32x8 Value, f32x8 *Sin, f32x8 *Cos);
+internal inline void SinCosFast(f32x8 Value, f32x8 *Sin, f32x8 *Cos);
+internal inline f32x8 Atan2(f32x8 Y, f32x8 X);
+internal inline f32x8 Atan2Fast(f32x8 Y, f32x8 X);
+
+internal inline v2x4 V2x4Load(v2 *Source);
+internal inline void V2x4Store(v2 *Destination, v2x4 Value);
+internal inline v2x8 V2x8Load(v2 *Source);
+internal inline void V2x8Store(v2 *Destination, v2x8 Value);
+internal inline v3x4 V3x4Load(v3 *Source);
+internal inline void V3x4Store(v3 *Destination, v3x4 Value);
+internal inline v3x8 V3x8Load(v3 *Source);
+internal inline void V3x8Store(v3 *Destination, v3x8 Value);
+
+internal void SinCosArray(f32 *Angles, f32 *Sines, f32 *Cosines, u32 Count, enum32(math_accuracy) Accuracy);
+internal void Atan2Array(f32 *Ys, f32 *Xs, f32 *Angles, u32 Count, enum32(math_accuracy) Accuracy);
+internal void V2RotateArray(v2 *Vectors, f32 *Angles, v2 *Results, u32 Count, enum32(math_accuracy) Accuracy); // NOTE: Angles are in degrees, like V2Rotate
+
+// NOTE: The batch kernels above go through GlobalMathKernels, which starts out on the ones the build was compiled for
+#ifdef WASP_CPU_H
+internal math_kernels MathKernelsGet(flag32(cpu_feature) Features); // NOTE: The fastest kernels these features can run
+#endif
+
 /*
   IMPLEMENTATION
 */
 
-#if Platform_LINUX || Platform_DARWIN
-#include <x86intrin.h>
-#elif Platform_WIN32
-#include <intrin.h>
-#elif Platform_WASM
-// NOTE: We don't support intrinsics here yet!
-#else
-#error We don't know what to include for intrinsics on this platform!
-#endif
-
 //
 // NOTE:
 // http://gruntthepeon.free.fr/ssemath/
@@ -254,1055 +595,4617 @@ internal inline f32 Determinant(v2 A, v2 B);
 
 // TODO: Instead paste intrinsics from https://github.com/microsoft/DirectXMath/blob/main/Inc/DirectXMathVector.inl, or make our own...
 
+#if MathSSE
 #define USE_SSE2
 #include "sse_mathfun_extension.h"
+#endif
 
-internal inline f32
-Floor(f32 Value)
+#if MathDispatchAVX2
+#define AVX_MATHFUN_TARGET CpuTarget("avx2")
+#endif
+
+#if MathWideAVX2 || MathDispatchAVX2
+#include "avx_mathfun.h"
+#endif
+
+//
+// NOTE: The Simd functions are the only place that knows which backend simd128 is. Masks have every bit of a lane
+// either set or clear. The Int functions treat the lanes as s32 bit patterns, SimdConvertToInt leaves those in the
+// register and SimdConvertToFloat turns them back into floats
+//
+
+internal inline simd128
+SimdSet1(f32 Value)
 {
-    f32 Result = _mm_cvtss_f32(_mm_floor_ss(_mm_setzero_ps(), _mm_set_ss(Value)));
+#if MathSSE
+    simd128 Result = _mm_set1_ps(Value);
+#elif MathNEON
+    simd128 Result = vdupq_n_f32(Value);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = Value;
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Ceil(f32 Value)
+internal inline simd128
+SimdSetr(f32 E0, f32 E1, f32 E2, f32 E3)
 {
-    f32 Result = _mm_cvtss_f32(_mm_ceil_ss(_mm_setzero_ps(), _mm_set_ss(Value)));
+#if MathSSE
+    simd128 Result = _mm_setr_ps(E0, E1, E2, E3);
+#elif MathNEON
+    f32 Values[4] = {E0, E1, E2, E3};
+    simd128 Result = vld1q_f32(Values);
+#else
+    simd128 Result;
+    Result.F[0] = E0;
+    Result.F[1] = E1;
+    Result.F[2] = E2;
+    Result.F[3] = E3;
+#endif
     return(Result);
 }
 
-internal inline f32
-Round(f32 Value)
+internal inline simd128
+SimdZero(void)
 {
-    f32 Result = _mm_cvtss_f32(_mm_round_ss(_mm_setzero_ps(), _mm_set_ss(Value), _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC));
+#if MathSSE
+    simd128 Result = _mm_setzero_ps();
+#else
+    simd128 Result = SimdSet1(0.0f);
+#endif
     return(Result);
 }
 
-internal inline f32
-Mod(f32 Value, f32 Divisor)
+internal inline simd128
+SimdLoad(f32 *Source)
 {
-    f32 Result = Value - Floor(Value / Divisor) * Divisor;
+#if MathSSE
+    simd128 Result = _mm_loadu_ps(Source);
+#elif MathNEON
+    simd128 Result = vld1q_f32(Source);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = Source[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Sin(f32 Value)
+internal inline simd128
+SimdIntLoad(u32 *Source)
 {
-    f32 Result = _mm_cvtss_f32(sin_ps(_mm_set_ss(Value)));
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_loadu_si128((__m128i *)Source));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vld1q_u32(Source));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = Source[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Cos(f32 Value)
+internal inline void
+SimdStore(f32 *Destination, simd128 Value)
 {
-    f32 Result = _mm_cvtss_f32(cos_ps(_mm_set_ss(Value)));
-    return(Result);
+#if MathSSE
+    _mm_storeu_ps(Destination, Value);
+#elif MathNEON
+    vst1q_f32(Destination, Value);
+#else
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Destination[Lane] = Value.F[Lane];
+    }
+#endif
 }
 
 internal inline f32
-Tan(f32 Value)
+SimdFirst(simd128 Value)
 {
-    f32 Result = _mm_cvtss_f32(tan_ps(_mm_set_ss(Value)));
+#if MathSSE
+    f32 Result = _mm_cvtss_f32(Value);
+#elif MathNEON
+    f32 Result = vgetq_lane_f32(Value, 0);
+#else
+    f32 Result = Value.F[0];
+#endif
     return(Result);
 }
 
-internal inline void
-SinCos(f32 Value, f32 *Sin, f32 *Cos)
+internal inline simd128
+SimdAdd(simd128 A, simd128 B)
 {
-    __m128 XMM0, XMM1;
-    sincos_ps(_mm_set_ss(Value), &XMM0, &XMM1);
-    *Sin = _mm_cvtss_f32(XMM0);
-    *Cos = _mm_cvtss_f32(XMM1);
+#if MathSSE
+    simd128 Result = _mm_add_ps(A, B);
+#elif MathNEON
+    simd128 Result = vaddq_f32(A, B);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = A.F[Lane] + B.F[Lane];
+    }
+#endif
+    return(Result);
 }
 
-internal inline f32
-Atan2(f32 A, f32 B)
+internal inline simd128
+SimdSub(simd128 A, simd128 B)
 {
-    f32 Result = _mm_cvtss_f32(atan2_ps(_mm_set_ss(A), _mm_set_ss(B)));
+#if MathSSE
+    simd128 Result = _mm_sub_ps(A, B);
+#elif MathNEON
+    simd128 Result = vsubq_f32(A, B);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = A.F[Lane] - B.F[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Asin(f32 Value)
+internal inline simd128
+SimdMul(simd128 A, simd128 B)
 {
-    __m128 XMM0 = _mm_set_ss(Value);
-    __m128 XMM1 = _mm_sqrt_ss(_mm_sub_ss(_mm_set_ss(1.0f), _mm_mul_ss(XMM0, XMM0)));
-    f32 Result = _mm_cvtss_f32(atan2_ps(XMM0, XMM1));
+#if MathSSE
+    simd128 Result = _mm_mul_ps(A, B);
+#elif MathNEON
+    simd128 Result = vmulq_f32(A, B);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = A.F[Lane] * B.F[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Acos(f32 Value)
+internal inline simd128
+SimdDiv(simd128 A, simd128 B)
 {
-    __m128 XMM0 = _mm_set_ss(Value);
-    __m128 XMM1 = _mm_sqrt_ss(_mm_sub_ss(_mm_set_ss(1.0f), _mm_mul_ss(XMM0, XMM0)));
-    f32 Result = _mm_cvtss_f32(atan2_ps(XMM1, XMM0));
+#if MathSSE
+    simd128 Result = _mm_div_ps(A, B);
+#elif MathNEON
+    simd128 Result = vdivq_f32(A, B);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = A.F[Lane] / B.F[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Sqrt(f32 Value)
+// NOTE: Min and Max pick B when the lanes are equal or either is NaN, like the SSE instructions do
+internal inline simd128
+SimdMin(simd128 A, simd128 B)
 {
-    f32 Result = _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(Value)));
+#if MathSSE
+    simd128 Result = _mm_min_ps(A, B);
+#elif MathNEON
+    simd128 Result = vbslq_f32(vcltq_f32(A, B), A, B);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = A.F[Lane] < B.F[Lane] ? A.F[Lane] : B.F[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Square(f32 Value)
-{  
-    __m128 XMM0 = _mm_set_ss(Value);
-    f32 Result = _mm_cvtss_f32(_mm_mul_ss(XMM0, XMM0));
+internal inline simd128
+SimdMax(simd128 A, simd128 B)
+{
+#if MathSSE
+    simd128 Result = _mm_max_ps(A, B);
+#elif MathNEON
+    simd128 Result = vbslq_f32(vcgtq_f32(A, B), A, B);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = A.F[Lane] > B.F[Lane] ? A.F[Lane] : B.F[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Power(f32 Value, f32 Exponent)
+internal inline simd128
+SimdSqrt(simd128 Value)
 {
-    f32 Result = _mm_cvtss_f32(exp_ps(_mm_mul_ss(_mm_set_ss(Exponent), log_ps(_mm_set_ss(Value)))));
+#if MathSSE
+    simd128 Result = _mm_sqrt_ps(Value);
+#elif MathNEON
+    simd128 Result = vsqrtq_f32(Value);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = __builtin_sqrtf(Value.F[Lane]);
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Exponent(f32 Value)
+// NOTE: The hardware estimate of 1 / sqrt, 12 bits on SSE. NEON only gives 8 so it gets one refinement step here to
+// land close to that, the scalar backend has no estimate and divides. All three give different bits, and so do Intel
+// and AMD, so nothing that has to replay the same may depend on it
+internal inline simd128
+SimdInverseSqrtEstimate(simd128 Value)
 {
-    f32 Result = _mm_cvtss_f32(exp_ps(_mm_set_ss(Value)));
+#if MathSSE
+    simd128 Result = _mm_rsqrt_ps(Value);
+#elif MathNEON
+    simd128 Result = vrsqrteq_f32(Value);
+    Result = vmulq_f32(Result, vrsqrtsq_f32(vmulq_f32(Value, Result), Result));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = 1.0f / __builtin_sqrtf(Value.F[Lane]);
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-Logarithm(f32 Value)
+// NOTE: The estimate with one Newton-Raphson step, E * (1.5 - 0.5 * Value * E * E). Multiplying Value by E first keeps
+// E * E from going denormal for large values. Zero and infinity come out as NaN
+internal inline simd128
+SimdInverseSqrtFast(simd128 Value)
 {
-    f32 Result = _mm_cvtss_f32(log_ps(_mm_set_ss(Value)));
+    simd128 Estimate = SimdInverseSqrtEstimate(Value);
+    simd128 Correction = SimdMul(SimdMul(SimdMul(SimdSet1(0.5f), Value), Estimate), Estimate);
+    simd128 Result = SimdMul(Estimate, SimdSub(SimdSet1(1.5f), Correction));
     return(Result);
 }
 
-internal inline f32
-Cosh(f32 Value)
+#if MathScalar
+// NOTE: Rounds the way the SSE4.1 round instructions do, Mode 0 down, 1 up and 2 to the nearest even. Floats of 2^23
+// and up, infinities and NaN are already whole and pass through, and the results keep the sign of the input so -0.5
+// floors to -1 and ceils to -0
+internal inline simd128
+SimdRoundLanes(simd128 Value, u32 Mode)
 {
-    __m128 XMM0 = _mm_set_ss(Value);
-    __m128 XMM1 = _mm_div_ss(_mm_add_ss(exp_ps(XMM0), exp_ps(_mm_mul_ss(_mm_set_ss(-1.0f), XMM0))), _mm_set_ss(2.0f));
-    f32 Result = _mm_cvtss_f32(XMM1);
+    simd128 Result = Value;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        f32 LaneValue = Value.F[Lane];
+        f32 Magnitude = LaneValue < 0.0f ? -LaneValue : LaneValue;
+        if(Magnitude < 8388608.0f)
+        {
+            f32 Truncated = (f32)(s32)LaneValue;
+            switch(Mode)
+            {
+                case 0: Result.F[Lane] = Truncated > LaneValue ? Truncated - 1.0f : Truncated; break;
+                case 1: Result.F[Lane] = Truncated < LaneValue ? Truncated + 1.0f : Truncated; break;
+                
+                // NOTE: Adding and taking away 2^23 leaves no bits below the point, rounded to even in the default mode
+                case 2: Result.F[Lane] = (Magnitude + 8388608.0f) - 8388608.0f; break;
+            }
+            
+            Result.U[Lane] |= Value.U[Lane] & 0x80000000;
+        }
+    }
+    
     return(Result);
 }
+#endif
 
-internal inline f32
-Sech(f32 Value)
+internal inline simd128
+SimdFloor(simd128 Value)
 {
-    __m128 XMM0 = _mm_set_ss(Value);
-    __m128 XMM1 = _mm_div_ss(_mm_add_ss(exp_ps(XMM0), exp_ps(_mm_mul_ss(_mm_set_ss(-1.0f), XMM0))), _mm_set_ss(2.0f));
-    __m128 XMM2 = _mm_rcp_ss(XMM1);
-    
-    f32 Result = _mm_cvtss_f32(XMM2);
+#if MathSSE
+    simd128 Result = _mm_floor_ps(Value);
+#elif MathNEON
+    simd128 Result = vrndmq_f32(Value);
+#else
+    simd128 Result = SimdRoundLanes(Value, 0);
+#endif
     return(Result);
 }
 
-internal inline f32
-Sigmoid(f32 Value)
+internal inline simd128
+SimdCeil(simd128 Value)
 {
-    __m128 XMM0 = exp_ps(_mm_set_ss(-Value));
-    __m128 XMM1 = _mm_add_ss(_mm_set_ss(1), XMM0);
-    __m128 XMM2 = _mm_rcp_ss(XMM1);
-    
-    f32 Result = _mm_cvtss_f32(XMM2);
+#if MathSSE
+    simd128 Result = _mm_ceil_ps(Value);
+#elif MathNEON
+    simd128 Result = vrndpq_f32(Value);
+#else
+    simd128 Result = SimdRoundLanes(Value, 1);
+#endif
     return(Result);
 }
 
-internal inline f32
-SigmoidDerivative(f32 Value)
+// NOTE: To the nearest whole number, halfway cases to the even one
+internal inline simd128
+SimdRound(simd128 Value)
 {
-    __m128 XMM0 = exp_ps(_mm_set_ss(-Value));
-    __m128 XMM1 = _mm_add_ss(_mm_set_ss(1), XMM0);
-    __m128 XMM2 = _mm_mul_ss(XMM1, XMM1);
-    __m128 XMM3 = _mm_div_ss(XMM0, XMM2);
-    
-    f32 Result = _mm_cvtss_f32(XMM3);
+#if MathSSE
+    simd128 Result = _mm_round_ps(Value, _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+#elif MathNEON
+    simd128 Result = vrndnq_f32(Value);
+#else
+    simd128 Result = SimdRoundLanes(Value, 2);
+#endif
     return(Result);
 }
 
-internal inline f32
-Tanh(f32 Value)
+internal inline simd128
+SimdAnd(simd128 A, simd128 B)
 {
-    __m128 XMM0 = _mm_set_ss(Value);
-    __m128 XMM1 = exp_ps(XMM0);
-    __m128 XMM2 = exp_ps(_mm_mul_ss(_mm_set_ss(-1.0f), XMM0));
-    __m128 XMM3 = _mm_div_ss(_mm_sub_ss(XMM1, XMM2), _mm_add_ss(XMM1, XMM2));
-    
-    f32 Result = _mm_cvtss_f32(XMM3);
+#if MathSSE
+    simd128 Result = _mm_and_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(A), vreinterpretq_u32_f32(B)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.U[Lane] & B.U[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-TanhDerivative(f32 Value)
+internal inline simd128
+SimdOr(simd128 A, simd128 B)
 {
-    __m128 XMM0 = _mm_set_ss(Value);
-    __m128 XMM1 = exp_ps(XMM0);
-    __m128 XMM2 = exp_ps(_mm_mul_ss(_mm_set_ss(-1.0f), XMM0));
-    __m128 XMM3 = _mm_div_ss(_mm_sub_ss(XMM1, XMM2), _mm_add_ss(XMM1, XMM2));
-    __m128 XMM4 = _mm_sub_ss(_mm_set_ss(1.0f), _mm_mul_ss(XMM3, XMM3));
-    
-    f32 Result = _mm_cvtss_f32(XMM4);
+#if MathSSE
+    simd128 Result = _mm_or_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(A), vreinterpretq_u32_f32(B)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.U[Lane] | B.U[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-ReLU(f32 Value)
+internal inline simd128
+SimdXor(simd128 A, simd128 B)
 {
-    f32 Result = Max(0.0f, Value);
+#if MathSSE
+    simd128 Result = _mm_xor_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(A), vreinterpretq_u32_f32(B)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.U[Lane] ^ B.U[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline f32
-ReLUDerivative(f32 Value)
+// NOTE: The complement of A and B, the operand order of the SSE instruction
+internal inline simd128
+SimdAndNot(simd128 A, simd128 B)
 {
-    f32 Result = Value < 0.0f ? 0.0f : 1.0f;
+#if MathSSE
+    simd128 Result = _mm_andnot_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(B), vreinterpretq_u32_f32(A)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = ~A.U[Lane] & B.U[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline v2
-V2(f32 X, f32 Y)
+internal inline simd128
+SimdCmpLT(simd128 A, simd128 B)
 {
-    v2 Result;
-    Result.X = X;
-    Result.Y = Y;
+#if MathSSE
+    simd128 Result = _mm_cmplt_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vcltq_f32(A, B));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.F[Lane] < B.F[Lane] ? 0xffffffff : 0;
+    }
+#endif
     return(Result);
 }
 
-internal inline v3
-V3(f32 X, f32 Y, f32 Z)
+internal inline simd128
+SimdCmpLE(simd128 A, simd128 B)
 {
-    v3 Result;
-    Result.X = X;
-    Result.Y = Y;
-    Result.Z = Z;
+#if MathSSE
+    simd128 Result = _mm_cmple_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vcleq_f32(A, B));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.F[Lane] <= B.F[Lane] ? 0xffffffff : 0;
+    }
+#endif
     return(Result);
 }
 
-internal inline v4
-V4(f32 X, f32 Y, f32 Z, f32 W)
+internal inline simd128
+SimdCmpGT(simd128 A, simd128 B)
 {
-    v4 Result;
-    Result.X = X;
-    Result.Y = Y;
-    Result.Z = Z;
-    Result.W = W;
+#if MathSSE
+    simd128 Result = _mm_cmpgt_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vcgtq_f32(A, B));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.F[Lane] > B.F[Lane] ? 0xffffffff : 0;
+    }
+#endif
     return(Result);
 }
 
-internal inline m4
-M4(f32 M00, f32 M01, f32 M02, f32 M03,
-   f32 M10, f32 M11, f32 M12, f32 M13,
-   f32 M20, f32 M21, f32 M22, f32 M23,
-   f32 M30, f32 M31, f32 M32, f32 M33)
+internal inline simd128
+SimdCmpGE(simd128 A, simd128 B)
 {
-    m4 Result;
-    
-    Result.M00 = M00;
-    Result.M01 = M01;
-    Result.M02 = M02;
-    Result.M03 = M03;
-    
-    Result.M10 = M10;
-    Result.M11 = M11;
-    Result.M12 = M12;
-    Result.M13 = M13;
-    
-    Result.M20 = M20;
-    Result.M21 = M21;
-    Result.M22 = M22;
-    Result.M23 = M23;
-    
-    Result.M30 = M30;
-    Result.M31 = M31;
-    Result.M32 = M32;
-    Result.M33 = M33;
-    
+#if MathSSE
+    simd128 Result = _mm_cmpge_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vcgeq_f32(A, B));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.F[Lane] >= B.F[Lane] ? 0xffffffff : 0;
+    }
+#endif
     return(Result);
 }
 
-internal inline m2
-M2(f32 M00, f32 M01,
-   f32 M10, f32 M11)
+internal inline simd128
+SimdCmpEQ(simd128 A, simd128 B)
 {
-    m2 Result;
-    
-    Result.M00 = M00;
-    Result.M01 = M01;
-    Result.M10 = M10;
-    Result.M11 = M11;
-    
+#if MathSSE
+    simd128 Result = _mm_cmpeq_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vceqq_f32(A, B));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.F[Lane] == B.F[Lane] ? 0xffffffff : 0;
+    }
+#endif
     return(Result);
 }
 
-internal inline v2
-operator+(v2 A, v2 B)
+// NOTE: Set for NaN lanes, the only comparison that is
+internal inline simd128
+SimdCmpNEQ(simd128 A, simd128 B)
 {
-    v2 Result;
-    Result.X = A.X + B.X;
-    Result.Y = A.Y + B.Y;
+#if MathSSE
+    simd128 Result = _mm_cmpneq_ps(A, B);
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(A, B)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.F[Lane] != B.F[Lane] ? 0xffffffff : 0;
+    }
+#endif
     return(Result);
 }
 
-internal inline v3
-operator+(v3 A, v3 B)
+// NOTE: A where the mask is set, B elsewhere
+internal inline simd128
+SimdSelect(simd128 Mask, simd128 A, simd128 B)
 {
-    v3 Result;
-    Result.X = A.X + B.X;
-    Result.Y = A.Y + B.Y;
-    Result.Z = A.Z + B.Z;
+#if MathSSE
+    simd128 Result = _mm_blendv_ps(B, A, Mask);
+#elif MathNEON
+    simd128 Result = vbslq_f32(vreinterpretq_u32_f32(Mask), A, B);
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = Mask.U[Lane] ? A.F[Lane] : B.F[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline v4
-operator+(v4 A, v4 B)
+// NOTE: The sign bit of each lane, lane 0 in bit 0
+internal inline u32
+SimdMoveMask(simd128 Value)
 {
-    v4 Result;
-    Result.X = A.X + B.X;
-    Result.Y = A.Y + B.Y;
-    Result.Z = A.Z + B.Z;
-    Result.W = A.W + B.W;
+#if MathSSE
+    u32 Result = (u32)_mm_movemask_ps(Value);
+#elif MathNEON
+    s32 Shifts[4] = {0, 1, 2, 3};
+    uint32x4_t Signs = vshrq_n_u32(vreinterpretq_u32_f32(Value), 31);
+    u32 Result = vaddvq_u32(vshlq_u32(Signs, vld1q_s32(Shifts)));
+#else
+    u32 Result = 0;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result |= (Value.U[Lane] >> 31) << Lane;
+    }
+#endif
     return(Result);
 }
 
-internal inline v2
-operator-(v2 A, v2 B)
+internal inline simd128
+SimdShuffleLanes(simd128 A, simd128 B, u32 I0, u32 I1, u32 I2, u32 I3)
 {
-    v2 Result;
-    Result.X = A.X - B.X;
-    Result.Y = A.Y - B.Y;
+    f32 ValuesA[4];
+    f32 ValuesB[4];
+    SimdStore(ValuesA, A);
+    SimdStore(ValuesB, B);
+    
+    simd128 Result = SimdSetr(ValuesA[I0], ValuesA[I1], ValuesB[I2], ValuesB[I3]);
     return(Result);
 }
 
-internal inline v3
-operator-(v3 A, v3 B)
+// NOTE: Lanes I0 and I1 of A, then lanes I2 and I3 of B. The indices have to be constants
+#if MathSSE
+#define SimdShuffle(A, B, I0, I1, I2, I3) _mm_shuffle_ps(A, B, _MM_SHUFFLE(I3, I2, I1, I0))
+#elif MathNEON && !Compiler_MSVC
+#define SimdShuffle(A, B, I0, I1, I2, I3) __builtin_shufflevector(A, B, I0, I1, (I2) + 4, (I3) + 4)
+#else
+#define SimdShuffle(A, B, I0, I1, I2, I3) SimdShuffleLanes(A, B, I0, I1, I2, I3)
+#endif
+
+#define SimdSplat(Value, Lane) SimdShuffle(Value, Value, Lane, Lane, Lane, Lane)
+
+// NOTE: Lanes 0 and 1 of A and B interleaved, A0 B0 A1 B1
+internal inline simd128
+SimdUnpackLow(simd128 A, simd128 B)
 {
-    v3 Result;
-    Result.X = A.X - B.X;
-    Result.Y = A.Y - B.Y;
-    Result.Z = A.Z - B.Z;
+#if MathSSE
+    simd128 Result = _mm_unpacklo_ps(A, B);
+#elif MathNEON
+    simd128 Result = vzip1q_f32(A, B);
+#else
+    simd128 Result;
+    Result.F[0] = A.F[0];
+    Result.F[1] = B.F[0];
+    Result.F[2] = A.F[1];
+    Result.F[3] = B.F[1];
+#endif
     return(Result);
 }
 
-internal inline v4
-operator-(v4 A, v4 B)
+// NOTE: Lanes 2 and 3 of A and B interleaved, A2 B2 A3 B3
+internal inline simd128
+SimdUnpackHigh(simd128 A, simd128 B)
 {
-    v4 Result;
-    Result.X = A.X - B.X;
-    Result.Y = A.Y - B.Y;
-    Result.Z = A.Z - B.Z;
-    Result.W = A.W - B.W;
+#if MathSSE
+    simd128 Result = _mm_unpackhi_ps(A, B);
+#elif MathNEON
+    simd128 Result = vzip2q_f32(A, B);
+#else
+    simd128 Result;
+    Result.F[0] = A.F[2];
+    Result.F[1] = B.F[2];
+    Result.F[2] = A.F[3];
+    Result.F[3] = B.F[3];
+#endif
     return(Result);
 }
 
-internal inline v2
-operator*(v2 A, f32 B)
+internal inline void
+SimdTranspose(simd128 *Rows)
 {
-    v2 Result;
-    Result.X = A.X * B;
-    Result.Y = A.Y * B;
-    return(Result);
+#if MathSSE
+    _MM_TRANSPOSE4_PS(Rows[0], Rows[1], Rows[2], Rows[3]);
+#else
+    simd128 Low01 = SimdShuffle(Rows[0], Rows[1], 0, 1, 0, 1);
+    simd128 High01 = SimdShuffle(Rows[0], Rows[1], 2, 3, 2, 3);
+    simd128 Low23 = SimdShuffle(Rows[2], Rows[3], 0, 1, 0, 1);
+    simd128 High23 = SimdShuffle(Rows[2], Rows[3], 2, 3, 2, 3);
+    
+    Rows[0] = SimdShuffle(Low01, Low23, 0, 2, 0, 2);
+    Rows[1] = SimdShuffle(Low01, Low23, 1, 3, 1, 3);
+    Rows[2] = SimdShuffle(High01, High23, 0, 2, 0, 2);
+    Rows[3] = SimdShuffle(High01, High23, 1, 3, 1, 3);
+#endif
 }
 
-internal inline v3
-operator*(v3 A, f32 B)
+internal inline simd128
+SimdIntSet1(s32 Value)
 {
-    v3 Result;
-    Result.X = A.X * B;
-    Result.Y = A.Y * B;
-    Result.Z = A.Z * B;
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_set1_epi32(Value));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_s32(vdupq_n_s32(Value));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = (u32)Value;
+    }
+#endif
     return(Result);
 }
 
-internal inline v4
-operator*(v4 A, f32 B)
+internal inline simd128
+SimdIntAdd(simd128 A, simd128 B)
 {
-    v4 Result;
-    Result.X = A.X * B;
-    Result.Y = A.Y * B;
-    Result.Z = A.Z * B;
-    Result.W = A.W * B;
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(A), _mm_castps_si128(B)));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_s32(vaddq_s32(vreinterpretq_s32_f32(A), vreinterpretq_s32_f32(B)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.U[Lane] + B.U[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline v2
-operator*(f32 A, v2 B)
+internal inline simd128
+SimdIntSub(simd128 A, simd128 B)
 {
-    v2 Result;
-    Result.X = B.X * A;
-    Result.Y = B.Y * A;
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_sub_epi32(_mm_castps_si128(A), _mm_castps_si128(B)));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_s32(vsubq_s32(vreinterpretq_s32_f32(A), vreinterpretq_s32_f32(B)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.U[Lane] - B.U[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline v3
-operator*(f32 A, v3 B)
+internal inline simd128
+SimdIntCmpEQ(simd128 A, simd128 B)
 {
-    v3 Result;
-    Result.X = B.X * A;
-    Result.Y = B.Y * A;
-    Result.Z = B.Z * A;
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(A), _mm_castps_si128(B)));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vceqq_u32(vreinterpretq_u32_f32(A), vreinterpretq_u32_f32(B)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = A.U[Lane] == B.U[Lane] ? 0xffffffff : 0;
+    }
+#endif
     return(Result);
 }
 
-internal inline v4
-operator*(f32 A, v4 B)
+internal inline simd128
+SimdShiftLeft(simd128 Value, s32 Count)
 {
-    v4 Result;
-    Result.X = B.X * A;
-    Result.Y = B.Y * A;
-    Result.Z = B.Z * A;
-    Result.W = B.W * A;
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(Value), Count));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vshlq_u32(vreinterpretq_u32_f32(Value), vdupq_n_s32(Count)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = Value.U[Lane] << Count;
+    }
+#endif
     return(Result);
 }
 
-internal inline v2
-operator/(v2 A, f32 B)
+// NOTE: Shifts in zeros
+internal inline simd128
+SimdShiftRight(simd128 Value, s32 Count)
 {
-    v2 Result;
-    Result.X = A.X / B;
-    Result.Y = A.Y / B;
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_srli_epi32(_mm_castps_si128(Value), Count));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_u32(vshlq_u32(vreinterpretq_u32_f32(Value), vdupq_n_s32(-Count)));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.U[Lane] = Value.U[Lane] >> Count;
+    }
+#endif
     return(Result);
 }
 
-internal inline v3
-operator/(v3 A, f32 B)
+// NOTE: Truncates toward zero. Lanes out of the s32 range come out as 0x80000000 on SSE and the scalar backend, NEON
+// clamps them instead, which only differs for inputs none of the callers give a meaningful result for
+internal inline simd128
+SimdConvertToInt(simd128 Value)
 {
-    v3 Result;
-    Result.X = A.X / B;
-    Result.Y = A.Y / B;
-    Result.Z = A.Z / B;
+#if MathSSE
+    simd128 Result = _mm_castsi128_ps(_mm_cvttps_epi32(Value));
+#elif MathNEON
+    simd128 Result = vreinterpretq_f32_s32(vcvtq_s32_f32(Value));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        f32 LaneValue = Value.F[Lane];
+        b32 InRange = LaneValue >= -2147483648.0f && LaneValue < 2147483648.0f;
+        Result.U[Lane] = InRange ? (u32)(s32)LaneValue : 0x80000000;
+    }
+#endif
     return(Result);
 }
 
-internal inline v4
-operator/(v4 A, f32 B)
+internal inline simd128
+SimdConvertToFloat(simd128 Value)
 {
-    v4 Result;
-    Result.X = A.X / B;
-    Result.Y = A.Y / B;
-    Result.Z = A.Z / B;
-    Result.W = A.W / B;
+#if MathSSE
+    simd128 Result = _mm_cvtepi32_ps(_mm_castps_si128(Value));
+#elif MathNEON
+    simd128 Result = vcvtq_f32_s32(vreinterpretq_s32_f32(Value));
+#else
+    simd128 Result;
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Result.F[Lane] = (f32)(s32)Value.U[Lane];
+    }
+#endif
     return(Result);
 }
 
-internal inline v2 &
-operator+=(v2 &A, v2 B)
+//
+// NOTE: The cephes kernels of sse_mathfun.h and sse_mathfun_extension.h rewritten on the Simd functions, so they run
+// on every backend. Each one goes through the same operations in the same order as the SSE original and gives the
+// same bits for every input, the constants are converted from double like the originals are. They are compiled on
+// every target so the bench can check them against the SSE versions
+//
+
+internal inline void
+SimdSinCosPortable(simd128 Value, simd128 *Sin, simd128 *Cos)
 {
-    A.X += B.X;
-    A.Y += B.Y;
+    simd128 SignMask = SimdIntSet1((s32)0x80000000);
     
-    return(A);
+    simd128 SinSignBit = SimdAnd(Value, SignMask);
+    simd128 X = SimdAndNot(SignMask, Value);
+    
+    // NOTE: The octant, rounded up to even so the reduction is around a multiple of Pi/2
+    simd128 Y = SimdMul(X, SimdSet1((f32)1.27323954473516));
+    simd128 Octant = SimdConvertToInt(Y);
+    Octant = SimdIntAdd(Octant, SimdIntSet1(1));
+    Octant = SimdAnd(Octant, SimdIntSet1(~1));
+    Y = SimdConvertToFloat(Octant);
+    
+    simd128 SinSwapSignBit = SimdShiftLeft(SimdAnd(Octant, SimdIntSet1(4)), 29);
+    simd128 PolynomialMask = SimdIntCmpEQ(SimdAnd(Octant, SimdIntSet1(2)), SimdZero());
+    
+    // NOTE: X - Y*Pi/4 with Pi/4 split in three, so the reduction stays exact
+    simd128 Reduce1 = SimdMul(Y, SimdSet1((f32)-0.78515625));
+    simd128 Reduce2 = SimdMul(Y, SimdSet1((f32)-2.4187564849853515625e-4));
+    simd128 Reduce3 = SimdMul(Y, SimdSet1((f32)-3.77489497744594108e-8));
+    X = SimdAdd(X, Reduce1);
+    X = SimdAdd(X, Reduce2);
+    X = SimdAdd(X, Reduce3);
+    
+    Octant = SimdIntSub(Octant, SimdIntSet1(2));
+    Octant = SimdAndNot(Octant, SimdIntSet1(4));
+    simd128 CosSignBit = SimdShiftLeft(Octant, 29);
+    
+    SinSignBit = SimdXor(SinSignBit, SinSwapSignBit);
+    
+    simd128 Z = SimdMul(X, X);
+    
+    simd128 CosPolynomial = SimdSet1((f32)2.443315711809948E-005);
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdAdd(CosPolynomial, SimdSet1((f32)-1.388731625493765E-003));
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdAdd(CosPolynomial, SimdSet1((f32)4.166664568298827E-002));
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdSub(CosPolynomial, SimdMul(Z, SimdSet1(0.5f)));
+    CosPolynomial = SimdAdd(CosPolynomial, SimdSet1(1.0f));
+    
+    simd128 SinPolynomial = SimdSet1((f32)-1.9515295891E-4);
+    SinPolynomial = SimdMul(SinPolynomial, Z);
+    SinPolynomial = SimdAdd(SinPolynomial, SimdSet1((f32)8.3321608736E-3));
+    SinPolynomial = SimdMul(SinPolynomial, Z);
+    SinPolynomial = SimdAdd(SinPolynomial, SimdSet1((f32)-1.6666654611E-1));
+    SinPolynomial = SimdMul(SinPolynomial, Z);
+    SinPolynomial = SimdMul(SinPolynomial, X);
+    SinPolynomial = SimdAdd(SinPolynomial, X);
+    
+    // NOTE: Each polynomial goes to the sine in some octants and to the cosine in the others
+    simd128 SinFromSin = SimdAnd(PolynomialMask, SinPolynomial);
+    simd128 SinFromCos = SimdAndNot(PolynomialMask, CosPolynomial);
+    SinPolynomial = SimdSub(SinPolynomial, SinFromSin);
+    CosPolynomial = SimdSub(CosPolynomial, SinFromCos);
+    
+    *Sin = SimdXor(SimdAdd(SinFromCos, SinFromSin), SinSignBit);
+    *Cos = SimdXor(SimdAdd(CosPolynomial, SinPolynomial), CosSignBit);
 }
 
-internal inline v3 &
-operator+=(v3 &A, v3 B)
+internal inline simd128
+SimdSinPortable(simd128 Value)
 {
-    A.X += B.X;
-    A.Y += B.Y;
-    A.Z += B.Z;
-    
-    return(A);
+    simd128 Result, Unused;
+    SimdSinCosPortable(Value, &Result, &Unused);
+    return(Result);
 }
 
-internal inline v4 &
-operator+=(v4 &A, v4 B)
+// NOTE: Not taken from SimdSinCosPortable, which gives NaN where the polynomial it doesn't pick overflows
+internal inline simd128
+SimdCosPortable(simd128 Value)
 {
-    A.X += B.X;
-    A.Y += B.Y;
-    A.Z += B.Z;
-    A.W += B.W;
+    simd128 X = SimdAndNot(SimdIntSet1((s32)0x80000000), Value);
     
-    return(A);
+    simd128 Y = SimdMul(X, SimdSet1((f32)1.27323954473516));
+    simd128 Octant = SimdConvertToInt(Y);
+    Octant = SimdIntAdd(Octant, SimdIntSet1(1));
+    Octant = SimdAnd(Octant, SimdIntSet1(~1));
+    Y = SimdConvertToFloat(Octant);
+    Octant = SimdIntSub(Octant, SimdIntSet1(2));
+    
+    simd128 SignBit = SimdShiftLeft(SimdAndNot(Octant, SimdIntSet1(4)), 29);
+    simd128 PolynomialMask = SimdIntCmpEQ(SimdAnd(Octant, SimdIntSet1(2)), SimdZero());
+    
+    simd128 Reduce1 = SimdMul(Y, SimdSet1((f32)-0.78515625));
+    simd128 Reduce2 = SimdMul(Y, SimdSet1((f32)-2.4187564849853515625e-4));
+    simd128 Reduce3 = SimdMul(Y, SimdSet1((f32)-3.77489497744594108e-8));
+    X = SimdAdd(X, Reduce1);
+    X = SimdAdd(X, Reduce2);
+    X = SimdAdd(X, Reduce3);
+    
+    simd128 Z = SimdMul(X, X);
+    
+    simd128 CosPolynomial = SimdSet1((f32)2.443315711809948E-005);
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdAdd(CosPolynomial, SimdSet1((f32)-1.388731625493765E-003));
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdAdd(CosPolynomial, SimdSet1((f32)4.166664568298827E-002));
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdMul(CosPolynomial, Z);
+    CosPolynomial = SimdSub(CosPolynomial, SimdMul(Z, SimdSet1(0.5f)));
+    CosPolynomial = SimdAdd(CosPolynomial, SimdSet1(1.0f));
+    
+    simd128 SinPolynomial = SimdSet1((f32)-1.9515295891E-4);
+    SinPolynomial = SimdMul(SinPolynomial, Z);
+    SinPolynomial = SimdAdd(SinPolynomial, SimdSet1((f32)8.3321608736E-3));
+    SinPolynomial = SimdMul(SinPolynomial, Z);
+    SinPolynomial = SimdAdd(SinPolynomial, SimdSet1((f32)-1.6666654611E-1));
+    SinPolynomial = SimdMul(SinPolynomial, Z);
+    SinPolynomial = SimdMul(SinPolynomial, X);
+    SinPolynomial = SimdAdd(SinPolynomial, X);
+    
+    SinPolynomial = SimdAnd(PolynomialMask, SinPolynomial);
+    CosPolynomial = SimdAndNot(PolynomialMask, CosPolynomial);
+    
+    simd128 Result = SimdXor(SimdAdd(CosPolynomial, SinPolynomial), SignBit);
+    return(Result);
 }
 
-internal inline v2 &
-operator-=(v2 &A, v2 B)
+internal inline simd128
+SimdTanPortable(simd128 Value)
 {
-    A.X -= B.X;
-    A.Y -= B.Y;
+    simd128 SignMask = SimdIntSet1((s32)0x80000000);
     
-    return(A);
+    simd128 SignBit = SimdAnd(Value, SignMask);
+    simd128 X = SimdAndNot(SignMask, Value);
+    
+    simd128 Y = SimdMul(X, SimdSet1((f32)1.27323954473516));
+    simd128 Octant = SimdConvertToInt(Y);
+    Octant = SimdIntAdd(Octant, SimdIntSet1(1));
+    Octant = SimdAnd(Octant, SimdIntSet1(~1));
+    Y = SimdConvertToFloat(Octant);
+    
+    simd128 PolynomialMask = SimdIntCmpEQ(SimdAnd(Octant, SimdIntSet1(2)), SimdZero());
+    
+    simd128 Reduce1 = SimdMul(Y, SimdSet1((f32)-0.78515625));
+    simd128 Reduce2 = SimdMul(Y, SimdSet1((f32)-2.4187564849853515625e-4));
+    simd128 Reduce3 = SimdMul(Y, SimdSet1((f32)-3.77489497744594108e-8));
+    simd128 Z = SimdAdd(X, Reduce1);
+    Z = SimdAdd(Z, Reduce2);
+    Z = SimdAdd(Z, Reduce3);
+    
+    simd128 ZZ = SimdMul(Z, Z);
+    
+    Y = SimdSet1((f32)9.38540185543E-3);
+    Y = SimdMul(Y, ZZ);
+    Y = SimdAdd(Y, SimdSet1((f32)3.11992232697E-3));
+    Y = SimdMul(Y, ZZ);
+    Y = SimdAdd(Y, SimdSet1((f32)2.44301354525E-2));
+    Y = SimdMul(Y, ZZ);
+    Y = SimdAdd(Y, SimdSet1((f32)5.34112807005E-2));
+    Y = SimdMul(Y, ZZ);
+    Y = SimdAdd(Y, SimdSet1((f32)1.33387994085E-1));
+    Y = SimdMul(Y, ZZ);
+    Y = SimdAdd(Y, SimdSet1((f32)3.33331568548E-1));
+    Y = SimdMul(Y, ZZ);
+    Y = SimdMul(Y, Z);
+    Y = SimdAdd(Y, Z);
+    
+    // NOTE: -1/tan of the reduced angle in the octants next to the poles
+    simd128 Cotangent = SimdDiv(SimdSet1(1.0f), Y);
+    Cotangent = SimdXor(Cotangent, SignMask);
+    
+    Y = SimdAnd(PolynomialMask, Y);
+    Cotangent = SimdAndNot(PolynomialMask, Cotangent);
+    Y = SimdOr(Y, Cotangent);
+    
+    simd128 Result = SimdXor(Y, SignBit);
+    return(Result);
 }
 
-internal inline v3 &
-operator-=(v3 &A, v3 B)
+internal inline simd128
+SimdAtanPortable(simd128 Value)
 {
-    A.X -= B.X;
-    A.Y -= B.Y;
-    A.Z -= B.Z;
+    simd128 SignMask = SimdIntSet1((s32)0x80000000);
+    simd128 One = SimdSet1(1.0f);
     
-    return(A);
+    simd128 SignBit = SimdAnd(Value, SignMask);
+    simd128 X = SimdAndNot(SignMask, Value);
+    
+    // NOTE: Above tan(3Pi/8) this is Pi/2 + atan(-1/X), between tan(Pi/8) and that Pi/4 + atan((X-1)/(X+1))
+    simd128 AboveHigh = SimdCmpGT(X, SimdSet1((f32)2.414213562373095));
+    simd128 AboveLow = SimdCmpGT(X, SimdSet1((f32)0.4142135623730950));
+    simd128 Middle = SimdAndNot(AboveHigh, AboveLow);
+    
+    simd128 HighOffset = SimdAnd(AboveHigh, SimdSet1((f32)1.5707963267948966192));
+    simd128 HighX = SimdDiv(One, X);
+    HighX = SimdXor(HighX, SignMask);
+    simd128 MiddleOffset = SimdAnd(Middle, SimdSet1((f32)0.7853981633974483096));
+    
+    simd128 MiddleX = SimdDiv(SimdSub(X, One), SimdAdd(X, One));
+    MiddleX = SimdAnd(Middle, MiddleX);
+    HighX = SimdAnd(AboveHigh, HighX);
+    MiddleX = SimdOr(MiddleX, HighX);
+    
+    simd128 Reduced = SimdOr(AboveHigh, Middle);
+    MiddleX = SimdAnd(Reduced, MiddleX);
+    X = SimdAndNot(Reduced, X);
+    X = SimdOr(MiddleX, X);
+    simd128 Y = SimdOr(HighOffset, MiddleOffset);
+    
+    simd128 ZZ = SimdMul(X, X);
+    simd128 Polynomial = SimdSet1((f32)8.05374449538e-2);
+    Polynomial = SimdMul(Polynomial, ZZ);
+    Polynomial = SimdSub(Polynomial, SimdSet1((f32)1.38776856032E-1));
+    Polynomial = SimdMul(Polynomial, ZZ);
+    Polynomial = SimdAdd(Polynomial, SimdSet1((f32)1.99777106478E-1));
+    Polynomial = SimdMul(Polynomial, ZZ);
+    Polynomial = SimdSub(Polynomial, SimdSet1((f32)3.33329491539E-1));
+    Polynomial = SimdMul(Polynomial, ZZ);
+    Polynomial = SimdMul(Polynomial, X);
+    Polynomial = SimdAdd(Polynomial, X);
+    Y = SimdAdd(Y, Polynomial);
+    
+    simd128 Result = SimdXor(Y, SignBit);
+    return(Result);
 }
 
-internal inline v4 &
-operator-=(v4 &A, v4 B)
+internal inline simd128
+SimdAtan2Portable(simd128 Y, simd128 X)
 {
-    A.X -= B.X;
-    A.Y -= B.Y;
-    A.Z -= B.Z;
-    A.W -= B.W;
+    simd128 Zero = SimdZero();
+    simd128 SignMask = SimdIntSet1((s32)0x80000000);
+    simd128 PiValue = SimdSet1((f32)3.141592653589793238);
     
-    return(A);
+    simd128 XEqualZero = SimdCmpEQ(X, Zero);
+    simd128 XAboveZero = SimdCmpGT(X, Zero);
+    simd128 XAtMostZero = SimdCmpLE(X, Zero);
+    simd128 YEqualZero = SimdCmpEQ(Y, Zero);
+    simd128 XBelowZero = SimdCmpLT(X, Zero);
+    simd128 YBelowZero = SimdCmpLT(Y, Zero);
+    
+    simd128 ZeroMask = SimdOr(SimdAnd(XEqualZero, YEqualZero), SimdAnd(YEqualZero, XAboveZero));
+    
+    simd128 HalfPiMask = SimdAndNot(YEqualZero, XEqualZero);
+    simd128 HalfPiResult = SimdXor(SimdSet1((f32)1.5707963267948966192), SimdAnd(YBelowZero, SignMask));
+    HalfPiResult = SimdAnd(HalfPiMask, HalfPiResult);
+    
+    simd128 PiMask = SimdAnd(YEqualZero, XAtMostZero);
+    simd128 PiResult = SimdAnd(PiMask, PiValue);
+    
+    // NOTE: Left of the Y axis atan(Y/X) is off by Pi, toward the sign of Y
+    simd128 OffsetSign = SimdAnd(SimdAnd(XBelowZero, YBelowZero), SignMask);
+    simd128 Offset = SimdAnd(XBelowZero, SimdXor(PiValue, OffsetSign));
+    
+    simd128 AtanResult = SimdAdd(SimdAtanPortable(SimdDiv(Y, X)), Offset);
+    
+    simd128 Result = SimdAndNot(ZeroMask, HalfPiResult);
+    AtanResult = SimdAndNot(HalfPiMask, AtanResult);
+    Result = SimdOr(Result, AtanResult);
+    Result = SimdOr(Result, PiResult);
+    return(Result);
 }
 
-internal inline v2 &
-operator*=(v2 &A, f32 B)
+internal inline simd128
+SimdExpPortable(simd128 Value)
 {
-    A.X *= B;
-    A.Y *= B;
+    simd128 One = SimdSet1(1.0f);
     
-    return(A);
+    simd128 X = SimdMin(Value, SimdSet1(88.3762626647949f));
+    X = SimdMax(X, SimdSet1(-88.3762626647949f));
+    
+    // NOTE: exp(X) = 2^N * exp(X - N*log(2)), with N the nearest whole number to X/log(2)
+    simd128 N = SimdMul(X, SimdSet1((f32)1.44269504088896341));
+    N = SimdAdd(N, SimdSet1(0.5f));
+    
+    simd128 Truncated = SimdConvertToFloat(SimdConvertToInt(N));
+    simd128 Mask = SimdCmpGT(Truncated, N);
+    Mask = SimdAnd(Mask, One);
+    N = SimdSub(Truncated, Mask);
+    
+    simd128 Reduce1 = SimdMul(N, SimdSet1((f32)0.693359375));
+    simd128 Reduce2 = SimdMul(N, SimdSet1((f32)-2.12194440e-4));
+    X = SimdSub(X, Reduce1);
+    X = SimdSub(X, Reduce2);
+    
+    simd128 Z = SimdMul(X, X);
+    simd128 Y = SimdSet1((f32)1.9875691500E-4);
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)1.3981999507E-3));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)8.3334519073E-3));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)4.1665795894E-2));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)1.6666665459E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)5.0000001201E-1));
+    Y = SimdMul(Y, Z);
+    Y = SimdAdd(Y, X);
+    Y = SimdAdd(Y, One);
+    
+    // NOTE: 2^N built straight in the exponent bits
+    simd128 PowerOfTwo = SimdConvertToInt(N);
+    PowerOfTwo = SimdIntAdd(PowerOfTwo, SimdIntSet1(0x7f));
+    PowerOfTwo = SimdShiftLeft(PowerOfTwo, 23);
+    
+    simd128 Result = SimdMul(Y, PowerOfTwo);
+    return(Result);
 }
 
-internal inline v3 &
-operator*=(v3 &A, f32 B)
+// NOTE: NaN for lanes at or below zero
+internal inline simd128
+SimdLogPortable(simd128 Value)
 {
-    A.X *= B;
-    A.Y *= B;
-    A.Z *= B;
+    simd128 One = SimdSet1(1.0f);
     
-    return(A);
+    simd128 InvalidMask = SimdCmpLE(Value, SimdZero());
+    
+    // NOTE: Denormals are cut off at the smallest normal float
+    simd128 X = SimdMax(Value, SimdIntSet1(0x00800000));
+    
+    // NOTE: Splits X into a mantissa in [0.5, 1) and the exponent E
+    simd128 E = SimdShiftRight(X, 23);
+    X = SimdAnd(X, SimdIntSet1(~0x7f800000));
+    X = SimdOr(X, SimdSet1(0.5f));
+    E = SimdIntSub(E, SimdIntSet1(0x7f));
+    E = SimdConvertToFloat(E);
+    E = SimdAdd(E, One);
+    
+    // NOTE: Below sqrt(1/2) the mantissa is doubled and the exponent lowered, so X - 1 stays around zero
+    simd128 Mask = SimdCmpLT(X, SimdSet1((f32)0.707106781186547524));
+    simd128 Temp = SimdAnd(X, Mask);
+    X = SimdSub(X, One);
+    E = SimdSub(E, SimdAnd(One, Mask));
+    X = SimdAdd(X, Temp);
+    
+    simd128 Z = SimdMul(X, X);
+    simd128 Y = SimdSet1((f32)7.0376836292E-2);
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)-1.1514610310E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)1.1676998740E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)-1.2420140846E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)1.4249322787E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)-1.6668057665E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)2.0000714765E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)-2.4999993993E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdAdd(Y, SimdSet1((f32)3.3333331174E-1));
+    Y = SimdMul(Y, X);
+    Y = SimdMul(Y, Z);
+    
+    Temp = SimdMul(E, SimdSet1((f32)-2.12194440e-4));
+    Y = SimdAdd(Y, Temp);
+    Temp = SimdMul(Z, SimdSet1(0.5f));
+    Y = SimdSub(Y, Temp);
+    Temp = SimdMul(E, SimdSet1((f32)0.693359375));
+    X = SimdAdd(X, Y);
+    X = SimdAdd(X, Temp);
+    
+    simd128 Result = SimdOr(X, InvalidMask);
+    return(Result);
 }
 
-internal inline v4 &
-operator*=(v4 &A, f32 B)
+//
+// NOTE: The kernels every backend uses. SSE keeps the original sse_mathfun functions, the rest take the portable ones
+//
+
+internal inline void
+SimdSinCos(simd128 Value, simd128 *Sin, simd128 *Cos)
 {
-    A.X *= B;
-    A.Y *= B;
-    A.Z *= B;
-    A.W *= B;
-    
-    return(A);
+#if MathSSE
+    sincos_ps(Value, Sin, Cos);
+#else
+    SimdSinCosPortable(Value, Sin, Cos);
+#endif
 }
 
-internal inline v2 &
-operator/=(v2 &A, f32 B)
+internal inline simd128
+SimdSin(simd128 Value)
 {
-    A.X /= B;
-    A.Y /= B;
-    
-    return(A);
+#if MathSSE
+    simd128 Result = sin_ps(Value);
+#else
+    simd128 Result = SimdSinPortable(Value);
+#endif
+    return(Result);
 }
 
-internal inline v3 &
-operator/=(v3 &A, f32 B)
+internal inline simd128
+SimdCos(simd128 Value)
 {
-    A.X /= B;
-    A.Y /= B;
-    A.Z /= B;
-    
-    return(A);
+#if MathSSE
+    simd128 Result = cos_ps(Value);
+#else
+    simd128 Result = SimdCosPortable(Value);
+#endif
+    return(Result);
 }
 
-internal inline v4 &
-operator/=(v4 &A, f32 B)
+internal inline simd128
+SimdTan(simd128 Value)
 {
-    A.X /= B;
-    A.Y /= B;
-    A.Z /= B;
-    A.W /= B;
-    
-    return(A);
+#if MathSSE
+    simd128 Result = tan_ps(Value);
+#else
+    simd128 Result = SimdTanPortable(Value);
+#endif
+    return(Result);
 }
 
-internal inline m4
-operator*(m4 A, m4 B)
+internal inline simd128
+SimdAtan2(simd128 Y, simd128 X)
 {
-    m4 Result;
+#if MathSSE
+    simd128 Result = atan2_ps(Y, X);
+#else
+    simd128 Result = SimdAtan2Portable(Y, X);
+#endif
+    return(Result);
+}
 
-    Result.M00 = A.M00 * B.M00 + A.M01 * B.M10 + A.M02 * B.M20 + A.M03 * B.M30;
-    Result.M01 = A.M00 * B.M01 + A.M01 * B.M11 + A.M02 * B.M21 + A.M03 * B.M31;
-    Result.M02 = A.M00 * B.M02 + A.M01 * B.M12 + A.M02 * B.M22 + A.M03 * B.M32;
-    Result.M03 = A.M00 * B.M03 + A.M01 * B.M13 + A.M02 * B.M23 + A.M03 * B.M33;
+internal inline simd128
+SimdExp(simd128 Value)
+{
+#if MathSSE
+    simd128 Result = exp_ps(Value);
+#else
+    simd128 Result = SimdExpPortable(Value);
+#endif
+    return(Result);
+}
 
-    Result.M10 = A.M10 * B.M00 + A.M11 * B.M10 + A.M12 * B.M20 + A.M13 * B.M30;
-    Result.M11 = A.M10 * B.M01 + A.M11 * B.M11 + A.M12 * B.M21 + A.M13 * B.M31;
-    Result.M12 = A.M10 * B.M02 + A.M11 * B.M12 + A.M12 * B.M22 + A.M13 * B.M32;
-    Result.M13 = A.M10 * B.M03 + A.M11 * B.M13 + A.M12 * B.M23 + A.M13 * B.M33;
+internal inline simd128
+SimdLog(simd128 Value)
+{
+#if MathSSE
+    simd128 Result = log_ps(Value);
+#else
+    simd128 Result = SimdLogPortable(Value);
+#endif
+    return(Result);
+}
 
-    Result.M20 = A.M20 * B.M00 + A.M21 * B.M10 + A.M22 * B.M20 + A.M23 * B.M30;
-    Result.M21 = A.M20 * B.M01 + A.M21 * B.M11 + A.M22 * B.M21 + A.M23 * B.M31;
-    Result.M22 = A.M20 * B.M02 + A.M21 * B.M12 + A.M22 * B.M22 + A.M23 * B.M32;
-    Result.M23 = A.M20 * B.M03 + A.M21 * B.M13 + A.M22 * B.M23 + A.M23 * B.M33;
+internal inline f32
+Floor(f32 Value)
+{
+    f32 Result = SimdFirst(SimdFloor(SimdSet1(Value)));
+    return(Result);
+}
 
-    Result.M30 = A.M30 * B.M00 + A.M31 * B.M10 + A.M32 * B.M20 + A.M33 * B.M30;
-    Result.M31 = A.M30 * B.M01 + A.M31 * B.M11 + A.M32 * B.M21 + A.M33 * B.M31;
-    Result.M32 = A.M30 * B.M02 + A.M31 * B.M12 + A.M32 * B.M22 + A.M33 * B.M32;
-    Result.M33 = A.M30 * B.M03 + A.M31 * B.M13 + A.M32 * B.M23 + A.M33 * B.M33;
+internal inline f32
+Ceil(f32 Value)
+{
+    f32 Result = SimdFirst(SimdCeil(SimdSet1(Value)));
+    return(Result);
+}
 
+internal inline f32
+Round(f32 Value)
+{
+    f32 Result = SimdFirst(SimdRound(SimdSet1(Value)));
     return(Result);
 }
 
-internal inline v4
-operator*(m4 A, v4 B)
+internal inline f32
+Mod(f32 Value, f32 Divisor)
 {
-    v4 Result;
+    f32 Result = Value - Floor(Value / Divisor) * Divisor;
+    return(Result);
+}
 
-    Result.X = A.M00 * B.X + A.M01 * B.Y + A.M02 * B.Z * A.M03 * B.W;
-    Result.Y = A.M10 * B.X + A.M11 * B.Y + A.M12 * B.Z * A.M13 * B.W;
-    Result.Z = A.M20 * B.X + A.M21 * B.Y + A.M22 * B.Z * A.M23 * B.W;
-    Result.W = A.M30 * B.X + A.M31 * B.Y + A.M32 * B.Z * A.M33 * B.W;
+internal inline f32
+Sin(f32 Value)
+{
+    f32 Result = SimdFirst(SimdSin(SimdSet1(Value)));
+    return(Result);
+}
 
+internal inline f32
+Cos(f32 Value)
+{
+    f32 Result = SimdFirst(SimdCos(SimdSet1(Value)));
     return(Result);
 }
 
-internal inline m2
-operator*(m2 A, m2 B)
+internal inline f32
+Tan(f32 Value)
 {
-    m2 Result;
+    f32 Result = SimdFirst(SimdTan(SimdSet1(Value)));
+    return(Result);
+}
 
-    Result.M00 = A.M00 * B.M00 + A.M01 * B.M10;
-    Result.M01 = A.M00 * B.M01 + A.M01 * B.M11;
-    Result.M10 = A.M10 * B.M00 + A.M11 * B.M10;
-    Result.M11 = A.M10 * B.M01 + A.M11 * B.M11;
+internal inline void
+SinCos(f32 Value, f32 *Sin, f32 *Cos)
+{
+    simd128 SinValues, CosValues;
+    SimdSinCos(SimdSet1(Value), &SinValues, &CosValues);
+    *Sin = SimdFirst(SinValues);
+    *Cos = SimdFirst(CosValues);
+}
 
+internal inline f32
+Atan2(f32 A, f32 B)
+{
+    f32 Result = SimdFirst(SimdAtan2(SimdSet1(A), SimdSet1(B)));
     return(Result);
 }
 
-internal inline v2
-operator*(m2 A, v2 B)
+internal inline f32
+Asin(f32 Value)
 {
-    v2 Result;
+    simd128 X = SimdSet1(Value);
+    simd128 Y = SimdSqrt(SimdSub(SimdSet1(1.0f), SimdMul(X, X)));
+    f32 Result = SimdFirst(SimdAtan2(X, Y));
+    return(Result);
+}
 
-    Result.X = A.M00 * B.X + A.M01 * B.Y;
-    Result.Y = A.M10 * B.X + A.M11 * B.Y;
+internal inline f32
+Acos(f32 Value)
+{
+    simd128 X = SimdSet1(Value);
+    simd128 Y = SimdSqrt(SimdSub(SimdSet1(1.0f), SimdMul(X, X)));
+    f32 Result = SimdFirst(SimdAtan2(Y, X));
+    return(Result);
+}
 
+internal inline f32
+Sqrt(f32 Value)
+{
+    f32 Result = SimdFirst(SimdSqrt(SimdSet1(Value)));
     return(Result);
 }
 
-internal inline m4
-Transpose(m4 A)
+internal inline f32
+InverseSqrtFast(f32 Value)
 {
-    m4 Result;
+    f32 Result = SimdFirst(SimdInverseSqrtFast(SimdSet1(Value)));
+    return(Result);
+}
 
-    Result.M00 = Result.M00;
-    Result.M01 = Result.M10;
-    Result.M02 = Result.M20;
-    Result.M03 = Result.M30;
+internal inline f32
+Square(f32 Value)
+{  
+    simd128 X = SimdSet1(Value);
+    f32 Result = SimdFirst(SimdMul(X, X));
+    return(Result);
+}
 
-    Result.M10 = Result.M01;
-    Result.M11 = Result.M11;
-    Result.M12 = Result.M21;
-    Result.M13 = Result.M31;
+internal inline f32
+Power(f32 Value, f32 Exponent)
+{
+    f32 Result = SimdFirst(SimdExp(SimdMul(SimdSet1(Exponent), SimdLog(SimdSet1(Value)))));
+    return(Result);
+}
 
-    Result.M20 = Result.M02;
-    Result.M21 = Result.M12;
-    Result.M22 = Result.M22;
-    Result.M23 = Result.M32;
+internal inline f32
+Exponent(f32 Value)
+{
+    f32 Result = SimdFirst(SimdExp(SimdSet1(Value)));
+    return(Result);
+}
 
-    Result.M30 = Result.M03;
-    Result.M31 = Result.M13;
-    Result.M32 = Result.M23;
-    Result.M33 = Result.M33;
+internal inline f32
+Logarithm(f32 Value)
+{
+    f32 Result = SimdFirst(SimdLog(SimdSet1(Value)));
+    return(Result);
+}
 
+internal inline f32
+Cosh(f32 Value)
+{
+    simd128 X = SimdSet1(Value);
+    simd128 Y = SimdDiv(SimdAdd(SimdExp(X), SimdExp(SimdMul(SimdSet1(-1.0f), X))), SimdSet1(2.0f));
+    f32 Result = SimdFirst(Y);
     return(Result);
 }
 
-internal inline m2
-Transpose(m2 A)
+internal inline f32
+Sech(f32 Value)
 {
-    m2 Result;
+    simd128 X = SimdSet1(Value);
+    simd128 Y = SimdDiv(SimdAdd(SimdExp(X), SimdExp(SimdMul(SimdSet1(-1.0f), X))), SimdSet1(2.0f));
+    
+    // NOTE: A full division, the reciprocal estimates differ between instruction sets
+    f32 Result = SimdFirst(SimdDiv(SimdSet1(1.0f), Y));
+    return(Result);
+}
 
-    Result.M00 = Result.M00;
-    Result.M01 = Result.M10;
-    Result.M10 = Result.M01;
-    Result.M11 = Result.M11;
+internal inline f32
+Sigmoid(f32 Value)
+{
+    simd128 X = SimdExp(SimdSet1(-Value));
+    simd128 Y = SimdAdd(SimdSet1(1.0f), X);
+    
+    f32 Result = SimdFirst(SimdDiv(SimdSet1(1.0f), Y));
+    return(Result);
+}
 
+internal inline f32
+SigmoidDerivative(f32 Value)
+{
+    simd128 X = SimdExp(SimdSet1(-Value));
+    simd128 Y = SimdAdd(SimdSet1(1.0f), X);
+    
+    f32 Result = SimdFirst(SimdDiv(X, SimdMul(Y, Y)));
     return(Result);
 }
 
-internal inline m2
-Inverse(m2 A)
+internal inline f32
+Tanh(f32 Value)
 {
-    m2 Result;
+    simd128 X = SimdSet1(Value);
+    simd128 Positive = SimdExp(X);
+    simd128 Negative = SimdExp(SimdMul(SimdSet1(-1.0f), X));
+    
+    f32 Result = SimdFirst(SimdDiv(SimdSub(Positive, Negative), SimdAdd(Positive, Negative)));
+    return(Result);
+}
 
-    f32 Determinant = A.M00 * A.M11 - A.M01 * A.M10;
-    f32 InverseDeterminant = 1.0f / Determinant;
+internal inline f32
+TanhDerivative(f32 Value)
+{
+    simd128 X = SimdSet1(Value);
+    simd128 Positive = SimdExp(X);
+    simd128 Negative = SimdExp(SimdMul(SimdSet1(-1.0f), X));
+    simd128 Tangent = SimdDiv(SimdSub(Positive, Negative), SimdAdd(Positive, Negative));
+    
+    f32 Result = SimdFirst(SimdSub(SimdSet1(1.0f), SimdMul(Tangent, Tangent)));
+    return(Result);
+}
 
-    Result.M00 = A.M11 * InverseDeterminant;
-    Result.M01 = -A.M01 * InverseDeterminant;
-    Result.M10 = -A.M10 * InverseDeterminant;
-    Result.M11 = A.M00 * InverseDeterminant;
+internal inline f32
+ReLU(f32 Value)
+{
+    f32 Result = Max(0.0f, Value);
+    return(Result);
+}
 
+internal inline f32
+ReLUDerivative(f32 Value)
+{
+    f32 Result = Value < 0.0f ? 0.0f : 1.0f;
     return(Result);
 }
 
-internal inline m2
-EigenVectors(m2 A, v2 *B)
+internal inline v2
+V2(f32 X, f32 Y)
 {
-    m2 Result = {};
+    v2 Result;
+    Result.X = X;
+    Result.Y = Y;
+    return(Result);
+}
 
-    f32 Trace = A.M00 + A.M11;
-    f32 Determinant = A.M00 * A.M11 - A.M01 * A.M10;
+internal inline v3
+V3(f32 X, f32 Y, f32 Z)
+{
+    v3 Result;
+    Result.X = X;
+    Result.Y = Y;
+    Result.Z = Z;
+    return(Result);
+}
+
+internal inline v4
+V4(f32 X, f32 Y, f32 Z, f32 W)
+{
+    v4 Result;
+    Result.Values = SimdSetr(X, Y, Z, W);
+    return(Result);
+}
+
+internal inline m4
+M4(f32 M00, f32 M01, f32 M02, f32 M03,
+   f32 M10, f32 M11, f32 M12, f32 M13,
+   f32 M20, f32 M21, f32 M22, f32 M23,
+   f32 M30, f32 M31, f32 M32, f32 M33)
+{
+    m4 Result;
+    Result.Rows[0] = SimdSetr(M00, M01, M02, M03);
+    Result.Rows[1] = SimdSetr(M10, M11, M12, M13);
+    Result.Rows[2] = SimdSetr(M20, M21, M22, M23);
+    Result.Rows[3] = SimdSetr(M30, M31, M32, M33);
+    return(Result);
+}
+
+internal inline m2
+M2(f32 M00, f32 M01,
+   f32 M10, f32 M11)
+{
+    m2 Result;
+    
+    Result.M00 = M00;
+    Result.M01 = M01;
+    Result.M10 = M10;
+    Result.M11 = M11;
+    
+    return(Result);
+}
+
+internal inline v2
+operator+(v2 A, v2 B)
+{
+    v2 Result;
+    Result.X = A.X + B.X;
+    Result.Y = A.Y + B.Y;
+    return(Result);
+}
+
+internal inline v3
+operator+(v3 A, v3 B)
+{
+    v3 Result;
+    Result.X = A.X + B.X;
+    Result.Y = A.Y + B.Y;
+    Result.Z = A.Z + B.Z;
+    return(Result);
+}
+
+internal inline v4
+operator+(v4 A, v4 B)
+{
+    v4 Result;
+    Result.Values = SimdAdd(A.Values, B.Values);
+    return(Result);
+}
+
+internal inline v2
+operator-(v2 A, v2 B)
+{
+    v2 Result;
+    Result.X = A.X - B.X;
+    Result.Y = A.Y - B.Y;
+    return(Result);
+}
+
+internal inline v3
+operator-(v3 A, v3 B)
+{
+    v3 Result;
+    Result.X = A.X - B.X;
+    Result.Y = A.Y - B.Y;
+    Result.Z = A.Z - B.Z;
+    return(Result);
+}
+
+internal inline v4
+operator-(v4 A, v4 B)
+{
+    v4 Result;
+    Result.Values = SimdSub(A.Values, B.Values);
+    return(Result);
+}
+
+internal inline v2
+operator*(v2 A, f32 B)
+{
+    v2 Result;
+    Result.X = A.X * B;
+    Result.Y = A.Y * B;
+    return(Result);
+}
+
+internal inline v3
+operator*(v3 A, f32 B)
+{
+    v3 Result;
+    Result.X = A.X * B;
+    Result.Y = A.Y * B;
+    Result.Z = A.Z * B;
+    return(Result);
+}
+
+internal inline v4
+operator*(v4 A, f32 B)
+{
+    v4 Result;
+    Result.Values = SimdMul(A.Values, SimdSet1(B));
+    return(Result);
+}
+
+internal inline v2
+operator*(f32 A, v2 B)
+{
+    v2 Result;
+    Result.X = B.X * A;
+    Result.Y = B.Y * A;
+    return(Result);
+}
+
+internal inline v3
+operator*(f32 A, v3 B)
+{
+    v3 Result;
+    Result.X = B.X * A;
+    Result.Y = B.Y * A;
+    Result.Z = B.Z * A;
+    return(Result);
+}
+
+internal inline v4
+operator*(f32 A, v4 B)
+{
+    v4 Result;
+    Result.Values = SimdMul(B.Values, SimdSet1(A));
+    return(Result);
+}
+
+internal inline v2
+operator/(v2 A, f32 B)
+{
+    v2 Result;
+    Result.X = A.X / B;
+    Result.Y = A.Y / B;
+    return(Result);
+}
+
+internal inline v3
+operator/(v3 A, f32 B)
+{
+    v3 Result;
+    Result.X = A.X / B;
+    Result.Y = A.Y / B;
+    Result.Z = A.Z / B;
+    return(Result);
+}
+
+internal inline v4
+operator/(v4 A, f32 B)
+{
+    v4 Result;
+    Result.Values = SimdDiv(A.Values, SimdSet1(B));
+    return(Result);
+}
+
+internal inline v2 &
+operator+=(v2 &A, v2 B)
+{
+    A.X += B.X;
+    A.Y += B.Y;
+    
+    return(A);
+}
+
+internal inline v3 &
+operator+=(v3 &A, v3 B)
+{
+    A.X += B.X;
+    A.Y += B.Y;
+    A.Z += B.Z;
+    
+    return(A);
+}
+
+internal inline v4 &
+operator+=(v4 &A, v4 B)
+{
+    A.Values = SimdAdd(A.Values, B.Values);
+    
+    return(A);
+}
+
+internal inline v2 &
+operator-=(v2 &A, v2 B)
+{
+    A.X -= B.X;
+    A.Y -= B.Y;
+    
+    return(A);
+}
+
+internal inline v3 &
+operator-=(v3 &A, v3 B)
+{
+    A.X -= B.X;
+    A.Y -= B.Y;
+    A.Z -= B.Z;
+    
+    return(A);
+}
+
+internal inline v4 &
+operator-=(v4 &A, v4 B)
+{
+    A.Values = SimdSub(A.Values, B.Values);
+    
+    return(A);
+}
+
+internal inline v2 &
+operator*=(v2 &A, f32 B)
+{
+    A.X *= B;
+    A.Y *= B;
+    
+    return(A);
+}
+
+internal inline v3 &
+operator*=(v3 &A, f32 B)
+{
+    A.X *= B;
+    A.Y *= B;
+    A.Z *= B;
+    
+    return(A);
+}
+
+internal inline v4 &
+operator*=(v4 &A, f32 B)
+{
+    A.Values = SimdMul(A.Values, SimdSet1(B));
+    
+    return(A);
+}
+
+internal inline v2 &
+operator/=(v2 &A, f32 B)
+{
+    A.X /= B;
+    A.Y /= B;
+    
+    return(A);
+}
+
+internal inline v3 &
+operator/=(v3 &A, f32 B)
+{
+    A.X /= B;
+    A.Y /= B;
+    A.Z /= B;
+    
+    return(A);
+}
+
+internal inline v4 &
+operator/=(v4 &A, f32 B)
+{
+    A.Values = SimdDiv(A.Values, SimdSet1(B));
+    
+    return(A);
+}
+
+internal inline m4
+operator*(m4 A, m4 B)
+{
+    // NOTE: Row I of the result is the rows of B weighted by the elements of row I of A. With AVX two rows go at once,
+    // the sums run in the same order either way so both give the same bits
+    m4 Result;
+#if MathWideAVX2
+    __m256 B0 = _mm256_broadcast_ps(&B.Rows[0]);
+    __m256 B1 = _mm256_broadcast_ps(&B.Rows[1]);
+    __m256 B2 = _mm256_broadcast_ps(&B.Rows[2]);
+    __m256 B3 = _mm256_broadcast_ps(&B.Rows[3]);
+    
+    for(u32 RowIndex = 0;
+        RowIndex < 4;
+        RowIndex += 2)
+    {
+        __m256 Rows = _mm256_setr_m128(A.Rows[RowIndex], A.Rows[RowIndex + 1]);
+        
+        __m256 YMM0 = _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(0, 0, 0, 0)), B0);
+        YMM0 = _mm256_add_ps(YMM0, _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(1, 1, 1, 1)), B1));
+        YMM0 = _mm256_add_ps(YMM0, _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(2, 2, 2, 2)), B2));
+        YMM0 = _mm256_add_ps(YMM0, _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, _MM_SHUFFLE(3, 3, 3, 3)), B3));
+        
+        Result.Rows[RowIndex] = _mm256_castps256_ps128(YMM0);
+        Result.Rows[RowIndex + 1] = _mm256_extractf128_ps(YMM0, 1);
+    }
+#else
+    for(u32 RowIndex = 0;
+        RowIndex < 4;
+        RowIndex++)
+    {
+        simd128 Row = A.Rows[RowIndex];
+        
+        simd128 XMM0 = SimdMul(SimdSplat(Row, 0), B.Rows[0]);
+        XMM0 = SimdAdd(XMM0, SimdMul(SimdSplat(Row, 1), B.Rows[1]));
+        XMM0 = SimdAdd(XMM0, SimdMul(SimdSplat(Row, 2), B.Rows[2]));
+        XMM0 = SimdAdd(XMM0, SimdMul(SimdSplat(Row, 3), B.Rows[3]));
+        
+        Result.Rows[RowIndex] = XMM0;
+    }
+#endif
+    return(Result);
+}
+
+internal inline v4
+operator*(m4 A, v4 B)
+{
+    // NOTE: The columns of A weighted by the elements of B
+    SimdTranspose(A.Rows);
+    
+    simd128 XMM0 = SimdMul(SimdSplat(B.Values, 0), A.Rows[0]);
+    XMM0 = SimdAdd(XMM0, SimdMul(SimdSplat(B.Values, 1), A.Rows[1]));
+    XMM0 = SimdAdd(XMM0, SimdMul(SimdSplat(B.Values, 2), A.Rows[2]));
+    XMM0 = SimdAdd(XMM0, SimdMul(SimdSplat(B.Values, 3), A.Rows[3]));
+    
+    v4 Result;
+    Result.Values = XMM0;
+    return(Result);
+}
+
+internal inline m2
+operator*(m2 A, m2 B)
+{
+    m2 Result;
+    
+    Result.M00 = A.M00 * B.M00 + A.M01 * B.M10;
+    Result.M01 = A.M00 * B.M01 + A.M01 * B.M11;
+    Result.M10 = A.M10 * B.M00 + A.M11 * B.M10;
+    Result.M11 = A.M10 * B.M01 + A.M11 * B.M11;
+    
+    return(Result);
+}
+
+internal inline v2
+operator*(m2 A, v2 B)
+{
+    v2 Result;
+    
+    Result.X = A.M00 * B.X + A.M01 * B.Y;
+    Result.Y = A.M10 * B.X + A.M11 * B.Y;
+    
+    return(Result);
+}
+
+internal inline m4
+Transpose(m4 A)
+{
+    m4 Result = A;
+    SimdTranspose(Result.Rows);
+    return(Result);
+}
+
+internal inline m2
+Transpose(m2 A)
+{
+    m2 Result;
+    
+    Result.M00 = Result.M00;
+    Result.M01 = Result.M10;
+    Result.M10 = Result.M01;
+    Result.M11 = Result.M11;
+    
+    return(Result);
+}
+
+internal inline m2
+Inverse(m2 A)
+{
+    m2 Result;
+    
+    f32 Determinant = A.M00 * A.M11 - A.M01 * A.M10;
+    f32 InverseDeterminant = 1.0f / Determinant;
+    
+    Result.M00 = A.M11 * InverseDeterminant;
+    Result.M01 = -A.M01 * InverseDeterminant;
+    Result.M10 = -A.M10 * InverseDeterminant;
+    Result.M11 = A.M00 * InverseDeterminant;
+    
+    return(Result);
+}
+
+//
+// NOTE: The 4x4 inverse works on the four 2x2 blocks of the matrix, each packed row major into one register.
+// https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+//
+
+// NOTE: A * B
+internal inline simd128
+M4BlockMultiply(simd128 A, simd128 B)
+{
+    simd128 Result = SimdAdd(SimdMul(A, SimdShuffle(B, B, 0, 3, 0, 3)),
+                               SimdMul(SimdShuffle(A, A, 1, 0, 3, 2), SimdShuffle(B, B, 2, 1, 2, 1)));
+    return(Result);
+}
+
+// NOTE: Adjugate(A) * B
+internal inline simd128
+M4BlockAdjugateMultiply(simd128 A, simd128 B)
+{
+    simd128 Result = SimdSub(SimdMul(SimdShuffle(A, A, 3, 3, 0, 0), B),
+                               SimdMul(SimdShuffle(A, A, 1, 1, 2, 2), SimdShuffle(B, B, 2, 3, 0, 1)));
+    return(Result);
+}
+
+// NOTE: A * Adjugate(B)
+internal inline simd128
+M4BlockMultiplyAdjugate(simd128 A, simd128 B)
+{
+    simd128 Result = SimdSub(SimdMul(A, SimdShuffle(B, B, 3, 0, 3, 0)),
+                               SimdMul(SimdShuffle(A, A, 1, 0, 3, 2), SimdShuffle(B, B, 2, 1, 2, 1)));
+    return(Result);
+}
+
+internal inline m4
+Inverse(m4 A)
+{
+    // NOTE: With the blocks | X Y | the inverse is 1 / |A| times the adjugates of
+    //                       | Z W |
+    // |W| X - Y (W# Z), |Y| Z - W (X# Y)#, |Z| Y - X (W# Z)# and |X| W - Z (X# Y), put back in place by the last shuffles
+    simd128 X = SimdShuffle(A.Rows[0], A.Rows[1], 0, 1, 0, 1);
+    simd128 Y = SimdShuffle(A.Rows[0], A.Rows[1], 2, 3, 2, 3);
+    simd128 Z = SimdShuffle(A.Rows[2], A.Rows[3], 0, 1, 0, 1);
+    simd128 W = SimdShuffle(A.Rows[2], A.Rows[3], 2, 3, 2, 3);
+    
+    // NOTE: The determinants of the blocks, as |X| |Y| |Z| |W|
+    simd128 Determinants = SimdSub(SimdMul(SimdShuffle(A.Rows[0], A.Rows[2], 0, 2, 0, 2), SimdShuffle(A.Rows[1], A.Rows[3], 1, 3, 1, 3)),
+                                     SimdMul(SimdShuffle(A.Rows[0], A.Rows[2], 1, 3, 1, 3), SimdShuffle(A.Rows[1], A.Rows[3], 0, 2, 0, 2)));
+    simd128 DeterminantX = SimdSplat(Determinants, 0);
+    simd128 DeterminantY = SimdSplat(Determinants, 1);
+    simd128 DeterminantZ = SimdSplat(Determinants, 2);
+    simd128 DeterminantW = SimdSplat(Determinants, 3);
+    
+    simd128 WZ = M4BlockAdjugateMultiply(W, Z);
+    simd128 XY = M4BlockAdjugateMultiply(X, Y);
+    
+    simd128 ResultX = SimdSub(SimdMul(DeterminantW, X), M4BlockMultiply(Y, WZ));
+    simd128 ResultW = SimdSub(SimdMul(DeterminantX, W), M4BlockMultiply(Z, XY));
+    simd128 ResultY = SimdSub(SimdMul(DeterminantY, Z), M4BlockMultiplyAdjugate(W, XY));
+    simd128 ResultZ = SimdSub(SimdMul(DeterminantZ, Y), M4BlockMultiplyAdjugate(X, WZ));
+    
+    // NOTE: |A| = |X| |W| + |Y| |Z| - Trace((X# Y) (W# Z))
+    simd128 Trace = SimdMul(XY, SimdShuffle(WZ, WZ, 0, 2, 1, 3));
+    Trace = SimdAdd(Trace, SimdShuffle(Trace, Trace, 1, 0, 3, 2));
+    Trace = SimdAdd(Trace, SimdShuffle(Trace, Trace, 2, 3, 0, 1));
+    
+    simd128 Determinant = SimdSub(SimdAdd(SimdMul(DeterminantX, DeterminantW), SimdMul(DeterminantY, DeterminantZ)), Trace);
+    
+    // NOTE: The signs of the adjugate come in with the reciprocal
+    simd128 InverseDeterminant = SimdDiv(SimdSetr(1.0f, -1.0f, -1.0f, 1.0f), Determinant);
+    ResultX = SimdMul(ResultX, InverseDeterminant);
+    ResultY = SimdMul(ResultY, InverseDeterminant);
+    ResultZ = SimdMul(ResultZ, InverseDeterminant);
+    ResultW = SimdMul(ResultW, InverseDeterminant);
+    
+    m4 Result;
+    Result.Rows[0] = SimdShuffle(ResultX, ResultY, 3, 1, 3, 1);
+    Result.Rows[1] = SimdShuffle(ResultX, ResultY, 2, 0, 2, 0);
+    Result.Rows[2] = SimdShuffle(ResultZ, ResultW, 3, 1, 3, 1);
+    Result.Rows[3] = SimdShuffle(ResultZ, ResultW, 2, 0, 2, 0);
+    return(Result);
+}
+
+internal inline v3
+M4Transform(m4 Matrix, v3 Point)
+{
+    // NOTE: The point goes in with W = 1 and comes out times 1 / W, same as M4TransformPoints does per lane
+    SimdTranspose(Matrix.Rows);
+    
+    simd128 XMM0 = SimdMul(SimdSet1(Point.X), Matrix.Rows[0]);
+    XMM0 = SimdAdd(XMM0, SimdMul(SimdSet1(Point.Y), Matrix.Rows[1]));
+    XMM0 = SimdAdd(XMM0, SimdMul(SimdSet1(Point.Z), Matrix.Rows[2]));
+    XMM0 = SimdAdd(XMM0, Matrix.Rows[3]);
+    XMM0 = SimdMul(XMM0, SimdDiv(SimdSet1(1.0f), SimdSplat(XMM0, 3)));
+    
+    v4 Transformed;
+    Transformed.Values = XMM0;
+    
+    v3 Result = V3(Transformed.X, Transformed.Y, Transformed.Z);
+    return(Result);
+}
+
+internal void
+M4TransformPointsBaseline(m4 Matrix, v3 *Points, u32 Count)
+{
+    // NOTE: 8 points at a time with X, Y and Z each in their own register, and every element of the matrix in a
+    // register of its own. The sums run in the same order as in M4Transform, so both give the same bits
+    f32 *Elements = &Matrix.M00;
+    
+    f32x8 M[16];
+    for(u32 Index = 0;
+        Index < 16;
+        Index++)
+    {
+        M[Index] = F32x8(Elements[Index]);
+    }
+    
+    for(u32 Index = 0;
+        Index < Count;
+        Index += 8)
+    {
+        v3 *First = Points + Index;
+        u32 LanesCount = (u32)Min(Count - Index, 8);
+        
+        v3x8 Point;
+        if(LanesCount == 8)
+        {
+            Point = V3x8Load(First);
+        }
+        else
+        {
+            Point.X = F32x8GatherStrided(&First->X, SizeOf(v3), LanesCount);
+            Point.Y = F32x8GatherStrided(&First->Y, SizeOf(v3), LanesCount);
+            Point.Z = F32x8GatherStrided(&First->Z, SizeOf(v3), LanesCount);
+        }
+        
+        f32x8 W = Point.X * M[12] + Point.Y * M[13] + Point.Z * M[14] + M[15];
+        f32x8 InverseW = F32x8(1.0f) / W;
+        
+        v3x8 Transformed;
+        Transformed.X = (Point.X * M[0] + Point.Y * M[1] + Point.Z * M[2] + M[3]) * InverseW;
+        Transformed.Y = (Point.X * M[4] + Point.Y * M[5] + Point.Z * M[6] + M[7]) * InverseW;
+        Transformed.Z = (Point.X * M[8] + Point.Y * M[9] + Point.Z * M[10] + M[11]) * InverseW;
+        
+        if(LanesCount == 8)
+        {
+            V3x8Store(First, Transformed);
+        }
+        else
+        {
+            F32x8ScatterStrided(&First->X, SizeOf(v3), LanesCount, Transformed.X);
+            F32x8ScatterStrided(&First->Y, SizeOf(v3), LanesCount, Transformed.Y);
+            F32x8ScatterStrided(&First->Z, SizeOf(v3), LanesCount, Transformed.Z);
+        }
+    }
+}
+
+internal inline m2
+EigenVectors(m2 A, v2 *B)
+{
+    m2 Result = {};
+    
+    f32 Trace = A.M00 + A.M11;
+    f32 Determinant = A.M00 * A.M11 - A.M01 * A.M10;
+    
+    f32 D = Sqrt(Trace * Trace - 4.0f * Determinant);
+    
+    f32 Lambda1 = 0.5f * (Trace + D);
+    f32 Lambda2 = 0.5f * (Trace - D);
+    
+    if(B)
+    {
+        *B = V2(Lambda1, Lambda2);
+    }
+    
+    m2 Matrix1 = M2(A.M00 - Lambda1, A.M01, A.M10, A.M11 - Lambda1);
+    m2 Matrix2 = M2(A.M00 - Lambda2, A.M01, A.M10, A.M11 - Lambda2);
+    
+    if(Abs(Matrix1.M00) > 0.0001f || Abs(Matrix1.M01) > 0.0001f)
+    {
+        if(Abs(Matrix1.M00) < 0.0001f)
+        {
+            Result.M00 = 1.0f;
+            Result.M10 = 0.0f;
+        }
+        else if(Abs(Matrix1.M01) < 0.0001f)
+        {
+            Result.M00 = 0.0f;
+            Result.M10 = 1.0f;
+        }
+        else
+        {
+            Result.M00 = Matrix1.M01;
+            Result.M10 = -Matrix1.M00;
+        }
+    }
+    else if(Abs(Matrix1.M10) > 0.0001f || Abs(Matrix1.M11) > 0.0001f)
+    {
+        if(Abs(Matrix1.M10) < 0.0001f)
+        {
+            Result.M00 = 1.0f;
+            Result.M10 = 0.0f;
+        }
+        else if(Abs(Matrix1.M11) < 0.0001f)
+        {
+            Result.M00 = 0.0f;
+            Result.M10 = 1.0f;
+        }
+        else
+        {
+            Result.M00 = Matrix1.M11;
+            Result.M10 = -Matrix1.M10;
+        }
+    }
+    
+    if(Abs(Matrix2.M00) > 0.0001f || Abs(Matrix2.M01) > 0.0001f)
+    {
+        if(Abs(Matrix2.M00) < 0.0001f)
+        {
+            Result.M01 = 1.0f;
+            Result.M11 = 0.0f;
+        }
+        else if(Abs(Matrix2.M01) < 0.0001f)
+        {
+            Result.M01 = 0.0f;
+            Result.M11 = 1.0f;
+        }
+        else
+        {
+            Result.M01 = Matrix2.M01;
+            Result.M11 = -Matrix2.M00;
+        }
+    }
+    else if(Abs(Matrix2.M10) > 0.0001f || Abs(Matrix2.M11) > 0.0001f)
+    {
+        if(Abs(Matrix2.M10) < 0.0001f)
+        {
+            Result.M01 = 1.0f;
+            Result.M11 = 0.0f;
+        }
+        else if(Abs(Matrix2.M11) < 0.0001f)
+        {
+            Result.M01 = 0.0f;
+            Result.M11 = 1.0f;
+        }
+        else
+        {
+            Result.M01 = Matrix2.M11;
+            Result.M11 = -Matrix2.M10;
+        }
+    }
+    
+    return(Result);
+}
+
+internal inline m2
+M2Identity()
+{
+    m2 Result = M2(
+        1.0f, 0.0f,
+        0.0f, 1.0f
+    );
+    return(Result);
+}
+
+internal inline m2
+operator-(m2 A, m2 B)
+{
+    m2 Result;
+    
+    Result.M00 = A.M00 - B.M00;
+    Result.M01 = A.M01 - B.M01;
+    Result.M10 = A.M10 - B.M10;
+    Result.M11 = A.M11 - B.M11;
+    
+    return(Result);
+}
+
+internal inline m2
+operator+(m2 A, m2 B)
+{
+    m2 Result;
+    
+    Result.M00 = A.M00 + B.M00;
+    Result.M01 = A.M01 + B.M01;
+    Result.M10 = A.M10 + B.M10;
+    Result.M11 = A.M11 + B.M11;
+    
+    return(Result);
+}
+
+internal inline m2
+operator-(m2 A)
+{
+    m2 Result;
+    
+    Result.M00 = -A.M00;
+    Result.M01 = -A.M01;
+    Result.M10 = -A.M10;
+    Result.M11 = -A.M11;
+    
+    return(Result);
+}
+
+internal inline f32
+Distance(v2 A, v2 B)
+{
+    f32 Result = Sqrt(DistanceSquare(A, B));
+    return(Result);
+}
+
+internal inline f32
+Distance(v3 A, v3 B)
+{
+    f32 Result = Sqrt(DistanceSquare(A, B));
+    return(Result);
+}
+
+internal inline f32
+Distance(v4 A, v4 B)
+{
+    f32 Result = Sqrt(DistanceSquare(A, B));
+    return(Result);
+}
+
+internal inline f32
+Length(v2 A)
+{
+    f32 Result = Sqrt(LengthSquare(A));
+    return(Result);
+}
+
+internal inline f32
+Length(v3 A)
+{
+    f32 Result = Sqrt(LengthSquare(A));
+    return(Result);
+}
+
+internal inline f32
+Length(v4 A)
+{
+    f32 Result = Sqrt(LengthSquare(A));
+    return(Result);
+}
+
+internal inline v2
+Normalize(v2 A)
+{
+    v2 Result = A;
+    
+    f32 ALength = Length(A);
+    if(ALength > Epsilon)
+    {
+        Result /= ALength;
+    }
+    
+    return(Result);
+}
+
+internal inline v3
+Normalize(v3 A)
+{
+    v3 Result = A;
+    
+    f32 ALength = Length(A);
+    if(ALength > Epsilon)
+    {
+        Result /= ALength;
+    }
+    
+    return(Result);
+}
+
+internal inline v4
+Normalize(v4 A)
+{
+    v4 Result = A;
+    
+    f32 ALength = Length(A);
+    if(ALength > Epsilon)
+    {
+        Result /= ALength;
+    }
+    
+    return(Result);
+}
+
+internal inline f32
+LengthFast(v2 A)
+{
+    f32 Result = 0.0f;
+    
+    f32 ALengthSquare = LengthSquare(A);
+    if(ALengthSquare > Epsilon * Epsilon)
+    {
+        Result = ALengthSquare * InverseSqrtFast(ALengthSquare);
+    }
+    
+    return(Result);
+}
+
+internal inline f32
+LengthFast(v3 A)
+{
+    f32 Result = 0.0f;
+    
+    f32 ALengthSquare = LengthSquare(A);
+    if(ALengthSquare > Epsilon * Epsilon)
+    {
+        Result = ALengthSquare * InverseSqrtFast(ALengthSquare);
+    }
+    
+    return(Result);
+}
+
+internal inline f32
+LengthFast(v4 A)
+{
+    f32 Result = 0.0f;
+    
+    f32 ALengthSquare = LengthSquare(A);
+    if(ALengthSquare > Epsilon * Epsilon)
+    {
+        Result = ALengthSquare * InverseSqrtFast(ALengthSquare);
+    }
+    
+    return(Result);
+}
+
+internal inline v2
+NormalizeFast(v2 A)
+{
+    v2 Result = A;
+    
+    f32 ALengthSquare = LengthSquare(A);
+    if(ALengthSquare > Epsilon * Epsilon)
+    {
+        Result = A * InverseSqrtFast(ALengthSquare);
+    }
+    
+    return(Result);
+}
+
+internal inline v3
+NormalizeFast(v3 A)
+{
+    v3 Result = A;
+    
+    f32 ALengthSquare = LengthSquare(A);
+    if(ALengthSquare > Epsilon * Epsilon)
+    {
+        Result = A * InverseSqrtFast(ALengthSquare);
+    }
+    
+    return(Result);
+}
+
+internal inline v4
+NormalizeFast(v4 A)
+{
+    v4 Result = A;
+    
+    f32 ALengthSquare = LengthSquare(A);
+    if(ALengthSquare > Epsilon * Epsilon)
+    {
+        Result = A * InverseSqrtFast(ALengthSquare);
+    }
+    
+    return(Result);
+}
+
+internal inline f32
+DistanceSquare(v2 A, v2 B)
+{
+    f32 Result = LengthSquare(A - B);
+    return(Result);
+}
+
+internal inline f32
+DistanceSquare(v3 A, v3 B)
+{
+    f32 Result = LengthSquare(A - B);
+    return(Result);
+}
+
+internal inline f32
+DistanceSquare(v4 A, v4 B)
+{
+    f32 Result = LengthSquare(A - B);
+    return(Result);
+}
+
+internal inline f32
+LengthSquare(v2 A)
+{
+    f32 Result = A.X * A.X + A.Y * A.Y;
+    return(Result);
+}
+
+internal inline f32
+LengthSquare(v3 A)
+{
+    f32 Result = A.X * A.X + A.Y * A.Y + A.Z * A.Z;
+    return(Result);
+}
+
+internal inline f32
+LengthSquare(v4 A)
+{
+    f32 Result = A.X * A.X + A.Y * A.Y + A.Z * A.Z + A.W * A.W;
+    return(Result);
+}
+
+internal inline f32
+Lerp(f32 A, f32 B, f32 T)
+{
+    f32 Result = A + (B - A) * T;
+    return(Result);
+}
+
+internal inline v2
+Lerp(v2 A, v2 B, f32 T)
+{
+    v2 Result = A + (B - A) * T;
+    return(Result);
+}
+
+internal inline v3
+Lerp(v3 A, v3 B, f32 T)
+{
+    v3 Result = A + (B - A) * T;
+    return(Result);
+}
+
+internal inline v4
+Lerp(v4 A, v4 B, f32 T)
+{
+    v4 Result = A + (B - A) * T;
+    return(Result);
+}
+
+internal inline f32
+Dot(v2 A, v2 B)
+{
+    f32 Result = A.X * B.X + A.Y * B.Y;
+    return(Result);
+}
+
+internal inline f32
+Dot(v3 A, v3 B)
+{
+    f32 Result = A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+    return(Result);
+}
+
+internal inline f32
+Dot(v4 A, v4 B)
+{
+    f32 Result = A.X * B.X + A.Y * B.Y + A.Z * B.Z + A.W * B.W;
+    return(Result);
+}
+
+internal inline v2
+Hadamard(v2 A, v2 B)
+{
+    v2 Result;
+    Result.X = A.X * B.X;
+    Result.Y = A.Y * B.Y;
+    return(Result);
+}
+
+internal inline v3
+Hadamard(v3 A, v3 B)
+{
+    v3 Result;
+    Result.X = A.X * B.X;
+    Result.Y = A.Y * B.Y;
+    Result.Z = A.Z * B.Z;
+    return(Result);
+}
+
+internal inline v4
+Hadamard(v4 A, v4 B)
+{
+    v4 Result;
+    Result.Values = SimdMul(A.Values, B.Values);
+    return(Result);
+}
+
+internal inline v3
+Cross(v3 A, v3 B)
+{
+    v3 Result;
+    Result.X = A.Y * B.Z - A.Z * B.Y;
+    Result.Y = A.Z * B.X - A.X * B.Z;
+    Result.Z = A.X * B.Y - A.Y * B.X;
+    return(Result);
+}
+
+internal inline f32
+Determinant(v2 A, v2 B)
+{
+    f32 Result =  A.X * B.Y - A.Y * B.X;
+    return(Result);
+}
+
+internal inline v2
+V2Rotate(v2 V, f32 Angle)
+{
+    f32 S = Sin(Angle * D2R);
+    f32 C = Cos(Angle * D2R);
+    
+    v2 Result = V2(V.X * C - V.Y * S, V.X * S + V.Y * C);
+    return(Result);
+}
+
+internal inline f32x4
+F32x4(f32 Value)
+{
+    f32x4 Result;
+    Result.V = SimdSet1(Value);
+    return(Result);
+}
+
+internal inline f32x4
+F32x4(f32 E0, f32 E1, f32 E2, f32 E3)
+{
+    f32x4 Result;
+    Result.V = SimdSetr(E0, E1, E2, E3);
+    return(Result);
+}
+
+internal inline f32x4
+F32x4Load(f32 *Source)
+{
+    f32x4 Result;
+    Result.V = SimdLoad(Source);
+    return(Result);
+}
+
+internal inline void
+F32x4Store(f32 *Destination, f32x4 Value)
+{
+    SimdStore(Destination, Value.V);
+}
+
+internal inline f32x4
+F32x4GatherStrided(void *First, umm Stride, u32 Count)
+{
+    Assert(Count <= 4);
+    
+    u8 *At = (u8 *)First;
+    
+    f32x4 Result;
+    if(Count == 4)
+    {
+        Result.V = SimdSetr(*(f32 *)At, *(f32 *)(At + Stride), *(f32 *)(At + 2 * Stride), *(f32 *)(At + 3 * Stride));
+    }
+    else
+    {
+        f32 Values[4] = {};
+        for(u32 Lane = 0;
+            Lane < Count;
+            Lane++)
+        {
+            Values[Lane] = *(f32 *)(At + Lane * Stride);
+        }
+        
+        Result.V = SimdLoad(Values);
+    }
+    
+    return(Result);
+}
+
+internal inline void
+F32x4ScatterStrided(void *First, umm Stride, u32 Count, f32x4 Value)
+{
+    Assert(Count <= 4);
+    
+    f32 Values[4];
+    SimdStore(Values, Value.V);
+    
+    u8 *At = (u8 *)First;
+    for(u32 Lane = 0;
+        Lane < Count;
+        Lane++)
+    {
+        *(f32 *)(At + Lane * Stride) = Values[Lane];
+    }
+}
+
+internal inline f32
+F32x4Lane(f32x4 Value, u32 Lane)
+{
+    Assert(Lane < 4);
+    
+    f32 Values[4];
+    SimdStore(Values, Value.V);
+    
+    f32 Result = Values[Lane];
+    return(Result);
+}
+
+internal inline b32x4
+B32x4GatherStrided(void *First, umm Stride, u32 Count)
+{
+    Assert(Count <= 4);
+    
+    // NOTE: Read as integers, loading the flags through floats would let the compiler assume they don't alias
+    u8 *At = (u8 *)First;
+    u32 Values[4] = {};
+    for(u32 Lane = 0;
+        Lane < Count;
+        Lane++)
+    {
+        Values[Lane] = *(u32 *)(At + Lane * Stride);
+    }
+    
+    b32x4 Result;
+    Result.V = SimdXor(SimdIntCmpEQ(SimdIntLoad(Values), SimdZero()), SimdIntSet1(-1));
+    return(Result);
+}
+
+internal inline b32x4
+B32x4LanesBelow(u32 Count)
+{
+    b32x4 Result;
+    Result.V = SimdCmpLT(SimdSetr(0.0f, 1.0f, 2.0f, 3.0f), SimdSet1((f32)Min(Count, 4)));
+    return(Result);
+}
+
+internal inline b32
+B32x4Any(b32x4 Mask)
+{
+    b32 Result = SimdMoveMask(Mask.V) != 0;
+    return(Result);
+}
+
+internal inline b32
+B32x4All(b32x4 Mask)
+{
+    b32 Result = SimdMoveMask(Mask.V) == 0xf;
+    return(Result);
+}
+
+internal inline u32
+B32x4Bits(b32x4 Mask)
+{
+    u32 Result = SimdMoveMask(Mask.V);
+    return(Result);
+}
+
+internal inline f32x4
+operator+(f32x4 A, f32x4 B)
+{
+    f32x4 Result;
+    Result.V = SimdAdd(A.V, B.V);
+    return(Result);
+}
+
+internal inline f32x4
+operator-(f32x4 A, f32x4 B)
+{
+    f32x4 Result;
+    Result.V = SimdSub(A.V, B.V);
+    return(Result);
+}
+
+internal inline f32x4
+operator*(f32x4 A, f32x4 B)
+{
+    f32x4 Result;
+    Result.V = SimdMul(A.V, B.V);
+    return(Result);
+}
+
+internal inline f32x4
+operator/(f32x4 A, f32x4 B)
+{
+    f32x4 Result;
+    Result.V = SimdDiv(A.V, B.V);
+    return(Result);
+}
+
+internal inline f32x4
+operator*(f32x4 A, f32 B)
+{
+    f32x4 Result = A * F32x4(B);
+    return(Result);
+}
+
+internal inline f32x4
+operator*(f32 A, f32x4 B)
+{
+    f32x4 Result = F32x4(A) * B;
+    return(Result);
+}
+
+internal inline f32x4
+operator/(f32x4 A, f32 B)
+{
+    f32x4 Result = A / F32x4(B);
+    return(Result);
+}
+
+internal inline f32x4
+operator-(f32x4 A)
+{
+    f32x4 Result;
+    Result.V = SimdXor(A.V, SimdSet1(-0.0f));
+    return(Result);
+}
+
+internal inline f32x4 &
+operator+=(f32x4 &A, f32x4 B)
+{
+    A = A + B;
+    return(A);
+}
+
+internal inline f32x4 &
+operator-=(f32x4 &A, f32x4 B)
+{
+    A = A - B;
+    return(A);
+}
+
+internal inline f32x4 &
+operator*=(f32x4 &A, f32x4 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline f32x4 &
+operator/=(f32x4 &A, f32x4 B)
+{
+    A = A / B;
+    return(A);
+}
+
+internal inline f32x4 &
+operator*=(f32x4 &A, f32 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline f32x4 &
+operator/=(f32x4 &A, f32 B)
+{
+    A = A / B;
+    return(A);
+}
+
+internal inline b32x4
+operator<(f32x4 A, f32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdCmpLT(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator<=(f32x4 A, f32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdCmpLE(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator>(f32x4 A, f32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdCmpGT(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator>=(f32x4 A, f32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdCmpGE(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator==(f32x4 A, f32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdCmpEQ(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator!=(f32x4 A, f32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdCmpNEQ(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator&(b32x4 A, b32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdAnd(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator|(b32x4 A, b32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdOr(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator^(b32x4 A, b32x4 B)
+{
+    b32x4 Result;
+    Result.V = SimdXor(A.V, B.V);
+    return(Result);
+}
+
+internal inline b32x4
+operator~(b32x4 A)
+{
+    b32x4 Result;
+    Result.V = SimdXor(A.V, SimdIntSet1(-1));
+    return(Result);
+}
+
+internal inline f32x4
+F32x4Min(f32x4 A, f32x4 B)
+{
+    f32x4 Result;
+    Result.V = SimdMin(A.V, B.V);
+    return(Result);
+}
+
+internal inline f32x4
+F32x4Max(f32x4 A, f32x4 B)
+{
+    f32x4 Result;
+    Result.V = SimdMax(A.V, B.V);
+    return(Result);
+}
+
+internal inline f32x4
+F32x4Abs(f32x4 A)
+{
+    f32x4 Result;
+    Result.V = SimdAndNot(SimdSet1(-0.0f), A.V);
+    return(Result);
+}
+
+internal inline f32x4
+Floor(f32x4 Value)
+{
+    f32x4 Result;
+    Result.V = SimdFloor(Value.V);
+    return(Result);
+}
+
+internal inline f32x4
+Sqrt(f32x4 Value)
+{
+    f32x4 Result;
+    Result.V = SimdSqrt(Value.V);
+    return(Result);
+}
+
+internal inline f32x4
+InverseSqrtFast(f32x4 Value)
+{
+    f32x4 Result;
+    Result.V = SimdInverseSqrtFast(Value.V);
+    return(Result);
+}
+
+internal inline f32x4
+Sin(f32x4 Value)
+{
+    f32x4 Result;
+    Result.V = SimdSin(Value.V);
+    return(Result);
+}
+
+internal inline f32x4
+Cos(f32x4 Value)
+{
+    f32x4 Result;
+    Result.V = SimdCos(Value.V);
+    return(Result);
+}
+
+internal inline f32x4
+Select(b32x4 Mask, f32x4 A, f32x4 B)
+{
+    f32x4 Result;
+    Result.V = SimdSelect(Mask.V, A.V, B.V);
+    return(Result);
+}
+
+internal inline f32x8
+F32x8(f32 Value)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_set1_ps(Value);
+#else
+    Result.Low = F32x4(Value);
+    Result.High = Result.Low;
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+F32x8(f32 E0, f32 E1, f32 E2, f32 E3, f32 E4, f32 E5, f32 E6, f32 E7)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_setr_ps(E0, E1, E2, E3, E4, E5, E6, E7);
+#else
+    Result.Low = F32x4(E0, E1, E2, E3);
+    Result.High = F32x4(E4, E5, E6, E7);
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+F32x8Load(f32 *Source)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_loadu_ps(Source);
+#else
+    Result.Low = F32x4Load(Source);
+    Result.High = F32x4Load(Source + 4);
+#endif
+    return(Result);
+}
+
+internal inline void
+F32x8Store(f32 *Destination, f32x8 Value)
+{
+#if MathWideAVX2
+    _mm256_storeu_ps(Destination, Value.V);
+#else
+    F32x4Store(Destination, Value.Low);
+    F32x4Store(Destination + 4, Value.High);
+#endif
+}
+
+internal inline f32x8
+F32x8GatherStrided(void *First, umm Stride, u32 Count)
+{
+    Assert(Count <= 8);
+    
+    f32x8 Result;
+#if MathWideAVX2
+    // NOTE: The hardware gather takes 32 bit offsets, lanes that are masked off aren't loaded and come back as zero
+    Assert(Stride * 8 <= MaxS32);
+    
+    __m256i Lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i Offsets = _mm256_mullo_epi32(Lanes, _mm256_set1_epi32((s32)Stride));
+    __m256 Mask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32((s32)Count), Lanes));
+    
+    Result.V = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), (f32 *)First, Offsets, Mask, 1);
+#else
+    Result.Low = F32x4GatherStrided(First, Stride, Min(Count, 4));
+    Result.High = F32x4GatherStrided((u8 *)First + 4 * Stride, Stride, Count > 4 ? Count - 4 : 0);
+#endif
+    return(Result);
+}
+
+internal inline void
+F32x8ScatterStrided(void *First, umm Stride, u32 Count, f32x8 Value)
+{
+    Assert(Count <= 8);
+    
+    f32 Values[8];
+    F32x8Store(Values, Value);
+    
+    u8 *At = (u8 *)First;
+    for(u32 Lane = 0;
+        Lane < Count;
+        Lane++)
+    {
+        *(f32 *)(At + Lane * Stride) = Values[Lane];
+    }
+}
+
+internal inline f32
+F32x8Lane(f32x8 Value, u32 Lane)
+{
+    Assert(Lane < 8);
+    
+    f32 Values[8];
+    F32x8Store(Values, Value);
+    
+    f32 Result = Values[Lane];
+    return(Result);
+}
+
+internal inline b32x8
+B32x8GatherStrided(void *First, umm Stride, u32 Count)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    __m256i Values = _mm256_castps_si256(F32x8GatherStrided(First, Stride, Count).V);
+    Result.V = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(Values, _mm256_setzero_si256()), _mm256_set1_epi32(-1)));
+#else
+    Result.Low = B32x4GatherStrided(First, Stride, Min(Count, 4));
+    Result.High = B32x4GatherStrided((u8 *)First + 4 * Stride, Stride, Count > 4 ? Count - 4 : 0);
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+B32x8LanesBelow(u32 Count)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32((s32)Min(Count, 8)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+#else
+    Result.Low = B32x4LanesBelow(Count);
+    Result.High = B32x4LanesBelow(Count > 4 ? Count - 4 : 0);
+#endif
+    return(Result);
+}
+
+internal inline b32
+B32x8Any(b32x8 Mask)
+{
+#if MathWideAVX2
+    b32 Result = _mm256_movemask_ps(Mask.V) != 0;
+#else
+    b32 Result = B32x4Any(Mask.Low) || B32x4Any(Mask.High);
+#endif
+    return(Result);
+}
+
+internal inline b32
+B32x8All(b32x8 Mask)
+{
+#if MathWideAVX2
+    b32 Result = _mm256_movemask_ps(Mask.V) == 0xff;
+#else
+    b32 Result = B32x4All(Mask.Low) && B32x4All(Mask.High);
+#endif
+    return(Result);
+}
+
+internal inline u32
+B32x8Bits(b32x8 Mask)
+{
+#if MathWideAVX2
+    u32 Result = (u32)_mm256_movemask_ps(Mask.V);
+#else
+    u32 Result = B32x4Bits(Mask.Low) | (B32x4Bits(Mask.High) << 4);
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+operator+(f32x8 A, f32x8 B)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_add_ps(A.V, B.V);
+#else
+    Result.Low = A.Low + B.Low;
+    Result.High = A.High + B.High;
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+operator-(f32x8 A, f32x8 B)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_sub_ps(A.V, B.V);
+#else
+    Result.Low = A.Low - B.Low;
+    Result.High = A.High - B.High;
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+operator*(f32x8 A, f32x8 B)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_mul_ps(A.V, B.V);
+#else
+    Result.Low = A.Low * B.Low;
+    Result.High = A.High * B.High;
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+operator/(f32x8 A, f32x8 B)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_div_ps(A.V, B.V);
+#else
+    Result.Low = A.Low / B.Low;
+    Result.High = A.High / B.High;
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+operator*(f32x8 A, f32 B)
+{
+    f32x8 Result = A * F32x8(B);
+    return(Result);
+}
+
+internal inline f32x8
+operator*(f32 A, f32x8 B)
+{
+    f32x8 Result = F32x8(A) * B;
+    return(Result);
+}
+
+internal inline f32x8
+operator/(f32x8 A, f32 B)
+{
+    f32x8 Result = A / F32x8(B);
+    return(Result);
+}
+
+internal inline f32x8
+operator-(f32x8 A)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_xor_ps(A.V, _mm256_set1_ps(-0.0f));
+#else
+    Result.Low = -A.Low;
+    Result.High = -A.High;
+#endif
+    return(Result);
+}
+
+internal inline f32x8 &
+operator+=(f32x8 &A, f32x8 B)
+{
+    A = A + B;
+    return(A);
+}
+
+internal inline f32x8 &
+operator-=(f32x8 &A, f32x8 B)
+{
+    A = A - B;
+    return(A);
+}
+
+internal inline f32x8 &
+operator*=(f32x8 &A, f32x8 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline f32x8 &
+operator/=(f32x8 &A, f32x8 B)
+{
+    A = A / B;
+    return(A);
+}
+
+internal inline f32x8 &
+operator*=(f32x8 &A, f32 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline f32x8 &
+operator/=(f32x8 &A, f32 B)
+{
+    A = A / B;
+    return(A);
+}
+
+internal inline b32x8
+operator<(f32x8 A, f32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_cmp_ps(A.V, B.V, _CMP_LT_OQ);
+#else
+    Result.Low = A.Low < B.Low;
+    Result.High = A.High < B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator<=(f32x8 A, f32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_cmp_ps(A.V, B.V, _CMP_LE_OQ);
+#else
+    Result.Low = A.Low <= B.Low;
+    Result.High = A.High <= B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator>(f32x8 A, f32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_cmp_ps(A.V, B.V, _CMP_GT_OQ);
+#else
+    Result.Low = A.Low > B.Low;
+    Result.High = A.High > B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator>=(f32x8 A, f32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_cmp_ps(A.V, B.V, _CMP_GE_OQ);
+#else
+    Result.Low = A.Low >= B.Low;
+    Result.High = A.High >= B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator==(f32x8 A, f32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_cmp_ps(A.V, B.V, _CMP_EQ_OQ);
+#else
+    Result.Low = A.Low == B.Low;
+    Result.High = A.High == B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator!=(f32x8 A, f32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_cmp_ps(A.V, B.V, _CMP_NEQ_UQ);
+#else
+    Result.Low = A.Low != B.Low;
+    Result.High = A.High != B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator&(b32x8 A, b32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_and_ps(A.V, B.V);
+#else
+    Result.Low = A.Low & B.Low;
+    Result.High = A.High & B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator|(b32x8 A, b32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_or_ps(A.V, B.V);
+#else
+    Result.Low = A.Low | B.Low;
+    Result.High = A.High | B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator^(b32x8 A, b32x8 B)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_xor_ps(A.V, B.V);
+#else
+    Result.Low = A.Low ^ B.Low;
+    Result.High = A.High ^ B.High;
+#endif
+    return(Result);
+}
+
+internal inline b32x8
+operator~(b32x8 A)
+{
+    b32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_xor_ps(A.V, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+#else
+    Result.Low = ~A.Low;
+    Result.High = ~A.High;
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+F32x8Min(f32x8 A, f32x8 B)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_min_ps(A.V, B.V);
+#else
+    Result.Low = F32x4Min(A.Low, B.Low);
+    Result.High = F32x4Min(A.High, B.High);
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+F32x8Max(f32x8 A, f32x8 B)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_max_ps(A.V, B.V);
+#else
+    Result.Low = F32x4Max(A.Low, B.Low);
+    Result.High = F32x4Max(A.High, B.High);
+#endif
+    return(Result);
+}
+
+internal inline f32x8
+F32x8Abs(f32x8 A)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), A.V);
+#else
+    Result.Low = F32x4Abs(A.Low);
+    Result.High = F32x4Abs(A.High);
+#endif
+    return(Result);
+}
 
-    f32 D = Sqrt(Trace * Trace - 4.0f * Determinant);
+internal inline f32x8
+Floor(f32x8 Value)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_floor_ps(Value.V);
+#else
+    Result.Low = Floor(Value.Low);
+    Result.High = Floor(Value.High);
+#endif
+    return(Result);
+}
 
-    f32 Lambda1 = 0.5f * (Trace + D);
-    f32 Lambda2 = 0.5f * (Trace - D);
+internal inline f32x8
+Sqrt(f32x8 Value)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_sqrt_ps(Value.V);
+#else
+    Result.Low = Sqrt(Value.Low);
+    Result.High = Sqrt(Value.High);
+#endif
+    return(Result);
+}
 
-    if(B)
-    {
-        *B = V2(Lambda1, Lambda2);
-    }
+internal inline f32x8
+InverseSqrtFast(f32x8 Value)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    // NOTE: Same as SimdInverseSqrtFast
+    __m256 Estimate = _mm256_rsqrt_ps(Value.V);
+    __m256 Correction = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), Value.V), Estimate), Estimate);
+    Result.V = _mm256_mul_ps(Estimate, _mm256_sub_ps(_mm256_set1_ps(1.5f), Correction));
+#else
+    Result.Low = InverseSqrtFast(Value.Low);
+    Result.High = InverseSqrtFast(Value.High);
+#endif
+    return(Result);
+}
 
-    m2 Matrix1 = M2(A.M00 - Lambda1, A.M01, A.M10, A.M11 - Lambda1);
-    m2 Matrix2 = M2(A.M00 - Lambda2, A.M01, A.M10, A.M11 - Lambda2);
+internal inline f32x8
+Sin(f32x8 Value)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = sin256_ps(Value.V);
+#else
+    Result.Low = Sin(Value.Low);
+    Result.High = Sin(Value.High);
+#endif
+    return(Result);
+}
 
-    if(Abs(Matrix1.M00) > 0.0001f || Abs(Matrix1.M01) > 0.0001f)
-    {
-        if(Abs(Matrix1.M00) < 0.0001f)
-        {
-            Result.M00 = 1.0f;
-            Result.M10 = 0.0f;
-        }
-        else if(Abs(Matrix1.M01) < 0.0001f)
-        {
-            Result.M00 = 0.0f;
-            Result.M10 = 1.0f;
-        }
-        else
-        {
-            Result.M00 = Matrix1.M01;
-            Result.M10 = -Matrix1.M00;
-        }
-    }
-    else if(Abs(Matrix1.M10) > 0.0001f || Abs(Matrix1.M11) > 0.0001f)
-    {
-        if(Abs(Matrix1.M10) < 0.0001f)
-        {
-            Result.M00 = 1.0f;
-            Result.M10 = 0.0f;
-        }
-        else if(Abs(Matrix1.M11) < 0.0001f)
-        {
-            Result.M00 = 0.0f;
-            Result.M10 = 1.0f;
-        }
-        else
-        {
-            Result.M00 = Matrix1.M11;
-            Result.M10 = -Matrix1.M10;
-        }
-    }
+internal inline f32x8
+Cos(f32x8 Value)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = cos256_ps(Value.V);
+#else
+    Result.Low = Cos(Value.Low);
+    Result.High = Cos(Value.High);
+#endif
+    return(Result);
+}
 
-    if(Abs(Matrix2.M00) > 0.0001f || Abs(Matrix2.M01) > 0.0001f)
-    {
-        if(Abs(Matrix2.M00) < 0.0001f)
-        {
-            Result.M01 = 1.0f;
-            Result.M11 = 0.0f;
-        }
-        else if(Abs(Matrix2.M01) < 0.0001f)
-        {
-            Result.M01 = 0.0f;
-            Result.M11 = 1.0f;
-        }
-        else
-        {
-            Result.M01 = Matrix2.M01;
-            Result.M11 = -Matrix2.M00;
-        }
-    }
-    else if(Abs(Matrix2.M10) > 0.0001f || Abs(Matrix2.M11) > 0.0001f)
-    {
-        if(Abs(Matrix2.M10) < 0.0001f)
-        {
-            Result.M01 = 1.0f;
-            Result.M11 = 0.0f;
-        }
-        else if(Abs(Matrix2.M11) < 0.0001f)
-        {
-            Result.M01 = 0.0f;
-            Result.M11 = 1.0f;
-        }
-        else
-        {
-            Result.M01 = Matrix2.M11;
-            Result.M11 = -Matrix2.M10;
-        }
-    }
+internal inline f32x8
+Select(b32x8 Mask, f32x8 A, f32x8 B)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = _mm256_blendv_ps(B.V, A.V, Mask.V);
+#else
+    Result.Low = Select(Mask.Low, A.Low, B.Low);
+    Result.High = Select(Mask.High, A.High, B.High);
+#endif
+    return(Result);
+}
+
+internal inline v2x4
+V2x4(v2 Value)
+{
+    v2x4 Result;
+    Result.X = F32x4(Value.X);
+    Result.Y = F32x4(Value.Y);
+    return(Result);
+}
+
+internal inline v2x4
+V2x4(f32x4 X, f32x4 Y)
+{
+    v2x4 Result;
+    Result.X = X;
+    Result.Y = Y;
+    return(Result);
+}
+
+internal inline v2x4
+V2x4GatherStrided(v2 *First, umm Stride, u32 Count)
+{
+    v2x4 Result;
+    Result.X = F32x4GatherStrided(&First->X, Stride, Count);
+    Result.Y = F32x4GatherStrided(&First->Y, Stride, Count);
+    return(Result);
+}
+
+internal inline void
+V2x4ScatterStrided(v2 *First, umm Stride, u32 Count, v2x4 Value)
+{
+    F32x4ScatterStrided(&First->X, Stride, Count, Value.X);
+    F32x4ScatterStrided(&First->Y, Stride, Count, Value.Y);
+}
+
+internal inline v2
+V2x4Lane(v2x4 Value, u32 Lane)
+{
+    v2 Result = V2(F32x4Lane(Value.X, Lane), F32x4Lane(Value.Y, Lane));
+    return(Result);
+}
+
+internal inline v2x4
+operator+(v2x4 A, v2x4 B)
+{
+    v2x4 Result;
+    Result.X = A.X + B.X;
+    Result.Y = A.Y + B.Y;
+    return(Result);
+}
+
+internal inline v2x4
+operator-(v2x4 A, v2x4 B)
+{
+    v2x4 Result;
+    Result.X = A.X - B.X;
+    Result.Y = A.Y - B.Y;
+    return(Result);
+}
+
+internal inline v2x4
+operator*(v2x4 A, f32x4 B)
+{
+    v2x4 Result;
+    Result.X = A.X * B;
+    Result.Y = A.Y * B;
+    return(Result);
+}
+
+internal inline v2x4
+operator*(f32x4 A, v2x4 B)
+{
+    v2x4 Result = B * A;
+    return(Result);
+}
+
+internal inline v2x4
+operator*(v2x4 A, f32 B)
+{
+    v2x4 Result;
+    Result.X = A.X * B;
+    Result.Y = A.Y * B;
+    return(Result);
+}
+
+internal inline v2x4
+operator/(v2x4 A, f32x4 B)
+{
+    v2x4 Result;
+    Result.X = A.X / B;
+    Result.Y = A.Y / B;
+    return(Result);
+}
+
+internal inline v2x4
+operator/(v2x4 A, f32 B)
+{
+    v2x4 Result;
+    Result.X = A.X / B;
+    Result.Y = A.Y / B;
+    return(Result);
+}
+
+internal inline v2x4
+operator-(v2x4 A)
+{
+    v2x4 Result;
+    Result.X = -A.X;
+    Result.Y = -A.Y;
+    return(Result);
+}
+
+internal inline v2x4 &
+operator+=(v2x4 &A, v2x4 B)
+{
+    A = A + B;
+    return(A);
+}
+
+internal inline v2x4 &
+operator-=(v2x4 &A, v2x4 B)
+{
+    A = A - B;
+    return(A);
+}
+
+internal inline v2x4 &
+operator*=(v2x4 &A, f32x4 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline v2x4 &
+operator*=(v2x4 &A, f32 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline v2x4 &
+operator/=(v2x4 &A, f32x4 B)
+{
+    A = A / B;
+    return(A);
+}
+
+internal inline f32x4
+Dot(v2x4 A, v2x4 B)
+{
+    f32x4 Result = A.X * B.X + A.Y * B.Y;
+    return(Result);
+}
+
+internal inline f32x4
+LengthSquare(v2x4 A)
+{
+    f32x4 Result = A.X * A.X + A.Y * A.Y;
+    return(Result);
+}
+
+internal inline f32x4
+Length(v2x4 A)
+{
+    f32x4 Result = Sqrt(LengthSquare(A));
+    return(Result);
+}
+
+internal inline f32x4
+DistanceSquare(v2x4 A, v2x4 B)
+{
+    f32x4 Result = LengthSquare(A - B);
+    return(Result);
+}
+
+internal inline f32x4
+Distance(v2x4 A, v2x4 B)
+{
+    f32x4 Result = Sqrt(DistanceSquare(A, B));
+    return(Result);
+}
+
+internal inline v2x4
+Normalize(v2x4 A)
+{
+    // NOTE: Divides like the scalar version does, so every lane comes out the same as Normalize(v2) would
+    f32x4 ALength = Length(A);
+    v2x4 Result = Select(ALength > F32x4(Epsilon), A / ALength, A);
+    return(Result);
+}
+
+internal inline f32x4
+LengthFast(v2x4 A)
+{
+    // NOTE: The lanes that would be NaN are thrown away by the select
+    f32x4 ALengthSquare = LengthSquare(A);
+    f32x4 Result = Select(ALengthSquare > F32x4(Epsilon * Epsilon), ALengthSquare * InverseSqrtFast(ALengthSquare), F32x4(0.0f));
+    return(Result);
+}
+
+internal inline v2x4
+NormalizeFast(v2x4 A)
+{
+    f32x4 ALengthSquare = LengthSquare(A);
+    v2x4 Result = Select(ALengthSquare > F32x4(Epsilon * Epsilon), A * InverseSqrtFast(ALengthSquare), A);
+    return(Result);
+}
+
+internal inline v2x4
+Hadamard(v2x4 A, v2x4 B)
+{
+    v2x4 Result;
+    Result.X = A.X * B.X;
+    Result.Y = A.Y * B.Y;
+    return(Result);
+}
+
+internal inline v2x4
+Lerp(v2x4 A, v2x4 B, f32x4 T)
+{
+    v2x4 Result = A + (B - A) * T;
+    return(Result);
+}
+
+internal inline v2x4
+Select(b32x4 Mask, v2x4 A, v2x4 B)
+{
+    v2x4 Result;
+    Result.X = Select(Mask, A.X, B.X);
+    Result.Y = Select(Mask, A.Y, B.Y);
+    return(Result);
+}
+
+internal inline v2x8
+V2x8(v2 Value)
+{
+    v2x8 Result;
+    Result.X = F32x8(Value.X);
+    Result.Y = F32x8(Value.Y);
+    return(Result);
+}
+
+internal inline v2x8
+V2x8(f32x8 X, f32x8 Y)
+{
+    v2x8 Result;
+    Result.X = X;
+    Result.Y = Y;
+    return(Result);
+}
 
+internal inline v2x8
+V2x8GatherStrided(v2 *First, umm Stride, u32 Count)
+{
+    v2x8 Result;
+    Result.X = F32x8GatherStrided(&First->X, Stride, Count);
+    Result.Y = F32x8GatherStrided(&First->Y, Stride, Count);
     return(Result);
 }
 
-internal inline m2
-M2Identity()
+internal inline void
+V2x8ScatterStrided(v2 *First, umm Stride, u32 Count, v2x8 Value)
 {
-    m2 Result = M2(
-        1.0f, 0.0f,
-        0.0f, 1.0f
-    );
+    F32x8ScatterStrided(&First->X, Stride, Count, Value.X);
+    F32x8ScatterStrided(&First->Y, Stride, Count, Value.Y);
+}
+
+internal inline v2
+V2x8Lane(v2x8 Value, u32 Lane)
+{
+    v2 Result = V2(F32x8Lane(Value.X, Lane), F32x8Lane(Value.Y, Lane));
     return(Result);
 }
 
-internal inline m2
-operator-(m2 A, m2 B)
+internal inline v2x8
+operator+(v2x8 A, v2x8 B)
 {
-    m2 Result;
+    v2x8 Result;
+    Result.X = A.X + B.X;
+    Result.Y = A.Y + B.Y;
+    return(Result);
+}
 
-    Result.M00 = A.M00 - B.M00;
-    Result.M01 = A.M01 - B.M01;
-    Result.M10 = A.M10 - B.M10;
-    Result.M11 = A.M11 - B.M11;
+internal inline v2x8
+operator-(v2x8 A, v2x8 B)
+{
+    v2x8 Result;
+    Result.X = A.X - B.X;
+    Result.Y = A.Y - B.Y;
+    return(Result);
+}
 
+internal inline v2x8
+operator*(v2x8 A, f32x8 B)
+{
+    v2x8 Result;
+    Result.X = A.X * B;
+    Result.Y = A.Y * B;
     return(Result);
 }
 
-internal inline m2
-operator+(m2 A, m2 B)
+internal inline v2x8
+operator*(f32x8 A, v2x8 B)
 {
-    m2 Result;
+    v2x8 Result = B * A;
+    return(Result);
+}
 
-    Result.M00 = A.M00 + B.M00;
-    Result.M01 = A.M01 + B.M01;
-    Result.M10 = A.M10 + B.M10;
-    Result.M11 = A.M11 + B.M11;
+internal inline v2x8
+operator*(v2x8 A, f32 B)
+{
+    v2x8 Result;
+    Result.X = A.X * B;
+    Result.Y = A.Y * B;
+    return(Result);
+}
+
+internal inline v2x8
+operator/(v2x8 A, f32x8 B)
+{
+    v2x8 Result;
+    Result.X = A.X / B;
+    Result.Y = A.Y / B;
+    return(Result);
+}
 
+internal inline v2x8
+operator/(v2x8 A, f32 B)
+{
+    v2x8 Result;
+    Result.X = A.X / B;
+    Result.Y = A.Y / B;
     return(Result);
 }
 
-internal inline m2
-operator-(m2 A)
+internal inline v2x8
+operator-(v2x8 A)
 {
-    m2 Result;
+    v2x8 Result;
+    Result.X = -A.X;
+    Result.Y = -A.Y;
+    return(Result);
+}
 
-    Result.M00 = -A.M00;
-    Result.M01 = -A.M01;
-    Result.M10 = -A.M10;
-    Result.M11 = -A.M11;
+internal inline v2x8 &
+operator+=(v2x8 &A, v2x8 B)
+{
+    A = A + B;
+    return(A);
+}
+
+internal inline v2x8 &
+operator-=(v2x8 &A, v2x8 B)
+{
+    A = A - B;
+    return(A);
+}
+
+internal inline v2x8 &
+operator*=(v2x8 &A, f32x8 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline v2x8 &
+operator*=(v2x8 &A, f32 B)
+{
+    A = A * B;
+    return(A);
+}
+
+internal inline v2x8 &
+operator/=(v2x8 &A, f32x8 B)
+{
+    A = A / B;
+    return(A);
+}
 
+internal inline f32x8
+Dot(v2x8 A, v2x8 B)
+{
+    f32x8 Result = A.X * B.X + A.Y * B.Y;
     return(Result);
 }
 
-internal inline f32
-Distance(v2 A, v2 B)
+internal inline f32x8
+LengthSquare(v2x8 A)
 {
-    f32 Result = Sqrt(DistanceSquare(A, B));
+    f32x8 Result = A.X * A.X + A.Y * A.Y;
     return(Result);
 }
 
-internal inline f32
-Distance(v3 A, v3 B)
+internal inline f32x8
+Length(v2x8 A)
 {
-    f32 Result = Sqrt(DistanceSquare(A, B));
+    f32x8 Result = Sqrt(LengthSquare(A));
     return(Result);
 }
 
-internal inline f32
-Distance(v4 A, v4 B)
+internal inline f32x8
+DistanceSquare(v2x8 A, v2x8 B)
 {
-    f32 Result = Sqrt(DistanceSquare(A, B));
+    f32x8 Result = LengthSquare(A - B);
     return(Result);
 }
 
-internal inline f32
-Length(v2 A)
+internal inline f32x8
+Distance(v2x8 A, v2x8 B)
 {
-    f32 Result = Sqrt(LengthSquare(A));
+    f32x8 Result = Sqrt(DistanceSquare(A, B));
     return(Result);
 }
 
-internal inline f32
-Length(v3 A)
+internal inline v2x8
+Normalize(v2x8 A)
 {
-    f32 Result = Sqrt(LengthSquare(A));
+    // NOTE: Divides like the scalar version does, so every lane comes out the same as Normalize(v2) would
+    f32x8 ALength = Length(A);
+    v2x8 Result = Select(ALength > F32x8(Epsilon), A / ALength, A);
     return(Result);
 }
 
-internal inline f32
-Length(v4 A)
+internal inline f32x8
+LengthFast(v2x8 A)
 {
-    f32 Result = Sqrt(LengthSquare(A));
+    // NOTE: The lanes that would be NaN are thrown away by the select
+    f32x8 ALengthSquare = LengthSquare(A);
+    f32x8 Result = Select(ALengthSquare > F32x8(Epsilon * Epsilon), ALengthSquare * InverseSqrtFast(ALengthSquare), F32x8(0.0f));
     return(Result);
 }
 
-internal inline v2
-Normalize(v2 A)
+internal inline v2x8
+NormalizeFast(v2x8 A)
 {
-    v2 Result = A;
+    f32x8 ALengthSquare = LengthSquare(A);
+    v2x8 Result = Select(ALengthSquare > F32x8(Epsilon * Epsilon), A * InverseSqrtFast(ALengthSquare), A);
+    return(Result);
+}
+
+internal inline v2x8
+Hadamard(v2x8 A, v2x8 B)
+{
+    v2x8 Result;
+    Result.X = A.X * B.X;
+    Result.Y = A.Y * B.Y;
+    return(Result);
+}
+
+internal inline v2x8
+Lerp(v2x8 A, v2x8 B, f32x8 T)
+{
+    v2x8 Result = A + (B - A) * T;
+    return(Result);
+}
+
+internal inline v2x8
+Select(b32x8 Mask, v2x8 A, v2x8 B)
+{
+    v2x8 Result;
+    Result.X = Select(Mask, A.X, B.X);
+    Result.Y = Select(Mask, A.Y, B.Y);
+    return(Result);
+}
+
+internal inline void
+SinCos(f32x4 Value, f32x4 *Sin, f32x4 *Cos)
+{
+    SimdSinCos(Value.V, &Sin->V, &Cos->V);
+}
+
+internal inline void
+SinCosFast(f32x4 Value, f32x4 *Sin, f32x4 *Cos)
+{
+    // NOTE: Reduces to |R| <= Pi/4 around the nearest multiple of Pi/2, which is split in three so the reduction stays exact
+    f32x4 Quadrant = Floor(Value * F32x4(2.0f / Pi) + F32x4(0.5f));
+    f32x4 R = Value - Quadrant * F32x4(1.5703125f);
+    R = R - Quadrant * F32x4(4.837512969970703125e-4f);
+    R = R - Quadrant * F32x4(7.54978995489e-8f);
     
-    f32 ALength = Length(A);
-    if(ALength > Epsilon)
-    {
-        Result /= ALength;
-    }
+    f32x4 R2 = R * R;
+    f32x4 S = R + R * R2 * (F32x4(-0.166628405f) + R2 * F32x4(0.00815311912f));
+    f32x4 C = F32x4(1.0f) + R2 * (F32x4(-0.499781191f) + R2 * F32x4(0.0404981822f));
     
+    // NOTE: The quadrant mod 4 picks the polynomial for each output and its sign
+    f32x4 Mod4 = Quadrant - Floor(Quadrant * F32x4(0.25f)) * F32x4(4.0f);
+    b32x4 Swap = (Mod4 == F32x4(1.0f)) | (Mod4 == F32x4(3.0f));
+    b32x4 NegateSin = Mod4 >= F32x4(2.0f);
+    b32x4 NegateCos = (Mod4 == F32x4(1.0f)) | (Mod4 == F32x4(2.0f));
+    
+    f32x4 SinResult = Select(Swap, C, S);
+    f32x4 CosResult = Select(Swap, S, C);
+    *Sin = Select(NegateSin, -SinResult, SinResult);
+    *Cos = Select(NegateCos, -CosResult, CosResult);
+}
+
+internal inline f32x4
+Atan2(f32x4 Y, f32x4 X)
+{
+    f32x4 Result;
+    Result.V = SimdAtan2(Y.V, X.V);
     return(Result);
 }
 
-internal inline v3
-Normalize(v3 A)
+internal inline f32x4
+Atan2Fast(f32x4 Y, f32x4 X)
 {
-    v3 Result = A;
-    
-    f32 ALength = Length(A);
-    if(ALength > Epsilon)
-    {
-        Result /= ALength;
-    }
+    // NOTE: Polynomial for atan on [0, 1] over the smaller of the two by the larger, then moved out to the right octant.
+    // Lanes where both are zero come out as zero
+    f32x4 AbsY = F32x4Abs(Y);
+    f32x4 AbsX = F32x4Abs(X);
+    f32x4 Largest = F32x4Max(AbsX, AbsY);
+    f32x4 A = F32x4Min(AbsX, AbsY) / Largest;
+    f32x4 S = A * A;
     
+    f32x4 Result = A + A * S * (F32x4(-0.331620634f) + S * (F32x4(0.184151232f) + S * (F32x4(-0.0899142548f) + S * F32x4(0.0227974411f))));
+    Result = Select(AbsY > AbsX, F32x4(HalfPi) - Result, Result);
+    Result = Select(X < F32x4(0.0f), F32x4(Pi) - Result, Result);
+    Result = Select(Y < F32x4(0.0f), -Result, Result);
+    Result = Select(Largest > F32x4(0.0f), Result, F32x4(0.0f));
     return(Result);
 }
 
-internal inline v4
-Normalize(v4 A)
+internal inline void
+SinCos(f32x8 Value, f32x8 *Sin, f32x8 *Cos)
 {
-    v4 Result = A;
+#if MathWideAVX2
+    sincos256_ps(Value.V, &Sin->V, &Cos->V);
+#else
+    SinCos(Value.Low, &Sin->Low, &Cos->Low);
+    SinCos(Value.High, &Sin->High, &Cos->High);
+#endif
+}
+
+internal inline void
+SinCosFast(f32x8 Value, f32x8 *Sin, f32x8 *Cos)
+{
+    // NOTE: Same as the f32x4 version
+    f32x8 Quadrant = Floor(Value * F32x8(2.0f / Pi) + F32x8(0.5f));
+    f32x8 R = Value - Quadrant * F32x8(1.5703125f);
+    R = R - Quadrant * F32x8(4.837512969970703125e-4f);
+    R = R - Quadrant * F32x8(7.54978995489e-8f);
     
-    f32 ALength = Length(A);
-    if(ALength > Epsilon)
-    {
-        Result /= ALength;
-    }
+    f32x8 R2 = R * R;
+    f32x8 S = R + R * R2 * (F32x8(-0.166628405f) + R2 * F32x8(0.00815311912f));
+    f32x8 C = F32x8(1.0f) + R2 * (F32x8(-0.499781191f) + R2 * F32x8(0.0404981822f));
     
+    f32x8 Mod4 = Quadrant - Floor(Quadrant * F32x8(0.25f)) * F32x8(4.0f);
+    b32x8 Swap = (Mod4 == F32x8(1.0f)) | (Mod4 == F32x8(3.0f));
+    b32x8 NegateSin = Mod4 >= F32x8(2.0f);
+    b32x8 NegateCos = (Mod4 == F32x8(1.0f)) | (Mod4 == F32x8(2.0f));
+    
+    f32x8 SinResult = Select(Swap, C, S);
+    f32x8 CosResult = Select(Swap, S, C);
+    *Sin = Select(NegateSin, -SinResult, SinResult);
+    *Cos = Select(NegateCos, -CosResult, CosResult);
+}
+
+internal inline f32x8
+Atan2(f32x8 Y, f32x8 X)
+{
+    f32x8 Result;
+#if MathWideAVX2
+    Result.V = atan2_256_ps(Y.V, X.V);
+#else
+    Result.Low = Atan2(Y.Low, X.Low);
+    Result.High = Atan2(Y.High, X.High);
+#endif
     return(Result);
 }
 
-internal inline f32
-DistanceSquare(v2 A, v2 B)
+internal inline f32x8
+Atan2Fast(f32x8 Y, f32x8 X)
 {
-    f32 Result = LengthSquare(A - B);
+    // NOTE: Same as the f32x4 version
+    f32x8 AbsY = F32x8Abs(Y);
+    f32x8 AbsX = F32x8Abs(X);
+    f32x8 Largest = F32x8Max(AbsX, AbsY);
+    f32x8 A = F32x8Min(AbsX, AbsY) / Largest;
+    f32x8 S = A * A;
+    
+    f32x8 Result = A + A * S * (F32x8(-0.331620634f) + S * (F32x8(0.184151232f) + S * (F32x8(-0.0899142548f) + S * F32x8(0.0227974411f))));
+    Result = Select(AbsY > AbsX, F32x8(HalfPi) - Result, Result);
+    Result = Select(X < F32x8(0.0f), F32x8(Pi) - Result, Result);
+    Result = Select(Y < F32x8(0.0f), -Result, Result);
+    Result = Select(Largest > F32x8(0.0f), Result, F32x8(0.0f));
     return(Result);
 }
 
-internal inline f32
-DistanceSquare(v3 A, v3 B)
+internal inline v2x4
+V2x4Load(v2 *Source)
 {
-    f32 Result = LengthSquare(A - B);
+    // NOTE: Deinterleaves X0 Y0 X1 Y1 ... into a register of X and a register of Y
+    simd128 A = SimdLoad(&Source[0].X);
+    simd128 B = SimdLoad(&Source[2].X);
+    
+    v2x4 Result;
+    Result.X.V = SimdShuffle(A, B, 0, 2, 0, 2);
+    Result.Y.V = SimdShuffle(A, B, 1, 3, 1, 3);
     return(Result);
 }
 
-internal inline f32
-DistanceSquare(v4 A, v4 B)
+internal inline void
+V2x4Store(v2 *Destination, v2x4 Value)
 {
-    f32 Result = LengthSquare(A - B);
+    SimdStore(&Destination[0].X, SimdUnpackLow(Value.X.V, Value.Y.V));
+    SimdStore(&Destination[2].X, SimdUnpackHigh(Value.X.V, Value.Y.V));
+}
+
+internal inline v2x8
+V2x8Load(v2 *Source)
+{
+    v2x8 Result;
+#if MathWideAVX2
+    __m256 A = _mm256_loadu_ps(&Source[0].X);
+    __m256 B = _mm256_loadu_ps(&Source[4].X);
+    
+    // NOTE: The shuffles stay inside 128 bit halves and leave the lanes in 0 1 4 5 2 3 6 7 order, the permute fixes that up
+    __m256 X = _mm256_shuffle_ps(A, B, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 Y = _mm256_shuffle_ps(A, B, _MM_SHUFFLE(3, 1, 3, 1));
+    Result.X.V = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(X), _MM_SHUFFLE(3, 1, 2, 0)));
+    Result.Y.V = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(Y), _MM_SHUFFLE(3, 1, 2, 0)));
+#else
+    v2x4 Low = V2x4Load(Source);
+    v2x4 High = V2x4Load(Source + 4);
+    Result.X.Low = Low.X;
+    Result.X.High = High.X;
+    Result.Y.Low = Low.Y;
+    Result.Y.High = High.Y;
+#endif
     return(Result);
 }
 
-internal inline f32
-LengthSquare(v2 A)
+internal inline void
+V2x8Store(v2 *Destination, v2x8 Value)
 {
-    f32 Result = A.X * A.X + A.Y * A.Y;
+#if MathWideAVX2
+    __m256 Low = _mm256_unpacklo_ps(Value.X.V, Value.Y.V);
+    __m256 High = _mm256_unpackhi_ps(Value.X.V, Value.Y.V);
+    _mm256_storeu_ps(&Destination[0].X, _mm256_permute2f128_ps(Low, High, 0x20));
+    _mm256_storeu_ps(&Destination[4].X, _mm256_permute2f128_ps(Low, High, 0x31));
+#else
+    V2x4Store(Destination, V2x4(Value.X.Low, Value.Y.Low));
+    V2x4Store(Destination + 4, V2x4(Value.X.High, Value.Y.High));
+#endif
+}
+
+// NOTE: Four v3 are three registers, X0 Y0 Z0 X1 | Y1 Z1 X2 Y2 | Z2 X3 Y3 Z3. The shuffles gather the X, Y and Z of
+// each and put them back the same way. With AVX the upper 128 bits do the same for the next four
+internal inline v3x4
+V3x4Load(v3 *Source)
+{
+    simd128 A = SimdLoad(&Source[0].X);
+    simd128 B = SimdLoad(&Source[0].X + 4);
+    simd128 C = SimdLoad(&Source[0].X + 8);
+    
+    simd128 B12C01 = SimdShuffle(B, C, 1, 2, 0, 1);
+    simd128 A11B00 = SimdShuffle(A, B, 1, 1, 0, 0);
+    simd128 B33C22 = SimdShuffle(B, C, 3, 3, 2, 2);
+    simd128 A22B11 = SimdShuffle(A, B, 2, 2, 1, 1);
+    
+    v3x4 Result;
+    Result.X.V = SimdShuffle(A, B12C01, 0, 3, 1, 3);
+    Result.Y.V = SimdShuffle(A11B00, B33C22, 0, 2, 0, 2);
+    Result.Z.V = SimdShuffle(A22B11, C, 0, 2, 0, 3);
     return(Result);
 }
 
-internal inline f32
-LengthSquare(v3 A)
+internal inline void
+V3x4Store(v3 *Destination, v3x4 Value)
 {
-    f32 Result = A.X * A.X + A.Y * A.Y + A.Z * A.Z;
+    simd128 X = Value.X.V;
+    simd128 Y = Value.Y.V;
+    simd128 Z = Value.Z.V;
+    
+    simd128 X0Y0X1Y1 = SimdUnpackLow(X, Y);
+    simd128 Z00X11 = SimdShuffle(Z, X, 0, 0, 1, 1);
+    simd128 Y11Z11 = SimdShuffle(Y, Z, 1, 1, 1, 1);
+    simd128 X22Y22 = SimdShuffle(X, Y, 2, 2, 2, 2);
+    simd128 Z22X33 = SimdShuffle(Z, X, 2, 2, 3, 3);
+    simd128 Y33Z33 = SimdShuffle(Y, Z, 3, 3, 3, 3);
+    
+    SimdStore(&Destination[0].X, SimdShuffle(X0Y0X1Y1, Z00X11, 0, 1, 0, 2));
+    SimdStore(&Destination[0].X + 4, SimdShuffle(Y11Z11, X22Y22, 0, 2, 0, 2));
+    SimdStore(&Destination[0].X + 8, SimdShuffle(Z22X33, Y33Z33, 0, 2, 0, 2));
+}
+
+internal inline v3x8
+V3x8Load(v3 *Source)
+{
+    v3x8 Result;
+#if MathWideAVX2
+    f32 *At = &Source[0].X;
+    __m256 A = _mm256_setr_m128(_mm_loadu_ps(At), _mm_loadu_ps(At + 12));
+    __m256 B = _mm256_setr_m128(_mm_loadu_ps(At + 4), _mm_loadu_ps(At + 16));
+    __m256 C = _mm256_setr_m128(_mm_loadu_ps(At + 8), _mm_loadu_ps(At + 20));
+    
+    __m256 B12C01 = _mm256_shuffle_ps(B, C, _MM_SHUFFLE(1, 0, 2, 1));
+    __m256 A11B00 = _mm256_shuffle_ps(A, B, _MM_SHUFFLE(0, 0, 1, 1));
+    __m256 B33C22 = _mm256_shuffle_ps(B, C, _MM_SHUFFLE(2, 2, 3, 3));
+    __m256 A22B11 = _mm256_shuffle_ps(A, B, _MM_SHUFFLE(1, 1, 2, 2));
+    
+    Result.X.V = _mm256_shuffle_ps(A, B12C01, _MM_SHUFFLE(3, 1, 3, 0));
+    Result.Y.V = _mm256_shuffle_ps(A11B00, B33C22, _MM_SHUFFLE(2, 0, 2, 0));
+    Result.Z.V = _mm256_shuffle_ps(A22B11, C, _MM_SHUFFLE(3, 0, 2, 0));
+#else
+    v3x4 Low = V3x4Load(Source);
+    v3x4 High = V3x4Load(Source + 4);
+    Result.X.Low = Low.X;
+    Result.X.High = High.X;
+    Result.Y.Low = Low.Y;
+    Result.Y.High = High.Y;
+    Result.Z.Low = Low.Z;
+    Result.Z.High = High.Z;
+#endif
     return(Result);
 }
 
-internal inline f32
-LengthSquare(v4 A)
+internal inline void
+V3x8Store(v3 *Destination, v3x8 Value)
+{
+#if MathWideAVX2
+    __m256 X = Value.X.V;
+    __m256 Y = Value.Y.V;
+    __m256 Z = Value.Z.V;
+    
+    __m256 X0Y0X1Y1 = _mm256_unpacklo_ps(X, Y);
+    __m256 Z00X11 = _mm256_shuffle_ps(Z, X, _MM_SHUFFLE(1, 1, 0, 0));
+    __m256 Y11Z11 = _mm256_shuffle_ps(Y, Z, _MM_SHUFFLE(1, 1, 1, 1));
+    __m256 X22Y22 = _mm256_shuffle_ps(X, Y, _MM_SHUFFLE(2, 2, 2, 2));
+    __m256 Z22X33 = _mm256_shuffle_ps(Z, X, _MM_SHUFFLE(3, 3, 2, 2));
+    __m256 Y33Z33 = _mm256_shuffle_ps(Y, Z, _MM_SHUFFLE(3, 3, 3, 3));
+    
+    __m256 A = _mm256_shuffle_ps(X0Y0X1Y1, Z00X11, _MM_SHUFFLE(2, 0, 1, 0));
+    __m256 B = _mm256_shuffle_ps(Y11Z11, X22Y22, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 C = _mm256_shuffle_ps(Z22X33, Y33Z33, _MM_SHUFFLE(2, 0, 2, 0));
+    
+    f32 *At = &Destination[0].X;
+    _mm_storeu_ps(At, _mm256_castps256_ps128(A));
+    _mm_storeu_ps(At + 4, _mm256_castps256_ps128(B));
+    _mm_storeu_ps(At + 8, _mm256_castps256_ps128(C));
+    _mm_storeu_ps(At + 12, _mm256_extractf128_ps(A, 1));
+    _mm_storeu_ps(At + 16, _mm256_extractf128_ps(B, 1));
+    _mm_storeu_ps(At + 20, _mm256_extractf128_ps(C, 1));
+#else
+    v3x4 Low = {Value.X.Low, Value.Y.Low, Value.Z.Low};
+    v3x4 High = {Value.X.High, Value.Y.High, Value.Z.High};
+    V3x4Store(Destination, Low);
+    V3x4Store(Destination + 4, High);
+#endif
+}
+
+internal void
+SinCosArrayBaseline(f32 *Angles, f32 *Sines, f32 *Cosines, u32 Count, enum32(math_accuracy) Accuracy)
+{
+    // NOTE: The tail goes through the same kernels with the lanes past Count zeroed, so an element comes out the same wherever it sits
+    for(u32 Index = 0;
+        Index < Count;
+        Index += 8)
+    {
+        u32 LanesCount = (u32)Min(Count - Index, 8);
+        
+        f32x8 Angle;
+        if(LanesCount == 8)
+        {
+            Angle = F32x8Load(Angles + Index);
+        }
+        else
+        {
+            Angle = F32x8GatherStrided(Angles + Index, SizeOf(f32), LanesCount);
+        }
+        
+        f32x8 Sin, Cos;
+        if(Accuracy == MathAccuracy_Fast)
+        {
+            SinCosFast(Angle, &Sin, &Cos);
+        }
+        else
+        {
+            SinCos(Angle, &Sin, &Cos);
+        }
+        
+        if(LanesCount == 8)
+        {
+            F32x8Store(Sines + Index, Sin);
+            F32x8Store(Cosines + Index, Cos);
+        }
+        else
+        {
+            F32x8ScatterStrided(Sines + Index, SizeOf(f32), LanesCount, Sin);
+            F32x8ScatterStrided(Cosines + Index, SizeOf(f32), LanesCount, Cos);
+        }
+    }
+}
+
+internal void
+Atan2ArrayBaseline(f32 *Ys, f32 *Xs, f32 *Angles, u32 Count, enum32(math_accuracy) Accuracy)
+{
+    for(u32 Index = 0;
+        Index < Count;
+        Index += 8)
+    {
+        u32 LanesCount = (u32)Min(Count - Index, 8);
+        
+        f32x8 Y, X;
+        if(LanesCount == 8)
+        {
+            Y = F32x8Load(Ys + Index);
+            X = F32x8Load(Xs + Index);
+        }
+        else
+        {
+            Y = F32x8GatherStrided(Ys + Index, SizeOf(f32), LanesCount);
+            X = F32x8GatherStrided(Xs + Index, SizeOf(f32), LanesCount);
+        }
+        
+        f32x8 Angle;
+        if(Accuracy == MathAccuracy_Fast)
+        {
+            Angle = Atan2Fast(Y, X);
+        }
+        else
+        {
+            Angle = Atan2(Y, X);
+        }
+        
+        if(LanesCount == 8)
+        {
+            F32x8Store(Angles + Index, Angle);
+        }
+        else
+        {
+            F32x8ScatterStrided(Angles + Index, SizeOf(f32), LanesCount, Angle);
+        }
+    }
+}
+
+internal void
+V2RotateArrayBaseline(v2 *Vectors, f32 *Angles, v2 *Results, u32 Count, enum32(math_accuracy) Accuracy)
 {
-    f32 Result = A.X * A.X + A.Y * A.Y + A.Z * A.Z + A.W * A.W;
-    return(Result);
+    // NOTE: Does the same operations as V2Rotate in the same order, so Precise matches it bit for bit
+    for(u32 Index = 0;
+        Index < Count;
+        Index += 8)
+    {
+        u32 LanesCount = (u32)Min(Count - Index, 8);
+        
+        v2x8 Vector;
+        f32x8 Angle;
+        if(LanesCount == 8)
+        {
+            Vector = V2x8Load(Vectors + Index);
+            Angle = F32x8Load(Angles + Index);
+        }
+        else
+        {
+            Vector = V2x8GatherStrided(Vectors + Index, SizeOf(v2), LanesCount);
+            Angle = F32x8GatherStrided(Angles + Index, SizeOf(f32), LanesCount);
+        }
+        
+        f32x8 S, C;
+        if(Accuracy == MathAccuracy_Fast)
+        {
+            SinCosFast(Angle * D2R, &S, &C);
+        }
+        else
+        {
+            SinCos(Angle * D2R, &S, &C);
+        }
+        
+        v2x8 Result = V2x8(Vector.X * C - Vector.Y * S, Vector.X * S + Vector.Y * C);
+        
+        if(LanesCount == 8)
+        {
+            V2x8Store(Results + Index, Result);
+        }
+        else
+        {
+            V2x8ScatterStrided(Results + Index, SizeOf(v2), LanesCount, Result);
+        }
+    }
 }
 
-internal inline f32
-Lerp(f32 A, f32 B, f32 T)
-{
-    f32 Result = A + (B - A) * T;
-    return(Result);
-}
+#if MathDispatchAVX2
+// NOTE: The AVX2 kernels do the full blocks of 8 in one register each and hand the rest to the baseline kernels. They
+// run the same operations in the same order as the f32x8 code, without FMA contraction, so which kernels the CPU ends
+// up on never changes a result and replays stay in sync across machines
 
-internal inline v2
-Lerp(v2 A, v2 B, f32 T)
+CpuTarget("avx2") internal inline void
+SinCosFastAVX2(__m256 Value, __m256 *Sin, __m256 *Cos)
 {
-    v2 Result = A + (B - A) * T;
+    // NOTE: Same as SinCosFast
+    __m256 Quadrant = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(Value, _mm256_set1_ps(2.0f / Pi)), _mm256_set1_ps(0.5f)));
+    __m256 R = _mm256_sub_ps(Value, _mm256_mul_ps(Quadrant, _mm256_set1_ps(1.5703125f)));
+    R = _mm256_sub_ps(R, _mm256_mul_ps(Quadrant, _mm256_set1_ps(4.837512969970703125e-4f)));
+    R = _mm256_sub_ps(R, _mm256_mul_ps(Quadrant, _mm256_set1_ps(7.54978995489e-8f)));
+    
+    __m256 R2 = _mm256_mul_ps(R, R);
+    __m256 S = _mm256_add_ps(R, _mm256_mul_ps(_mm256_mul_ps(R, R2), _mm256_add_ps(_mm256_set1_ps(-0.166628405f), _mm256_mul_ps(R2, _mm256_set1_ps(0.00815311912f)))));
+    __m256 C = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(R2, _mm256_add_ps(_mm256_set1_ps(-0.499781191f), _mm256_mul_ps(R2, _mm256_set1_ps(0.0404981822f)))));
+    
+    __m256 Mod4 = _mm256_sub_ps(Quadrant, _mm256_mul_ps(_mm256_floor_ps(_mm256_mul_ps(Quadrant, _mm256_set1_ps(0.25f))), _mm256_set1_ps(4.0f)));
+    __m256 IsOne = _mm256_cmp_ps(Mod4, _mm256_set1_ps(1.0f), _CMP_EQ_OQ);
+    __m256 Swap = _mm256_or_ps(IsOne, _mm256_cmp_ps(Mod4, _mm256_set1_ps(3.0f), _CMP_EQ_OQ));
+    __m256 NegateSin = _mm256_cmp_ps(Mod4, _mm256_set1_ps(2.0f), _CMP_GE_OQ);
+    __m256 NegateCos = _mm256_or_ps(IsOne, _mm256_cmp_ps(Mod4, _mm256_set1_ps(2.0f), _CMP_EQ_OQ));
+    
+    __m256 SignMask = _mm256_set1_ps(-0.0f);
+    __m256 SinResult = _mm256_blendv_ps(S, C, Swap);
+    __m256 CosResult = _mm256_blendv_ps(C, S, Swap);
+    *Sin = _mm256_blendv_ps(SinResult, _mm256_xor_ps(SinResult, SignMask), NegateSin);
+    *Cos = _mm256_blendv_ps(CosResult, _mm256_xor_ps(CosResult, SignMask), NegateCos);
+}
+
+CpuTarget("avx2") internal inline __m256
+Atan2FastAVX2(__m256 Y, __m256 X)
+{
+    // NOTE: Same as Atan2Fast
+    __m256 SignMask = _mm256_set1_ps(-0.0f);
+    __m256 AbsY = _mm256_andnot_ps(SignMask, Y);
+    __m256 AbsX = _mm256_andnot_ps(SignMask, X);
+    __m256 Largest = _mm256_max_ps(AbsX, AbsY);
+    __m256 A = _mm256_div_ps(_mm256_min_ps(AbsX, AbsY), Largest);
+    __m256 S = _mm256_mul_ps(A, A);
+    
+    __m256 Polynomial = _mm256_add_ps(_mm256_set1_ps(-0.0899142548f), _mm256_mul_ps(S, _mm256_set1_ps(0.0227974411f)));
+    Polynomial = _mm256_add_ps(_mm256_set1_ps(0.184151232f), _mm256_mul_ps(S, Polynomial));
+    Polynomial = _mm256_add_ps(_mm256_set1_ps(-0.331620634f), _mm256_mul_ps(S, Polynomial));
+    
+    __m256 Result = _mm256_add_ps(A, _mm256_mul_ps(_mm256_mul_ps(A, S), Polynomial));
+    Result = _mm256_blendv_ps(Result, _mm256_sub_ps(_mm256_set1_ps(HalfPi), Result), _mm256_cmp_ps(AbsY, AbsX, _CMP_GT_OQ));
+    Result = _mm256_blendv_ps(Result, _mm256_sub_ps(_mm256_set1_ps(Pi), Result), _mm256_cmp_ps(X, _mm256_setzero_ps(), _CMP_LT_OQ));
+    Result = _mm256_blendv_ps(Result, _mm256_xor_ps(Result, SignMask), _mm256_cmp_ps(Y, _mm256_setzero_ps(), _CMP_LT_OQ));
+    Result = _mm256_blendv_ps(_mm256_setzero_ps(), Result, _mm256_cmp_ps(Largest, _mm256_setzero_ps(), _CMP_GT_OQ));
     return(Result);
 }
 
-internal inline v3
-Lerp(v3 A, v3 B, f32 T)
+CpuTarget("avx2") internal void
+SinCosArrayAVX2(f32 *Angles, f32 *Sines, f32 *Cosines, u32 Count, enum32(math_accuracy) Accuracy)
 {
-    v3 Result = A + (B - A) * T;
-    return(Result);
+    u32 BlocksCount = Count & ~7u;
+    for(u32 Index = 0;
+        Index < BlocksCount;
+        Index += 8)
+    {
+        __m256 Angle = _mm256_loadu_ps(Angles + Index);
+        
+        __m256 Sin, Cos;
+        if(Accuracy == MathAccuracy_Fast)
+        {
+            SinCosFastAVX2(Angle, &Sin, &Cos);
+        }
+        else
+        {
+            sincos256_ps(Angle, &Sin, &Cos);
+        }
+        
+        _mm256_storeu_ps(Sines + Index, Sin);
+        _mm256_storeu_ps(Cosines + Index, Cos);
+    }
+    
+    SinCosArrayBaseline(Angles + BlocksCount, Sines + BlocksCount, Cosines + BlocksCount, Count - BlocksCount, Accuracy);
 }
 
-internal inline v4
-Lerp(v4 A, v4 B, f32 T)
+CpuTarget("avx2") internal void
+Atan2ArrayAVX2(f32 *Ys, f32 *Xs, f32 *Angles, u32 Count, enum32(math_accuracy) Accuracy)
 {
-    v4 Result = A + (B - A) * T;
-    return(Result);
+    u32 BlocksCount = Count & ~7u;
+    for(u32 Index = 0;
+        Index < BlocksCount;
+        Index += 8)
+    {
+        __m256 Y = _mm256_loadu_ps(Ys + Index);
+        __m256 X = _mm256_loadu_ps(Xs + Index);
+        
+        __m256 Angle;
+        if(Accuracy == MathAccuracy_Fast)
+        {
+            Angle = Atan2FastAVX2(Y, X);
+        }
+        else
+        {
+            Angle = atan2_256_ps(Y, X);
+        }
+        
+        _mm256_storeu_ps(Angles + Index, Angle);
+    }
+    
+    Atan2ArrayBaseline(Ys + BlocksCount, Xs + BlocksCount, Angles + BlocksCount, Count - BlocksCount, Accuracy);
 }
 
-internal inline f32
-Dot(v2 A, v2 B)
+CpuTarget("avx2") internal void
+V2RotateArrayAVX2(v2 *Vectors, f32 *Angles, v2 *Results, u32 Count, enum32(math_accuracy) Accuracy)
 {
-    f32 Result = A.X * B.X + A.Y * B.Y;
-    return(Result);
+    u32 BlocksCount = Count & ~7u;
+    for(u32 Index = 0;
+        Index < BlocksCount;
+        Index += 8)
+    {
+        // NOTE: Deinterleaved the same way as V2x8Load, and put back like V2x8Store
+        __m256 A = _mm256_loadu_ps(&Vectors[Index].X);
+        __m256 B = _mm256_loadu_ps(&Vectors[Index + 4].X);
+        __m256 X = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(A, B, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+        __m256 Y = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(A, B, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+        __m256 Angle = _mm256_mul_ps(_mm256_loadu_ps(Angles + Index), _mm256_set1_ps(D2R));
+        
+        __m256 S, C;
+        if(Accuracy == MathAccuracy_Fast)
+        {
+            SinCosFastAVX2(Angle, &S, &C);
+        }
+        else
+        {
+            sincos256_ps(Angle, &S, &C);
+        }
+        
+        __m256 ResultX = _mm256_sub_ps(_mm256_mul_ps(X, C), _mm256_mul_ps(Y, S));
+        __m256 ResultY = _mm256_add_ps(_mm256_mul_ps(X, S), _mm256_mul_ps(Y, C));
+        
+        __m256 Low = _mm256_unpacklo_ps(ResultX, ResultY);
+        __m256 High = _mm256_unpackhi_ps(ResultX, ResultY);
+        _mm256_storeu_ps(&Results[Index].X, _mm256_permute2f128_ps(Low, High, 0x20));
+        _mm256_storeu_ps(&Results[Index + 4].X, _mm256_permute2f128_ps(Low, High, 0x31));
+    }
+    
+    V2RotateArrayBaseline(Vectors + BlocksCount, Angles + BlocksCount, Results + BlocksCount, Count - BlocksCount, Accuracy);
 }
 
-internal inline f32
-Dot(v3 A, v3 B)
+CpuTarget("avx2") internal void
+M4TransformPointsAVX2(m4 Matrix, v3 *Points, u32 Count)
 {
-    f32 Result = A.X * B.X + A.Y * B.Y + A.Z * B.Z;
-    return(Result);
+    f32 *Elements = &Matrix.M00;
+    
+    __m256 M[16];
+    for(u32 Index = 0;
+        Index < 16;
+        Index++)
+    {
+        M[Index] = _mm256_set1_ps(Elements[Index]);
+    }
+    
+    u32 BlocksCount = Count & ~7u;
+    for(u32 Index = 0;
+        Index < BlocksCount;
+        Index += 8)
+    {
+        // NOTE: Deinterleaved the same way as V3x8Load, and put back like V3x8Store
+        f32 *At = &Points[Index].X;
+        __m256 A = _mm256_setr_m128(_mm_loadu_ps(At), _mm_loadu_ps(At + 12));
+        __m256 B = _mm256_setr_m128(_mm_loadu_ps(At + 4), _mm_loadu_ps(At + 16));
+        __m256 C = _mm256_setr_m128(_mm_loadu_ps(At + 8), _mm_loadu_ps(At + 20));
+        
+        __m256 B12C01 = _mm256_shuffle_ps(B, C, _MM_SHUFFLE(1, 0, 2, 1));
+        __m256 A11B00 = _mm256_shuffle_ps(A, B, _MM_SHUFFLE(0, 0, 1, 1));
+        __m256 B33C22 = _mm256_shuffle_ps(B, C, _MM_SHUFFLE(2, 2, 3, 3));
+        __m256 A22B11 = _mm256_shuffle_ps(A, B, _MM_SHUFFLE(1, 1, 2, 2));
+        
+        __m256 X = _mm256_shuffle_ps(A, B12C01, _MM_SHUFFLE(3, 1, 3, 0));
+        __m256 Y = _mm256_shuffle_ps(A11B00, B33C22, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 Z = _mm256_shuffle_ps(A22B11, C, _MM_SHUFFLE(3, 0, 2, 0));
+        
+        __m256 W = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(X, M[12]), _mm256_mul_ps(Y, M[13])), _mm256_mul_ps(Z, M[14])), M[15]);
+        __m256 InverseW = _mm256_div_ps(_mm256_set1_ps(1.0f), W);
+        
+        __m256 TX = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(X, M[0]), _mm256_mul_ps(Y, M[1])), _mm256_mul_ps(Z, M[2])), M[3]), InverseW);
+        __m256 TY = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(X, M[4]), _mm256_mul_ps(Y, M[5])), _mm256_mul_ps(Z, M[6])), M[7]), InverseW);
+        __m256 TZ = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(X, M[8]), _mm256_mul_ps(Y, M[9])), _mm256_mul_ps(Z, M[10])), M[11]), InverseW);
+        
+        __m256 X0Y0X1Y1 = _mm256_unpacklo_ps(TX, TY);
+        __m256 Z00X11 = _mm256_shuffle_ps(TZ, TX, _MM_SHUFFLE(1, 1, 0, 0));
+        __m256 Y11Z11 = _mm256_shuffle_ps(TY, TZ, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 X22Y22 = _mm256_shuffle_ps(TX, TY, _MM_SHUFFLE(2, 2, 2, 2));
+        __m256 Z22X33 = _mm256_shuffle_ps(TZ, TX, _MM_SHUFFLE(3, 3, 2, 2));
+        __m256 Y33Z33 = _mm256_shuffle_ps(TY, TZ, _MM_SHUFFLE(3, 3, 3, 3));
+        
+        A = _mm256_shuffle_ps(X0Y0X1Y1, Z00X11, _MM_SHUFFLE(2, 0, 1, 0));
+        B = _mm256_shuffle_ps(Y11Z11, X22Y22, _MM_SHUFFLE(2, 0, 2, 0));
+        C = _mm256_shuffle_ps(Z22X33, Y33Z33, _MM_SHUFFLE(2, 0, 2, 0));
+        
+        _mm_storeu_ps(At, _mm256_castps256_ps128(A));
+        _mm_storeu_ps(At + 4, _mm256_castps256_ps128(B));
+        _mm_storeu_ps(At + 8, _mm256_castps256_ps128(C));
+        _mm_storeu_ps(At + 12, _mm256_extractf128_ps(A, 1));
+        _mm_storeu_ps(At + 16, _mm256_extractf128_ps(B, 1));
+        _mm_storeu_ps(At + 20, _mm256_extractf128_ps(C, 1));
+    }
+    
+    M4TransformPointsBaseline(Matrix, Points + BlocksCount, Count - BlocksCount);
 }
+#endif
 
-internal inline f32
-Dot(v4 A, v4 B)
+global math_kernels GlobalMathKernels =
 {
-    f32 Result = A.X * B.X + A.Y * B.Y + A.Z * B.Z + A.W * B.W;
-    return(Result);
-}
+    (char *)(MathWideAVX2 ? "avx2" : MathSSE ? "sse4.1" : MathNEON ? "neon" : "scalar"),
+    SinCosArrayBaseline,
+    Atan2ArrayBaseline,
+    V2RotateArrayBaseline,
+    M4TransformPointsBaseline,
+};
 
-internal inline v2
-Hadamard(v2 A, v2 B)
+#ifdef WASP_CPU_H
+internal math_kernels
+MathKernelsGet(flag32(cpu_feature) Features)
 {
-    v2 Result;
-    Result.X = A.X * B.X;
-    Result.Y = A.Y * B.Y;
+    math_kernels Result = {};
+    Result.Name = (char *)(MathWideAVX2 ? "avx2" : MathSSE ? "sse4.1" : MathNEON ? "neon" : "scalar");
+    Result.SinCosArray = SinCosArrayBaseline;
+    Result.Atan2Array = Atan2ArrayBaseline;
+    Result.V2RotateArray = V2RotateArrayBaseline;
+    Result.M4TransformPoints = M4TransformPointsBaseline;
+    
+#if MathDispatchAVX2
+    if((Features & CpuFeature_AVX2) == CpuFeature_AVX2)
+    {
+        Result.Name = "avx2";
+        Result.SinCosArray = SinCosArrayAVX2;
+        Result.Atan2Array = Atan2ArrayAVX2;
+        Result.V2RotateArray = V2RotateArrayAVX2;
+        Result.M4TransformPoints = M4TransformPointsAVX2;
+    }
+#endif
+    
     return(Result);
 }
+#endif
 
-internal inline v3
-Hadamard(v3 A, v3 B)
+internal void
+SinCosArray(f32 *Angles, f32 *Sines, f32 *Cosines, u32 Count, enum32(math_accuracy) Accuracy)
 {
-    v3 Result;
-    Result.X = A.X * B.X;
-    Result.Y = A.Y * B.Y;
-    Result.Z = A.Z * B.Z;
-    return(Result);
+    GlobalMathKernels.SinCosArray(Angles, Sines, Cosines, Count, Accuracy);
 }
 
-internal inline v4
-Hadamard(v4 A, v4 B)
+internal void
+Atan2Array(f32 *Ys, f32 *Xs, f32 *Angles, u32 Count, enum32(math_accuracy) Accuracy)
 {
-    v4 Result;
-    Result.X = A.X * B.X;
-    Result.Y = A.Y * B.Y;
-    Result.Z = A.Z * B.Z;
-    Result.W = A.W * B.W;
-    return(Result);
+    GlobalMathKernels.Atan2Array(Ys, Xs, Angles, Count, Accuracy);
 }
 
-internal inline v3
-Cross(v3 A, v3 B)
+internal void
+V2RotateArray(v2 *Vectors, f32 *Angles, v2 *Results, u32 Count, enum32(math_accuracy) Accuracy)
 {
-    v3 Result;
-    Result.X = A.Y * B.Z - A.Z * B.Y;
-    Result.Y = A.Z * B.X - A.X * B.Z;
-    Result.Z = A.X * B.Y - A.Y * B.X;
-    return(Result);
+    GlobalMathKernels.V2RotateArray(Vectors, Angles, Results, Count, Accuracy);
 }
 
-internal inline f32
-Determinant(v2 A, v2 B)
+internal void
+M4TransformPoints(m4 Matrix, v3 *Points, u32 Count)
 {
-    f32 Result =  A.X * B.Y - A.Y * B.X;
-    return(Result);
+    GlobalMathKernels.M4TransformPoints(Matrix, Points, Count);
 }
 
-internal inline v2
-V2Rotate(v2 V, f32 Angle)
-{
-    f32 S = Sin(Angle * D2R);
-    f32 C = Cos(Angle * D2R);
-
-    v2 Result = V2(V.X * C - V.Y * S, V.X * S + V.Y * C);
-    return(Result);
-}
 
 
 
@@ -1364,7 +5267,7 @@ union v2
     {
         f32 X, Y;
     };
-
+    
     struct
     {
         f32 U, V;
@@ -1377,12 +5280,12 @@ union v3
     {
         f32 X, Y, Z;
     };
-
+    
     struct
     {
         f32 R, G, B;
     };
-
+    
     struct
     {
         f32 Pitch, Yaw, Roll;
@@ -1395,12 +5298,12 @@ union v4
     {
         f32 X, Y, Z, W;
     };
-
+    
     struct
     {
         f32 R, G, B, A;
     };
-
+    
     __m128 Values;
 };
 
@@ -1413,7 +5316,7 @@ union m4
             M20, M21, M22, M23,
             M30, M31, M32, M33;
     };
-
+    
     __m128 Rows[4];
 };
 
@@ -1495,14 +5398,14 @@ internal inline v2
 V2Unit(v2 A)
 {
     v2 Result = v2(0.0f, 0.0f);
-
+    
     f32 Length = V2Length(A);
     if(Length)
     {
         Result.X = A.X / Length;
         Result.Y = A.Y / Length;
     }
-
+    
     return(Result);
 }
 
@@ -1510,10 +5413,10 @@ internal inline f32
 V2Distance(v2 A, v2 B)
 {
     f32 Result;
-
+    
     v2 Delta = V2Substract(A, B);
     Result = V2Length(Delta);
-
+    
     return(Result);
 }
 
@@ -1522,7 +5425,7 @@ V2Rotate(v2 V, f32 Angle)
 {
     f32 S = Sin(Angle * DegreesToRadiansScalar);
     f32 C = Cos(Angle * DegreesToRadiansScalar);
-
+    
     v2 Result = v2(V.X * C - V.Y * S, V.X * S + V.Y * C);
     return(Result);
 }
@@ -1615,7 +5518,7 @@ internal inline v3
 V3Unit(v3 A)
 {
     v3 Result = v3(0.0f, 0.0f, 0.0f);
-
+    
     f32 Length = V3Length(A);
     if(Length)
     {
@@ -1623,7 +5526,7 @@ V3Unit(v3 A)
         Result.Y = A.Y / Length;
         Result.Z = A.Z / Length;
     }
-
+    
     return(Result);
 }
 
@@ -1631,10 +5534,10 @@ internal inline f32
 V3Distance(v3 A, v3 B)
 {
     f32 Result;
-
+    
     v3 Delta = V3Substract(A, B);
     Result = V3Length(Delta);
-
+    
     return(Result);
 }
 
@@ -1644,7 +5547,7 @@ V3Transform(v3 A, v3 Translation, v4 Rotation, v3 Scale)
     v3 ScaledVector = V3Hadamard(Scale, Translation);
     v3 RotatedVector = V4QuaternionRotateVector(Rotation, ScaledVector);
     v3 TranslatedVector = V3Add(RotatedVector, Translation);
-
+    
     return(TranslatedVector);
 }
 
@@ -1653,7 +5556,7 @@ V3TransformNoTranslation(v3 A, v3 Translation, v4 Rotation, v3 Scale)
 {
     v3 ScaledVector = V3Hadamard(Scale, Translation);
     v3 RotatedVector = V4QuaternionRotateVector(Rotation, ScaledVector);
-
+    
     return(RotatedVector);
 }
 
@@ -1662,11 +5565,11 @@ V3InverseTransform(v3 A, v3 Translation, v4 Rotation, v3 Scale)
 {
     v4 InverseRotation = v4(-Rotation.X, -Rotation.Y, -Rotation.Z, Rotation.W);
     v3 InverseScale = v3(1.0f / Scale.X, 1.0f / Scale.Y, 1.0f / Scale.Z);
-
+    
     v3 TranslatedVector = V3Substract(A, Translation);
     v3 RotatedVector = V4QuaternionRotateVector(InverseRotation, TranslatedVector);
     v3 ScaledVector = V3Hadamard(InverseScale, RotatedVector);
-
+    
     return(ScaledVector);
 }
 
@@ -1675,10 +5578,10 @@ V3InverseTransformNoTranslation(v3 A, v4 Rotation, v3 Scale)
 {
     v4 InverseRotation = v4(-Rotation.X, -Rotation.Y, -Rotation.Z, Rotation.W);
     v3 InverseScale = v3(1.0f / Scale.X, 1.0f / Scale.Y, 1.0f / Scale.Z);
-
+    
     v3 RotatedVector = V4QuaternionRotateVector(InverseRotation, A);
     v3 ScaledVector = V3Hadamard(InverseScale, RotatedVector);
-
+    
     return(ScaledVector);
 }
 
@@ -1689,7 +5592,7 @@ V3RotatorToVector(v3 Rotator)
     SinCos(Rotator.Pitch * DegreesToRadiansScalar, &PS, &PC);
     SinCos(Rotator.Yaw   * DegreesToRadiansScalar, &YS, &YC);
     v3 Vector = v3(PC * YC, PC * YS, PS);
-
+    
     return(Vector);
 }
 
@@ -1700,7 +5603,7 @@ V3VectorToRotator(v3 Vector)
     Rotator.Yaw = Atan2(Vector.Y, Vector.X) * RadiansToDegreesScalar;
     Rotator.Pitch = Atan2(Vector.Z, SquareRoot(Vector.X * Vector.X + Vector.Y * Vector.Y)) * RadiansToDegreesScalar;
     Rotator.Roll = 0.0f;
-
+    
     return(Rotator);
 }
 
@@ -1709,7 +5612,7 @@ V3RotateAroundZ(v3 V, f32 Angle)
 {
     f32 S = Sin(Angle * DegreesToRadiansScalar);
     f32 C = Cos(Angle * DegreesToRadiansScalar);
-
+    
     v3 Result = v3(V.X * C - V.Y * S, V.X * S + V.Y * C, V.Z);
     return(Result);
 }
@@ -1775,7 +5678,7 @@ V4Dot(v4 A, v4 B)
     // TODO: Figure out how we should load these
     __m128 XMM0 = _mm_loadu_ps(&A.X);
     __m128 XMM1 = _mm_loadu_ps(&B.X);
-
+    
     f32 Result = _mm_cvtss_f32(_mm_dp_ps(XMM0, XMM1, 0xFF));
     return(Result);
 }
@@ -1802,7 +5705,7 @@ internal inline v4
 V4Unit(v4 A)
 {
     v4 Result = v4(0.0f, 0.0f, 0.0f, 0.0f);
-
+    
     f32 Length = V4Length(A);
     if(Length)
     {
@@ -1811,7 +5714,7 @@ V4Unit(v4 A)
         Result.Z = A.Z / Length;
         Result.W = A.W / Length;
     }
-
+    
     return(Result);
 }
 
@@ -1819,10 +5722,10 @@ internal inline f32
 V4Distance(v4 A, v4 B)
 {
     f32 Result;
-
+    
     v4 Delta = V4Substract(A, B);
     Result = V4Length(Delta);
-
+    
     return(Result);
 }
 
@@ -1830,10 +5733,10 @@ internal inline v4
 V4MakeQuaternionFromRotation(v3 Axis, f32 Angle)
 {
     v3 AxisUnit = V3Unit(Axis);
-
+    
     f32 CosAngle, SinAngle;
     SinCos(Angle * 0.5f * DegreesToRadiansScalar, &SinAngle, &CosAngle);
-
+    
     v4 Result = v4(SinAngle * AxisUnit.X, SinAngle * AxisUnit.Y, SinAngle * AxisUnit.Z, CosAngle);
     return(Result);
 }
@@ -1854,27 +5757,27 @@ M4Make(f32 M00, f32 M01, f32 M02, f32 M03,
        f32 M30, f32 M31, f32 M32, f32 M33)
 {
     m4 Result;
-
+    
     Result.M00 = M00;
     Result.M01 = M01;
     Result.M02 = M02;
     Result.M03 = M03;
-
+    
     Result.M10 = M10;
     Result.M11 = M11;
     Result.M12 = M12;
     Result.M13 = M13;
-
+    
     Result.M20 = M20;
     Result.M21 = M21;
     Result.M22 = M22;
     Result.M23 = M23;
-
+    
     Result.M30 = M30;
     Result.M31 = M31;
     Result.M32 = M32;
     Result.M33 = M33;
-
+    
     return(Result);
 }
 
@@ -1916,7 +5819,7 @@ M4MakePerspective(f32 FOV, f32 FarPlane, f32 NearPlane, f32 WidthOverHeight)
     f32 C = WidthOverHeight;
     f32 N = NearPlane;
     f32 F = FarPlane;
-
+    
     m4 Result = m4(R / (C * T), 0.0f,  0.0f,        0.0f,
                    0.0f,        R / T, 0.0f,        0.0f,
                    0.0f,        0.0f,  N / (N - F), -F * N / (N - F),
@@ -1931,7 +5834,7 @@ M4MakeRotation(v3 Rotation)
     SinCos(Rotation.Pitch * DegreesToRadiansScalar, &PS, &PC);
     SinCos(Rotation.Yaw   * DegreesToRadiansScalar, &YS, &YC);
     SinCos(Rotation.Roll  * DegreesToRadiansScalar, &RS, &RC);
-
+    
     m4 Result = m4(PC * YC,                -PC * YS,                -PS,     0.0f,
                    RS * PS * YC + RC * YS, RC * YC - RS * PS * YS,  RS * PC, 0.0f,
                    RC * PS * YC - RS * YS, -YC * RS - RC * PS * YS, RC * PC, 0.0f,
@@ -1965,25 +5868,25 @@ M4MakeFromTransform(v3 Translation, v4 Rotation, v3 Scale)
     f32 X2 = Rotation.X + Rotation.X;
     f32 Y2 = Rotation.Y + Rotation.Y;
     f32 Z2 = Rotation.Z + Rotation.Z;
-
+    
     f32 XX2 = Rotation.X * X2;
     f32 XY2 = Rotation.X * Y2;
     f32 XZ2 = Rotation.X * Z2;
-
+    
     f32 YY2 = Rotation.Y * Y2;
     f32 YZ2 = Rotation.Y * Z2;
-
+    
     f32 ZZ2 = Rotation.Z * Z2;
-
+    
     f32 WX2 = Rotation.W * X2;
     f32 WY2 = Rotation.W * Y2;
     f32 WZ2 = Rotation.W * Z2;
-
+    
     m4 Result = m4((1.0f - (YY2 + ZZ2)) * Scale.X, (XY2 - WZ2)          * Scale.Y, (XZ2 + WY2)          * Scale.Z, Translation.X,
                    (XY2 + WZ2)          * Scale.X, (1.0f - (XX2 + ZZ2)) * Scale.Y, (YZ2 - WX2)          * Scale.Z, Translation.Y,
                    (XZ2 - WY2)          * Scale.X, (YZ2 + WX2)          * Scale.Y, (1.0f - (XX2 + YY2)) * Scale.Z, Translation.Z,
                    0.0f,                            0.0f,                           0.0f,                           1.0f);
-
+    
     return(Result);
 }
 
@@ -1993,29 +5896,29 @@ M4MakeInverseFromTransform(v3 Translation, v4 Rotation, v3 Scale)
     v4 InverseRotation = v4(-Rotation.X, -Rotation.Y, -Rotation.Z, Rotation.W);
     v3 InverseScale = v3(1.0f / Scale.X, 1.0f / Scale.Y, 1.0f / Scale.Z);
     v3 InverseTranslation = V4QuaternionRotateVector(InverseRotation, V3Hadamard(InverseScale, V3Scale(Translation, -1.0f)));
-
+    
     f32 X2 = InverseRotation.X + InverseRotation.X;
     f32 Y2 = InverseRotation.Y + InverseRotation.Y;
     f32 Z2 = InverseRotation.Z + InverseRotation.Z;
-
+    
     f32 XX2 = InverseRotation.X * X2;
     f32 XY2 = InverseRotation.X * Y2;
     f32 XZ2 = InverseRotation.X * Z2;
-
+    
     f32 YY2 = InverseRotation.Y * Y2;
     f32 YZ2 = InverseRotation.Y * Z2;
-
+    
     f32 ZZ2 = InverseRotation.Z * Z2;
-
+    
     f32 WX2 = InverseRotation.W * X2;
     f32 WY2 = InverseRotation.W * Y2;
     f32 WZ2 = InverseRotation.W * Z2;
-
+    
     m4 Result = m4((1.0f - (YY2 + ZZ2)) * InverseScale.X, (XY2 - WZ2)          * InverseScale.Y, (XZ2 + WY2)          * InverseScale.Z, InverseTranslation.X,
                    (XY2 + WZ2)          * InverseScale.X, (1.0f - (XX2 + ZZ2)) * InverseScale.Y, (YZ2 - WX2)          * InverseScale.Z, InverseTranslation.Y,
                    (XZ2 - WY2)          * InverseScale.X, (YZ2 + WX2)          * InverseScale.Y, (1.0f - (XX2 + YY2)) * InverseScale.Z, InverseTranslation.Z,
                    0.0f,                                  0.0f,                                  0.0f,                                  1.0f);
-
+    
     return(Result);
 }
 
@@ -2023,27 +5926,27 @@ internal inline m4
 M4Multiply(m4 A, m4 B)
 {
     // TODO: AVX2 version from XMMatrixMultiply, https://github.com/microsoft/DirectXMath/blob/main/Inc/DirectXMathMatrix.inl#L228
-
+    
     __m128 XMM0 = _mm_mul_ps(_mm_set1_ps(A.M00), B.Rows[0]);
     XMM0 = _mm_fmadd_ps(_mm_set1_ps(A.M01), B.Rows[1], XMM0);
     XMM0 = _mm_fmadd_ps(_mm_set1_ps(A.M02), B.Rows[2], XMM0);
     XMM0 = _mm_fmadd_ps(_mm_set1_ps(A.M03), B.Rows[3], XMM0);
-
+    
     __m128 XMM1 = _mm_mul_ps(_mm_set1_ps(A.M10), B.Rows[0]);
     XMM1 = _mm_fmadd_ps(_mm_set1_ps(A.M11), B.Rows[1], XMM1);
     XMM1 = _mm_fmadd_ps(_mm_set1_ps(A.M12), B.Rows[2], XMM1);
     XMM1 = _mm_fmadd_ps(_mm_set1_ps(A.M13), B.Rows[3], XMM1);
-
+    
     __m128 XMM2 = _mm_mul_ps(_mm_set1_ps(A.M20), B.Rows[0]);
     XMM2 = _mm_fmadd_ps(_mm_set1_ps(A.M21), B.Rows[1], XMM2);
     XMM2 = _mm_fmadd_ps(_mm_set1_ps(A.M22), B.Rows[2], XMM2);
     XMM2 = _mm_fmadd_ps(_mm_set1_ps(A.M23), B.Rows[3], XMM2);
-
+    
     __m128 XMM3 = _mm_mul_ps(_mm_set1_ps(A.M30), B.Rows[0]);
     XMM3 = _mm_fmadd_ps(_mm_set1_ps(A.M31), B.Rows[1], XMM3);
     XMM3 = _mm_fmadd_ps(_mm_set1_ps(A.M32), B.Rows[2], XMM3);
     XMM3 = _mm_fmadd_ps(_mm_set1_ps(A.M33), B.Rows[3], XMM3);
-
+    
     m4 Result;
     Result.Rows[0] = XMM0;
     Result.Rows[1] = XMM1;
@@ -2056,17 +5959,17 @@ internal inline v3
 M4Transform(m4 Matrix, v3 Target)
 {
     v4 Vector = v4(Target.X, Target.Y, Target.Z, 1.0f);
-
+    
     _MM_TRANSPOSE4_PS(Matrix.Rows[0], Matrix.Rows[1], Matrix.Rows[2], Matrix.Rows[3]);
-
+    
     __m128 XMM0 = _mm_mul_ps(_mm_set1_ps(Vector.X), Matrix.Rows[0]);
     XMM0 = _mm_fmadd_ps(_mm_set1_ps(Vector.Y), Matrix.Rows[1], XMM0);
     XMM0 = _mm_fmadd_ps(_mm_set1_ps(Vector.Z), Matrix.Rows[2], XMM0);
     XMM0 = _mm_fmadd_ps(_mm_set1_ps(Vector.W), Matrix.Rows[3], XMM0);
-
+    
     v4 Transformed;
     Transformed.Values = XMM0;
-
+    
     v3 Result = v3(Transformed.X / Transformed.W, Transformed.Y / Transformed.W, Transformed.Z / Transformed.W);
     return(Result);
 }
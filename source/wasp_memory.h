@@ -5,23 +5,118 @@
 #ifndef WASP_MEMORY_H
 #define WASP_MEMORY_H
 
-// TODO: Probably support arena chaining so we can grow on systems without a MMU, like WASM
+// NOTE: Arenas created with MemoryArenaFlag_Chained treat the reserved size as a block size. A push that doesn't fit
+// reserves a new block, big enough for the push, and links the old one behind it. Temporaries and resets release the
+// blocks again, so they roll back across block boundaries. Use this on systems without a MMU, like WASM, or when
+// there is no sensible worst case to reserve up front.
+
+// NOTE: Compile with WASP_MEMORY_INSTRUMENT=1 to track every arena: high-water mark, commit events and the file and
+// line of every push, including sub-arenas. MemoryInstrumentReport prints it all through Outf, so the string module
+// has to be included as well. Arenas can be named with MemoryArenaName, unnamed ones go by their creation site.
+
+#ifndef WASP_MEMORY_INSTRUMENT
+#define WASP_MEMORY_INSTRUMENT 0
+#endif
 
 /*
   CONSTANTS
 */
 
+#define MemoryInstrumentSitesCount 64
+#define MemoryInstrumentCommitsCount 16
+
+// NOTE: Pool handles are a slot index in the low bits and the slot's generation in the high bits
+#define MemoryPoolIndexBits 20
+#define MemoryPoolIndexMask ((1u << MemoryPoolIndexBits) - 1)
+#define MemoryPoolCapacityMax (1u << MemoryPoolIndexBits)
+
+// NOTE: Copies and sets of at least this size use non-temporal stores. Past the per core share of the last level
+// cache the destination gets evicted before it is used again anyway, so it is not worth pulling it in
+#define MemoryNonTemporalThreshold MB(2)
+
+// NOTE: Slabs are aligned to their size, so the slab of any block is found by masking its address. Size classes are
+// powers of two from 16 bytes to 8 KB, larger allocations get their own reservation
+#define MemorySlabSize KB(64)
+#define MemorySlabHeaderSize 64
+#define MemorySlabClassShiftMin 4
+#define MemorySlabClassesCount 10
+#define MemorySlabClassLarge MemorySlabClassesCount
+#define MemorySlabBlockSizeMax ((umm)1 << (MemorySlabClassShiftMin + MemorySlabClassesCount - 1))
+#define MemorySlabThreadsMax 64 // NOTE: Threads alive at once, the platform layer reuses the indices of released threads
+
 /*
   TYPES
 */
 
 enum memory_arena_flag
 {
-    // MemoryArenaFlag_DecommitOnReset = 1 << 0, // TODO: Possibly do this
+    MemoryArenaFlag_DecommitOnReset    = 1 << 0, // NOTE: Reset decommits everything past what was committed at creation
     
     MemoryArenaFlag_AllowFailedPush    = 1 << 1,
     MemoryArenaFlag_AllowFailedCreate  = 1 << 2,
     MemoryArenaFlag_OnlyCommitAsNeeded = 1 << 3,
+    MemoryArenaFlag_Chained            = 1 << 4,
+    
+    // NOTE: Transparent huge pages, the reservation is aligned to the huge page size and commits are rounded up to it
+    MemoryArenaFlag_HugePages          = 1 << 5,
+    // NOTE: Explicit huge pages from the pool the OS sets aside, everything is committed up front. Falls back to
+    // transparent huge pages when the pool is empty or we lack the privilege
+    MemoryArenaFlag_HugePagesExplicit  = 1 << 6,
+    // NOTE: Pages are faulted in when they are committed, instead of on first touch
+    MemoryArenaFlag_Prefault           = 1 << 7,
+};
+
+struct memory_push_site
+{
+    char *File;
+    int Line;
+    
+    u64 PushesCount;
+    umm Bytes;
+    umm LargestPush;
+};
+
+struct memory_commit_event
+{
+    char *File;
+    int Line;
+    
+    umm Used;
+    umm Committed;
+};
+
+struct memory_arena_stats
+{
+    memory_arena_stats *Next; // NOTE: Every instrumented arena ever created, newest first
+    memory_arena_stats *Parent; // NOTE: Set for arenas made with MemoryArenaPushArena
+    
+    char *Name;
+    char *File;
+    int Line;
+    
+    umm Reserved;
+    umm Committed;
+    umm Used;
+    umm HighWater;
+    
+    u64 PushesCount;
+    u32 FailedPushesCount;
+    b32 Destroyed;
+    
+    u32 CommitsCount; // NOTE: Commits only keeps the most recent ones
+    memory_commit_event Commits[MemoryInstrumentCommitsCount];
+    
+    u32 SitesCount; // NOTE: Pushes from sites past the table go into the last entry
+    memory_push_site Sites[MemoryInstrumentSitesCount];
+};
+
+// NOTE: Sits at the start of every chained block but the first one, and holds the state of the block before it
+struct memory_arena_block
+{
+    u8 *Memory;
+    umm Reserved;
+    umm Committed;
+    umm Used;
 };
 
 struct memory_arena
@@ -29,18 +124,140 @@ struct memory_arena
     u8 *Memory_; // TODO: Remove _
     umm Reserved;
     umm Committed;
-    // TODO: Have some baseline committed here, if we want to decommit on reset
+    umm Baseline; // NOTE: Committed at creation, MemoryArenaFlag_DecommitOnReset never decommits below it
     umm Used;
     
     flag32(memory_arena_flag) Flags;
     
+    // NOTE: Only used by chained arenas, the fields above always describe the newest block
+    umm BlockSize;
+    u32 BlocksCount; // NOTE: Not counting the first block
+    umm PreviousReserved;
+    umm PreviousCommitted;
+    umm PreviousUsed;
+    
     b8 Released;
     b8 CantReset; // NOTE: In case that we have pushed an arena, this could cause holes of decommitted memory
+    
+#if WASP_MEMORY_INSTRUMENT
+    memory_arena_stats *Stats;
+#endif
+};
+
+// NOTE: A growable array in its own reserved range, pages are committed as it grows. Elements never move, so pointers
+// into it stay valid until they are popped or swap-removed. Reserve for the worst case, it only costs address space
+struct memory_array
+{
+    memory_arena Arena;
+    b32 InArena; // NOTE: Reserved inside another arena and released with it
+    
+    umm ElementSize;
+    umm Count;
+    umm Capacity;
+};
+
+// NOTE: Zero is never a valid handle
+typedef u32 memory_pool_handle;
+
+// NOTE: Free slots are linked through DenseIndex
+struct memory_pool_slot
+{
+    u32 Generation;
+    u32 DenseIndex;
+};
+
+// NOTE: Live elements are packed at the front of Dense, releasing moves the last one into the hole, so iterate
+// backwards when releasing while iterating. Handles go through the slots and stay valid when elements move.
+struct memory_pool
+{
+    memory_array Dense;
+    memory_array DenseSlots; // NOTE: u32 slot index of every dense element
+    memory_array Slots;
+    
+    u32 FreeSlot; // NOTE: MemoryPoolIndexMask when there is none
+};
+
+// NOTE: Two arenas that take turns a frame each. MemoryFrameSwap resets the older one and makes it current, so what
+// was pushed during the previous frame can still be read while the next one is built
+struct memory_frame_arenas
+{
+    memory_arena Arenas[2];
+    u32 Current;
+};
+
+// NOTE: A ring buffer over a mirrored mapping, the same pages follow each other twice in the address space, so any
+// read or write of up to Size bytes is contiguous even where it wraps around. Positions only ever grow and are
+// wrapped with Size - 1 when used. One producer and one consumer can use it from different threads
+struct memory_ring
+{
+    u8 *Memory;
+    umm Size;
+    
+    volatile u64 ReadPosition;
+    volatile u64 WritePosition;
+};
+
+struct memory_slab_block
+{
+    memory_slab_block *Next;
+};
+
+// NOTE: Sits in the first MemorySlabHeaderSize bytes of every slab. A slab belongs to the thread that carved it, only
+// that thread touches its free blocks, every other thread hands blocks back through the owner's remote list
+struct memory_slab
+{
+    memory_slab *Next; // NOTE: In the owner's list for the class while it has free blocks, or in the free slabs
+    memory_slab *Previous;
+    
+    union
+    {
+        struct
+        {
+            memory_slab_block *FreeBlocks;
+            u8 *Unused; // NOTE: Blocks from here on were never handed out
+        };
+        
+        // NOTE: Large allocations
+        struct
+        {
+            u8 *Reservation;
+            umm ReservationSize;
+        };
+    };
+    
+    umm BlockSize;
+    u32 ClassIndex;
+    u32 Owner;
+    u32 UsedCount;
+    u32 BlocksCount;
+};
+
+struct memory_slab_cache
+{
+    memory_slab *Slabs[MemorySlabClassesCount]; // NOTE: Slabs with free blocks, the first one is allocated from
+    
+    // NOTE: Pushed to by other threads and taken as a whole by the owner, so there is no ABA problem. On its own cache
+    // line so remote frees don't keep stealing the line with the owner's lists
+    AlignAs(64) memory_slab_block *volatile RemoteFree;
+};
+
+// NOTE: Slabs are carved from the arena under a spin lock, which is only taken once per slab and for large
+// allocations. Slabs that become empty go to FreeSlabs where any thread or class can pick them up again
+struct memory_slab_allocator
+{
+    memory_arena Arena;
+    volatile u32 Lock;
+    
+    memory_slab *FreeSlabs;
+    memory_slab *LargeSlabs;
+    
+    memory_slab_cache *Caches; // NOTE: MemorySlabThreadsMax of them, indexed by thread index
 };
 
 struct memory_temporary
 {
     memory_arena *Arena;
+    u32 BlocksCount;
     umm Used;
 };
 
@@ -48,17 +265,26 @@ struct memory_temporary
   GLOBALS
 */
 
+#if WASP_MEMORY_INSTRUMENT
+global memory_arena_stats *volatile GlobalMemoryArenaStats;
+#endif
+
 /*
   FUNCTIONS
 */
 
 internal inline void MemorySet(void *DestinationInit, u8 Value, umm Size);
-internal inline void MemoryCopy(void *DestinationInit, void *SourceInit, umm Size);
+internal inline void MemoryCopy(void *DestinationInit, void *SourceInit, umm Size); // NOTE: The regions must not overlap
 
 #define ZeroStruct(Pointer) MemorySet(Pointer, 0, SizeOf(*Pointer))
 #define ZeroArray(Array) MemorySet(Array, 0, SizeOf(Array))
 #define ZeroBuffer(Buffer) MemorySet((Buffer).Data, 0, (Buffer).Size)
 
+// NOTE: Never elided, even when the memory is dead afterwards. Use it to wipe keys and other secrets
+internal void MemoryZeroSecure(void *Destination, umm Size);
+
+#define ZeroStructSecure(Pointer) MemoryZeroSecure(Pointer, SizeOf(*Pointer))
+
 // NOTE: These reserve/release functions wont do any syscalls if a size of zero is passed in, to avoid having to check for zero allocations (example FileReadEntire)
 internal void *MemoryReserveAndCommit(umm Size);
 internal void *MemoryReserve(umm Size);
@@ -72,15 +298,42 @@ internal inline void MemoryReleaseBuffer(buffer *Buffer);
 internal b32 MemoryCommit(void *Memory, umm Size);
 internal void MemoryDecommit(void *Memory, umm Size);
 
-internal memory_arena MemoryArenaFromBuffer(void *Data, umm Size, flag32(memory_arena_flag) Flags);
+// NOTE: Explicit huge pages come reserved and committed, and return zero if the OS can't hand them out. Transparent
+// ones are only reserved, aligned to the huge page size and advised, they are plain pages where the OS has no support
+internal umm GetHugePageSize(void);
+internal void *MemoryReserveHuge(umm Size, b32 Explicit);
+internal void MemoryPrefault(void *Memory, umm Size);
+
+// NOTE: Maps a whole file read only, returns an invalid buffer if the file is missing or empty
+internal buffer MemoryMapFile(char *FileName);
+internal void MemoryUnmapFile(buffer *Buffer);
+
+// NOTE: Maps the same Size bytes twice back to back and returns the start of the first copy, Size has to be a multiple
+// of the mirror granularity. Release takes the same Size, not the size of both copies
+internal umm GetMemoryMirrorGranularity(void);
+internal void *MemoryMirrorCreate(umm Size);
+internal void MemoryMirrorRelease(void *Memory, umm Size);
 
-internal memory_arena MemoryArenaCreate(umm Reserved, umm Committed, flag32(memory_arena_flag) Flags);
+// NOTE: The At variants take the call site for instrumentation, use the macros below instead of calling them directly
+#if WASP_MEMORY_INSTRUMENT
+#define MemorySite (char *)__FILE__, __LINE__
+#else
+#define MemorySite 0, 0
+#endif
+
+internal memory_arena MemoryArenaFromBufferAt(void *Data, umm Size, flag32(memory_arena_flag) Flags, char *File, int Line);
+#define MemoryArenaFromBuffer(Data, Size, Flags) MemoryArenaFromBufferAt(Data, Size, Flags, MemorySite)
+
+internal memory_arena MemoryArenaCreateAt(umm Reserved, umm Committed, flag32(memory_arena_flag) Flags, char *File, int Line);
+#define MemoryArenaCreate(Reserved, Committed, Flags) MemoryArenaCreateAt(Reserved, Committed, Flags, MemorySite)
 internal void MemoryArenaDestroy(memory_arena *Arena);
 
 // TODO: Possibly always return "valid" memory for these pushes, just have the same zeroed out page repeatedly mapped, and log to error system on failure?
 
-internal u8 *MemoryArenaPush(memory_arena *Arena, umm Size, umm Alignment);
-internal memory_arena MemoryArenaPushArena(memory_arena *Arena, umm Reserved, umm Committed, flag32(memory_arena_flag) Flags);
+internal u8 *MemoryArenaPushAt(memory_arena *Arena, umm Size, umm Alignment, char *File, int Line);
+#define MemoryArenaPush(Arena, Size, Alignment) MemoryArenaPushAt(Arena, Size, Alignment, MemorySite)
+internal memory_arena MemoryArenaPushArenaAt(memory_arena *Arena, umm Reserved, umm Committed, flag32(memory_arena_flag) Flags, char *File, int Line);
+#define MemoryArenaPushArena(Arena, Reserved, Committed, Flags) MemoryArenaPushArenaAt(Arena, Reserved, Committed, Flags, MemorySite)
 internal buffer MemoryArenaPushBufferOfSize(memory_arena *Arena, umm Size);
 internal buffer MemoryArenaPushBuffer(memory_arena *Arena, buffer Buffer);
 internal buffer MemoryArenaPushBuffers(memory_arena *Arena, buffer A, buffer B);
@@ -89,22 +342,326 @@ internal b32 MemoryArenaPushBufferInPlace(memory_arena *Arena, buffer *Buffer);
 #define MemoryArenaPushArray(Arena, Type, Aligned, Count) ((Type *)MemoryArenaPush(Arena, (Count) * SizeOf(Type), (Aligned) ? AlignOf(Type) : 1))
 #define MemoryArenaPushType(Arena, Type, Aligned) MemoryArenaPushArray(Arena, Type, Aligned, 1)
 
-// TODO: Array begin/end API
-
 internal void MemoryArenaReset(memory_arena *Arena);
 
+// NOTE: Counts every block of a chained arena
+internal inline umm MemoryArenaUsedTotal(memory_arena *Arena);
+
 internal inline memory_temporary MemoryTemporaryBegin(memory_arena *Arena);
 internal inline void MemoryTemporaryEnd(memory_temporary Temp); // TODO: Probably take in a pointer instead and invalidate the temp, it's maybe a bit weird this way? If we keep it like this at least call it reset instead, that makes more sense
 
 #define MemoryScratchBegin(Conflict) MemoryTemporaryBegin(MemoryScratchGet(Conflict))
 #define MemoryScratchEnd(Scratch) MemoryTemporaryEnd(Scratch)
 
+internal memory_frame_arenas MemoryFrameArenasCreate(umm Reserved, umm Committed, flag32(memory_arena_flag) Flags);
+internal void MemoryFrameArenasDestroy(memory_frame_arenas *Frames);
+internal inline memory_arena *MemoryFrameArena(memory_frame_arenas *Frames);
+internal inline memory_arena *MemoryFramePreviousArena(memory_frame_arenas *Frames);
+internal void MemoryFrameSwap(memory_frame_arenas *Frames);
+
+// NOTE: Size is rounded up to a power of two and the mirror granularity, the ring has no memory if mapping failed.
+// Begin hands out contiguous memory to fill or read in place, End publishes it to the other side. WriteBegin
+// returns zero when Size bytes aren't free, ReadBegin returns everything that has been written so far
+internal memory_ring MemoryRingCreate(umm Size);
+internal void MemoryRingDestroy(memory_ring *Ring);
+internal inline umm MemoryRingUsed(memory_ring *Ring);
+internal inline umm MemoryRingFree(memory_ring *Ring);
+internal u8 *MemoryRingWriteBegin(memory_ring *Ring, umm Size);
+internal void MemoryRingWriteEnd(memory_ring *Ring, umm Size);
+internal u8 *MemoryRingReadBegin(memory_ring *Ring, umm *Size);
+internal void MemoryRingReadEnd(memory_ring *Ring, umm Size);
+internal b32 MemoryRingWrite(memory_ring *Ring, void *Data, umm Size); // NOTE: All or nothing
+internal b32 MemoryRingRead(memory_ring *Ring, void *Data, umm Size);
+
+// NOTE: Reserved is the address space for all slabs, it is committed as slabs get carved. Alloc and Free can be
+// called from any thread, freeing a block another thread allocated defers it until that thread runs out of blocks of
+// the class or calls MemorySlabCollect. Blocks are not zeroed, Alloc returns zero when the reservation is used up
+internal memory_slab_allocator MemorySlabCreate(umm Reserved);
+internal void MemorySlabDestroy(memory_slab_allocator *Allocator);
+internal void *MemorySlabAlloc(memory_slab_allocator *Allocator, umm Size);
+internal void MemorySlabFree(memory_slab_allocator *Allocator, void *Memory); // NOTE: Zero is ignored
+internal void MemorySlabCollect(memory_slab_allocator *Allocator);
+internal void MemorySlabThreadRelease(memory_slab_allocator *Allocator); // NOTE: Before ThreadContextRelease, for every allocator the thread used
+internal inline umm MemorySlabSizeOf(void *Memory); // NOTE: Usable size, at least what was asked for
+
+#define MemorySlabAllocType(Allocator, Type) ((Type *)MemorySlabAlloc(Allocator, SizeOf(Type)))
+
+// NOTE: With an arena the range is reserved inside it and released with it, the whole range then counts as used in it.
+// Without one it gets its own reservation that MemoryArrayDestroy releases, prefer that for large worst case capacities.
+// The typed macros check the element size against the one the array was created with
+internal memory_array MemoryArrayCreateSized(memory_arena *Arena, umm ElementSize, umm Capacity);
+internal void MemoryArrayDestroy(memory_array *Array);
+internal void *MemoryArrayPush(memory_array *Array, umm ElementSize); // NOTE: Zeroed, or zero when full
+internal void *MemoryArrayAppend(memory_array *Array, umm ElementSize, void *Elements, umm Count); // NOTE: Zero when it doesn't fit
+internal inline void *MemoryArrayAt(memory_array *Array, umm ElementSize, umm Index);
+internal void MemoryArrayPop(memory_array *Array);
+internal void MemoryArraySwapRemove(memory_array *Array, umm Index);
+internal void MemoryArrayClear(memory_array *Array);
+internal inline umm MemoryArrayCommittedCount(memory_array *Array);
+internal inline umm MemoryArrayUsedTotal(memory_array *Array); // NOTE: Bytes of the elements pushed, not the capacity
+
+#define MemoryArrayCreate(Arena, Type, Capacity) MemoryArrayCreateSized(Arena, SizeOf(Type), Capacity)
+#define MemoryArrayPushType(Array, Type) ((Type *)MemoryArrayPush(Array, SizeOf(Type)))
+#define MemoryArrayAppendType(Array, Type, Elements, Count) ((Type *)MemoryArrayAppend(Array, SizeOf(Type), Elements, Count))
+#define MemoryArrayAtType(Array, Type, Index) ((Type *)MemoryArrayAt(Array, SizeOf(Type), Index))
+
+// NOTE: Backed by memory arrays, so it grows up to Capacity without ever copying
+internal memory_pool MemoryPoolCreateSized(memory_arena *Arena, umm ElementSize, u32 Capacity);
+internal void MemoryPoolDestroy(memory_pool *Pool); // NOTE: Only for pools created without an arena
+internal void *MemoryPoolAcquire(memory_pool *Pool, umm ElementSize, memory_pool_handle *Handle); // NOTE: Zeroed, or zero when full
+internal void *MemoryPoolGet(memory_pool *Pool, umm ElementSize, memory_pool_handle Handle); // NOTE: Zero for stale handles
+internal inline void *MemoryPoolAt(memory_pool *Pool, umm ElementSize, u32 Index);
+internal inline u32 MemoryPoolCount(memory_pool *Pool);
+internal b32 MemoryPoolRelease(memory_pool *Pool, memory_pool_handle Handle);
+internal void MemoryPoolReleaseAt(memory_pool *Pool, u32 Index);
+internal inline memory_pool_handle MemoryPoolHandleAt(memory_pool *Pool, u32 Index);
+internal void MemoryPoolClear(memory_pool *Pool);
+internal inline umm MemoryPoolUsedTotal(memory_pool *Pool); // NOTE: Bytes pushed into its arrays, not the capacity
+
+#define MemoryPoolCreate(Arena, Type, Capacity) MemoryPoolCreateSized(Arena, SizeOf(Type), Capacity)
+#define MemoryPoolAcquireType(Pool, Type, Handle) ((Type *)MemoryPoolAcquire(Pool, SizeOf(Type), Handle))
+#define MemoryPoolGetType(Pool, Type, Handle) ((Type *)MemoryPoolGet(Pool, SizeOf(Type), Handle))
+#define MemoryPoolAtType(Pool, Type, Index) ((Type *)MemoryPoolAt(Pool, SizeOf(Type), Index))
+
+// NOTE: These compile to nothing without WASP_MEMORY_INSTRUMENT
+internal inline void MemoryArenaName(memory_arena *Arena, char *Name);
+internal void MemoryInstrumentReport(void);
+
+#if WASP_MEMORY_INSTRUMENT
+internal void MemoryInstrumentRegister(memory_arena_stats *Stats); // NOTE: Implemented by platform layer, must be thread safe
+internal void Outf(char *Format, ...); // NOTE: Implemented by the string module
+#endif
+
 /*
   IMPLEMENTATION
 */
 
+#if Compiler_MSVC && !(Architecture_X86_64 || Architecture_X86_32)
+#include <intrin.h>
+#endif
+
+#if Architecture_X86_64 || Architecture_X86_32
+#if Compiler_MSVC
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+// NOTE: The vector width is picked at compile time, 32 bytes when compiled with AVX2 and 16 otherwise. Every path
+// handles the ends with unaligned vectors that overlap the body, so there are no byte loops past the smallest sizes.
+#if defined(__AVX2__)
+#define MemoryVectorSize 32
+#define memory_vector __m256i
+#define MemoryVectorLoad(Pointer) _mm256_loadu_si256((__m256i *)(Pointer))
+#define MemoryVectorStore(Pointer, Value) _mm256_storeu_si256((__m256i *)(Pointer), Value)
+#define MemoryVectorStoreAligned(Pointer, Value) _mm256_store_si256((__m256i *)(Pointer), Value)
+#define MemoryVectorStream(Pointer, Value) _mm256_stream_si256((__m256i *)(Pointer), Value)
+#define MemoryVectorSplat(Value) _mm256_set1_epi8((char)(Value))
+#else
+#define MemoryVectorSize 16
+#define memory_vector __m128i
+#define MemoryVectorLoad(Pointer) _mm_loadu_si128((__m128i *)(Pointer))
+#define MemoryVectorStore(Pointer, Value) _mm_storeu_si128((__m128i *)(Pointer), Value)
+#define MemoryVectorStoreAligned(Pointer, Value) _mm_store_si128((__m128i *)(Pointer), Value)
+#define MemoryVectorStream(Pointer, Value) _mm_stream_si128((__m128i *)(Pointer), Value)
+#define MemoryVectorSplat(Value) _mm_set1_epi8((char)(Value))
+#endif
+
+// NOTE: Bigger than 2 vectors, the first and last vector are stored unaligned and the body in between aligned
+internal void
+MemorySetLarge(u8 *Destination, u8 Value, umm Size)
+{
+    memory_vector Vector = MemoryVectorSplat(Value);
+    
+    u8 *End = Destination + Size;
+    MemoryVectorStore(Destination, Vector);
+    MemoryVectorStore(End - MemoryVectorSize, Vector);
+    
+    u8 *At = (u8 *)(((umm)Destination + MemoryVectorSize) & ~(umm)(MemoryVectorSize - 1));
+    umm Remaining = (umm)(End - At);
+    
+    if(Size >= MemoryNonTemporalThreshold)
+    {
+        while(Remaining >= 4*MemoryVectorSize)
+        {
+            MemoryVectorStream(At + 0*MemoryVectorSize, Vector);
+            MemoryVectorStream(At + 1*MemoryVectorSize, Vector);
+            MemoryVectorStream(At + 2*MemoryVectorSize, Vector);
+            MemoryVectorStream(At + 3*MemoryVectorSize, Vector);
+            At += 4*MemoryVectorSize;
+            Remaining -= 4*MemoryVectorSize;
+        }
+        
+        // NOTE: Streaming stores are weakly ordered, make them visible before anything stored after this returns
+        _mm_sfence();
+    }
+    else
+    {
+        while(Remaining >= 4*MemoryVectorSize)
+        {
+            MemoryVectorStoreAligned(At + 0*MemoryVectorSize, Vector);
+            MemoryVectorStoreAligned(At + 1*MemoryVectorSize, Vector);
+            MemoryVectorStoreAligned(At + 2*MemoryVectorSize, Vector);
+            MemoryVectorStoreAligned(At + 3*MemoryVectorSize, Vector);
+            At += 4*MemoryVectorSize;
+            Remaining -= 4*MemoryVectorSize;
+        }
+    }
+    
+    while(Remaining > MemoryVectorSize)
+    {
+        MemoryVectorStoreAligned(At, Vector);
+        At += MemoryVectorSize;
+        Remaining -= MemoryVectorSize;
+    }
+}
+
+internal void
+MemoryCopyLarge(u8 *Destination, u8 *Source, umm Size)
+{
+    // NOTE: Both ends are loaded up front, the stores of the body may not overlap them since the regions are disjoint
+    memory_vector Head = MemoryVectorLoad(Source);
+    memory_vector Tail = MemoryVectorLoad(Source + Size - MemoryVectorSize);
+    
+    umm Skip = MemoryVectorSize - ((umm)Destination & (MemoryVectorSize - 1));
+    u8 *At = Destination + Skip;
+    u8 *From = Source + Skip;
+    umm Remaining = Size - Skip;
+    
+    if(Size >= MemoryNonTemporalThreshold)
+    {
+        while(Remaining >= 4*MemoryVectorSize)
+        {
+            memory_vector A = MemoryVectorLoad(From + 0*MemoryVectorSize);
+            memory_vector B = MemoryVectorLoad(From + 1*MemoryVectorSize);
+            memory_vector C = MemoryVectorLoad(From + 2*MemoryVectorSize);
+            memory_vector D = MemoryVectorLoad(From + 3*MemoryVectorSize);
+            MemoryVectorStream(At + 0*MemoryVectorSize, A);
+            MemoryVectorStream(At + 1*MemoryVectorSize, B);
+            MemoryVectorStream(At + 2*MemoryVectorSize, C);
+            MemoryVectorStream(At + 3*MemoryVectorSize, D);
+            At += 4*MemoryVectorSize;
+            From += 4*MemoryVectorSize;
+            Remaining -= 4*MemoryVectorSize;
+        }
+        
+        _mm_sfence();
+    }
+    else
+    {
+        while(Remaining >= 4*MemoryVectorSize)
+        {
+            memory_vector A = MemoryVectorLoad(From + 0*MemoryVectorSize);
+            memory_vector B = MemoryVectorLoad(From + 1*MemoryVectorSize);
+            memory_vector C = MemoryVectorLoad(From + 2*MemoryVectorSize);
+            memory_vector D = MemoryVectorLoad(From + 3*MemoryVectorSize);
+            MemoryVectorStoreAligned(At + 0*MemoryVectorSize, A);
+            MemoryVectorStoreAligned(At + 1*MemoryVectorSize, B);
+            MemoryVectorStoreAligned(At + 2*MemoryVectorSize, C);
+            MemoryVectorStoreAligned(At + 3*MemoryVectorSize, D);
+            At += 4*MemoryVectorSize;
+            From += 4*MemoryVectorSize;
+            Remaining -= 4*MemoryVectorSize;
+        }
+    }
+    
+    while(Remaining > MemoryVectorSize)
+    {
+        MemoryVectorStoreAligned(At, MemoryVectorLoad(From));
+        At += MemoryVectorSize;
+        From += MemoryVectorSize;
+        Remaining -= MemoryVectorSize;
+    }
+    
+    MemoryVectorStore(Destination, Head);
+    MemoryVectorStore(Destination + Size - MemoryVectorSize, Tail);
+}
+
+internal inline void
+MemorySet(void *DestinationInit, u8 Value, umm Size)
+{
+    u8 *Destination = (u8 *)DestinationInit;
+    
+    if(Size < 8)
+    {
+        while(Size--)
+        {
+            *Destination++ = Value;
+        }
+    }
+    else if(Size <= 16)
+    {
+        __m128i Vector = _mm_set1_epi8((char)Value);
+        _mm_storel_epi64((__m128i *)Destination, Vector);
+        _mm_storel_epi64((__m128i *)(Destination + Size - 8), Vector);
+    }
+    else if(Size <= 32)
+    {
+        __m128i Vector = _mm_set1_epi8((char)Value);
+        _mm_storeu_si128((__m128i *)Destination, Vector);
+        _mm_storeu_si128((__m128i *)(Destination + Size - 16), Vector);
+    }
+#if MemoryVectorSize == 32
+    else if(Size <= 64)
+    {
+        __m256i Vector = _mm256_set1_epi8((char)Value);
+        _mm256_storeu_si256((__m256i *)Destination, Vector);
+        _mm256_storeu_si256((__m256i *)(Destination + Size - 32), Vector);
+    }
+#endif
+    else
+    {
+        MemorySetLarge(Destination, Value, Size);
+    }
+}
+
+internal inline void
+MemoryCopy(void *DestinationInit, void *SourceInit, umm Size)
+{
+    u8 *Destination = (u8 *)DestinationInit;
+    u8 *Source = (u8 *)SourceInit;
+    
+    if(Size < 8)
+    {
+        while(Size--)
+        {
+            *Destination++ = *Source++;
+        }
+    }
+    else if(Size <= 16)
+    {
+        __m128i Head = _mm_loadl_epi64((__m128i *)Source);
+        __m128i Tail = _mm_loadl_epi64((__m128i *)(Source + Size - 8));
+        _mm_storel_epi64((__m128i *)Destination, Head);
+        _mm_storel_epi64((__m128i *)(Destination + Size - 8), Tail);
+    }
+    else if(Size <= 32)
+    {
+        __m128i Head = _mm_loadu_si128((__m128i *)Source);
+        __m128i Tail = _mm_loadu_si128((__m128i *)(Source + Size - 16));
+        _mm_storeu_si128((__m128i *)Destination, Head);
+        _mm_storeu_si128((__m128i *)(Destination + Size - 16), Tail);
+    }
+#if MemoryVectorSize == 32
+    else if(Size <= 64)
+    {
+        __m256i Head = _mm256_loadu_si256((__m256i *)Source);
+        __m256i Tail = _mm256_loadu_si256((__m256i *)(Source + Size - 32));
+        _mm256_storeu_si256((__m256i *)Destination, Head);
+        _mm256_storeu_si256((__m256i *)(Destination + Size - 32), Tail);
+    }
+#endif
+    else
+    {
+        MemoryCopyLarge(Destination, Source, Size);
+    }
+}
+
+#else
+
+// TODO: Vectorize this for ARM and WASM
 internal inline void
-MemorySet(void *DestinationInit, u8 Value, umm Size) // TODO: Make sure that this cant be optimized out (for zeroing)
+MemorySet(void *DestinationInit, u8 Value, umm Size)
 {
     u8 *Destination = (u8 *)DestinationInit;
     
@@ -126,6 +683,26 @@ MemoryCopy(void *DestinationInit, void *SourceInit, umm Size)
     }
 }
 
+#endif
+
+internal void
+MemoryZeroSecure(void *Destination, umm Size)
+{
+#if Compiler_MSVC
+    // NOTE: Every store through a volatile pointer is observable, so none of them can be dropped
+    volatile u8 *At = (volatile u8 *)Destination;
+    while(Size--)
+    {
+        *At++ = 0;
+    }
+#else
+    MemorySet(Destination, 0, Size);
+    
+    // NOTE: The compiler has to assume the asm reads the memory through the pointer, so the stores above are live
+    __asm__ __volatile__("" : : "r"(Destination) : "memory");
+#endif
+}
+
 internal inline buffer
 MemoryReserveAndCommitBuffer(umm Size)
 {
@@ -166,128 +743,482 @@ MemoryReleaseBuffer(buffer *Buffer)
     ZeroStruct(Buffer);
 }
 
-internal memory_arena
-MemoryArenaFromBuffer(void *Data, umm Size, flag32(memory_arena_flag) Flags)
+#if WASP_MEMORY_INSTRUMENT
+
+internal void
+MemoryInstrumentCreate(memory_arena *Arena, memory_arena_stats *Parent, char *File, int Line)
 {
-    memory_arena Result = {};
+    memory_arena_stats *Stats = (memory_arena_stats *)MemoryReserveAndCommit(SizeOf(memory_arena_stats));
+    Assert(Stats);
     
-    Result.Memory_ = (u8 *)Data;
-    Result.Reserved = Size;
-    Result.Committed = Size;
-    Result.Flags = Flags;
+    Stats->Parent = Parent;
+    Stats->File = File;
+    Stats->Line = Line;
+    Stats->Reserved = Arena->PreviousReserved + Arena->Reserved;
+    Stats->Committed = Arena->PreviousCommitted + Arena->Committed;
     
-    return(Result);
+    Arena->Stats = Stats;
+    
+    MemoryInstrumentRegister(Stats);
 }
 
-internal memory_arena
-MemoryArenaCreate(umm Reserved, umm Committed, flag32(memory_arena_flag) Flags)
+internal void
+MemoryInstrumentCommit(memory_arena *Arena, char *File, int Line)
 {
-    if(!Reserved)
-    {
-        Reserved = Committed;
-    }
+    memory_arena_stats *Stats = Arena->Stats;
     
-    Assert(Reserved >= Committed);
+    memory_commit_event *Event = &Stats->Commits[Stats->CommitsCount++ % MemoryInstrumentCommitsCount];
+    Event->File = File;
+    Event->Line = Line;
+    Event->Used = Arena->PreviousUsed + Arena->Used;
+    Event->Committed = Arena->PreviousCommitted + Arena->Committed;
     
-    umm PageSize = GetPageSize();
-    Assert(Reserved >= PageSize);
-    Assert(IsAligned(Reserved, PageSize));
-    Assert(IsAligned(Committed, PageSize));
+    Stats->Committed = Event->Committed;
+}
+
+// NOTE: After blocks were added or released, or the arena was rolled back
+internal void
+MemoryInstrumentSync(memory_arena *Arena)
+{
+    memory_arena_stats *Stats = Arena->Stats;
     
-    memory_arena Result = {};
+    Stats->Reserved = Arena->PreviousReserved + Arena->Reserved;
+    Stats->Committed = Arena->PreviousCommitted + Arena->Committed;
+    Stats->Used = Arena->PreviousUsed + Arena->Used;
+}
+
+internal void
+MemoryInstrumentPush(memory_arena *Arena, umm Size, char *File, int Line)
+{
+    memory_arena_stats *Stats = Arena->Stats;
     
-    void *Memory = MemoryReserve(Reserved);
-    if(Memory)
+    memory_push_site *Site = 0;
+    for(u32 Index = 0;
+        Index < Stats->SitesCount;
+        Index++)
     {
-        if(!Committed || MemoryCommit(Memory, Committed))
+        // NOTE: __FILE__ strings aren't guaranteed to be pooled, but this is only a few extra entries if they are not
+        if(Stats->Sites[Index].Line == Line && Stats->Sites[Index].File == File)
         {
-            Result.Memory_ = (u8 *)Memory;
-            Result.Reserved = Reserved;
-            Result.Committed = Committed;
-            Result.Flags = Flags;
+            Site = &Stats->Sites[Index];
+            break;
+        }
+    }
+    
+    if(!Site)
+    {
+        if(Stats->SitesCount < MemoryInstrumentSitesCount)
+        {
+            Site = &Stats->Sites[Stats->SitesCount++];
+            Site->File = File;
+            Site->Line = Line;
         }
         else
         {
-            MemoryRelease(Memory, Reserved);
+            Site = &Stats->Sites[MemoryInstrumentSitesCount - 1];
+            Site->File = "(other sites)";
+            Site->Line = 0;
         }
     }
     
-    if(!Result.Reserved && !(Result.Flags & MemoryArenaFlag_AllowFailedCreate))
-    {
-        Assert(0); // TODO: Some better more specific crash function, but don't use the logging system, it relies on this function to begin with!
-    }
+    Site->PushesCount++;
+    Site->Bytes += Size;
+    Site->LargestPush = Max(Site->LargestPush, Size);
     
-    return(Result);
+    Stats->PushesCount++;
+    Stats->Used = Arena->PreviousUsed + Arena->Used;
+    Stats->HighWater = Max(Stats->HighWater, Stats->Used);
 }
 
 internal void
-MemoryArenaDestroy(memory_arena *Arena)
+MemoryInstrumentReportArena(memory_arena_stats *Stats)
 {
-    Assert(Arena);
-    Assert(!Arena->Released);
+    Outf("arena %s", Stats->Name ? Stats->Name : "(unnamed)");
+    if(Stats->File)
+    {
+        Outf(" created at %s:%d", Stats->File, Stats->Line);
+    }
+    if(Stats->Parent)
+    {
+        Outf(" inside %s", Stats->Parent->Name ? Stats->Parent->Name : "(unnamed)");
+    }
+    Outf("%s\n", Stats->Destroyed ? " (destroyed)" : "");
     
-    if(Arena->Reserved)
+    Outf("    used %llu, high water %llu, committed %llu, reserved %llu bytes\n",
+         (u64)Stats->Used, (u64)Stats->HighWater, (u64)Stats->Committed, (u64)Stats->Reserved);
+    Outf("    %llu pushes, %u commits, %u failed pushes\n",
+         Stats->PushesCount, Stats->CommitsCount, Stats->FailedPushesCount);
+    
+    u32 CommitsCount = Min(Stats->CommitsCount, (u32)MemoryInstrumentCommitsCount);
+    for(u32 Offset = CommitsCount;
+        Offset >= 1;
+        Offset--)
     {
-        MemoryRelease(Arena->Memory_, Arena->Reserved);
+        memory_commit_event *Event = &Stats->Commits[(Stats->CommitsCount - Offset) % MemoryInstrumentCommitsCount];
+        Outf("    commit to %llu bytes at %llu used, from %s:%d\n",
+             (u64)Event->Committed, (u64)Event->Used, Event->File ? Event->File : "(unknown)", Event->Line);
     }
     
-    ZeroStruct(Arena);
-    Arena->Released = 1;
+    // NOTE: Biggest sites first, the table is small enough that a selection sort is fine
+    u8 Printed[MemoryInstrumentSitesCount] = {};
+    for(u32 Rank = 0;
+        Rank < Stats->SitesCount;
+        Rank++)
+    {
+        u32 Best = 0;
+        b32 Found = 0;
+        for(u32 Index = 0;
+            Index < Stats->SitesCount;
+            Index++)
+        {
+            if(!Printed[Index] && (!Found || Stats->Sites[Index].Bytes > Stats->Sites[Best].Bytes))
+            {
+                Best = Index;
+                Found = 1;
+            }
+        }
+        
+        memory_push_site *Site = &Stats->Sites[Best];
+        Printed[Best] = 1;
+        
+        Outf("    %llu bytes in %llu pushes, largest %llu, from %s:%d\n",
+             (u64)Site->Bytes, Site->PushesCount, (u64)Site->LargestPush, Site->File ? Site->File : "(unknown)", Site->Line);
+    }
+}
+
+#endif
+
+internal inline void
+MemoryArenaName(memory_arena *Arena, char *Name)
+{
+#if WASP_MEMORY_INSTRUMENT
+    Assert(Arena);
+    
+    if(Arena->Stats)
+    {
+        Arena->Stats->Name = Name;
+    }
+#else
+    (void)(Arena);
+    (void)(Name);
+#endif
 }
 
+// NOTE: Reserves an arena or a chained block with the huge page and prefault flags applied, Reserved and Committed
+// are rounded up as needed. Returns zero with nothing reserved if the reserve or the commit fails
 internal u8 *
-MemoryArenaPush(memory_arena *Arena, umm Size, umm Alignment)
+MemoryArenaReserve(flag32(memory_arena_flag) Flags, umm *Reserved, umm *Committed)
+{
+    u8 *Result = 0;
+    b32 PreCommitted = 0;
+    
+    if(Flags & (MemoryArenaFlag_HugePages|MemoryArenaFlag_HugePagesExplicit))
+    {
+        umm HugePageSize = GetHugePageSize();
+        *Reserved = AlignUp(*Reserved, HugePageSize);
+        *Committed = AlignUp(*Committed, HugePageSize);
+        
+        if(Flags & MemoryArenaFlag_HugePagesExplicit)
+        {
+            Result = (u8 *)MemoryReserveHuge(*Reserved, 1);
+            if(Result)
+            {
+                *Committed = *Reserved;
+                PreCommitted = 1; // NOTE: Pool pages are allocated when mapped, so there's nothing to prefault either
+            }
+        }
+        
+        if(!Result)
+        {
+            Result = (u8 *)MemoryReserveHuge(*Reserved, 0);
+        }
+    }
+    else
+    {
+        Result = (u8 *)MemoryReserve(*Reserved);
+    }
+    
+    if(Result && *Committed && !PreCommitted)
+    {
+        if(MemoryCommit(Result, *Committed))
+        {
+            if(Flags & MemoryArenaFlag_Prefault)
+            {
+                MemoryPrefault(Result, *Committed);
+            }
+        }
+        else
+        {
+            MemoryRelease(Result, *Reserved);
+            Result = 0;
+        }
+    }
+    
+    return(Result);
+}
+
+internal memory_arena
+MemoryArenaFromBufferAt(void *Data, umm Size, flag32(memory_arena_flag) Flags, char *File, int Line)
+{
+    memory_arena Result = {};
+    
+    Result.Memory_ = (u8 *)Data;
+    Result.Reserved = Size;
+    Result.Committed = Size;
+    Result.Baseline = Size;
+    Result.Flags = Flags;
+    Result.BlockSize = Size;
+    
+#if WASP_MEMORY_INSTRUMENT
+    MemoryInstrumentCreate(&Result, 0, File, Line);
+#else
+    (void)(File);
+    (void)(Line);
+#endif
+    
+    return(Result);
+}
+
+internal memory_arena
+MemoryArenaCreateAt(umm Reserved, umm Committed, flag32(memory_arena_flag) Flags, char *File, int Line)
+{
+    if(!Reserved)
+    {
+        Reserved = Committed;
+    }
+    
+    Assert(Reserved >= Committed);
+    
+    umm PageSize = GetPageSize();
+    Assert(Reserved >= PageSize);
+    Assert(IsAligned(Reserved, PageSize));
+    Assert(IsAligned(Committed, PageSize));
+    
+    memory_arena Result = {};
+    
+    u8 *Memory = MemoryArenaReserve(Flags, &Reserved, &Committed);
+    if(Memory)
+    {
+        Result.Memory_ = Memory;
+        Result.Reserved = Reserved;
+        Result.Committed = Committed;
+        Result.Baseline = Committed;
+        Result.Flags = Flags;
+        Result.BlockSize = Reserved;
+    }
+    
+    if(!Result.Reserved && !(Result.Flags & MemoryArenaFlag_AllowFailedCreate))
+    {
+        Assert(0); // TODO: Some better more specific crash function, but don't use the logging system, it relies on this function to begin with!
+    }
+    
+#if WASP_MEMORY_INSTRUMENT
+    if(Result.Reserved)
+    {
+        MemoryInstrumentCreate(&Result, 0, File, Line);
+    }
+#else
+    (void)(File);
+    (void)(Line);
+#endif
+    
+    return(Result);
+}
+
+// NOTE: Links a new block in front of the current one, big enough for Size bytes at Alignment after the block header
+internal b32
+MemoryArenaBlockPush(memory_arena *Arena, umm Size, umm Alignment)
+{
+    b32 Result = 0;
+    
+    umm PageSize = GetPageSize();
+    umm Reserved = AlignUp(Max(Arena->BlockSize, SizeOf(memory_arena_block) + Alignment + Size), PageSize);
+    umm Committed = AlignUp(SizeOf(memory_arena_block), PageSize);
+    
+    u8 *Memory = MemoryArenaReserve(Arena->Flags, &Reserved, &Committed);
+    if(Memory)
+    {
+        memory_arena_block *Block = (memory_arena_block *)Memory;
+        Block->Memory = Arena->Memory_;
+        Block->Reserved = Arena->Reserved;
+        Block->Committed = Arena->Committed;
+        Block->Used = Arena->Used;
+        
+        Arena->PreviousReserved += Arena->Reserved;
+        Arena->PreviousCommitted += Arena->Committed;
+        Arena->PreviousUsed += Arena->Used;
+        
+        Arena->Memory_ = Memory;
+        Arena->Reserved = Reserved;
+        Arena->Committed = Committed;
+        Arena->Used = SizeOf(memory_arena_block);
+        Arena->BlocksCount++;
+        
+        Result = 1;
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryArenaBlockPop(memory_arena *Arena)
+{
+    Assert(Arena->BlocksCount);
+    
+    memory_arena_block Block = *(memory_arena_block *)Arena->Memory_;
+    
+    MemoryRelease(Arena->Memory_, Arena->Reserved);
+    
+    Arena->Memory_ = Block.Memory;
+    Arena->Reserved = Block.Reserved;
+    Arena->Committed = Block.Committed;
+    Arena->Used = Block.Used;
+    Arena->BlocksCount--;
+    
+    Arena->PreviousReserved -= Block.Reserved;
+    Arena->PreviousCommitted -= Block.Committed;
+    Arena->PreviousUsed -= Block.Used;
+}
+
+internal void
+MemoryArenaDestroy(memory_arena *Arena)
 {
     Assert(Arena);
     Assert(!Arena->Released);
     
-    Assert(Alignment);
-    Assert(IsPowerOfTwo(Alignment)); // TODO: Probably remove this requirement... It's due to the AlignUp macro requiring power of two for now...
+    while(Arena->BlocksCount)
+    {
+        MemoryArenaBlockPop(Arena);
+    }
+    
+    if(Arena->Reserved)
+    {
+        MemoryRelease(Arena->Memory_, Arena->Reserved);
+    }
+    
+#if WASP_MEMORY_INSTRUMENT
+    if(Arena->Stats)
+    {
+        Arena->Stats->Destroyed = 1; // NOTE: Kept around so the report still covers short lived arenas
+    }
+#endif
     
+    ZeroStruct(Arena);
+    Arena->Released = 1;
+}
+
+// NOTE: Only pushes into the current block, returns zero without any error handling if it doesn't fit
+internal u8 *
+MemoryArenaPushInBlock(memory_arena *Arena, umm Size, umm Alignment, char *File, int Line)
+{
     u8 *Result = 0;
     
-    if(Size)
+    umm Used = AlignUp(Arena->Used, Alignment);
+    umm NewUsed = Used + Size;
+    
+    if(NewUsed <= Arena->Reserved)
     {
-        umm Used = AlignUp(Arena->Used, Alignment);
-        umm NewUsed = Used + Size;
-        
-        if(NewUsed <= Arena->Reserved)
+        if(NewUsed > Arena->Committed)
         {
-            if(NewUsed > Arena->Committed)
+            umm PageSize = GetPageSize();
+            Assert(Arena->Reserved >= PageSize);
+            Assert(IsAligned(Arena->Reserved, PageSize));
+            Assert(IsAligned(Arena->Committed, PageSize));
+            
+            umm NewCommitted;
+            
+            if(Arena->Flags & MemoryArenaFlag_OnlyCommitAsNeeded)
             {
-                umm PageSize = GetPageSize();
-                Assert(Arena->Reserved >= PageSize);
-                Assert(IsAligned(Arena->Reserved, PageSize));
-                Assert(IsAligned(Arena->Committed, PageSize));
-                
-                umm NewCommitted;
-                
-                if(Arena->Flags & MemoryArenaFlag_OnlyCommitAsNeeded)
-                {
-                    NewCommitted = AlignUp(NewUsed, PageSize);
-                }
-                else
+                NewCommitted = AlignUp(NewUsed, PageSize);
+            }
+            else
+            {
+                NewCommitted = AlignUpToPowerOfTwo(NewUsed);
+            }
+            
+            if(Arena->Flags & (MemoryArenaFlag_HugePages|MemoryArenaFlag_HugePagesExplicit))
+            {
+                // NOTE: A partially committed huge page can't be backed by one
+                NewCommitted = AlignUp(NewCommitted, GetHugePageSize());
+            }
+            
+            NewCommitted = Clamp(NewCommitted, PageSize, Arena->Reserved);
+            
+            if(MemoryCommit(Arena->Memory_ + Arena->Committed, NewCommitted - Arena->Committed))
+            {
+                if(Arena->Flags & MemoryArenaFlag_Prefault)
                 {
-                    NewCommitted = AlignUpToPowerOfTwo(NewUsed);
+                    MemoryPrefault(Arena->Memory_ + Arena->Committed, NewCommitted - Arena->Committed);
                 }
                 
-                NewCommitted = Clamp(NewCommitted, PageSize, Arena->Reserved);
+                Arena->Committed = NewCommitted;
                 
-                if(MemoryCommit(Arena->Memory_, NewCommitted)) // TODO: For speed we might want to only pass in the pages that are relevant?
-                {
-                    Arena->Committed = NewCommitted;
-                }
+#if WASP_MEMORY_INSTRUMENT
+                if(Arena->Stats) MemoryInstrumentCommit(Arena, File, Line);
+#endif
             }
+        }
+        
+        if(NewUsed <= Arena->Committed)
+        {
+            Result = Arena->Memory_ + Used;
+            Arena->Used = NewUsed;
+        }
+    }
+    
+#if !WASP_MEMORY_INSTRUMENT
+    (void)(File);
+    (void)(Line);
+#endif
+    
+    return(Result);
+}
+
+internal u8 *
+MemoryArenaPushAt(memory_arena *Arena, umm Size, umm Alignment, char *File, int Line)
+{
+    Assert(Arena);
+    Assert(!Arena->Released);
+    
+    Assert(Alignment);
+    Assert(IsPowerOfTwo(Alignment)); // TODO: Probably remove this requirement... It's due to the AlignUp macro requiring power of two for now...
+    
+    u8 *Result = 0;
+    
+    if(Size)
+    {
+        Result = MemoryArenaPushInBlock(Arena, Size, Alignment, File, Line);
+        
+        if(!Result && (Arena->Flags & MemoryArenaFlag_Chained) && MemoryArenaBlockPush(Arena, Size, Alignment))
+        {
+#if WASP_MEMORY_INSTRUMENT
+            if(Arena->Stats) MemoryInstrumentSync(Arena);
+#endif
             
-            if(NewUsed <= Arena->Committed)
-            {
-                Result = Arena->Memory_ + Used;
-                Arena->Used = NewUsed;
-            }
+            Result = MemoryArenaPushInBlock(Arena, Size, Alignment, File, Line);
         }
         
-        if(!Result)
+        if(Result)
         {
+#if WASP_MEMORY_INSTRUMENT
+            if(Arena->Stats) MemoryInstrumentPush(Arena, Size, File, Line);
+#endif
+        }
+        else
+        {
+#if WASP_MEMORY_INSTRUMENT
+            if(Arena->Stats)
+            {
+                Arena->Stats->FailedPushesCount++;
+                
+                if(!(Arena->Flags & MemoryArenaFlag_AllowFailedPush))
+                {
+                    Outf("failed to push %llu bytes from %s:%d\n", (u64)Size, File, Line);
+                    MemoryInstrumentReportArena(Arena->Stats);
+                }
+            }
+#endif
+            
             if(Arena->Flags & MemoryArenaFlag_AllowFailedPush)
             {
                 Logf(LogSeverity_Error, "Failed to push %llu bytes", Size); // TODO: More specific info
@@ -303,7 +1234,7 @@ MemoryArenaPush(memory_arena *Arena, umm Size, umm Alignment)
 }
 
 internal memory_arena
-MemoryArenaPushArena(memory_arena *Arena, umm Reserved, umm Committed, flag32(memory_arena_flag) Flags)
+MemoryArenaPushArenaAt(memory_arena *Arena, umm Reserved, umm Committed, flag32(memory_arena_flag) Flags, char *File, int Line)
 {
     Assert(Arena);
     Assert(!Arena->Released);
@@ -322,23 +1253,59 @@ MemoryArenaPushArena(memory_arena *Arena, umm Reserved, umm Committed, flag32(me
     
     memory_arena Result = {};
     
-    umm NewUsed = Arena->Committed + Reserved;
-    if(NewUsed <= Arena->Reserved)
+    // NOTE: The sub-arena starts at the first unused page, a chained arena gets a new block if that's too far in. Not
+    // at the first uncommitted page, a huge page block commits a whole huge page or all of itself up front
+    umm Start = AlignUp(Arena->Used, PageSize);
+    b32 Fits = Start + Reserved <= Arena->Reserved;
+    if(!Fits && (Arena->Flags & MemoryArenaFlag_Chained))
+    {
+        if(MemoryArenaBlockPush(Arena, Reserved, PageSize))
+        {
+            Start = AlignUp(Arena->Used, PageSize);
+            Fits = Start + Reserved <= Arena->Reserved;
+        }
+    }
+    
+    if(Fits)
     {
-        u8 *Memory = Arena->Memory_ + Arena->Committed;
+        umm NewUsed = Start + Reserved;
+        u8 *Memory = Arena->Memory_ + Start;
         if(!Committed || MemoryCommit(Memory, Committed))
         {
             Result.Memory_ = (u8 *)Memory;
             Result.Reserved = Reserved;
             Result.Committed = Committed;
-            Result.Flags = Flags;
+            Result.Baseline = Committed;
+            Result.Flags = Flags & ~MemoryArenaFlag_Chained; // NOTE: Its blocks would outlive the parent's
+            Result.BlockSize = Reserved;
             
-            Arena->Committed = NewUsed;
+            Arena->Committed = Max(Arena->Committed, NewUsed);
             Arena->Used = NewUsed;
             Arena->CantReset = 1;
+            
+#if WASP_MEMORY_INSTRUMENT
+            if(Arena->Stats)
+            {
+                MemoryInstrumentSync(Arena);
+                MemoryInstrumentCommit(Arena, File, Line);
+                MemoryInstrumentPush(Arena, Reserved, File, Line);
+            }
+            
+            MemoryInstrumentCreate(&Result, Arena->Stats, File, Line);
+#endif
         }
     }
     
+    if(!Result.Reserved && !(Flags & MemoryArenaFlag_AllowFailedCreate))
+    {
+        Assert(0); // TODO: Some better more specific crash function, same as in MemoryArenaCreateAt
+    }
+    
+#if !WASP_MEMORY_INSTRUMENT
+    (void)(File);
+    (void)(Line);
+#endif
+    
     return(Result);
 }
 
@@ -412,7 +1379,31 @@ MemoryArenaReset(memory_arena *Arena)
     Assert(!Arena->Released);
     Assert(!Arena->CantReset);
     
-    Arena->Used = 0; // TODO: Possibly allow decommitting on reset with a flag?
+    while(Arena->BlocksCount)
+    {
+        MemoryArenaBlockPop(Arena);
+    }
+    
+    Arena->Used = 0;
+    
+    if((Arena->Flags & MemoryArenaFlag_DecommitOnReset) && Arena->Committed > Arena->Baseline)
+    {
+        MemoryDecommit(Arena->Memory_ + Arena->Baseline, Arena->Committed - Arena->Baseline);
+        Arena->Committed = Arena->Baseline;
+    }
+    
+#if WASP_MEMORY_INSTRUMENT
+    if(Arena->Stats) MemoryInstrumentSync(Arena);
+#endif
+}
+
+internal inline umm
+MemoryArenaUsedTotal(memory_arena *Arena)
+{
+    Assert(Arena);
+    
+    umm Result = Arena->PreviousUsed + Arena->Used;
+    return(Result);
 }
 
 internal inline memory_temporary
@@ -423,6 +1414,7 @@ MemoryTemporaryBegin(memory_arena *Arena)
     
     memory_temporary Result;
     Result.Arena = Arena;
+    Result.BlocksCount = Arena->BlocksCount;
     Result.Used = Arena->Used;
     return(Result);
 }
@@ -433,28 +1425,1009 @@ MemoryTemporaryEnd(memory_temporary Temp)
     // NOTE: Obviously this wont save you from a new arena relacing the old one, but we don't care "enough" for that case to have some sort of incremental ID attached
     Assert(Temp.Arena);
     Assert(!Temp.Arena->Released);
+    Assert(Temp.Arena->BlocksCount >= Temp.BlocksCount);
+    
+    while(Temp.Arena->BlocksCount > Temp.BlocksCount)
+    {
+        MemoryArenaBlockPop(Temp.Arena);
+    }
     
     Temp.Arena->Used = Temp.Used;
+    
+#if WASP_MEMORY_INSTRUMENT
+    if(Temp.Arena->Stats) MemoryInstrumentSync(Temp.Arena);
+#endif
 }
 
-internal memory_arena *MemoryArenasGet(void); // NOTE: Implemented by platform layer
-
-internal memory_arena *
-MemoryScratchGet(memory_arena *Conflict)
+internal memory_array
+MemoryArrayCreateSized(memory_arena *Arena, umm ElementSize, umm Capacity)
 {
-    memory_arena *Result = 0;
-    memory_arena *Arenas = MemoryArenasGet();
+    Assert(ElementSize);
+    Assert(Capacity);
     
-    for(u32 Index = 0;
-        Index < 2;
-        Index++)
+    umm PageSize = GetPageSize();
+    umm Reserved = AlignUp(ElementSize * Capacity, PageSize);
+    
+    // NOTE: The range starts on a page, so any element alignment up to the page size holds
+    memory_array Result = {};
+    Result.ElementSize = ElementSize;
+    Result.Capacity = Capacity;
+    
+    if(Arena)
     {
-        memory_arena *Arena = Arenas + Index;
-        if(Arena != Conflict)
-        {
-            Result = Arena;
-            break;
-        }
+        Result.Arena = MemoryArenaPushArena(Arena, Reserved, 0, MemoryArenaFlag_OnlyCommitAsNeeded);
+        Result.InArena = 1;
+    }
+    else
+    {
+        Result.Arena = MemoryArenaCreate(Reserved, 0, MemoryArenaFlag_OnlyCommitAsNeeded);
+    }
+    
+    Assert(Result.Arena.Reserved);
+    
+    return(Result);
+}
+
+internal void
+MemoryArrayDestroy(memory_array *Array)
+{
+    Assert(Array);
+    Assert(!Array->InArena);
+    
+    MemoryArenaDestroy(&Array->Arena);
+    ZeroStruct(Array);
+}
+
+internal void *
+MemoryArrayAppend(memory_array *Array, umm ElementSize, void *Elements, umm Count)
+{
+    Assert(Array);
+    Assert(Array->ElementSize == ElementSize);
+    
+    u8 *Result = 0;
+    
+    if(Count && Count <= Array->Capacity - Array->Count)
+    {
+        Result = MemoryArenaPush(&Array->Arena, ElementSize * Count, 1);
+        Array->Count += Count;
+        
+        if(Elements)
+        {
+            MemoryCopy(Result, Elements, ElementSize * Count);
+        }
+        else
+        {
+            MemorySet(Result, 0, ElementSize * Count);
+        }
+    }
+    
+    return(Result);
+}
+
+internal void *
+MemoryArrayPush(memory_array *Array, umm ElementSize)
+{
+    void *Result = MemoryArrayAppend(Array, ElementSize, 0, 1);
+    return(Result);
+}
+
+internal inline void *
+MemoryArrayAt(memory_array *Array, umm ElementSize, umm Index)
+{
+    Assert(Array);
+    Assert(Array->ElementSize == ElementSize);
+    Assert(Index < Array->Count);
+    
+    void *Result = Array->Arena.Memory_ + Index * ElementSize;
+    return(Result);
+}
+
+internal void
+MemoryArrayPop(memory_array *Array)
+{
+    Assert(Array);
+    Assert(Array->Count);
+    
+    Array->Count--;
+    Array->Arena.Used = Array->Count * Array->ElementSize;
+}
+
+internal void
+MemoryArraySwapRemove(memory_array *Array, umm Index)
+{
+    Assert(Array);
+    Assert(Index < Array->Count);
+    
+    umm LastIndex = Array->Count - 1;
+    if(Index != LastIndex)
+    {
+        MemoryCopy(Array->Arena.Memory_ + Index * Array->ElementSize, Array->Arena.Memory_ + LastIndex * Array->ElementSize, Array->ElementSize);
+    }
+    
+    MemoryArrayPop(Array);
+}
+
+internal void
+MemoryArrayClear(memory_array *Array)
+{
+    Assert(Array);
+    
+    Array->Count = 0;
+    Array->Arena.Used = 0;
+}
+
+internal inline umm
+MemoryArrayCommittedCount(memory_array *Array)
+{
+    Assert(Array);
+    
+    umm Result = Array->Arena.Committed / Array->ElementSize;
+    return(Result);
+}
+
+internal inline umm
+MemoryArrayUsedTotal(memory_array *Array)
+{
+    Assert(Array);
+    
+    umm Result = Array->Count * Array->ElementSize;
+    return(Result);
+}
+
+internal memory_pool
+MemoryPoolCreateSized(memory_arena *Arena, umm ElementSize, u32 Capacity)
+{
+    Assert(Capacity && Capacity <= MemoryPoolCapacityMax);
+    
+    memory_pool Result = {};
+    Result.Dense = MemoryArrayCreateSized(Arena, ElementSize, Capacity);
+    Result.DenseSlots = MemoryArrayCreate(Arena, u32, Capacity);
+    Result.Slots = MemoryArrayCreate(Arena, memory_pool_slot, Capacity);
+    Result.FreeSlot = MemoryPoolIndexMask;
+    
+    return(Result);
+}
+
+internal void
+MemoryPoolDestroy(memory_pool *Pool)
+{
+    Assert(Pool);
+    
+    MemoryArrayDestroy(&Pool->Dense);
+    MemoryArrayDestroy(&Pool->DenseSlots);
+    MemoryArrayDestroy(&Pool->Slots);
+}
+
+internal void *
+MemoryPoolAcquire(memory_pool *Pool, umm ElementSize, memory_pool_handle *Handle)
+{
+    Assert(Pool);
+    
+    void *Result = 0;
+    
+    if(Pool->Dense.Count < Pool->Dense.Capacity)
+    {
+        u32 SlotIndex;
+        memory_pool_slot *Slot;
+        
+        if(Pool->FreeSlot != MemoryPoolIndexMask)
+        {
+            SlotIndex = Pool->FreeSlot;
+            Slot = MemoryArrayAtType(&Pool->Slots, memory_pool_slot, SlotIndex);
+            Pool->FreeSlot = Slot->DenseIndex;
+        }
+        else
+        {
+            // NOTE: Every slot is in use when there are no free ones, so there is one left past the used ones
+            SlotIndex = (u32)Pool->Slots.Count;
+            Slot = MemoryArrayPushType(&Pool->Slots, memory_pool_slot);
+            Slot->Generation = 1;
+        }
+        
+        u32 DenseIndex = (u32)Pool->Dense.Count;
+        
+        Result = MemoryArrayPush(&Pool->Dense, ElementSize);
+        *MemoryArrayPushType(&Pool->DenseSlots, u32) = SlotIndex;
+        Slot->DenseIndex = DenseIndex;
+        
+        if(Handle)
+        {
+            *Handle = (Slot->Generation << MemoryPoolIndexBits) | SlotIndex;
+        }
+    }
+    else if(Handle)
+    {
+        *Handle = 0;
+    }
+    
+    return(Result);
+}
+
+internal inline memory_pool_slot *
+MemoryPoolSlotGet(memory_pool *Pool, memory_pool_handle Handle)
+{
+    memory_pool_slot *Result = 0;
+    
+    u32 SlotIndex = Handle & MemoryPoolIndexMask;
+    if(SlotIndex < Pool->Slots.Count)
+    {
+        memory_pool_slot *Slot = MemoryArrayAtType(&Pool->Slots, memory_pool_slot, SlotIndex);
+        if(Slot->Generation == (Handle >> MemoryPoolIndexBits))
+        {
+            Result = Slot;
+        }
+    }
+    
+    return(Result);
+}
+
+internal void *
+MemoryPoolGet(memory_pool *Pool, umm ElementSize, memory_pool_handle Handle)
+{
+    Assert(Pool);
+    
+    void *Result = 0;
+    
+    memory_pool_slot *Slot = MemoryPoolSlotGet(Pool, Handle);
+    if(Slot)
+    {
+        Result = MemoryArrayAt(&Pool->Dense, ElementSize, Slot->DenseIndex);
+    }
+    
+    return(Result);
+}
+
+internal inline void *
+MemoryPoolAt(memory_pool *Pool, umm ElementSize, u32 Index)
+{
+    Assert(Pool);
+    
+    void *Result = MemoryArrayAt(&Pool->Dense, ElementSize, Index);
+    return(Result);
+}
+
+internal inline u32
+MemoryPoolCount(memory_pool *Pool)
+{
+    Assert(Pool);
+    
+    u32 Result = (u32)Pool->Dense.Count;
+    return(Result);
+}
+
+internal inline memory_pool_handle
+MemoryPoolHandleAt(memory_pool *Pool, u32 Index)
+{
+    Assert(Pool);
+    
+    u32 SlotIndex = *MemoryArrayAtType(&Pool->DenseSlots, u32, Index);
+    memory_pool_slot *Slot = MemoryArrayAtType(&Pool->Slots, memory_pool_slot, SlotIndex);
+    
+    memory_pool_handle Result = (Slot->Generation << MemoryPoolIndexBits) | SlotIndex;
+    return(Result);
+}
+
+internal void
+MemoryPoolReleaseAt(memory_pool *Pool, u32 Index)
+{
+    Assert(Pool);
+    
+    u32 SlotIndex = *MemoryArrayAtType(&Pool->DenseSlots, u32, Index);
+    
+    // NOTE: The last element moves into the hole, its slot has to follow it
+    u32 LastIndex = (u32)Pool->Dense.Count - 1;
+    if(Index != LastIndex)
+    {
+        u32 MovedSlotIndex = *MemoryArrayAtType(&Pool->DenseSlots, u32, LastIndex);
+        MemoryArrayAtType(&Pool->Slots, memory_pool_slot, MovedSlotIndex)->DenseIndex = Index;
+    }
+    
+    MemoryArraySwapRemove(&Pool->Dense, Index);
+    MemoryArraySwapRemove(&Pool->DenseSlots, Index);
+    
+    // NOTE: Generation zero is skipped on wrap around, so no handle is ever zero
+    memory_pool_slot *Slot = MemoryArrayAtType(&Pool->Slots, memory_pool_slot, SlotIndex);
+    Slot->Generation = (Slot->Generation + 1) & (MaxU32 >> MemoryPoolIndexBits);
+    if(!Slot->Generation)
+    {
+        Slot->Generation = 1;
+    }
+    
+    Slot->DenseIndex = Pool->FreeSlot;
+    Pool->FreeSlot = SlotIndex;
+}
+
+internal b32
+MemoryPoolRelease(memory_pool *Pool, memory_pool_handle Handle)
+{
+    Assert(Pool);
+    
+    b32 Result = 0;
+    
+    memory_pool_slot *Slot = MemoryPoolSlotGet(Pool, Handle);
+    if(Slot && Slot->DenseIndex < Pool->Dense.Count && *MemoryArrayAtType(&Pool->DenseSlots, u32, Slot->DenseIndex) == (Handle & MemoryPoolIndexMask))
+    {
+        MemoryPoolReleaseAt(Pool, Slot->DenseIndex);
+        Result = 1;
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryPoolClear(memory_pool *Pool)
+{
+    Assert(Pool);
+    
+    while(Pool->Dense.Count)
+    {
+        MemoryPoolReleaseAt(Pool, (u32)Pool->Dense.Count - 1);
+    }
+}
+
+internal inline umm
+MemoryPoolUsedTotal(memory_pool *Pool)
+{
+    Assert(Pool);
+    
+    umm Result = MemoryArrayUsedTotal(&Pool->Dense) + MemoryArrayUsedTotal(&Pool->DenseSlots) + MemoryArrayUsedTotal(&Pool->Slots);
+    return(Result);
+}
+
+internal memory_frame_arenas
+MemoryFrameArenasCreate(umm Reserved, umm Committed, flag32(memory_arena_flag) Flags)
+{
+    memory_frame_arenas Result = {};
+    
+    for(u32 Index = 0;
+        Index < ArrayCount(Result.Arenas);
+        Index++)
+    {
+        Result.Arenas[Index] = MemoryArenaCreate(Reserved, Committed, Flags);
+        MemoryArenaName(&Result.Arenas[Index], "frame");
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryFrameArenasDestroy(memory_frame_arenas *Frames)
+{
+    Assert(Frames);
+    
+    for(u32 Index = 0;
+        Index < ArrayCount(Frames->Arenas);
+        Index++)
+    {
+        MemoryArenaDestroy(&Frames->Arenas[Index]);
+    }
+}
+
+internal inline memory_arena *
+MemoryFrameArena(memory_frame_arenas *Frames)
+{
+    Assert(Frames);
+    
+    memory_arena *Result = &Frames->Arenas[Frames->Current];
+    return(Result);
+}
+
+internal inline memory_arena *
+MemoryFramePreviousArena(memory_frame_arenas *Frames)
+{
+    Assert(Frames);
+    
+    memory_arena *Result = &Frames->Arenas[Frames->Current ^ 1];
+    return(Result);
+}
+
+internal void
+MemoryFrameSwap(memory_frame_arenas *Frames)
+{
+    Assert(Frames);
+    
+    Frames->Current ^= 1;
+    MemoryArenaReset(&Frames->Arenas[Frames->Current]);
+}
+
+// NOTE: The side that doesn't own a position has to see the data before it sees the position move
+internal inline u64
+MemoryRingLoadPosition(volatile u64 *Position)
+{
+#if Compiler_MSVC
+    u64 Result = *Position;
+    _ReadWriteBarrier();
+#else
+    u64 Result = __atomic_load_n(Position, __ATOMIC_ACQUIRE);
+#endif
+    
+    return(Result);
+}
+
+internal inline void
+MemoryRingStorePosition(volatile u64 *Position, u64 Value)
+{
+#if Compiler_MSVC
+    _ReadWriteBarrier();
+    *Position = Value;
+#else
+    __atomic_store_n(Position, Value, __ATOMIC_RELEASE);
+#endif
+}
+
+internal memory_ring
+MemoryRingCreate(umm Size)
+{
+    // NOTE: A power of two so positions wrap with a mask, and a multiple of the granularity so it can be mirrored
+    Size = AlignUpToPowerOfTwo(Max(Size, GetMemoryMirrorGranularity()));
+    
+    memory_ring Result = {};
+    Result.Memory = (u8 *)MemoryMirrorCreate(Size);
+    if(Result.Memory)
+    {
+        Result.Size = Size;
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryRingDestroy(memory_ring *Ring)
+{
+    Assert(Ring);
+    
+    if(Ring->Memory)
+    {
+        MemoryMirrorRelease(Ring->Memory, Ring->Size);
+    }
+    
+    ZeroStruct(Ring);
+}
+
+internal inline umm
+MemoryRingUsed(memory_ring *Ring)
+{
+    Assert(Ring);
+    
+    umm Result = (umm)(MemoryRingLoadPosition(&Ring->WritePosition) - MemoryRingLoadPosition(&Ring->ReadPosition));
+    return(Result);
+}
+
+internal inline umm
+MemoryRingFree(memory_ring *Ring)
+{
+    umm Result = Ring->Size - MemoryRingUsed(Ring);
+    return(Result);
+}
+
+internal u8 *
+MemoryRingWriteBegin(memory_ring *Ring, umm Size)
+{
+    Assert(Ring);
+    Assert(Size <= Ring->Size);
+    
+    u8 *Result = 0;
+    
+    u64 WritePosition = Ring->WritePosition;
+    if(Ring->Size - (umm)(WritePosition - MemoryRingLoadPosition(&Ring->ReadPosition)) >= Size)
+    {
+        Result = Ring->Memory + (WritePosition & (Ring->Size - 1));
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryRingWriteEnd(memory_ring *Ring, umm Size)
+{
+    Assert(Ring);
+    Assert(Size <= MemoryRingFree(Ring));
+    
+    MemoryRingStorePosition(&Ring->WritePosition, Ring->WritePosition + Size);
+}
+
+internal u8 *
+MemoryRingReadBegin(memory_ring *Ring, umm *Size)
+{
+    Assert(Ring);
+    Assert(Size);
+    
+    u64 ReadPosition = Ring->ReadPosition;
+    *Size = (umm)(MemoryRingLoadPosition(&Ring->WritePosition) - ReadPosition);
+    
+    u8 *Result = Ring->Memory + (ReadPosition & (Ring->Size - 1));
+    return(Result);
+}
+
+internal void
+MemoryRingReadEnd(memory_ring *Ring, umm Size)
+{
+    Assert(Ring);
+    Assert(Size <= MemoryRingUsed(Ring));
+    
+    MemoryRingStorePosition(&Ring->ReadPosition, Ring->ReadPosition + Size);
+}
+
+internal b32
+MemoryRingWrite(memory_ring *Ring, void *Data, umm Size)
+{
+    u8 *Destination = MemoryRingWriteBegin(Ring, Size);
+    
+    b32 Result = Destination != 0;
+    if(Result)
+    {
+        MemoryCopy(Destination, Data, Size);
+        MemoryRingWriteEnd(Ring, Size);
+    }
+    
+    return(Result);
+}
+
+internal b32
+MemoryRingRead(memory_ring *Ring, void *Data, umm Size)
+{
+    umm Available;
+    u8 *Source = MemoryRingReadBegin(Ring, &Available);
+    
+    b32 Result = Available >= Size;
+    if(Result)
+    {
+        MemoryCopy(Data, Source, Size);
+        MemoryRingReadEnd(Ring, Size);
+    }
+    
+    return(Result);
+}
+
+internal u32 ThreadIndexGet(void); // NOTE: Implemented by platform layer
+
+internal inline memory_slab *
+MemorySlabFromPointer(void *Memory)
+{
+    memory_slab *Result = (memory_slab *)((umm)Memory & ~(umm)(MemorySlabSize - 1));
+    return(Result);
+}
+
+internal inline u32
+MemorySlabClassIndex(umm Size)
+{
+    Assert(Size <= MemorySlabBlockSizeMax);
+    
+    u32 Result = 0;
+    if(Size > ((umm)1 << MemorySlabClassShiftMin))
+    {
+        // NOTE: The class is the number of bits Size - 1 needs, minus the smallest class
+#if Compiler_MSVC
+        unsigned long Bit;
+        _BitScanReverse(&Bit, (u32)(Size - 1));
+        Result = (u32)Bit + 1 - MemorySlabClassShiftMin;
+#else
+        Result = (u32)(32 - __builtin_clz((u32)(Size - 1))) - MemorySlabClassShiftMin;
+#endif
+    }
+    
+    return(Result);
+}
+
+internal void
+MemorySlabLock(memory_slab_allocator *Allocator)
+{
+#if Compiler_MSVC
+    while(_InterlockedExchange((volatile long *)&Allocator->Lock, 1))
+#else
+    while(__atomic_exchange_n(&Allocator->Lock, 1, __ATOMIC_ACQUIRE))
+#endif
+    {
+#if Architecture_X86_64 || Architecture_X86_32
+        _mm_pause();
+#endif
+    }
+}
+
+internal void
+MemorySlabUnlock(memory_slab_allocator *Allocator)
+{
+#if Compiler_MSVC
+    _InterlockedExchange((volatile long *)&Allocator->Lock, 0);
+#else
+    __atomic_store_n(&Allocator->Lock, 0, __ATOMIC_RELEASE);
+#endif
+}
+
+internal void
+MemorySlabRemotePush(memory_slab_cache *Cache, memory_slab_block *Block)
+{
+#if Compiler_MSVC
+    memory_slab_block *Head;
+    do
+    {
+        Head = Cache->RemoteFree;
+        Block->Next = Head;
+    }
+    while(_InterlockedCompareExchangePointer((void *volatile *)&Cache->RemoteFree, Block, Head) != Head);
+#else
+    memory_slab_block *Head = __atomic_load_n(&Cache->RemoteFree, __ATOMIC_RELAXED);
+    do
+    {
+        Block->Next = Head;
+    }
+    while(!__atomic_compare_exchange_n(&Cache->RemoteFree, &Head, Block, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#endif
+}
+
+internal memory_slab_block *
+MemorySlabRemoteTake(memory_slab_cache *Cache)
+{
+#if Compiler_MSVC
+    memory_slab_block *Result = (memory_slab_block *)_InterlockedExchangePointer((void *volatile *)&Cache->RemoteFree, 0);
+#else
+    memory_slab_block *Result = __atomic_exchange_n(&Cache->RemoteFree, (memory_slab_block *)0, __ATOMIC_ACQUIRE);
+#endif
+    
+    return(Result);
+}
+
+internal inline void
+MemorySlabLink(memory_slab **Head, memory_slab *Slab)
+{
+    Slab->Previous = 0;
+    Slab->Next = *Head;
+    if(*Head)
+    {
+        (*Head)->Previous = Slab;
+    }
+    
+    *Head = Slab;
+}
+
+internal inline void
+MemorySlabUnlink(memory_slab **Head, memory_slab *Slab)
+{
+    if(Slab->Previous)
+    {
+        Slab->Previous->Next = Slab->Next;
+    }
+    else
+    {
+        Assert(*Head == Slab);
+        *Head = Slab->Next;
+    }
+    
+    if(Slab->Next)
+    {
+        Slab->Next->Previous = Slab->Previous;
+    }
+    
+    Slab->Next = 0;
+    Slab->Previous = 0;
+}
+
+internal memory_slab_allocator
+MemorySlabCreate(umm Reserved)
+{
+    memory_slab_allocator Result = {};
+    Result.Arena = MemoryArenaCreate(Reserved, 0, MemoryArenaFlag_OnlyCommitAsNeeded|MemoryArenaFlag_AllowFailedPush);
+    MemoryArenaName(&Result.Arena, "slabs");
+    
+    Result.Caches = MemoryArenaPushArray(&Result.Arena, memory_slab_cache, 1, MemorySlabThreadsMax);
+    
+    // NOTE: Only whole slabs are pushed from here on, so aligning the first one aligns all of them
+    umm Address = (umm)(Result.Arena.Memory_ + Result.Arena.Used);
+    umm Padding = AlignUp(Address, MemorySlabSize) - Address;
+    if(Padding)
+    {
+        MemoryArenaPush(&Result.Arena, Padding, 1);
+    }
+    
+    return(Result);
+}
+
+internal void
+MemorySlabDestroy(memory_slab_allocator *Allocator)
+{
+    Assert(Allocator);
+    
+    memory_slab *Slab = Allocator->LargeSlabs;
+    while(Slab)
+    {
+        memory_slab *Next = Slab->Next;
+        MemoryRelease(Slab->Reservation, Slab->ReservationSize);
+        Slab = Next;
+    }
+    
+    MemoryArenaDestroy(&Allocator->Arena);
+    ZeroStruct(Allocator);
+}
+
+internal memory_slab *
+MemorySlabAcquire(memory_slab_allocator *Allocator, u32 ClassIndex, u32 Owner)
+{
+    MemorySlabLock(Allocator);
+    
+    memory_slab *Result = Allocator->FreeSlabs;
+    if(Result)
+    {
+        Allocator->FreeSlabs = Result->Next;
+    }
+    else
+    {
+        Result = (memory_slab *)MemoryArenaPush(&Allocator->Arena, MemorySlabSize, 1);
+    }
+    
+    MemorySlabUnlock(Allocator);
+    
+    if(Result)
+    {
+        Assert(MemorySlabFromPointer(Result) == Result);
+        
+        umm BlockSize = (umm)1 << (ClassIndex + MemorySlabClassShiftMin);
+        
+        Result->Next = 0;
+        Result->Previous = 0;
+        Result->FreeBlocks = 0;
+        Result->Unused = (u8 *)Result + MemorySlabHeaderSize;
+        Result->BlockSize = BlockSize;
+        Result->ClassIndex = ClassIndex;
+        Result->Owner = Owner;
+        Result->UsedCount = 0;
+        Result->BlocksCount = (u32)((MemorySlabSize - MemorySlabHeaderSize) / BlockSize);
+    }
+    
+    return(Result);
+}
+
+internal void *
+MemorySlabAllocLarge(memory_slab_allocator *Allocator, umm Size)
+{
+    void *Result = 0;
+    
+    // NOTE: Reserve a slab more than needed so the header can sit at a slab aligned address
+    umm Committed = AlignUp(MemorySlabHeaderSize + Size, GetPageSize());
+    umm ReservationSize = Committed + MemorySlabSize;
+    
+    u8 *Reservation = (u8 *)MemoryReserve(ReservationSize);
+    if(Reservation)
+    {
+        memory_slab *Slab = (memory_slab *)AlignUp((umm)Reservation, MemorySlabSize);
+        if(MemoryCommit(Slab, Committed))
+        {
+            Slab->Reservation = Reservation;
+            Slab->ReservationSize = ReservationSize;
+            Slab->BlockSize = Size;
+            Slab->ClassIndex = MemorySlabClassLarge;
+            Slab->Owner = 0;
+            Slab->UsedCount = 1;
+            Slab->BlocksCount = 1;
+            
+            MemorySlabLock(Allocator);
+            MemorySlabLink(&Allocator->LargeSlabs, Slab);
+            MemorySlabUnlock(Allocator);
+            
+            Result = (u8 *)Slab + MemorySlabHeaderSize;
+        }
+        else
+        {
+            MemoryRelease(Reservation, ReservationSize);
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+MemorySlabFreeLocal(memory_slab_allocator *Allocator, memory_slab_cache *Cache, memory_slab *Slab, memory_slab_block *Block)
+{
+    memory_slab **Slabs = Cache->Slabs + Slab->ClassIndex;
+    
+    if(Slab->UsedCount == Slab->BlocksCount)
+    {
+        MemorySlabLink(Slabs, Slab);
+    }
+    
+    Block->Next = Slab->FreeBlocks;
+    Slab->FreeBlocks = Block;
+    Slab->UsedCount--;
+    
+    // NOTE: Every class keeps its last slab even when it is empty, so a single block going back and forth doesn't
+    // take the lock every time
+    if(!Slab->UsedCount && (Slab->Next || Slab->Previous))
+    {
+        MemorySlabUnlink(Slabs, Slab);
+        
+        MemorySlabLock(Allocator);
+        Slab->Next = Allocator->FreeSlabs;
+        Allocator->FreeSlabs = Slab;
+        MemorySlabUnlock(Allocator);
+    }
+}
+
+internal void
+MemorySlabCollectCache(memory_slab_allocator *Allocator, memory_slab_cache *Cache)
+{
+    memory_slab_block *Block = MemorySlabRemoteTake(Cache);
+    while(Block)
+    {
+        memory_slab_block *Next = Block->Next;
+        MemorySlabFreeLocal(Allocator, Cache, MemorySlabFromPointer(Block), Block);
+        Block = Next;
+    }
+}
+
+internal void
+MemorySlabCollect(memory_slab_allocator *Allocator)
+{
+    Assert(Allocator);
+    
+    u32 Owner = ThreadIndexGet();
+    Assert(Owner < MemorySlabThreadsMax);
+    
+    MemorySlabCollectCache(Allocator, Allocator->Caches + Owner);
+}
+
+// NOTE: Slabs that still have blocks out stay in the cache, the next thread that gets this thread index adopts them
+// together with whatever other threads free into them in the meantime
+internal void
+MemorySlabThreadRelease(memory_slab_allocator *Allocator)
+{
+    Assert(Allocator);
+    
+    u32 Owner = ThreadIndexGet();
+    Assert(Owner < MemorySlabThreadsMax);
+    
+    memory_slab_cache *Cache = Allocator->Caches + Owner;
+    MemorySlabCollectCache(Allocator, Cache);
+    
+    for(u32 ClassIndex = 0;
+        ClassIndex < MemorySlabClassesCount;
+        ClassIndex++)
+    {
+        memory_slab *Slab = Cache->Slabs[ClassIndex];
+        while(Slab)
+        {
+            memory_slab *Next = Slab->Next;
+            
+            if(!Slab->UsedCount)
+            {
+                MemorySlabUnlink(Cache->Slabs + ClassIndex, Slab);
+                
+                MemorySlabLock(Allocator);
+                Slab->Next = Allocator->FreeSlabs;
+                Allocator->FreeSlabs = Slab;
+                MemorySlabUnlock(Allocator);
+            }
+            
+            Slab = Next;
+        }
+    }
+}
+
+internal void *
+MemorySlabAlloc(memory_slab_allocator *Allocator, umm Size)
+{
+    Assert(Allocator);
+    Assert(Allocator->Caches);
+    
+    void *Result = 0;
+    
+    if(Size > MemorySlabBlockSizeMax)
+    {
+        Result = MemorySlabAllocLarge(Allocator, Size);
+    }
+    else
+    {
+        u32 Owner = ThreadIndexGet();
+        Assert(Owner < MemorySlabThreadsMax);
+        
+        memory_slab_cache *Cache = Allocator->Caches + Owner;
+        u32 ClassIndex = MemorySlabClassIndex(Size);
+        
+        memory_slab *Slab = Cache->Slabs[ClassIndex];
+        if(!Slab)
+        {
+            // NOTE: Blocks other threads gave back might refill the class before we carve a new slab
+            MemorySlabCollectCache(Allocator, Cache);
+            
+            Slab = Cache->Slabs[ClassIndex];
+            if(!Slab)
+            {
+                Slab = MemorySlabAcquire(Allocator, ClassIndex, Owner);
+                if(Slab)
+                {
+                    MemorySlabLink(Cache->Slabs + ClassIndex, Slab);
+                }
+            }
+        }
+        
+        if(Slab)
+        {
+            memory_slab_block *Block = Slab->FreeBlocks;
+            if(Block)
+            {
+                Slab->FreeBlocks = Block->Next;
+            }
+            else
+            {
+                Block = (memory_slab_block *)Slab->Unused;
+                Slab->Unused += Slab->BlockSize;
+            }
+            
+            Slab->UsedCount++;
+            if(Slab->UsedCount == Slab->BlocksCount)
+            {
+                MemorySlabUnlink(Cache->Slabs + ClassIndex, Slab);
+            }
+            
+            Result = Block;
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+MemorySlabFree(memory_slab_allocator *Allocator, void *Memory)
+{
+    Assert(Allocator);
+    
+    if(Memory)
+    {
+        memory_slab *Slab = MemorySlabFromPointer(Memory);
+        
+        if(Slab->ClassIndex == MemorySlabClassLarge)
+        {
+            MemorySlabLock(Allocator);
+            MemorySlabUnlink(&Allocator->LargeSlabs, Slab);
+            MemorySlabUnlock(Allocator);
+            
+            MemoryRelease(Slab->Reservation, Slab->ReservationSize);
+        }
+        else
+        {
+            Assert(Slab->Owner < MemorySlabThreadsMax);
+            Assert(Slab->UsedCount);
+            
+            memory_slab_block *Block = (memory_slab_block *)Memory;
+            memory_slab_cache *Cache = Allocator->Caches + Slab->Owner;
+            
+            if(Slab->Owner == ThreadIndexGet())
+            {
+                MemorySlabFreeLocal(Allocator, Cache, Slab, Block);
+            }
+            else
+            {
+                MemorySlabRemotePush(Cache, Block);
+            }
+        }
+    }
+}
+
+internal inline umm
+MemorySlabSizeOf(void *Memory)
+{
+    Assert(Memory);
+    
+    umm Result = MemorySlabFromPointer(Memory)->BlockSize;
+    return(Result);
+}
+
+internal memory_arena *MemoryArenasGet(void); // NOTE: Implemented by platform layer
+
+internal memory_arena *
+MemoryScratchGet(memory_arena *Conflict)
+{
+    memory_arena *Result = 0;
+    memory_arena *Arenas = MemoryArenasGet();
+    
+    for(u32 Index = 0;
+        Index < 2;
+        Index++)
+    {
+        memory_arena *Arena = Arenas + Index;
+        if(Arena != Conflict)
+        {
+            Result = Arena;
+            break;
+        }
     }
     
     Assert(Result);
@@ -471,7 +2444,69 @@ MemoryInit(void)
         Index++)
     {
         Arenas[Index] = MemoryArenaCreate(MB(2), KB(32), 0); // TODO: Some way to change this
+        MemoryArenaName(&Arenas[Index], "scratch");
+    }
+}
+
+// NOTE: Arenas are listed in creation order, sub-arenas right after the top level arena they live in
+internal void
+MemoryInstrumentReport(void)
+{
+#if WASP_MEMORY_INSTRUMENT
+    memory_arena_stats *Stop = 0;
+    for(;;)
+    {
+        // NOTE: The list is newest first, so walk up to the last one we haven't printed yet
+        memory_arena_stats *Root = 0;
+        for(memory_arena_stats *Stats = GlobalMemoryArenaStats;
+            Stats != Stop;
+            Stats = Stats->Next)
+        {
+            if(!Stats->Parent)
+            {
+                Root = Stats;
+            }
+        }
+        
+        if(!Root)
+        {
+            break;
+        }
+        
+        MemoryInstrumentReportArena(Root);
+        
+        memory_arena_stats *ChildStop = 0;
+        for(;;)
+        {
+            memory_arena_stats *Child = 0;
+            for(memory_arena_stats *Stats = GlobalMemoryArenaStats;
+                Stats != ChildStop;
+                Stats = Stats->Next)
+            {
+                memory_arena_stats *Ancestor = Stats->Parent;
+                while(Ancestor && Ancestor->Parent)
+                {
+                    Ancestor = Ancestor->Parent;
+                }
+                
+                if(Ancestor == Root)
+                {
+                    Child = Stats;
+                }
+            }
+            
+            if(!Child)
+            {
+                break;
+            }
+            
+            MemoryInstrumentReportArena(Child);
+            ChildStop = Child;
+        }
+        
+        Stop = Root;
     }
+#endif
 }
 
 #endif // WASP_MEMORY_H
\ No newline at end of file
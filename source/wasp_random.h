@@ -0,0 +1,510 @@
+#ifndef WASP_H
+#error This module depends on wasp.h
+#endif
+
+#ifndef WASP_RANDOM_H
+#define WASP_RANDOM_H
+
+// NOTE: Seedable pseudo random streams, xoshiro128+ underneath. Not for anything that has to be unpredictable. A series
+// is identified by a seed and a stream number, give every system or every entity its own stream and the values each
+// one gets no longer depend on the order the others draw in, so the work can be split up or run in parallel without
+// changing the results. The x4 and x8 series run 4 or 8 consecutive streams side by side with SSE2 or AVX2, lane N of
+// RandomSeriesX8Create(Seed, Stream) is the same series as RandomSeriesCreate(Seed, Stream + N) and can be split off
+// with RandomSeriesX8Lane to carry on one value at a time. The scalar path produces the same values on every other
+// target, floats included, so a stream can be replayed anywhere.
+//
+// The low bits of xoshiro128+ are its weakest, the floats and RandomChoice only use the high ones.
+
+/*
+  CONSTANTS
+*/
+
+#define RandomGolden64 0x9e3779b97f4a7c15ull
+
+/*
+  TYPES
+*/
+
+#if Architecture_X86_64 || Architecture_X86_32
+#if Compiler_MSVC
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+struct random_series
+{
+    u32 State[4];
+};
+
+struct random_series_x4
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    __m128i State[4];
+#else
+    u32 State[4][4];
+#endif
+};
+
+struct random_series_x8
+{
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    __m256i State[4];
+#else
+    random_series_x4 Low;
+    random_series_x4 High;
+#endif
+};
+
+/*
+  FUNCTIONS
+*/
+
+internal random_series RandomSeriesCreate(u64 Seed, u64 Stream);
+internal random_series_x4 RandomSeriesX4Create(u64 Seed, u64 FirstStream); // NOTE: Lane N is stream FirstStream + N
+internal random_series_x8 RandomSeriesX8Create(u64 Seed, u64 FirstStream); // NOTE: Lane N is stream FirstStream + N
+internal inline random_series RandomSeriesX4Lane(random_series_x4 *Series, u32 Lane);
+internal inline random_series RandomSeriesX8Lane(random_series_x8 *Series, u32 Lane);
+
+internal inline u32 RandomNext(random_series *Series);
+internal inline f32 RandomUnilateral(random_series *Series); // NOTE: [0, 1) in steps of 2^-24
+internal inline f32 RandomBilateral(random_series *Series); // NOTE: [-1, 1)
+internal inline f32 RandomBetween(random_series *Series, f32 Min, f32 Max); // NOTE: [Min, Max)
+internal inline u32 RandomChoice(random_series *Series, u32 Count); // NOTE: [0, Count), Count must not be zero
+
+// NOTE: One value per lane written to Values, which needs room for 4 or 8 and no particular alignment
+internal inline void RandomNext(random_series_x4 *Series, u32 *Values);
+internal inline void RandomUnilateral(random_series_x4 *Series, f32 *Values);
+internal inline void RandomBilateral(random_series_x4 *Series, f32 *Values);
+internal inline void RandomBetween(random_series_x4 *Series, f32 Min, f32 Max, f32 *Values);
+internal inline void RandomChoice(random_series_x4 *Series, u32 Count, u32 *Values);
+
+internal inline void RandomNext(random_series_x8 *Series, u32 *Values);
+internal inline void RandomUnilateral(random_series_x8 *Series, f32 *Values);
+internal inline void RandomBilateral(random_series_x8 *Series, f32 *Values);
+internal inline void RandomBetween(random_series_x8 *Series, f32 Min, f32 Max, f32 *Values);
+internal inline void RandomChoice(random_series_x8 *Series, u32 Count, u32 *Values);
+
+/*
+  IMPLEMENTATION
+*/
+
+// NOTE: The splitmix64 finalizer, a bijection so different inputs never collide
+internal inline u64
+RandomMix64(u64 Value)
+{
+    u64 Result = Value;
+    Result = (Result ^ (Result >> 30)) * 0xbf58476d1ce4e5b9ull;
+    Result = (Result ^ (Result >> 27)) * 0x94d049bb133111ebull;
+    Result ^= Result >> 31;
+    return(Result);
+}
+
+// NOTE: Runs splitmix64 from a key made of both the seed and the stream, so neighbouring streams don't share any state
+// the way they would if the stream were just added to the seed. Xoshiro must never start out all zero
+internal random_series
+RandomSeriesCreate(u64 Seed, u64 Stream)
+{
+    random_series Result;
+    
+    u64 Key = RandomMix64(Seed ^ RandomMix64(Stream + RandomGolden64));
+    u64 First = RandomMix64(Key + RandomGolden64);
+    u64 Second = RandomMix64(Key + 2 * RandomGolden64);
+    
+    Result.State[0] = (u32)First;
+    Result.State[1] = (u32)(First >> 32);
+    Result.State[2] = (u32)Second;
+    Result.State[3] = (u32)(Second >> 32);
+    
+    if(!(First | Second))
+    {
+        Result.State[0] = 1;
+    }
+    
+    return(Result);
+}
+
+internal inline u32
+RandomNext(random_series *Series)
+{
+    u32 *State = Series->State;
+    
+    u32 Result = State[0] + State[3];
+    u32 Shifted = State[1] << 9;
+    
+    State[2] ^= State[0];
+    State[3] ^= State[1];
+    State[1] ^= State[2];
+    State[0] ^= State[3];
+    State[2] ^= Shifted;
+    State[3] = (State[3] << 11) | (State[3] >> 21);
+    
+    return(Result);
+}
+
+// NOTE: The top 24 bits, every one of those floats is exact so the wide versions give the same bits
+internal inline f32
+RandomUnilateral(random_series *Series)
+{
+    f32 Result = (f32)(RandomNext(Series) >> 8) * (1.0f / 16777216.0f);
+    return(Result);
+}
+
+internal inline f32
+RandomBilateral(random_series *Series)
+{
+    f32 Result = 2.0f * RandomUnilateral(Series) - 1.0f;
+    return(Result);
+}
+
+internal inline f32
+RandomBetween(random_series *Series, f32 Min, f32 Max)
+{
+    f32 Result = Min + (Max - Min) * RandomUnilateral(Series);
+    return(Result);
+}
+
+// NOTE: The high half of a 32x32 multiply, without the modulo's bias toward small values beyond the 2^-32 that's left
+internal inline u32
+RandomChoice(random_series *Series, u32 Count)
+{
+    Assert(Count);
+    
+    u32 Result = (u32)(((u64)RandomNext(Series) * Count) >> 32);
+    return(Result);
+}
+
+internal random_series_x4
+RandomSeriesX4Create(u64 Seed, u64 FirstStream)
+{
+    random_series_x4 Result;
+    
+    u32 States[4][4];
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        random_series Series = RandomSeriesCreate(Seed, FirstStream + Lane);
+        for(u32 Word = 0;
+            Word < 4;
+            Word++)
+        {
+            States[Word][Lane] = Series.State[Word];
+        }
+    }
+    
+    for(u32 Word = 0;
+        Word < 4;
+        Word++)
+    {
+#if Architecture_X86_64 || Architecture_X86_32
+        Result.State[Word] = _mm_loadu_si128((__m128i *)States[Word]);
+#else
+        for(u32 Lane = 0;
+            Lane < 4;
+            Lane++)
+        {
+            Result.State[Word][Lane] = States[Word][Lane];
+        }
+#endif
+    }
+    
+    return(Result);
+}
+
+internal inline random_series
+RandomSeriesX4Lane(random_series_x4 *Series, u32 Lane)
+{
+    Assert(Lane < 4);
+    
+    random_series Result;
+    for(u32 Word = 0;
+        Word < 4;
+        Word++)
+    {
+#if Architecture_X86_64 || Architecture_X86_32
+        u32 Lanes[4];
+        _mm_storeu_si128((__m128i *)Lanes, Series->State[Word]);
+        Result.State[Word] = Lanes[Lane];
+#else
+        Result.State[Word] = Series->State[Word][Lane];
+#endif
+    }
+    
+    return(Result);
+}
+
+#if Architecture_X86_64 || Architecture_X86_32
+internal inline __m128i
+RandomNextX4(random_series_x4 *Series)
+{
+    __m128i *State = Series->State;
+    
+    __m128i Result = _mm_add_epi32(State[0], State[3]);
+    __m128i Shifted = _mm_slli_epi32(State[1], 9);
+    
+    State[2] = _mm_xor_si128(State[2], State[0]);
+    State[3] = _mm_xor_si128(State[3], State[1]);
+    State[1] = _mm_xor_si128(State[1], State[2]);
+    State[0] = _mm_xor_si128(State[0], State[3]);
+    State[2] = _mm_xor_si128(State[2], Shifted);
+    State[3] = _mm_or_si128(_mm_slli_epi32(State[3], 11), _mm_srli_epi32(State[3], 21));
+    
+    return(Result);
+}
+
+internal inline __m128
+RandomUnilateralX4(random_series_x4 *Series)
+{
+    __m128 Result = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(RandomNextX4(Series), 8)), _mm_set1_ps(1.0f / 16777216.0f));
+    return(Result);
+}
+#endif
+
+internal inline void
+RandomNext(random_series_x4 *Series, u32 *Values)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    _mm_storeu_si128((__m128i *)Values, RandomNextX4(Series));
+#else
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        random_series Lanes = RandomSeriesX4Lane(Series, Lane);
+        Values[Lane] = RandomNext(&Lanes);
+        
+        for(u32 Word = 0;
+            Word < 4;
+            Word++)
+        {
+            Series->State[Word][Lane] = Lanes.State[Word];
+        }
+    }
+#endif
+}
+
+internal inline void
+RandomUnilateral(random_series_x4 *Series, f32 *Values)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    _mm_storeu_ps(Values, RandomUnilateralX4(Series));
+#else
+    u32 Next[4];
+    RandomNext(Series, Next);
+    
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Values[Lane] = (f32)(Next[Lane] >> 8) * (1.0f / 16777216.0f);
+    }
+#endif
+}
+
+internal inline void
+RandomBilateral(random_series_x4 *Series, f32 *Values)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    __m128 Unilateral = RandomUnilateralX4(Series);
+    _mm_storeu_ps(Values, _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), Unilateral), _mm_set1_ps(1.0f)));
+#else
+    RandomUnilateral(Series, Values);
+    
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Values[Lane] = 2.0f * Values[Lane] - 1.0f;
+    }
+#endif
+}
+
+internal inline void
+RandomBetween(random_series_x4 *Series, f32 Min, f32 Max, f32 *Values)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    __m128 Unilateral = RandomUnilateralX4(Series);
+    _mm_storeu_ps(Values, _mm_add_ps(_mm_set1_ps(Min), _mm_mul_ps(_mm_set1_ps(Max - Min), Unilateral)));
+#else
+    RandomUnilateral(Series, Values);
+    
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Values[Lane] = Min + (Max - Min) * Values[Lane];
+    }
+#endif
+}
+
+internal inline void
+RandomChoice(random_series_x4 *Series, u32 Count, u32 *Values)
+{
+    Assert(Count);
+    
+#if Architecture_X86_64 || Architecture_X86_32
+    // NOTE: SSE2 only multiplies the even lanes into 64 bits, the odd ones are shifted down for a second multiply and
+    // their high halves already sit where they belong
+    __m128i Next = RandomNextX4(Series);
+    __m128i Multiplier = _mm_set1_epi32((s32)Count);
+    
+    __m128i Even = _mm_srli_epi64(_mm_mul_epu32(Next, Multiplier), 32);
+    __m128i Odd = _mm_mul_epu32(_mm_srli_epi64(Next, 32), Multiplier);
+    __m128i OddMask = _mm_set_epi32(-1, 0, -1, 0);
+    
+    _mm_storeu_si128((__m128i *)Values, _mm_or_si128(Even, _mm_and_si128(Odd, OddMask)));
+#else
+    RandomNext(Series, Values);
+    
+    for(u32 Lane = 0;
+        Lane < 4;
+        Lane++)
+    {
+        Values[Lane] = (u32)(((u64)Values[Lane] * Count) >> 32);
+    }
+#endif
+}
+
+internal random_series_x8
+RandomSeriesX8Create(u64 Seed, u64 FirstStream)
+{
+    random_series_x8 Result;
+    
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    random_series_x4 Low = RandomSeriesX4Create(Seed, FirstStream);
+    random_series_x4 High = RandomSeriesX4Create(Seed, FirstStream + 4);
+    
+    for(u32 Word = 0;
+        Word < 4;
+        Word++)
+    {
+        Result.State[Word] = _mm256_inserti128_si256(_mm256_castsi128_si256(Low.State[Word]), High.State[Word], 1);
+    }
+#else
+    Result.Low = RandomSeriesX4Create(Seed, FirstStream);
+    Result.High = RandomSeriesX4Create(Seed, FirstStream + 4);
+#endif
+    
+    return(Result);
+}
+
+internal inline random_series
+RandomSeriesX8Lane(random_series_x8 *Series, u32 Lane)
+{
+    Assert(Lane < 8);
+    
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    random_series Result;
+    for(u32 Word = 0;
+        Word < 4;
+        Word++)
+    {
+        u32 Lanes[8];
+        _mm256_storeu_si256((__m256i *)Lanes, Series->State[Word]);
+        Result.State[Word] = Lanes[Lane];
+    }
+#else
+    random_series Result = (Lane < 4) ? RandomSeriesX4Lane(&Series->Low, Lane) : RandomSeriesX4Lane(&Series->High, Lane - 4);
+#endif
+    
+    return(Result);
+}
+
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+internal inline __m256i
+RandomNextX8(random_series_x8 *Series)
+{
+    // NOTE: Same as RandomNextX4
+    __m256i *State = Series->State;
+    
+    __m256i Result = _mm256_add_epi32(State[0], State[3]);
+    __m256i Shifted = _mm256_slli_epi32(State[1], 9);
+    
+    State[2] = _mm256_xor_si256(State[2], State[0]);
+    State[3] = _mm256_xor_si256(State[3], State[1]);
+    State[1] = _mm256_xor_si256(State[1], State[2]);
+    State[0] = _mm256_xor_si256(State[0], State[3]);
+    State[2] = _mm256_xor_si256(State[2], Shifted);
+    State[3] = _mm256_or_si256(_mm256_slli_epi32(State[3], 11), _mm256_srli_epi32(State[3], 21));
+    
+    return(Result);
+}
+
+internal inline __m256
+RandomUnilateralX8(random_series_x8 *Series)
+{
+    __m256 Result = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(RandomNextX8(Series), 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+    return(Result);
+}
+#endif
+
+internal inline void
+RandomNext(random_series_x8 *Series, u32 *Values)
+{
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    _mm256_storeu_si256((__m256i *)Values, RandomNextX8(Series));
+#else
+    RandomNext(&Series->Low, Values);
+    RandomNext(&Series->High, Values + 4);
+#endif
+}
+
+internal inline void
+RandomUnilateral(random_series_x8 *Series, f32 *Values)
+{
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    _mm256_storeu_ps(Values, RandomUnilateralX8(Series));
+#else
+    RandomUnilateral(&Series->Low, Values);
+    RandomUnilateral(&Series->High, Values + 4);
+#endif
+}
+
+internal inline void
+RandomBilateral(random_series_x8 *Series, f32 *Values)
+{
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    __m256 Unilateral = RandomUnilateralX8(Series);
+    _mm256_storeu_ps(Values, _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), Unilateral), _mm256_set1_ps(1.0f)));
+#else
+    RandomBilateral(&Series->Low, Values);
+    RandomBilateral(&Series->High, Values + 4);
+#endif
+}
+
+internal inline void
+RandomBetween(random_series_x8 *Series, f32 Min, f32 Max, f32 *Values)
+{
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    __m256 Unilateral = RandomUnilateralX8(Series);
+    _mm256_storeu_ps(Values, _mm256_add_ps(_mm256_set1_ps(Min), _mm256_mul_ps(_mm256_set1_ps(Max - Min), Unilateral)));
+#else
+    RandomBetween(&Series->Low, Min, Max, Values);
+    RandomBetween(&Series->High, Min, Max, Values + 4);
+#endif
+}
+
+internal inline void
+RandomChoice(random_series_x8 *Series, u32 Count, u32 *Values)
+{
+    Assert(Count);
+    
+#if (Architecture_X86_64 || Architecture_X86_32) && defined(__AVX2__)
+    // NOTE: Same as the x4 version
+    __m256i Next = RandomNextX8(Series);
+    __m256i Multiplier = _mm256_set1_epi32((s32)Count);
+    
+    __m256i Even = _mm256_srli_epi64(_mm256_mul_epu32(Next, Multiplier), 32);
+    __m256i Odd = _mm256_mul_epu32(_mm256_srli_epi64(Next, 32), Multiplier);
+    __m256i OddMask = _mm256_set_epi32(-1, 0, -1, 0, -1, 0, -1, 0);
+    
+    _mm256_storeu_si256((__m256i *)Values, _mm256_or_si256(Even, _mm256_and_si256(Odd, OddMask)));
+#else
+    RandomChoice(&Series->Low, Count, Values);
+    RandomChoice(&Series->High, Count, Values + 4);
+#endif
+}
+
+#endif
@@ -1119,7 +1119,12 @@ PushfList(memory_arena *Arena, char *Format, va_list Args)
 {
     string Result = {};
     
-    umm Count = StringFormatList(0, 0, Format, Args);
+    // NOTE: Formatting consumes the va_list, so the measuring pass gets its own copy
+    va_list MeasureArgs;
+    va_copy(MeasureArgs, Args);
+    umm Count = StringFormatList(0, 0, Format, MeasureArgs);
+    va_end(MeasureArgs);
+    
     u8 *Memory = MemoryArenaPush(Arena, Count, 1);
     if(Memory)
     {
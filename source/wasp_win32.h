@@ -299,6 +299,194 @@ MemoryDecommit(void *Memory, umm Size)
     Assert(VirtualFree(Memory, Size, MEM_DECOMMIT));
 }
 
+internal umm
+GetHugePageSize(void)
+{
+    umm Result = (umm)GetLargePageMinimum();
+    if(!Result)
+    {
+        Result = MB(2);
+    }
+    
+    return(Result);
+}
+
+internal void *
+MemoryReserveHuge(umm Size, b32 Explicit)
+{
+    void *Result = 0;
+    
+    Assert(IsAligned(Size, GetHugePageSize()));
+    
+    if(Size)
+    {
+        if(Explicit)
+        {
+            // NOTE: Large pages can't be reserved without committing them, and need SeLockMemoryPrivilege
+            Result = VirtualAlloc(0, Size, MEM_RESERVE|MEM_COMMIT|MEM_LARGE_PAGES, PAGE_READWRITE);
+        }
+        else
+        {
+            // NOTE: Windows has no transparent huge pages, these are regular pages
+            Result = VirtualAlloc(0, Size, MEM_RESERVE, PAGE_NOACCESS);
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryPrefault(void *Memory, umm Size)
+{
+    Assert(Memory);
+    
+    // NOTE: Touch a byte of every page without changing it
+    umm PageSize = GetPageSize();
+    for(umm Offset = 0;
+        Offset < Size;
+        Offset += PageSize)
+    {
+        volatile u8 *At = (volatile u8 *)Memory + Offset;
+        *At = *At;
+    }
+}
+
+internal umm
+GetMemoryMirrorGranularity(void)
+{
+    // NOTE: Views can only be mapped at multiples of the allocation granularity, not the page size
+    SYSTEM_INFO Info;
+    GetSystemInfo(&Info);
+    
+    umm Result = Info.dwAllocationGranularity;
+    return(Result);
+}
+
+// NOTE: Placeholders need Windows 10 1803, and VirtualAlloc2 and MapViewOfFile3 come from onecore
+#pragma comment(lib, "onecore.lib")
+
+internal void *
+MemoryMirrorCreate(umm Size)
+{
+    void *Result = 0;
+    
+    Assert(IsAligned(Size, GetMemoryMirrorGranularity()));
+    
+    if(Size)
+    {
+        HANDLE Section = CreateFileMappingA(INVALID_HANDLE_VALUE, 0, PAGE_READWRITE, (DWORD)((u64)Size >> 32), (DWORD)Size, 0);
+        if(Section)
+        {
+            // NOTE: Reserve a placeholder for both copies and split it in two, each half gets replaced by a view
+            u8 *Memory = (u8 *)VirtualAlloc2(0, 0, 2 * Size, MEM_RESERVE|MEM_RESERVE_PLACEHOLDER, PAGE_NOACCESS, 0, 0);
+            if(Memory)
+            {
+                Assert(VirtualFree(Memory, Size, MEM_RELEASE|MEM_PRESERVE_PLACEHOLDER));
+                
+                void *First = MapViewOfFile3(Section, 0, Memory, 0, Size, MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE, 0, 0);
+                void *Second = MapViewOfFile3(Section, 0, Memory + Size, 0, Size, MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE, 0, 0);
+                
+                if(First && Second)
+                {
+                    Result = Memory;
+                }
+                else
+                {
+                    if(First)
+                    {
+                        Assert(UnmapViewOfFile(First));
+                    }
+                    else
+                    {
+                        Assert(VirtualFree(Memory, 0, MEM_RELEASE));
+                    }
+                    
+                    if(Second)
+                    {
+                        Assert(UnmapViewOfFile(Second));
+                    }
+                    else
+                    {
+                        Assert(VirtualFree(Memory + Size, 0, MEM_RELEASE));
+                    }
+                }
+            }
+            
+            CloseHandle(Section); // NOTE: The views keep the section alive
+        }
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryMirrorRelease(void *Memory, umm Size)
+{
+    if(Size)
+    {
+        Assert(Memory);
+        Assert(UnmapViewOfFile(Memory));
+        Assert(UnmapViewOfFile((u8 *)Memory + Size));
+    }
+}
+
+internal buffer
+MemoryMapFile(char *FileName)
+{
+    buffer Result = {};
+    
+    HANDLE File = CreateFileA(FileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if(File != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER FileSize;
+        if(GetFileSizeEx(File, &FileSize) && FileSize.QuadPart)
+        {
+            HANDLE Mapping = CreateFileMappingA(File, 0, PAGE_READONLY, 0, 0, 0);
+            if(Mapping)
+            {
+                void *Memory = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+                if(Memory)
+                {
+                    Result.Data = (u8 *)Memory;
+                    Result.Size = (umm)FileSize.QuadPart;
+                }
+                
+                CloseHandle(Mapping); // NOTE: The view keeps the mapping alive
+            }
+        }
+        
+        CloseHandle(File);
+    }
+    
+    return(Result);
+}
+
+internal void
+MemoryUnmapFile(buffer *Buffer)
+{
+    Assert(Buffer);
+    
+    if(IsValid(*Buffer))
+    {
+        Assert(UnmapViewOfFile(Buffer->Data));
+    }
+    
+    ZeroStruct(Buffer);
+}
+
+#if WASP_MEMORY_INSTRUMENT
+internal void
+MemoryInstrumentRegister(memory_arena_stats *Stats)
+{
+    memory_arena_stats *Head;
+    do
+    {
+        Head = GlobalMemoryArenaStats;
+        Stats->Next = Head;
+    } while(InterlockedCompareExchangePointer((void *volatile *)&GlobalMemoryArenaStats, Stats, Head) != Head);
+}
+#endif
+
 #endif // WASP_MEMORY_H
 
 #ifdef WASP_FILE_H
@@ -1428,6 +1616,7 @@ VulkanPlatformCreateSurface(VkInstance Instance, window_handle Window)
 struct thread_context
 {
     u32 ThreadIndex;
+    thread_context *NextFree;
     
 #ifdef WASP_MEMORY_H
     memory_arena Arenas[2];
@@ -1438,31 +1627,68 @@ struct thread_context
 #endif
 };
 
-// TODO: Use the Tls API (to support no CRT).
-// We should do this with some sort of init once function, like we would need for assert,
-// so probably rewrite that one.
-// Unless we just make the entry point be in WASP, and therefore also the TLS init stuff?
+// NOTE: Uses the Tls API instead of __declspec(thread), which needs the CRT to set up the TLS directory. The TLS
+// index is allocated by whichever thread gets here first, stored plus one so that zero means not allocated yet.
 
-// global DWORD GlobalWin32ThreadContextIndex;
+global volatile LONG GlobalWin32ThreadContextSlot;
+global volatile LONG GlobalWin32ThreadContextCount;
 
-#ifdef WASP_THREAD_H
-#error We are doing some bad stuff here, it's time to implement TLS properly!
-#endif
+// NOTE: Released contexts are kept with their thread index and handed to the next thread that starts, so thread
+// indices only go as high as the number of threads alive at once
+global SRWLOCK GlobalWin32ThreadContextLock = SRWLOCK_INIT;
+global thread_context *GlobalWin32ThreadContextFree;
 
-global thread_context *GlobalThreadContext;
+internal DWORD
+Win32ThreadContextSlot(void)
+{
+    LONG Slot = GlobalWin32ThreadContextSlot;
+    
+    if(!Slot)
+    {
+        DWORD Index = TlsAlloc();
+        Assert(Index != TLS_OUT_OF_INDEXES);
+        
+        Slot = (LONG)Index + 1;
+        
+        LONG Previous = InterlockedCompareExchange(&GlobalWin32ThreadContextSlot, Slot, 0);
+        if(Previous)
+        {
+            TlsFree(Index); // NOTE: Someone else won the race, use theirs
+            Slot = Previous;
+        }
+    }
+    
+    DWORD Result = (DWORD)(Slot - 1);
+    return(Result);
+}
 
 internal thread_context *
 ThreadContextGet()
 {
-    thread_context *Result = GlobalThreadContext;
+    DWORD Slot = Win32ThreadContextSlot();
+    thread_context *Result = (thread_context *)TlsGetValue(Slot);
     
     if(!Result)
     {
-        Result = (thread_context *)VirtualAlloc(0, SizeOf(*Result), MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
-        Assert(Result);
+        AcquireSRWLockExclusive(&GlobalWin32ThreadContextLock);
+        Result = GlobalWin32ThreadContextFree;
+        if(Result)
+        {
+            GlobalWin32ThreadContextFree = Result->NextFree;
+            Result->NextFree = 0;
+        }
+        ReleaseSRWLockExclusive(&GlobalWin32ThreadContextLock);
+        
+        // NOTE: The arenas and the log of a reused context are set up again below
+        if(!Result)
+        {
+            Result = (thread_context *)VirtualAlloc(0, SizeOf(*Result), MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
+            Assert(Result);
+            
+            Result->ThreadIndex = (u32)InterlockedIncrement(&GlobalWin32ThreadContextCount) - 1;
+        }
         
-        GlobalThreadContext = Result;
-        Result->ThreadIndex = 0; // TODO
+        Assert(TlsSetValue(Slot, Result));
         
 #ifdef WASP_MEMORY_H
         MemoryInit(); // NOTE: It's important that this happens first so that the log can allocate in it's init
@@ -1476,8 +1702,36 @@ ThreadContextGet()
     return(Result);
 }
 
+// NOTE: Call before a thread exits, otherwise its scratch arenas leak and its thread index is never reused
+internal void
+ThreadContextRelease(void)
+{
+    DWORD Slot = Win32ThreadContextSlot();
+    thread_context *Context = (thread_context *)TlsGetValue(Slot);
+    
+    if(Context)
+    {
+#ifdef WASP_MEMORY_H
+        for(u32 Index = 0;
+            Index < ArrayCount(Context->Arenas);
+            Index++)
+        {
+            MemoryArenaDestroy(&Context->Arenas[Index]);
+        }
+#endif
+        
+        Assert(TlsSetValue(Slot, 0));
+        
+        AcquireSRWLockExclusive(&GlobalWin32ThreadContextLock);
+        Context->NextFree = GlobalWin32ThreadContextFree;
+        GlobalWin32ThreadContextFree = Context;
+        ReleaseSRWLockExclusive(&GlobalWin32ThreadContextLock);
+    }
+}
+
 #ifdef WASP_MEMORY_H
 internal memory_arena *MemoryArenasGet(void) {return(ThreadContextGet()->Arenas);}
+internal u32 ThreadIndexGet(void) {return(ThreadContextGet()->ThreadIndex);}
 #endif
 
 #ifdef WASP_LOG_H
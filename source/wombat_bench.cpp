@@ -0,0 +1,1588 @@
+// NOTE: Standalone benchmark, links the whole game through the unity build and runs scripted stress scenarios.
+// Frames render into an offscreen surface of the window's size, each frame runs the ticks a 60 Hz display would
+// get at SimulationHz. The bot plays every scenario and enemy projectiles do no damage, so the state stays stable.
+// Microbenchmarks of wasp routines run after the scenarios, everything runs when nothing is named.
+//
+// wombat_bench [-frames N] [scenario and microbenchmark names...]
+
+#define WOMBAT_BENCH 1
+
+#include "wombat_main.cpp"
+
+// NOTE: libm is the reference for the trig microbenchmark
+#include <math.h>
+
+// NOTE: The SSE originals are the reference for the portable math, builds on other backends still need them
+#if !MathSSE && (Architecture_X86_64 || Architecture_X86_32)
+#include <x86intrin.h>
+#define USE_SSE2
+#include "sse_mathfun_extension.h"
+#endif
+
+#define BenchDefaultFramesCount 240
+#define BenchWarmupFramesCount 16
+#define BenchTicksPerFrame (SimulationHz / 60)
+
+typedef void bench_setup(context *Context, memory_arena *Arena);
+typedef void bench_micro_run(memory_arena *Arena);
+
+struct bench_scenario
+{
+    char *Name;
+    bench_setup *Setup;
+};
+
+// NOTE: Microbenchmarks of wasp routines, they run outside of the game and print their own results
+struct bench_micro
+{
+    char *Name;
+    bench_micro_run *Run;
+};
+
+// NOTE: Results are added in here so the compiler can't drop the work
+global volatile u64 GlobalBenchSink;
+
+internal void
+BenchMapsCreate(context *Context, memory_arena *Arena, u32 MapSize, b32 Animated)
+{
+    game_assets *Assets = &Context->Assets;
+
+    b8 WalkableBlocks[] =
+    {
+        3, 4, 5, 6,
+    };
+
+    Context->MapSizeX = MapSize;
+    Context->MapSizeY = MapSize;
+
+    tile_map *IslandMap = &Context->IslandMap;
+    tile_map *SeaMap = &Context->SeaMap;
+    tile_map *OverlayMap = &Context->OverlayMap;
+
+    *IslandMap = TileMapCreate(Arena, MapSize, MapSize, Assets->MapAnimations, ArrayCount(Assets->MapAnimations));
+    *SeaMap = TileMapCreate(Arena, MapSize, MapSize, Assets->MapAnimations, ArrayCount(Assets->MapAnimations));
+    *OverlayMap = TileMapCreate(Arena, MapSize, MapSize, Assets->MapAnimations, ArrayCount(Assets->MapAnimations));
+
+    TileMapFill(SeaMap, 0, 0, MapSize, MapSize, 1);
+
+    if(Animated)
+    {
+        // NOTE: 1 is the sea and 2 the shallow water, both are animated
+        TileMapFill(IslandMap, 0, 0, MapSize, MapSize, 2);
+        TileMapFill(OverlayMap, 0, 0, MapSize, MapSize, 1);
+    }
+    else
+    {
+        random_series MapRandom = RandomSeriesCreate(Context->Seed, RandomStream_Map);
+        TileMapFillRandom(IslandMap, &MapRandom, Context->MapMargin, Context->MapMargin, MapSize - Context->MapMargin, MapSize - Context->MapMargin, 3, 4);
+    }
+
+    Context->CollisionMap = CollisionMapCreate(Arena, IslandMap, WalkableBlocks, ArrayCount(WalkableBlocks));
+
+    Context->PlayerX = Context->CollisionMap.SizeX / 2.0f;
+    Context->PlayerY = Context->CollisionMap.SizeY / 2.0f;
+    Context->LastPlayerX = Context->PlayerX;
+    Context->LastPlayerY = Context->PlayerY;
+}
+
+internal void
+BenchSetupBaseline(context *Context, memory_arena *Arena)
+{
+}
+
+internal void
+BenchSetupProjectiles(context *Context, memory_arena *Arena)
+{
+    u32 ProjectilesCount = 10000;
+    random_series Series = RandomSeriesCreate(Context->Seed, RandomStream_Bench);
+
+    // NOTE: Slow enough that none of them leave the map during the run, the enemies keep the collision loop busy
+    for(u32 Index = 0;
+        Index < ProjectilesCount;
+        Index++)
+    {
+        f32 Angle = RandomBetween(&Series, 0.0f, 2.0f * Pi);
+        f32 X = RandomBetween(&Series, 1.0f, 31.0f);
+        f32 Y = RandomBetween(&Series, 1.0f, 31.0f);
+        v2 Position = V2(X, Y);
+
+        ProjectileSpawn(Position, V2(Cos(Angle), Sin(Angle)) * 0.05f, 0, 0);
+    }
+
+    SpawnEnemies(64, Context->CollisionMap.SizeX / 2.0f, Context->CollisionMap.SizeY / 2.0f, 7, (f32)Context->Time);
+}
+
+internal void
+BenchSetupEnemies(context *Context, memory_arena *Arena)
+{
+    SpawnEnemies(100000, Context->CollisionMap.SizeX / 2.0f, Context->CollisionMap.SizeY / 2.0f, 7, (f32)Context->Time);
+}
+
+internal void
+BenchSetupMap(context *Context, memory_arena *Arena)
+{
+    BenchMapsCreate(Context, Arena, 512, 0);
+}
+
+internal void
+BenchSetupMapAnimated(context *Context, memory_arena *Arena)
+{
+    BenchMapsCreate(Context, Arena, 512, 1);
+}
+
+internal void
+BenchSetupShop(context *Context, memory_arena *Arena)
+{
+    Context->PlayerX = Context->MapSizeY / 2.0f;
+    Context->PlayerY = (f32)Context->MapMargin;
+    Context->LastPlayerX = Context->PlayerX;
+    Context->LastPlayerY = Context->PlayerY;
+
+    Context->ShopOpen = 1;
+}
+
+global bench_scenario GlobalBenchScenarios[] =
+{
+    {"baseline", BenchSetupBaseline},
+    {"projectiles_10k", BenchSetupProjectiles},
+    {"enemies_100k", BenchSetupEnemies},
+    {"map_512", BenchSetupMap},
+    {"map_512_animated", BenchSetupMapAnimated},
+    {"shop_open", BenchSetupShop},
+};
+
+internal f64
+BenchSeconds(u64 Start, u64 End)
+{
+    f64 Result = (f64)(End - Start) / (f64)SDL_GetPerformanceFrequency();
+    return(Result);
+}
+
+internal void
+BenchMicroHash(memory_arena *Arena)
+{
+    umm Sizes[] =
+    {
+        4, 8, 16, 32, 64, 128, 240, 256, 1024, KB(64), MB(1),
+    };
+
+    umm DataSize = MB(1);
+    u8 *Data = (u8 *)MemoryArenaPush(Arena, DataSize, 64);
+    for(umm Index = 0;
+        Index < DataSize;
+        Index++)
+    {
+        Data[Index] = (u8)HashU64(Index);
+    }
+
+    // NOTE: The same amount of bytes for every size, short keys are measured per call, long ones by throughput.
+    // Every key starts one byte further in so the loads aren't always aligned
+    umm BytesPerSize = MB(256);
+
+    for(u32 SizeIndex = 0;
+        SizeIndex < ArrayCount(Sizes);
+        SizeIndex++)
+    {
+        umm Size = Sizes[SizeIndex];
+        umm Iterations = BytesPerSize / Size;
+        umm OffsetMask = Size < DataSize ? 63 : 0;
+        u64 Sink = 0;
+
+        u64 Start = SDL_GetPerformanceCounter();
+        for(umm Iteration = 0;
+            Iteration < Iterations;
+            Iteration++)
+        {
+            Sink += Hash64(Data + (Iteration & OffsetMask), Size, Sink);
+        }
+        u64 Middle = SDL_GetPerformanceCounter();
+        for(umm Iteration = 0;
+            Iteration < Iterations;
+            Iteration++)
+        {
+            Sink += Hash128(Data + (Iteration & OffsetMask), Size, Sink).High;
+        }
+        u64 End = SDL_GetPerformanceCounter();
+
+        GlobalBenchSink += Sink;
+
+        f64 Seconds64 = BenchSeconds(Start, Middle);
+        f64 Seconds128 = BenchSeconds(Middle, End);
+
+        Outf("hash %llu bytes: hash64 %llu MB/s %llu ps/call, hash128 %llu MB/s %llu ps/call\n", (u64)Size,
+             (u64)((f64)(Iterations * Size) / Seconds64 / 1e6), (u64)(Seconds64 * 1e12 / (f64)Iterations),
+             (u64)((f64)(Iterations * Size) / Seconds128 / 1e6), (u64)(Seconds128 * 1e12 / (f64)Iterations));
+    }
+
+    // NOTE: Streaming the whole buffer in chunks the size of a typical file read
+    umm ChunkSizes[] =
+    {
+        64, KB(4),
+    };
+
+    for(u32 ChunkIndex = 0;
+        ChunkIndex < ArrayCount(ChunkSizes);
+        ChunkIndex++)
+    {
+        umm ChunkSize = ChunkSizes[ChunkIndex];
+        umm Iterations = BytesPerSize / DataSize;
+
+        hash_state State;
+
+        u64 Start = SDL_GetPerformanceCounter();
+        for(umm Iteration = 0;
+            Iteration < Iterations;
+            Iteration++)
+        {
+            HashBegin(&State, Iteration);
+            for(umm Offset = 0;
+                Offset < DataSize;
+                Offset += ChunkSize)
+            {
+                HashUpdate(&State, Data + Offset, ChunkSize);
+            }
+
+            GlobalBenchSink += HashEnd64(&State);
+        }
+        u64 End = SDL_GetPerformanceCounter();
+
+        Outf("hash stream %llu byte chunks: %llu MB/s\n", (u64)ChunkSize, (u64)((f64)(Iterations * DataSize) / BenchSeconds(Start, End) / 1e6));
+    }
+}
+
+// NOTE: Random sizes are freed in random order out of a fixed window of live blocks, against the same sequence
+// through SDL_malloc. Both touch a byte of every block so neither gets away with handing out untouched memory
+internal void
+BenchMicroSlab(memory_arena *Arena)
+{
+    umm SizesMax[] =
+    {
+        64, 1024, KB(8),
+    };
+
+    u32 LiveCount = 4096;
+    u32 OperationsCount = 1 << 22;
+
+    void **Live = MemoryArenaPushArray(Arena, void *, 1, LiveCount);
+    u32 *Sizes = MemoryArenaPushArray(Arena, u32, 1, OperationsCount);
+    u32 *Slots = MemoryArenaPushArray(Arena, u32, 1, OperationsCount);
+
+    memory_slab_allocator Slabs = MemorySlabCreate(GB(1));
+
+    for(u32 SizeIndex = 0;
+        SizeIndex < ArrayCount(SizesMax);
+        SizeIndex++)
+    {
+        for(u32 Index = 0;
+            Index < OperationsCount;
+            Index++)
+        {
+            u64 Random = HashU64(Index ^ ((u64)SizeIndex << 32));
+            Sizes[Index] = 1 + (u32)(Random % SizesMax[SizeIndex]);
+            Slots[Index] = (u32)(Random >> 32) % LiveCount;
+        }
+
+        f64 Seconds[2];
+        for(u32 Run = 0;
+            Run < 2;
+            Run++)
+        {
+            for(u32 Slot = 0;
+                Slot < LiveCount;
+                Slot++)
+            {
+                Live[Slot] = Run ? SDL_malloc(Sizes[Slot]) : MemorySlabAlloc(&Slabs, Sizes[Slot]);
+            }
+
+            u64 Start = SDL_GetPerformanceCounter();
+            for(u32 Index = 0;
+                Index < OperationsCount;
+                Index++)
+            {
+                u32 Slot = Slots[Index];
+                if(Run)
+                {
+                    SDL_free(Live[Slot]);
+                    Live[Slot] = SDL_malloc(Sizes[Index]);
+                }
+                else
+                {
+                    MemorySlabFree(&Slabs, Live[Slot]);
+                    Live[Slot] = MemorySlabAlloc(&Slabs, Sizes[Index]);
+                }
+
+                *(u8 *)Live[Slot] = (u8)Index;
+            }
+            u64 End = SDL_GetPerformanceCounter();
+
+            Seconds[Run] = BenchSeconds(Start, End);
+
+            for(u32 Slot = 0;
+                Slot < LiveCount;
+                Slot++)
+            {
+                GlobalBenchSink += *(u8 *)Live[Slot];
+                if(Run)
+                {
+                    SDL_free(Live[Slot]);
+                }
+                else
+                {
+                    MemorySlabFree(&Slabs, Live[Slot]);
+                }
+            }
+        }
+
+        Outf("slab up to %llu bytes: %llu ns per free and alloc, SDL_malloc %llu ns\n", (u64)SizesMax[SizeIndex],
+             (u64)(Seconds[0] * 1e9 / (f64)OperationsCount), (u64)(Seconds[1] * 1e9 / (f64)OperationsCount));
+    }
+
+    MemorySlabDestroy(&Slabs);
+}
+
+internal f64
+BenchMaxError(f32 *Values, f64 *Expected, u32 Count)
+{
+    f64 Result = 0;
+    for(u32 Index = 0;
+        Index < Count;
+        Index++)
+    {
+        f64 Error = Abs((f64)Values[Index] - Expected[Index]);
+        Result = Max(Result, Error);
+    }
+
+    return(Result);
+}
+
+// NOTE: Compares Count 32 bit words bit for bit, whatever type they were written as
+internal u32
+BenchMismatches(void *A, void *B, u32 Count)
+{
+    u32 Result = 0;
+    for(u32 Index = 0;
+        Index < Count;
+        Index++)
+    {
+        u32 BitsA, BitsB;
+        MemoryCopy(&BitsA, (u8 *)A + 4 * Index, SizeOf(u32));
+        MemoryCopy(&BitsB, (u8 *)B + 4 * Index, SizeOf(u32));
+
+        Result += (BitsA != BitsB);
+    }
+
+    return(Result);
+}
+
+// NOTE: Every variant goes over the same inputs the same number of times. The error is the max abs difference
+// against libm in double precision, in units of 1e-9
+internal void
+BenchMicroTrig(memory_arena *Arena)
+{
+    u32 Count = 1 << 14;
+    u32 Iterations = 1 << 10;
+
+    f32 *Angles = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *Ys = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *Xs = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *Sines = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *Cosines = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f64 *ExpectedSines = MemoryArenaPushArray(Arena, f64, 1, Count);
+    f64 *ExpectedCosines = MemoryArenaPushArray(Arena, f64, 1, Count);
+    f64 *ExpectedAngles = MemoryArenaPushArray(Arena, f64, 1, Count);
+    v2 *Vectors = MemoryArenaPushArray(Arena, v2, 1, Count);
+    v2 *Rotated = MemoryArenaPushArray(Arena, v2, 1, Count);
+
+    for(u32 Index = 0;
+        Index < Count;
+        Index++)
+    {
+        u64 Random = HashU64(Index);
+        Angles[Index] = ((f32)(u32)Random / (f32)MaxU32 - 0.5f) * 200.0f;
+        Ys[Index] = ((f32)(u32)(Random >> 32) / (f32)MaxU32 - 0.5f) * 20.0f;
+        Xs[Index] = ((f32)(u32)HashU64(Random) / (f32)MaxU32 - 0.5f) * 20.0f;
+        Vectors[Index] = V2(Xs[Index], Ys[Index]);
+
+        ExpectedSines[Index] = sin((f64)Angles[Index]);
+        ExpectedCosines[Index] = cos((f64)Angles[Index]);
+        ExpectedAngles[Index] = atan2((f64)Ys[Index], (f64)Xs[Index]);
+    }
+
+    f64 Elements = (f64)Count * (f64)Iterations;
+
+    {
+        char *Names[] = {"libm sinf/cosf", "SinCos", "SinCosArray precise", "SinCosArray fast"};
+        for(u32 Variant = 0;
+            Variant < ArrayCount(Names);
+            Variant++)
+        {
+            u64 Start = SDL_GetPerformanceCounter();
+            for(u32 Iteration = 0;
+                Iteration < Iterations;
+                Iteration++)
+            {
+                if(Variant == 0)
+                {
+                    for(u32 Index = 0;
+                        Index < Count;
+                        Index++)
+                    {
+                        Sines[Index] = sinf(Angles[Index]);
+                        Cosines[Index] = cosf(Angles[Index]);
+                    }
+                }
+                else if(Variant == 1)
+                {
+                    for(u32 Index = 0;
+                        Index < Count;
+                        Index++)
+                    {
+                        SinCos(Angles[Index], Sines + Index, Cosines + Index);
+                    }
+                }
+                else
+                {
+                    SinCosArray(Angles, Sines, Cosines, Count, Variant == 2 ? MathAccuracy_Precise : MathAccuracy_Fast);
+                }
+
+                u32 SinkBits;
+                MemoryCopy(&SinkBits, &Sines[Iteration & (Count - 1)], SizeOf(u32));
+                GlobalBenchSink += SinkBits;
+            }
+            u64 End = SDL_GetPerformanceCounter();
+
+            Outf("trig %s: %llu ps per element, max error sin %llue-9 cos %llue-9\n", Names[Variant], (u64)(BenchSeconds(Start, End) * 1e12 / Elements),
+                 (u64)(BenchMaxError(Sines, ExpectedSines, Count) * 1e9), (u64)(BenchMaxError(Cosines, ExpectedCosines, Count) * 1e9));
+        }
+    }
+
+    {
+        char *Names[] = {"libm atan2f", "Atan2", "Atan2Array precise", "Atan2Array fast"};
+        for(u32 Variant = 0;
+            Variant < ArrayCount(Names);
+            Variant++)
+        {
+            u64 Start = SDL_GetPerformanceCounter();
+            for(u32 Iteration = 0;
+                Iteration < Iterations;
+                Iteration++)
+            {
+                if(Variant == 0)
+                {
+                    for(u32 Index = 0;
+                        Index < Count;
+                        Index++)
+                    {
+                        Angles[Index] = atan2f(Ys[Index], Xs[Index]);
+                    }
+                }
+                else if(Variant == 1)
+                {
+                    for(u32 Index = 0;
+                        Index < Count;
+                        Index++)
+                    {
+                        Angles[Index] = Atan2(Ys[Index], Xs[Index]);
+                    }
+                }
+                else
+                {
+                    Atan2Array(Ys, Xs, Angles, Count, Variant == 2 ? MathAccuracy_Precise : MathAccuracy_Fast);
+                }
+
+                u32 SinkBits;
+                MemoryCopy(&SinkBits, &Angles[Iteration & (Count - 1)], SizeOf(u32));
+                GlobalBenchSink += SinkBits;
+            }
+            u64 End = SDL_GetPerformanceCounter();
+
+            Outf("trig %s: %llu ps per element, max error %llue-9\n", Names[Variant], (u64)(BenchSeconds(Start, End) * 1e12 / Elements),
+                 (u64)(BenchMaxError(Angles, ExpectedAngles, Count) * 1e9));
+        }
+    }
+
+    // NOTE: The angles were overwritten by atan2 above, in radians, which is as good a spread of degrees as any
+    {
+        char *Names[] = {"V2Rotate", "V2RotateArray precise", "V2RotateArray fast"};
+        for(u32 Variant = 0;
+            Variant < ArrayCount(Names);
+            Variant++)
+        {
+            u64 Start = SDL_GetPerformanceCounter();
+            for(u32 Iteration = 0;
+                Iteration < Iterations;
+                Iteration++)
+            {
+                if(Variant == 0)
+                {
+                    for(u32 Index = 0;
+                        Index < Count;
+                        Index++)
+                    {
+                        Rotated[Index] = V2Rotate(Vectors[Index], Angles[Index]);
+                    }
+                }
+                else
+                {
+                    V2RotateArray(Vectors, Angles, Rotated, Count, Variant == 1 ? MathAccuracy_Precise : MathAccuracy_Fast);
+                }
+
+                u32 SinkBits;
+                MemoryCopy(&SinkBits, &Rotated[Iteration & (Count - 1)].X, SizeOf(u32));
+                GlobalBenchSink += SinkBits;
+            }
+            u64 End = SDL_GetPerformanceCounter();
+
+            Outf("trig %s: %llu ps per element\n", Names[Variant], (u64)(BenchSeconds(Start, End) * 1e12 / Elements));
+        }
+    }
+}
+
+// NOTE: Points are transformed one by one through M4Transform and in batches through M4TransformPoints, the
+// multiplies and inverses chain through the previous result so they can't overlap
+internal void
+BenchMicroMatrix(memory_arena *Arena)
+{
+    u32 Count = 1 << 14;
+    u32 Iterations = 1 << 9;
+
+    v3 *Points = MemoryArenaPushArray(Arena, v3, 1, Count);
+    for(u32 Index = 0;
+        Index < Count;
+        Index++)
+    {
+        u64 Random = HashU64(Index);
+        Points[Index] = V3((f32)(Random & 0xFFFF), (f32)((Random >> 16) & 0xFFFF), (f32)((Random >> 32) & 0xFFFF));
+    }
+
+    m4 Camera = M4(1.0f, 0.0f, 0.0f, -640.0f,
+                   0.0f, 1.0f, 0.0f, -360.0f,
+                   0.0f, 0.0f, 1.0f, 0.0f,
+                   0.0f, 0.0f, 0.0f, 1.0f);
+
+    f64 Elements = (f64)Count * (f64)Iterations;
+
+    u64 Start = SDL_GetPerformanceCounter();
+    for(u32 Iteration = 0;
+        Iteration < Iterations;
+        Iteration++)
+    {
+        for(u32 Index = 0;
+            Index < Count;
+            Index++)
+        {
+            Points[Index] = M4Transform(Camera, Points[Index]);
+        }
+    }
+    u64 Middle = SDL_GetPerformanceCounter();
+    for(u32 Iteration = 0;
+        Iteration < Iterations;
+        Iteration++)
+    {
+        M4TransformPoints(Camera, Points, Count);
+    }
+    u64 End = SDL_GetPerformanceCounter();
+
+    GlobalBenchSink += (u64)(s64)Points[Count - 1].X;
+
+    Outf("matrix transform: M4Transform %llu ps per point, M4TransformPoints %llu ps per point\n",
+         (u64)(BenchSeconds(Start, Middle) * 1e12 / Elements), (u64)(BenchSeconds(Middle, End) * 1e12 / Elements));
+
+    u32 ChainCount = 1 << 22;
+    m4 Rotation = M4(0.8f, -0.6f, 0.0f, 0.0f,
+                     0.6f,  0.8f, 0.0f, 0.0f,
+                     0.0f,  0.0f, 1.0f, 0.0f,
+                     0.0f,  0.0f, 0.0f, 1.0f);
+
+    m4 Product = Camera;
+    Start = SDL_GetPerformanceCounter();
+    for(u32 Index = 0;
+        Index < ChainCount;
+        Index++)
+    {
+        Product = Product * Rotation;
+    }
+    Middle = SDL_GetPerformanceCounter();
+    m4 Inverted = Camera * Rotation;
+    for(u32 Index = 0;
+        Index < ChainCount;
+        Index++)
+    {
+        Inverted = Inverse(Inverted);
+    }
+    End = SDL_GetPerformanceCounter();
+
+    GlobalBenchSink += (u64)(Product.M03 + Inverted.M03);
+
+    Outf("matrix multiply %llu ps, inverse %llu ps\n",
+         (u64)(BenchSeconds(Start, Middle) * 1e12 / (f64)ChainCount), (u64)(BenchSeconds(Middle, End) * 1e12 / (f64)ChainCount));
+}
+
+// NOTE: The kernels the build was compiled for against the ones the CPU got dispatched to, over odd counts so the
+// tails are covered. They have to agree bit for bit, a mismatch is counted per element
+internal void
+BenchMicroDispatch(memory_arena *Arena)
+{
+    u32 Count = (1 << 14) + 5;
+    u32 Iterations = 1 << 9;
+
+    f32 *Angles = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *Ys = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *Xs = MemoryArenaPushArray(Arena, f32, 1, Count);
+    v2 *Vectors = MemoryArenaPushArray(Arena, v2, 1, Count);
+    v3 *Points = MemoryArenaPushArray(Arena, v3, 1, Count);
+
+    f32 *Outputs[2];
+    v2 *Rotated[2];
+    v3 *Transformed[2];
+    for(u32 Set = 0;
+        Set < 2;
+        Set++)
+    {
+        Outputs[Set] = MemoryArenaPushArray(Arena, f32, 1, 3 * Count);
+        Rotated[Set] = MemoryArenaPushArray(Arena, v2, 1, Count);
+        Transformed[Set] = MemoryArenaPushArray(Arena, v3, 1, Count);
+
+        MemorySet(Outputs[Set], 0, 3 * Count * SizeOf(f32));
+        MemorySet(Rotated[Set], 0, Count * SizeOf(v2));
+        MemorySet(Transformed[Set], 0, Count * SizeOf(v3));
+    }
+
+    for(u32 Index = 0;
+        Index < Count;
+        Index++)
+    {
+        u64 Random = HashU64(Index);
+        Angles[Index] = ((f32)(u32)Random / (f32)MaxU32 - 0.5f) * 200.0f;
+        Ys[Index] = ((f32)(u32)(Random >> 32) / (f32)MaxU32 - 0.5f) * 20.0f;
+        Xs[Index] = ((f32)(u32)HashU64(Random) / (f32)MaxU32 - 0.5f) * 20.0f;
+        Vectors[Index] = V2(Xs[Index], Ys[Index]);
+        Points[Index] = V3(Xs[Index], Ys[Index], Angles[Index]);
+    }
+
+    m4 Projection = M4(1.0f, 0.0f, 0.0f, -640.0f,
+                       0.0f, 1.0f, 0.0f, -360.0f,
+                       0.0f, 0.0f, 1.0f, 0.0f,
+                       0.0f, 0.0f, 0.01f, 1.0f);
+
+    math_kernels Sets[2] = {MathKernelsGet(0), GlobalMathKernels};
+    f64 Elements = (f64)Count * (f64)Iterations;
+
+    char *Names[] = {"SinCosArray precise", "SinCosArray fast", "Atan2Array precise", "Atan2Array fast", "V2RotateArray precise", "M4TransformPoints"};
+    for(u32 Variant = 0;
+        Variant < ArrayCount(Names);
+        Variant++)
+    {
+        u64 Picoseconds[2];
+        for(u32 Set = 0;
+            Set < 2;
+            Set++)
+        {
+            math_kernels *Kernels = Sets + Set;
+            f32 *Output = Outputs[Set];
+
+            u64 Start = SDL_GetPerformanceCounter();
+            for(u32 Iteration = 0;
+                Iteration < Iterations;
+                Iteration++)
+            {
+                switch(Variant)
+                {
+                    case 0: Kernels->SinCosArray(Angles, Output, Output + Count, Count, MathAccuracy_Precise); break;
+                    case 1: Kernels->SinCosArray(Angles, Output, Output + Count, Count, MathAccuracy_Fast); break;
+                    case 2: Kernels->Atan2Array(Ys, Xs, Output + 2 * Count, Count, MathAccuracy_Precise); break;
+                    case 3: Kernels->Atan2Array(Ys, Xs, Output + 2 * Count, Count, MathAccuracy_Fast); break;
+                    case 4: Kernels->V2RotateArray(Vectors, Angles, Rotated[Set], Count, MathAccuracy_Precise); break;
+
+                    case 5:
+                    {
+                        MemoryCopy(Transformed[Set], Points, Count * SizeOf(v3));
+                        Kernels->M4TransformPoints(Projection, Transformed[Set], Count);
+                    } break;
+                }
+
+                u32 SinkBits;
+                MemoryCopy(&SinkBits, &Output[Iteration % Count], SizeOf(u32));
+                GlobalBenchSink += SinkBits;
+            }
+            u64 End = SDL_GetPerformanceCounter();
+
+            Picoseconds[Set] = (u64)(BenchSeconds(Start, End) * 1e12 / Elements);
+        }
+
+        u32 Mismatches = BenchMismatches(Outputs[0], Outputs[1], 3 * Count) +
+                         BenchMismatches(Rotated[0], Rotated[1], 2 * Count) +
+                         BenchMismatches(Transformed[0], Transformed[1], 3 * Count);
+
+        Outf("dispatch %s: %s %llu ps per element, %s %llu ps per element, %u mismatches\n", Names[Variant],
+             Sets[0].Name, Picoseconds[0], Sets[1].Name, Picoseconds[1], Mismatches);
+    }
+}
+
+#if Architecture_X86_64 || Architecture_X86_32
+internal void
+BenchPortableReference(u32 Variant, f32 *As, f32 *Bs, f32 *Outputs, f32 *SecondOutputs)
+{
+    __m128 A = _mm_loadu_ps(As);
+    __m128 B = _mm_loadu_ps(Bs);
+
+    __m128 Result = _mm_setzero_ps();
+    __m128 Second = _mm_setzero_ps();
+    switch(Variant)
+    {
+        case 0: Result = sin_ps(A); break;
+        case 1: Result = cos_ps(A); break;
+        case 2: sincos_ps(A, &Result, &Second); break;
+        case 3: Result = tan_ps(A); break;
+        case 4: Result = atan2_ps(A, B); break;
+        case 5: Result = exp_ps(A); break;
+        case 6: Result = log_ps(A); break;
+        case 7: Result = _mm_floor_ps(A); break;
+        case 8: Result = _mm_ceil_ps(A); break;
+        case 9: Result = _mm_round_ps(A, _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC); break;
+        case 10: Result = _mm_sqrt_ps(A); break;
+    }
+
+    _mm_storeu_ps(Outputs, Result);
+    _mm_storeu_ps(SecondOutputs, Second);
+}
+#endif
+
+internal void
+BenchPortableSimd(u32 Variant, b32 Portable, f32 *As, f32 *Bs, f32 *Outputs, f32 *SecondOutputs)
+{
+    simd128 A = SimdLoad(As);
+    simd128 B = SimdLoad(Bs);
+
+    simd128 Result = SimdZero();
+    simd128 Second = SimdZero();
+    switch(Variant)
+    {
+        case 0: Result = Portable ? SimdSinPortable(A) : SimdSin(A); break;
+        case 1: Result = Portable ? SimdCosPortable(A) : SimdCos(A); break;
+
+        case 2:
+        {
+            if(Portable)
+            {
+                SimdSinCosPortable(A, &Result, &Second);
+            }
+            else
+            {
+                SimdSinCos(A, &Result, &Second);
+            }
+        } break;
+
+        case 3: Result = Portable ? SimdTanPortable(A) : SimdTan(A); break;
+        case 4: Result = Portable ? SimdAtan2Portable(A, B) : SimdAtan2(A, B); break;
+        case 5: Result = Portable ? SimdExpPortable(A) : SimdExp(A); break;
+        case 6: Result = Portable ? SimdLogPortable(A) : SimdLog(A); break;
+        case 7: Result = SimdFloor(A); break;
+        case 8: Result = SimdCeil(A); break;
+        case 9: Result = SimdRound(A); break;
+        case 10: Result = SimdSqrt(A); break;
+    }
+
+    SimdStore(Outputs, Result);
+    SimdStore(SecondOutputs, Second);
+}
+
+// NOTE: Checks the wasp_math kernels against the SSE originals bit for bit, two NaNs count as the same. Backend is
+// what this build runs, portable the kernels the NEON and scalar backends run, rounding and Sqrt have no portable
+// version of their own. A quarter of the inputs are random bit patterns, so infinities, NaNs and denormals are in.
+// Build with -DWASP_MATH_SCALAR=1 to check the scalar backend
+internal void
+BenchMicroPortable(memory_arena *Arena)
+{
+#if Architecture_X86_64 || Architecture_X86_32
+    u32 Count = 1 << 16;
+    u32 Iterations = 1 << 6;
+
+    f32 *As = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *Bs = MemoryArenaPushArray(Arena, f32, 1, Count);
+
+    f32 *Outputs[3];
+    for(u32 Set = 0;
+        Set < 3;
+        Set++)
+    {
+        Outputs[Set] = MemoryArenaPushArray(Arena, f32, 1, 2 * Count);
+    }
+
+    for(u32 Index = 0;
+        Index < Count;
+        Index++)
+    {
+        u64 Random = HashU64(Index);
+        u32 BitsA = (u32)Random;
+        u32 BitsB = (u32)(Random >> 32);
+
+        f32 Scales[4] = {200.0f, 20000.0f, 2.0f, 0.0f};
+        f32 Scale = Scales[Index % 4];
+        if(Scale != 0.0f)
+        {
+            As[Index] = ((f32)BitsA / (f32)MaxU32 - 0.5f) * Scale;
+            Bs[Index] = ((f32)BitsB / (f32)MaxU32 - 0.5f) * Scale;
+        }
+        else
+        {
+            MemoryCopy(As + Index, &BitsA, SizeOf(f32));
+            MemoryCopy(Bs + Index, &BitsB, SizeOf(f32));
+        }
+    }
+
+    // NOTE: Atan2 at the axes and the origin
+    As[0] = 0.0f; Bs[0] = 0.0f;
+    As[1] = 1.0f; Bs[1] = 0.0f;
+    As[2] = -1.0f; Bs[2] = 0.0f;
+    As[3] = 0.0f; Bs[3] = -1.0f;
+
+    f64 Elements = (f64)Count * (f64)Iterations;
+    char *Backend = (char *)(MathSSE ? "sse" : MathNEON ? "neon" : "scalar");
+
+    char *Names[] = {"Sin", "Cos", "SinCos", "Tan", "Atan2", "Exp", "Log", "Floor", "Ceil", "Round", "Sqrt"};
+    for(u32 Variant = 0;
+        Variant < ArrayCount(Names);
+        Variant++)
+    {
+        u64 Picoseconds[3];
+        for(u32 Set = 0;
+            Set < 3;
+            Set++)
+        {
+            f32 *Output = Outputs[Set];
+
+            u64 Start = SDL_GetPerformanceCounter();
+            for(u32 Iteration = 0;
+                Iteration < Iterations;
+                Iteration++)
+            {
+                for(u32 Index = 0;
+                    Index < Count;
+                    Index += 4)
+                {
+                    if(Set == 0)
+                    {
+                        BenchPortableReference(Variant, As + Index, Bs + Index, Output + Index, Output + Count + Index);
+                    }
+                    else
+                    {
+                        BenchPortableSimd(Variant, Set == 2, As + Index, Bs + Index, Output + Index, Output + Count + Index);
+                    }
+                }
+
+                u32 SinkBits;
+                MemoryCopy(&SinkBits, &Outputs[Set][Iteration % Count], SizeOf(u32));
+                GlobalBenchSink += SinkBits;
+            }
+            u64 End = SDL_GetPerformanceCounter();
+
+            Picoseconds[Set] = (u64)(BenchSeconds(Start, End) * 1e12 / Elements);
+        }
+
+        u32 Mismatches[3] = {};
+        for(u32 Set = 1;
+            Set < 3;
+            Set++)
+        {
+            for(u32 Index = 0;
+                Index < 2 * Count;
+                Index++)
+            {
+                f32 Expected = Outputs[0][Index];
+                f32 Value = Outputs[Set][Index];
+                b32 BothNaN = (Expected != Expected) && (Value != Value);
+
+                u32 ExpectedBits, ValueBits;
+                MemoryCopy(&ExpectedBits, &Expected, SizeOf(u32));
+                MemoryCopy(&ValueBits, &Value, SizeOf(u32));
+
+                Mismatches[Set] += (ExpectedBits != ValueBits) && !BothNaN;
+            }
+        }
+
+        Outf("portable %s: sse %llu ps per element, %s %llu ps per element with %u mismatches, portable %llu ps per element with %u mismatches\n",
+             Names[Variant], Picoseconds[0], Backend, Picoseconds[1], Mismatches[1], Picoseconds[2], Mismatches[2]);
+    }
+#else
+    Outf("portable: the SSE reference needs x86\n");
+#endif
+}
+
+// NOTE: Length and Normalize against their fast versions, one vector at a time and eight at a time. The vectors are
+// between 1e-3 and 1e4 long with every 64th one zero, which has to come out as 0 and as itself rather than NaN. The
+// error is the max relative one against double precision for the lengths, the max abs one per component for the
+// normalized vectors, both in units of 1e-9
+internal void
+BenchMicroNormalize(memory_arena *Arena)
+{
+    u32 Count = 1 << 14;
+    u32 Iterations = 1 << 10;
+
+    v2 *Vectors = MemoryArenaPushArray(Arena, v2, 1, Count);
+    f32 *Lengths = MemoryArenaPushArray(Arena, f32, 1, Count);
+    v2 *Normalized = MemoryArenaPushArray(Arena, v2, 1, Count);
+    f64 *ExpectedLengths = MemoryArenaPushArray(Arena, f64, 1, Count);
+    f64 *ExpectedNormalized = MemoryArenaPushArray(Arena, f64, 1, 2 * Count);
+
+    for(u32 Index = 0;
+        Index < Count;
+        Index++)
+    {
+        u64 Random = HashU64(Index);
+        f64 Scale = pow(10.0, ((f64)(u32)HashU64(Random) / (f64)MaxU32) * 7.0 - 3.0);
+        f32 X = (f32)(((f64)(u32)Random / (f64)MaxU32 - 0.5) * Scale);
+        f32 Y = (f32)(((f64)(u32)(Random >> 32) / (f64)MaxU32 - 0.5) * Scale);
+        if((Index % 64) == 0)
+        {
+            X = 0.0f;
+            Y = 0.0f;
+        }
+
+        Vectors[Index] = V2(X, Y);
+
+        f64 Length = sqrt((f64)X * (f64)X + (f64)Y * (f64)Y);
+        ExpectedLengths[Index] = Length;
+        ExpectedNormalized[2 * Index + 0] = (Length > 0.0) ? (f64)X / Length : 0.0;
+        ExpectedNormalized[2 * Index + 1] = (Length > 0.0) ? (f64)Y / Length : 0.0;
+    }
+
+    f64 Elements = (f64)Count * (f64)Iterations;
+
+    char *Names[] = {"Length", "LengthFast", "Length v2x8", "LengthFast v2x8", "Normalize", "NormalizeFast", "Normalize v2x8", "NormalizeFast v2x8"};
+    for(u32 Variant = 0;
+        Variant < ArrayCount(Names);
+        Variant++)
+    {
+        b32 Fast = (Variant & 1);
+        b32 Wide = (Variant & 2);
+        b32 Normalizing = (Variant & 4);
+
+        u64 Start = SDL_GetPerformanceCounter();
+        for(u32 Iteration = 0;
+            Iteration < Iterations;
+            Iteration++)
+        {
+            if(Wide)
+            {
+                for(u32 Index = 0;
+                    Index < Count;
+                    Index += 8)
+                {
+                    v2x8 Value = V2x8GatherStrided(Vectors + Index, SizeOf(v2), 8);
+                    if(Normalizing)
+                    {
+                        V2x8ScatterStrided(Normalized + Index, SizeOf(v2), 8, Fast ? NormalizeFast(Value) : Normalize(Value));
+                    }
+                    else
+                    {
+                        F32x8Store(Lengths + Index, Fast ? LengthFast(Value) : Length(Value));
+                    }
+                }
+            }
+            else
+            {
+                for(u32 Index = 0;
+                    Index < Count;
+                    Index++)
+                {
+                    if(Normalizing)
+                    {
+                        Normalized[Index] = Fast ? NormalizeFast(Vectors[Index]) : Normalize(Vectors[Index]);
+                    }
+                    else
+                    {
+                        Lengths[Index] = Fast ? LengthFast(Vectors[Index]) : Length(Vectors[Index]);
+                    }
+                }
+            }
+
+            u32 SinkBits;
+            MemoryCopy(&SinkBits, Normalizing ? &Normalized[Iteration & (Count - 1)].X : &Lengths[Iteration & (Count - 1)], SizeOf(u32));
+            GlobalBenchSink += SinkBits;
+        }
+        u64 End = SDL_GetPerformanceCounter();
+
+        f64 MaxError = 0;
+        u32 NaNs = 0;
+        if(Normalizing)
+        {
+            f32 *Values = (f32 *)Normalized;
+            for(u32 Index = 0;
+                Index < 2 * Count;
+                Index++)
+            {
+                NaNs += (Values[Index] != Values[Index]);
+            }
+
+            MaxError = BenchMaxError(Values, ExpectedNormalized, 2 * Count);
+        }
+        else
+        {
+            for(u32 Index = 0;
+                Index < Count;
+                Index++)
+            {
+                NaNs += (Lengths[Index] != Lengths[Index]);
+
+                f64 Error = Abs((f64)Lengths[Index] - ExpectedLengths[Index]);
+                if(ExpectedLengths[Index] > 0.0)
+                {
+                    Error /= ExpectedLengths[Index];
+                }
+
+                MaxError = Max(MaxError, Error);
+            }
+        }
+
+        Outf("normalize %s: %llu ps per element, max error %llue-9, %u NaNs\n", Names[Variant], (u64)(BenchSeconds(Start, End) * 1e12 / Elements),
+             (u64)(MaxError * 1e9), NaNs);
+    }
+}
+
+// NOTE: Fills a buffer one value at a time and 4 and 8 at a time, integers and floats. The xorshift32 the game
+// used before is in for comparison. The wide series have to match the single streams they are made of bit for bit,
+// a mismatch is counted per value
+internal void
+BenchMicroRandom(memory_arena *Arena)
+{
+    u32 Count = 1 << 14;
+    u32 Iterations = 1 << 10;
+
+    u32 *Values = MemoryArenaPushArray(Arena, u32, 1, Count);
+    u32 *Expected = MemoryArenaPushArray(Arena, u32, 1, Count);
+    f32 *Floats = MemoryArenaPushArray(Arena, f32, 1, Count);
+    f32 *ExpectedFloats = MemoryArenaPushArray(Arena, f32, 1, Count);
+
+    f64 Elements = (f64)Count * (f64)Iterations;
+
+    char *Names[] = {"xorshift32", "u32", "u32 x4", "u32 x8", "f32", "f32 x4", "f32 x8"};
+    u32 LanesCounts[] = {1, 1, 4, 8, 1, 4, 8};
+    for(u32 Variant = 0;
+        Variant < ArrayCount(Names);
+        Variant++)
+    {
+        b32 IsFloat = (Variant >= 4);
+        u32 Lanes = LanesCounts[Variant];
+
+        u32 XorShift = DefaultSeed;
+        random_series Series = RandomSeriesCreate(DefaultSeed, 0);
+        random_series_x4 Series4 = RandomSeriesX4Create(DefaultSeed, 0);
+        random_series_x8 Series8 = RandomSeriesX8Create(DefaultSeed, 0);
+
+        u64 Start = SDL_GetPerformanceCounter();
+        for(u32 Iteration = 0;
+            Iteration < Iterations;
+            Iteration++)
+        {
+            for(u32 Index = 0;
+                Index < Count;
+                Index += Lanes)
+            {
+                if(Variant == 0)
+                {
+                    XorShift ^= XorShift << 13;
+                    XorShift ^= XorShift >> 17;
+                    XorShift ^= XorShift << 5;
+                    Values[Index] = XorShift;
+                }
+                else if(Lanes == 1)
+                {
+                    if(IsFloat)
+                    {
+                        Floats[Index] = RandomUnilateral(&Series);
+                    }
+                    else
+                    {
+                        Values[Index] = RandomNext(&Series);
+                    }
+                }
+                else if(Lanes == 4)
+                {
+                    if(IsFloat)
+                    {
+                        RandomUnilateral(&Series4, Floats + Index);
+                    }
+                    else
+                    {
+                        RandomNext(&Series4, Values + Index);
+                    }
+                }
+                else
+                {
+                    if(IsFloat)
+                    {
+                        RandomUnilateral(&Series8, Floats + Index);
+                    }
+                    else
+                    {
+                        RandomNext(&Series8, Values + Index);
+                    }
+                }
+            }
+
+            if(IsFloat)
+            {
+                u32 SinkBits;
+                MemoryCopy(&SinkBits, &Floats[Iteration & (Count - 1)], SizeOf(u32));
+                GlobalBenchSink += SinkBits;
+            }
+            else
+            {
+                GlobalBenchSink += Values[Iteration & (Count - 1)];
+            }
+        }
+        u64 End = SDL_GetPerformanceCounter();
+
+        // NOTE: Replays every lane as its own stream for as many values as the last iteration drew from it
+        u32 Mismatches = 0;
+        if(Lanes > 1)
+        {
+            u32 PerLane = Count / Lanes;
+            for(u32 Lane = 0;
+                Lane < Lanes;
+                Lane++)
+            {
+                random_series Single = RandomSeriesCreate(DefaultSeed, Lane);
+                for(u32 Skip = 0;
+                    Skip < (Iterations - 1) * PerLane;
+                    Skip++)
+                {
+                    RandomNext(&Single);
+                }
+
+                for(u32 Index = Lane;
+                    Index < Count;
+                    Index += Lanes)
+                {
+                    if(IsFloat)
+                    {
+                        ExpectedFloats[Index] = RandomUnilateral(&Single);
+                    }
+                    else
+                    {
+                        Expected[Index] = RandomNext(&Single);
+                    }
+                }
+            }
+
+            Mismatches = IsFloat ? BenchMismatches(Floats, ExpectedFloats, Count) : BenchMismatches(Values, Expected, Count);
+        }
+
+        Outf("random %s: %llu ps per value, %u mismatches\n", Names[Variant], (u64)(BenchSeconds(Start, End) * 1e12 / Elements), Mismatches);
+    }
+}
+
+// NOTE: Keys are the index times an odd constant, so they are all different and the reference is a plain array
+// indexed by the key's index. Every insert, remove and find the map answers is checked against it, a mismatch is
+// counted per answer. Lookups go in a shuffled order, half of them for keys that were never inserted
+internal void
+BenchMicroHashMap(memory_arena *Arena)
+{
+    u32 KeysCounts[] =
+    {
+        1 << 10, 1 << 16, 1 << 20,
+    };
+
+    u32 OperationsCount = 1 << 22;
+    u64 KeyMultiplier = 0x9e3779b97f4a7c15ull;
+
+    for(u32 CountIndex = 0;
+        CountIndex < ArrayCount(KeysCounts);
+        CountIndex++)
+    {
+        u32 KeysCount = KeysCounts[CountIndex];
+        u32 Rounds = Max(OperationsCount / KeysCount, 1u);
+
+        memory_temporary Temp = MemoryTemporaryBegin(Arena);
+
+        // NOTE: Indices from KeysCount on are the misses
+        b8 *Present = MemoryArenaPushArray(Arena, b8, 1, 2 * KeysCount);
+        u32 *Order = MemoryArenaPushArray(Arena, u32, 1, 2 * KeysCount);
+
+        random_series Series = RandomSeriesCreate(DefaultSeed, RandomStream_Bench);
+        for(u32 Index = 0;
+            Index < 2 * KeysCount;
+            Index++)
+        {
+            Order[Index] = Index;
+        }
+
+        for(u32 Index = 2 * KeysCount - 1;
+            Index > 0;
+            Index--)
+        {
+            u32 Other = RandomNext(&Series) % (Index + 1);
+            u32 Swap = Order[Index];
+            Order[Index] = Order[Other];
+            Order[Other] = Swap;
+        }
+
+        u32 Mismatches = 0;
+        hash_map Map;
+
+        // NOTE: Starts small so the grows are part of the insert time
+        u64 InsertStart = SDL_GetPerformanceCounter();
+        for(u32 Round = 0;
+            Round < Rounds;
+            Round++)
+        {
+            if(Round)
+            {
+                HashMapDestroy(&Map);
+            }
+
+            Map = HashMapCreateU64(0, u32, 16);
+
+            for(u32 Index = 0;
+                Index < KeysCount;
+                Index++)
+            {
+                *HashMapInsertU64Type(&Map, u32, Index * KeyMultiplier, 0) = Index;
+            }
+        }
+        u64 InsertEnd = SDL_GetPerformanceCounter();
+
+        for(u32 Index = 0;
+            Index < KeysCount;
+            Index++)
+        {
+            Present[Index] = 1;
+        }
+
+        u64 FindStart = SDL_GetPerformanceCounter();
+        for(u32 Round = 0;
+            Round < Rounds;
+            Round++)
+        {
+            for(u32 Index = 0;
+                Index < 2 * KeysCount;
+                Index++)
+            {
+                u32 *Value = HashMapFindU64Type(&Map, u32, Order[Index] * KeyMultiplier);
+                GlobalBenchSink += Value ? *Value : 0;
+            }
+        }
+        u64 FindEnd = SDL_GetPerformanceCounter();
+
+        // NOTE: Removes every key in the first half of the shuffled order, misses included
+        u64 RemoveStart = SDL_GetPerformanceCounter();
+        for(u32 Index = 0;
+            Index < KeysCount;
+            Index++)
+        {
+            u32 Key = Order[Index];
+            b32 Removed = HashMapRemoveU64(&Map, Key * KeyMultiplier);
+            Mismatches += Removed != (b32)Present[Key];
+            Present[Key] = 0;
+        }
+        u64 RemoveEnd = SDL_GetPerformanceCounter();
+
+        // NOTE: Random inserts and removes on top, inserting a key that is there has to find it instead
+        u64 ChurnStart = SDL_GetPerformanceCounter();
+        for(u32 Operation = 0;
+            Operation < OperationsCount;
+            Operation++)
+        {
+            u32 Key = RandomNext(&Series) % (2 * KeysCount);
+            if(Operation & 1)
+            {
+                b32 Removed = HashMapRemoveU64(&Map, Key * KeyMultiplier);
+                Mismatches += Removed != (b32)Present[Key];
+                Present[Key] = 0;
+            }
+            else
+            {
+                b32 Inserted;
+                u32 *Value = HashMapInsertU64Type(&Map, u32, Key * KeyMultiplier, &Inserted);
+                Mismatches += Inserted == (b32)Present[Key];
+                Mismatches += !Inserted && *Value != Key;
+                *Value = Key;
+                Present[Key] = 1;
+            }
+        }
+        u64 ChurnEnd = SDL_GetPerformanceCounter();
+
+        // NOTE: The probes are the extra groups a lookup had to look at after the first one
+        u32 PresentCount = 0;
+        u64 ProbesTotal = 0;
+        u32 ProbesMax = 0;
+        for(u32 Key = 0;
+            Key < 2 * KeysCount;
+            Key++)
+        {
+            u64 KeyValue = Key * KeyMultiplier;
+            u32 *Value = HashMapFindU64Type(&Map, u32, KeyValue);
+            Mismatches += (Value != 0) != (b32)Present[Key];
+            Mismatches += Value && *Value != Key;
+
+            if(Present[Key])
+            {
+                u32 ProbesCount;
+                HashMapLookup(&Map, HashU64(KeyValue), &KeyValue, &ProbesCount);
+                ProbesTotal += ProbesCount;
+                ProbesMax = Max(ProbesMax, ProbesCount);
+                PresentCount++;
+            }
+        }
+
+        Mismatches += Map.Count != PresentCount;
+
+        f64 Inserts = (f64)Rounds * (f64)KeysCount;
+        // NOTE: Outf has no floats, the probes are per thousand keys and the load is in percent
+        Outf("hash_map %u keys: insert %llu ns, find %llu ns, remove %llu ns, churn %llu ns, probes %llu per 1000 keys, "
+             "%u max, load %u%%, %u mismatches\n", KeysCount,
+             (u64)(BenchSeconds(InsertStart, InsertEnd) * 1e9 / Inserts),
+             (u64)(BenchSeconds(FindStart, FindEnd) * 1e9 / (2.0 * Inserts)),
+             (u64)(BenchSeconds(RemoveStart, RemoveEnd) * 1e9 / (f64)KeysCount),
+             (u64)(BenchSeconds(ChurnStart, ChurnEnd) * 1e9 / (f64)OperationsCount),
+             PresentCount ? ProbesTotal * 1000 / PresentCount : 0, ProbesMax,
+             (u32)((u64)Map.Count * 100 / HashMapSlotsCount(&Map)), Mismatches);
+
+        HashMapDestroy(&Map);
+        MemoryTemporaryEnd(Temp);
+    }
+}
+
+global bench_micro GlobalBenchMicros[] =
+{
+    {"hash", BenchMicroHash},
+    {"slab", BenchMicroSlab},
+    {"trig", BenchMicroTrig},
+    {"matrix", BenchMicroMatrix},
+    {"dispatch", BenchMicroDispatch},
+    {"portable", BenchMicroPortable},
+    {"normalize", BenchMicroNormalize},
+    {"random", BenchMicroRandom},
+    {"hash_map", BenchMicroHashMap},
+};
+
+internal void
+BenchSort(u64 *Values, u32 Count)
+{
+    for(u32 Index = 1;
+        Index < Count;
+        Index++)
+    {
+        u64 Value = Values[Index];
+
+        u32 Position = Index;
+        while(Position > 0 && Values[Position - 1] > Value)
+        {
+            Values[Position] = Values[Position - 1];
+            Position--;
+        }
+
+        Values[Position] = Value;
+    }
+}
+
+internal void
+BenchRun(bench_scenario *Scenario, u32 FramesCount, memory_arena *TempArena)
+{
+    game_assets Assets = GlobalContext.Assets;
+    SDL_Surface *Surface = GlobalContext.WindowSurface;
+    memory_frame_arenas FrameArenas = GlobalContext.FrameArenas;
+
+    ZeroStruct(&GlobalContext);
+    GlobalContext.Assets = Assets;
+    GlobalContext.WindowSurface = Surface;
+    GlobalContext.FrameArenas = FrameArenas;
+
+    memory_arena Arena = MemoryArenaCreate(MB(256), 0, MemoryArenaFlag_OnlyCommitAsNeeded);
+    MemoryArenaName(&Arena, Scenario->Name);
+
+    GameInit(&GlobalContext, &Arena, DefaultSeed);
+
+    // NOTE: Scenarios start in game, enemy projectiles are harmless so nobody dies halfway
+    game_input Input = {};
+    Input.ShouldRestart = 1;
+    GameUpdate(&GlobalContext, &Input, SimulationDeltaTime);
+
+    GlobalContext.ProjectileDamage = 0;
+
+    Scenario->Setup(&GlobalContext, &Arena);
+
+    memory_temporary Temp = MemoryTemporaryBegin(TempArena);
+    u64 *FrameTimes = MemoryArenaPushArray(TempArena, u64, 1, FramesCount);
+
+    u64 Frequency = SDL_GetPerformanceFrequency();
+    u64 TickCounter = 0;
+    u64 FrameCounter = 0;
+
+    ProfilerInit();
+
+    for(u32 FrameIndex = 0;
+        FrameIndex < BenchWarmupFramesCount + FramesCount;
+        FrameIndex++)
+    {
+        u64 FrameStart = SDL_GetPerformanceCounter();
+
+        for(u32 TickIndex = 0;
+            TickIndex < BenchTicksPerFrame;
+            TickIndex++)
+        {
+            HeadlessBotInput(&GlobalContext, &Input);
+            GameUpdate(&GlobalContext, &Input, SimulationDeltaTime);
+        }
+
+        u64 TicksEnd = SDL_GetPerformanceCounter();
+
+        GameRender(&GlobalContext, 1.0f);
+
+        u64 FrameEnd = SDL_GetPerformanceCounter();
+
+        ProfilerFrameEnd();
+        MemoryFrameSwap(&GlobalContext.FrameArenas);
+
+        if(FrameIndex >= BenchWarmupFramesCount)
+        {
+            TickCounter += TicksEnd - FrameStart;
+            FrameCounter += FrameEnd - FrameStart;
+            FrameTimes[FrameIndex - BenchWarmupFramesCount] = FrameEnd - FrameStart;
+        }
+    }
+
+    BenchSort(FrameTimes, FramesCount);
+
+    u64 NanosecondsPerTick = (u64)((f64)TickCounter * 1e9 / (f64)Frequency / (f64)(FramesCount * BenchTicksPerFrame));
+    u64 NanosecondsPerFrame = (u64)((f64)FrameCounter * 1e9 / (f64)Frequency / (f64)FramesCount);
+    u64 MicrosecondsP50 = (u64)((f64)FrameTimes[FramesCount / 2] * 1e6 / (f64)Frequency);
+    u64 MicrosecondsP99 = (u64)((f64)FrameTimes[(FramesCount * 99) / 100] * 1e6 / (f64)Frequency);
+
+    umm UsedSize = MemoryArenaUsedTotal(&Arena) + MemoryArrayUsedTotal(&GlobalContext.Enemies) + MemoryPoolUsedTotal(&GlobalContext.Projectiles);
+
+    Outf("%s: %llu ns/tick, %llu ns/frame, p50 %llu us, p99 %llu us, arena %llu bytes\n",
+         Scenario->Name, NanosecondsPerTick, NanosecondsPerFrame, MicrosecondsP50, MicrosecondsP99, (u64)UsedSize);
+
+#if WOMBAT_PROFILER
+    profile_anchor Anchors[ProfilerAnchorsCount];
+    u64 FrameCycles;
+    ProfilerAverageAnchors(Anchors, &FrameCycles);
+
+    for(u32 AnchorIndex = 1;
+        AnchorIndex < ProfilerAnchorsCount;
+        AnchorIndex++)
+    {
+        if(GlobalProfiler.AnchorNames[AnchorIndex])
+        {
+            Outf("    %s: %llu cycles/frame exclusive, %u hits\n",
+                 GlobalProfiler.AnchorNames[AnchorIndex], Anchors[AnchorIndex].CyclesExclusive, Anchors[AnchorIndex].HitsCount);
+        }
+    }
+#endif
+
+    MemoryTemporaryEnd(Temp);
+    GameRelease(&GlobalContext);
+    MemoryArenaDestroy(&Arena);
+}
+
+s32 main(s32 ArgsCount, char **Args)
+{
+    if(!CpuSetup())
+    {
+        return(1);
+    }
+
+    u32 FramesCount = BenchDefaultFramesCount;
+
+    b32 Selected[ArrayCount(GlobalBenchScenarios)] = {};
+    b32 MicrosSelected[ArrayCount(GlobalBenchMicros)] = {};
+    b32 AnySelected = 0;
+
+    for(s32 ArgIndex = 1;
+        ArgIndex < ArgsCount;
+        ArgIndex++)
+    {
+        string Arg = StringBundleZ(Args[ArgIndex]);
+
+        if(StringEqualsZ(Arg, "-frames") && ArgIndex + 1 < ArgsCount)
+        {
+            u64 Value;
+            b32 Signed;
+            if(StringToInteger(StringBundleZ(Args[ArgIndex + 1]), &Value, &Signed, 10, 0) && !Signed && Value)
+            {
+                FramesCount = (u32)Value;
+            }
+
+            ArgIndex++;
+        }
+        else
+        {
+            b32 Found = 0;
+            for(u32 ScenarioIndex = 0;
+                ScenarioIndex < ArrayCount(GlobalBenchScenarios);
+                ScenarioIndex++)
+            {
+                if(StringEqualsZ(Arg, GlobalBenchScenarios[ScenarioIndex].Name))
+                {
+                    Selected[ScenarioIndex] = 1;
+                    AnySelected = 1;
+                    Found = 1;
+                }
+            }
+
+            for(u32 MicroIndex = 0;
+                MicroIndex < ArrayCount(GlobalBenchMicros);
+                MicroIndex++)
+            {
+                if(StringEqualsZ(Arg, GlobalBenchMicros[MicroIndex].Name))
+                {
+                    MicrosSelected[MicroIndex] = 1;
+                    AnySelected = 1;
+                    Found = 1;
+                }
+            }
+
+            if(!Found)
+            {
+                Outf("Unknown scenario or microbenchmark: %s\n", Args[ArgIndex]);
+                return(1);
+            }
+        }
+    }
+
+    memory_arena AssetsArena = MemoryArenaCreate(0, MB(8), 0);
+    memory_arena TempArena = MemoryArenaCreate(MB(64), 0, MemoryArenaFlag_OnlyCommitAsNeeded);
+    MemoryArenaName(&AssetsArena, "assets");
+    MemoryArenaName(&TempArena, "bench temp");
+
+    AssetsLoad(&GlobalContext.Assets, &AssetsArena);
+
+    GlobalContext.FrameArenas = MemoryFrameArenasCreate(MB(16), 0, MemoryArenaFlag_OnlyCommitAsNeeded);
+
+    GlobalContext.WindowSurface = SDL_CreateSurface(WindowWidth, WindowHeight, SDL_PIXELFORMAT_XRGB8888);
+    Assert(GlobalContext.WindowSurface);
+
+    Outf("cpu %s, math kernels %s\n", GlobalCpu.Brand, GlobalMathKernels.Name);
+    Outf("%u frames per scenario, %u ticks per frame, assets %llu bytes\n", FramesCount, BenchTicksPerFrame, (u64)MemoryArenaUsedTotal(&AssetsArena));
+
+    for(u32 ScenarioIndex = 0;
+        ScenarioIndex < ArrayCount(GlobalBenchScenarios);
+        ScenarioIndex++)
+    {
+        if(!AnySelected || Selected[ScenarioIndex])
+        {
+            BenchRun(&GlobalBenchScenarios[ScenarioIndex], FramesCount, &TempArena);
+        }
+    }
+
+    for(u32 MicroIndex = 0;
+        MicroIndex < ArrayCount(GlobalBenchMicros);
+        MicroIndex++)
+    {
+        if(!AnySelected || MicrosSelected[MicroIndex])
+        {
+            memory_temporary Temp = MemoryTemporaryBegin(&TempArena);
+            GlobalBenchMicros[MicroIndex].Run(&TempArena);
+            MemoryTemporaryEnd(Temp);
+        }
+    }
+
+    SDL_DestroySurface(GlobalContext.WindowSurface);
+    MemoryFrameArenasDestroy(&GlobalContext.FrameArenas);
+
+    MemoryInstrumentReport();
+
+    return(0);
+}
@@ -1,15 +1,47 @@
 #include <SDL3/SDL.h>
 
 #include "wasp.h"
+#include "wasp_cpu.h"
 #include "wasp_math.h"
 #include "wasp_memory.h"
 #include "wasp_string.h"
+#include "wasp_hash.h"
+#include "wasp_hash_map.h"
+#include "wasp_random.h"
+
+#if Platform_WIN32
 #include "wasp_win32.h"
+#elif Platform_LINUX
+#include "wasp_linux.h"
+#endif
 
 #define PixelScale 6
 #define WindowWidth 1280
 #define WindowHeight 720
 #define TilePixelSize PixelScale * 16
+#define SimulationHz 120
+#define SimulationDeltaTime (1.0f / SimulationHz)
+#define MaxFrameTime 0.25f
+#define DefaultSeed 1847569
+
+// NOTE: Only address space is reserved up front, pages are committed as the waves grow. Waves never get close,
+// the caps are sized for the enemies_100k bench, whose 100000 enemies keep about 144k shots in flight
+#define MaxEnemiesCount (1 << 17)
+#define MaxProjectilesCount (1 << 18)
+#define MaxMultishotCount 8
+#define SpawnBatchCount 256
+
+// NOTE: Every system draws from its own random stream, so the values one of them gets don't depend on how many the
+// others drew before it
+enum random_stream
+{
+    RandomStream_Map,
+    RandomStream_Waves,
+    RandomStream_Bench, // NOTE: Only drawn from by the bench setups
+
+    // NOTE: Every enemy gets a stream of its own, numbered in the order they were spawned over the whole game
+    RandomStream_Enemies,
+};
 
 struct texture
 {
@@ -37,16 +69,16 @@ struct enemy
 {
     u32 Type;
     v2 Position;
+    v2 LastPosition;
     f32 Angle;
     f32 TimeOfNextShot;
     b32 Dead;
+
+    random_series Random;
 };
 
 struct projectile
 {
-    projectile *Prev;
-    projectile *Next;
-
     u32 Type;
     v2 Position;
     v2 LastPosition;
@@ -71,13 +103,67 @@ struct font
     u32 GlyphHeight;
 };
 
+struct game_assets
+{
+    animation CharacterIdleAnimation;
+    animation CharacterWalkingAnimation;
+
+    texture BlankHealthBar;
+    texture HealthBar;
+
+    texture StartOn;
+    texture StartOff;
+
+    texture GameOver;
+    texture WinMenu;
+
+    texture ShopUI;
+    animation MaxHealth;
+    animation FasterRegen;
+    animation Multishot;
+
+    animation Enemies[2];
+    animation Projectiles[3];
+    animation MapAnimations[31];
+
+    font Font;
+};
+
+struct game_input
+{
+    f32 DirectionX;
+    f32 DirectionY;
+    v2 ViewDirection;
+    u32 MouseX;
+    u32 MouseY;
+
+    b32 DidClick;
+    b32 PressedSpace;
+    b32 ShouldRestart;
+};
+
 struct context
 {
     SDL_Surface *WindowSurface;
     SDL_Window *Window;
 
+    game_assets Assets;
+
+    u32 MapSizeX;
+    u32 MapSizeY;
+    u32 MapMargin;
+
+    tile_map SeaMap;
+    tile_map IslandMap;
+    tile_map OverlayMap;
+    collision_map CollisionMap;
+
+    f64 Time;
+
     f32 PlayerX;
     f32 PlayerY;
+    f32 LastPlayerX;
+    f32 LastPlayerY;
 
     b32 IsPointer;
 
@@ -106,14 +192,16 @@ struct context
     f32 ShotCooldown;
 
     u32 Seed;
+    random_series WaveRandom;
+    u64 EnemiesSpawnedCount;
 
-    enemy *Enemies;
-    u32 EnemiesCapacity;
-    u32 EnemiesCount;
+    memory_array Enemies;
     u32 EnemiesRemaining;
 
-    projectile Projectiles;
-    projectile FreeProjectiles;
+    memory_pool Projectiles;
+
+    // NOTE: Per frame allocations, anything pushed here lives until the end of the next frame
+    memory_frame_arenas FrameArenas;
 
     f32 RegenRate;
 
@@ -129,6 +217,8 @@ struct context
     b32 IsWaitingForNextWave;
     u32 WaveIndex;
 
+    b32 IsNearShop;
+
     v2 ViewDirection;
     u32 MouseX;
     u32 MouseY;
@@ -136,18 +226,11 @@ struct context
 
 global context GlobalContext;
 
-internal void AssertCallback(char *Expression, char *File, int LineNumber, char *Function)
-{
-}
+#include "wombat_replay.cpp"
+#include "wombat_profiler.cpp"
 
-internal u32
-GetRandom()
+internal void AssertCallback(char *Expression, char *File, int LineNumber, char *Function)
 {
-    u32 X = GlobalContext.Seed;
-	X ^= X << 13;
-	X ^= X >> 17;
-	X ^= X << 5;
-	return GlobalContext.Seed = X;
 }
 
 internal tile_map
@@ -301,11 +384,13 @@ FontCreate(char *Path, u32 GlyphWidth, u32 GlyphHeight)
 }
 
 internal void
-FontDraw(font *Font, string String, u32 X, u32 Y, b32 Centered)
+FontDrawScaled(font *Font, string String, u32 X, u32 Y, u32 Scale, b32 Centered)
 {
+    TIMED_BLOCK("FontDraw");
+
     if(Centered)
     {
-        X -= (u32)String.Size * Font->GlyphWidth * PixelScale / 2;
+        X -= (u32)String.Size * Font->GlyphWidth * Scale / 2;
     }
 
     for(u32 CharacterIndex = 0;
@@ -320,6 +405,11 @@ FontDraw(font *Font, string String, u32 X, u32 Y, b32 Centered)
             Index = Codepoint - 'A';
             FoundIndex = 1;
         }
+        if(Codepoint >= 'a' && Codepoint <= 'z')
+        {
+            Index = Codepoint - 'a';
+            FoundIndex = 1;
+        }
         if(Codepoint >= '0' && Codepoint <= '9')
         {
             Index = Codepoint - '0' + 'Z' - 'A' + 1;
@@ -340,8 +430,8 @@ FontDraw(font *Font, string String, u32 X, u32 Y, b32 Centered)
             SDL_Rect DestRect = {};
             DestRect.x = X;
             DestRect.y = Y;
-            DestRect.w = Font->GlyphWidth * PixelScale;
-            DestRect.h = Font->GlyphHeight * PixelScale;
+            DestRect.w = Font->GlyphWidth * Scale;
+            DestRect.h = Font->GlyphHeight * Scale;
     
             SDL_BlitSurfaceScaled(
                 Font->Atlas.Surface,
@@ -351,10 +441,16 @@ FontDraw(font *Font, string String, u32 X, u32 Y, b32 Centered)
                 SDL_SCALEMODE_NEAREST);
         }
 
-        X += (Font->GlyphWidth + 1) * PixelScale;
+        X += (Font->GlyphWidth + 1) * Scale;
     }
 }
 
+internal void
+FontDraw(font *Font, string String, u32 X, u32 Y, b32 Centered)
+{
+    FontDrawScaled(Font, String, X, Y, PixelScale, Centered);
+}
+
 internal void
 TextureDrawCustom(texture *Texture, u32 X, u32 Y)
 {
@@ -435,6 +531,8 @@ AnimationDraw(animation *Animation, u32 X, u32 Y, u32 Frame)
 internal void
 TileMapDraw(tile_map *TileMap, u32 X, u32 Y, u32 Frame)
 {
+    TIMED_FUNCTION;
+
     u32 CurrentX = X;
     u32 CurrentY = Y;
 
@@ -462,7 +560,7 @@ TileMapDraw(tile_map *TileMap, u32 X, u32 Y, u32 Frame)
 }
 
 internal void
-TileMapFillRandom(tile_map *TileMap, u32 X1, u32 Y1, u32 X2, u32 Y2, u8 First, u8 Count)
+TileMapFillRandom(tile_map *TileMap, random_series *Series, u32 X1, u32 Y1, u32 X2, u32 Y2, u8 First, u8 Count)
 {
     u32 Pitch = TileMap->SizeX;
     u32 RowStart = X1 + Y1 * TileMap->SizeX;
@@ -476,7 +574,7 @@ TileMapFillRandom(tile_map *TileMap, u32 X1, u32 Y1, u32 X2, u32 Y2, u8 First, u
             X < X2;
             X++)
         {
-            f32 Clamped = (f32)GetRandom() / (f32)MaxU32;
+            f32 Clamped = RandomUnilateral(Series);
 
             u8 Type = 0;
             while(Clamped < 0.33)
@@ -488,7 +586,7 @@ TileMapFillRandom(tile_map *TileMap, u32 X1, u32 Y1, u32 X2, u32 Y2, u8 First, u
                     break;
                 }
 
-                Clamped = (f32)GetRandom() / (f32)MaxU32;
+                Clamped = RandomUnilateral(Series);
             }
 
             TileMap->Layout[CurrentElement] = First + Type;
@@ -557,55 +655,93 @@ IsWalkable(collision_map *CollisionMap, u32 X, u32 Y)
 internal void
 SpawnEnemies(u32 Count, f32 X, f32 Y, f32 Radius, f32 Time)
 {
-    GlobalContext.EnemiesCount = Count;
+    MemoryArrayClear(&GlobalContext.Enemies);
     GlobalContext.EnemiesRemaining = Count;
 
-    for(u32 Index = 0;
-        Index < Count;
-        Index++)
+    // NOTE: Eight enemies draw from their own streams at once, the positions are filled in afterwards so the sines and
+    // cosines for a whole batch go through SinCosArray. Each enemy keeps its stream for the draws later in its life
+    for(u32 BatchStart = 0;
+        BatchStart < Count;
+        BatchStart += SpawnBatchCount)
     {
-        GlobalContext.Enemies[Index].Type = GetRandom() % 2;
-        GlobalContext.Enemies[Index].Dead = 0;
+        u32 BatchCount = Min(Count - BatchStart, SpawnBatchCount);
 
-        f32 RandomAngle = ((f32)GetRandom() / (f32)MaxU32) * 2.0f * Pi;
+        f32 Angles[SpawnBatchCount];
+        f32 Radii[SpawnBatchCount];
+        f32 Sines[SpawnBatchCount];
+        f32 Cosines[SpawnBatchCount];
 
-        f32 R = ((f32)GetRandom() / (f32)MaxU32) * Radius;
+        for(u32 GroupStart = 0;
+            GroupStart < BatchCount;
+            GroupStart += 8)
+        {
+            u64 FirstStream = RandomStream_Enemies + GlobalContext.EnemiesSpawnedCount;
+            random_series_x8 Series = RandomSeriesX8Create(GlobalContext.Seed, FirstStream);
+
+            u32 Types[8];
+            f32 ShotFactors[8];
+            RandomChoice(&Series, 2, Types);
+            RandomBetween(&Series, 0.0f, 2.0f * Pi, Angles + GroupStart);
+            RandomBetween(&Series, 0.0f, Radius, Radii + GroupStart);
+            RandomUnilateral(&Series, ShotFactors);
+
+            u32 GroupCount = Min(BatchCount - GroupStart, 8);
+            for(u32 Lane = 0;
+                Lane < GroupCount;
+                Lane++)
+            {
+                enemy *Enemy = MemoryArrayPushType(&GlobalContext.Enemies, enemy);
+                Assert(Enemy);
 
-        GlobalContext.Enemies[Index].Position = V2(Cos(RandomAngle) * R + X, Abs(Sin(RandomAngle)) * R + Y);
+                Enemy->Type = Types[Lane];
+                Enemy->Dead = 0;
+                Enemy->Random = RandomSeriesX8Lane(&Series, Lane);
 
-        if(GlobalContext.Enemies[Index].Type == 0)
-        {
-            GlobalContext.Enemies[Index].TimeOfNextShot = Time + GlobalContext.FireFireRate + GlobalContext.FireFireRateRandomFactor * (f32)GetRandom() / (f32)MaxU32;
+                if(Enemy->Type == 0)
+                {
+                    Enemy->TimeOfNextShot = Time + GlobalContext.FireFireRate + GlobalContext.FireFireRateRandomFactor * ShotFactors[Lane];
+                }
+                else
+                {
+                    Enemy->TimeOfNextShot = Time + GlobalContext.WaterFireRate + GlobalContext.WaterFireRateRandomFactor * ShotFactors[Lane];
+                }
+            }
+
+            GlobalContext.EnemiesSpawnedCount += GroupCount;
         }
-        else
+
+        SinCosArray(Angles, Sines, Cosines, BatchCount, MathAccuracy_Precise);
+
+        for(u32 Index = 0;
+            Index < BatchCount;
+            Index++)
         {
-            GlobalContext.Enemies[Index].TimeOfNextShot = Time + GlobalContext.WaterFireRate + GlobalContext.WaterFireRateRandomFactor * (f32)GetRandom() / (f32)MaxU32;
+            enemy *Enemy = MemoryArrayAtType(&GlobalContext.Enemies, enemy, BatchStart + Index);
+            Enemy->Position = V2(Cosines[Index] * Radii[Index] + X, Abs(Sines[Index]) * Radii[Index] + Y);
+            Enemy->LastPosition = Enemy->Position;
         }
     }
 }
 
 internal void
-InitProjectiles(memory_arena *Arena, u32 Capacity)
+InitProjectiles()
 {
-    DoublyLinkedListInit(&GlobalContext.Projectiles);
-    DoublyLinkedListInit(&GlobalContext.FreeProjectiles);
-
-    projectile *Projectiles = MemoryArenaPushArray(Arena, projectile, 0, Capacity);
-    for(u32 Index = 0;
-        Index < Capacity;
-        Index++)
-    {
-        DoublyLinkedListInsertAfter(&GlobalContext.FreeProjectiles, &Projectiles[Index]);
-    }
+    // NOTE: Grows with the multishot upgrades without moving, MaxProjectilesCount is only reserved. It gets its
+    // own reservation, inside the game arena the whole range would count as used
+    GlobalContext.Projectiles = MemoryPoolCreate(0, projectile, MaxProjectilesCount);
+    MemoryArenaName(&GlobalContext.Projectiles.Dense.Arena, "projectiles");
 }
 
 internal void
 ProjectileSpawn(v2 Position, v2 Velocity, b32 IsEnemy, u32 Type)
 {
-    projectile *Projectile = GlobalContext.FreeProjectiles.Next;
+    projectile *Projectile = MemoryPoolAcquireType(&GlobalContext.Projectiles, projectile, 0);
 
-    DoublyLinkedListRemove(Projectile);
-    DoublyLinkedListInsertAfter(&GlobalContext.Projectiles, Projectile);
+    // NOTE: Only when MaxProjectilesCount are alive, the shot is dropped
+    if(!Projectile)
+    {
+        return;
+    }
 
     Projectile->IsEnemy = IsEnemy;
     Projectile->LastPosition = Position;
@@ -669,12 +805,15 @@ RectLineIntersection(f32 PosX, f32 PosY, f32 Width, f32 Height,
 internal void
 ProjectileUpdate(f32 DeltaTime)
 {
-    projectile *ProjectileNext = 0;
-    for(projectile *Projectile = GlobalContext.Projectiles.Next;
-        Projectile != &GlobalContext.Projectiles;
-        Projectile = ProjectileNext)
+    TIMED_FUNCTION;
+
+    // NOTE: Backwards, releasing moves the last projectile into the hole and that one has been updated already
+    for(u32 Offset = MemoryPoolCount(&GlobalContext.Projectiles);
+        Offset >= 1;
+        Offset--)
     {
-        ProjectileNext = Projectile->Next;
+        u32 ProjectileIndex = Offset - 1;
+        projectile *Projectile = MemoryPoolAtType(&GlobalContext.Projectiles, projectile, ProjectileIndex);
 
         Projectile->LastPosition = Projectile->Position;
         Projectile->Position = Projectile->Position + Projectile->Velocity * DeltaTime;
@@ -702,10 +841,10 @@ ProjectileUpdate(f32 DeltaTime)
         else
         {
             for(u32 EnemyIndex = 0; 
-                EnemyIndex < GlobalContext.EnemiesCount;
+                EnemyIndex < GlobalContext.Enemies.Count;
                 EnemyIndex++)
             {
-                enemy *Enemy = &GlobalContext.Enemies[EnemyIndex];
+                enemy *Enemy = MemoryArrayAtType(&GlobalContext.Enemies, enemy, EnemyIndex);
 
                 if(!Enemy->Dead)
                 {
@@ -735,87 +874,78 @@ ProjectileUpdate(f32 DeltaTime)
 
         if(ShouldDelete)
         {
-            DoublyLinkedListRemove(Projectile);
-            DoublyLinkedListInsertBefore(&GlobalContext.FreeProjectiles, Projectile);
+            MemoryPoolReleaseAt(&GlobalContext.Projectiles, ProjectileIndex);
         }
     }
 }
 
 internal v2
-GetScreenPos(v2 World)
+GetScreenPos(v2 Camera, v2 World)
 {
     v2 Result = V2(
-        -GlobalContext.PlayerX * TilePixelSize + WindowWidth / 2.0f + (f32)TilePixelSize * World.X,
-        -GlobalContext.PlayerY * TilePixelSize + WindowHeight / 2.0f + (f32)TilePixelSize * World.Y);
+        -Camera.X * TilePixelSize + WindowWidth / 2.0f + (f32)TilePixelSize * World.X,
+        -Camera.Y * TilePixelSize + WindowHeight / 2.0f + (f32)TilePixelSize * World.Y);
     return(Result);
 }
 
-s32 main(s32 ArgsCount, char **Args)
-{
-    SDL_Init(SDL_INIT_VIDEO);
-
-    memory_arena Arena = MemoryArenaCreate(0, MB(8), 0);
-
-    SDL_Window *Window = SDL_CreateWindow("RoboElemental", WindowWidth, WindowHeight, 0);
-    SDL_Surface *WindowSurface = SDL_GetWindowSurface(Window);
-
-    GlobalContext.Window = Window;
-    GlobalContext.WindowSurface = WindowSurface;
-
-    animation CharacterIdleAnimation = AnimationCreate(&Arena, "assets/bot_idle_", 1);
-    animation CharacterWalkingAnimation = AnimationCreate(&Arena, "assets/bot_walking_", 2);
-    animation SeaAnimation = AnimationCreate(&Arena, "assets/sea", 16);
 
-    animation Grass0 = AnimationCreate(&Arena, "assets/tile_0", 1);
-    animation Grass1 = AnimationCreate(&Arena, "assets/tile_1", 1);
-    animation Grass2 = AnimationCreate(&Arena, "assets/tile_2", 1);
-    animation Grass3 = AnimationCreate(&Arena, "assets/tile_3", 1);
-    
-    animation ShallowWaterAnimation = AnimationCreate(&Arena, "assets/shallow_water", 4);
-
-    animation Collide0 = AnimationCreate(&Arena, "assets/collide0", 1);
-    animation Collide1 = AnimationCreate(&Arena, "assets/collide1", 1);
-    animation Collide2 = AnimationCreate(&Arena, "assets/collide2", 1);
-    animation Collide3 = AnimationCreate(&Arena, "assets/collide3", 1);
-    animation Collide4 = AnimationCreate(&Arena, "assets/collide4", 1);
-    animation Collide5 = AnimationCreate(&Arena, "assets/collide5", 1);
-    animation Collide6 = AnimationCreate(&Arena, "assets/collide6", 1);
-    animation Collide7 = AnimationCreate(&Arena, "assets/collide7", 1);
-
-    animation Temple0 = AnimationCreate(&Arena, "assets/temple_0", 1);
-    animation Temple1 = AnimationCreate(&Arena, "assets/temple_1", 1);
-    animation Temple2 = AnimationCreate(&Arena, "assets/temple_2", 1);
-    animation Temple3 = AnimationCreate(&Arena, "assets/temple_3", 1);
-    animation Temple4 = AnimationCreate(&Arena, "assets/temple_4", 1);
-    animation Temple5 = AnimationCreate(&Arena, "assets/temple_5", 1);
-    animation Temple6 = AnimationCreate(&Arena, "assets/temple_6", 1);
-    animation Temple7 = AnimationCreate(&Arena, "assets/temple_7", 1);
-    animation Temple8 = AnimationCreate(&Arena, "assets/temple_8", 1);
-    animation Temple9 = AnimationCreate(&Arena, "assets/temple_9", 1);
-    animation Temple10 = AnimationCreate(&Arena, "assets/temple_10", 1);
-    animation Temple11 = AnimationCreate(&Arena, "assets/temple_11", 1);
-    animation Temple12 = AnimationCreate(&Arena, "assets/temple_12", 1);
-
-    texture BlankHealthBar = TextureCreate("assets/blank_health_bar.bmp");
-    texture HealthBar = TextureCreate("assets/health_bar.bmp");
-
-    texture StartOn = TextureCreate("assets/start_on.bmp");
-    texture StartOff = TextureCreate("assets/start_off.bmp");
-
-    texture GameOver = TextureCreate("assets/gameover.bmp");
-    texture WinMenu = TextureCreate("assets/win_menu0.bmp");
-
-    texture ShopUI = TextureCreate("assets/shopui.bmp");
-    animation MaxHealth = AnimationCreate(&Arena, "assets/maxhealthlevel", 5);
-    animation FasterRegen = AnimationCreate(&Arena, "assets/fasterregen", 5);
-    animation Multishot = AnimationCreate(&Arena, "assets/multishot", 5);
-
-    animation Fire = AnimationCreate(&Arena, "assets/fire", 1);
-    animation Water = AnimationCreate(&Arena, "assets/water", 1);
-
-    animation Ball = AnimationCreate(&Arena, "assets/ball", 1);
-    animation FireBall = AnimationCreate(&Arena, "assets/fireball", 1);
-    animation WaterBall = AnimationCreate(&Arena, "assets/waterball", 1);
+internal void
+AssetsLoad(game_assets *Assets, memory_arena *Arena)
+{
+    Assets->CharacterIdleAnimation = AnimationCreate(Arena, "assets/bot_idle_", 1);
+    Assets->CharacterWalkingAnimation = AnimationCreate(Arena, "assets/bot_walking_", 2);
+    animation SeaAnimation = AnimationCreate(Arena, "assets/sea", 16);
+
+    animation Grass0 = AnimationCreate(Arena, "assets/tile_0", 1);
+    animation Grass1 = AnimationCreate(Arena, "assets/tile_1", 1);
+    animation Grass2 = AnimationCreate(Arena, "assets/tile_2", 1);
+    animation Grass3 = AnimationCreate(Arena, "assets/tile_3", 1);
+
+    animation ShallowWaterAnimation = AnimationCreate(Arena, "assets/shallow_water", 4);
+
+    animation Collide0 = AnimationCreate(Arena, "assets/collide0", 1);
+    animation Collide1 = AnimationCreate(Arena, "assets/collide1", 1);
+    animation Collide2 = AnimationCreate(Arena, "assets/collide2", 1);
+    animation Collide3 = AnimationCreate(Arena, "assets/collide3", 1);
+    animation Collide4 = AnimationCreate(Arena, "assets/collide4", 1);
+    animation Collide5 = AnimationCreate(Arena, "assets/collide5", 1);
+    animation Collide6 = AnimationCreate(Arena, "assets/collide6", 1);
+    animation Collide7 = AnimationCreate(Arena, "assets/collide7", 1);
+
+    animation Temple0 = AnimationCreate(Arena, "assets/temple_0", 1);
+    animation Temple1 = AnimationCreate(Arena, "assets/temple_1", 1);
+    animation Temple2 = AnimationCreate(Arena, "assets/temple_2", 1);
+    animation Temple3 = AnimationCreate(Arena, "assets/temple_3", 1);
+    animation Temple4 = AnimationCreate(Arena, "assets/temple_4", 1);
+    animation Temple5 = AnimationCreate(Arena, "assets/temple_5", 1);
+    animation Temple6 = AnimationCreate(Arena, "assets/temple_6", 1);
+    animation Temple7 = AnimationCreate(Arena, "assets/temple_7", 1);
+    animation Temple8 = AnimationCreate(Arena, "assets/temple_8", 1);
+    animation Temple9 = AnimationCreate(Arena, "assets/temple_9", 1);
+    animation Temple10 = AnimationCreate(Arena, "assets/temple_10", 1);
+    animation Temple11 = AnimationCreate(Arena, "assets/temple_11", 1);
+    animation Temple12 = AnimationCreate(Arena, "assets/temple_12", 1);
+
+    Assets->BlankHealthBar = TextureCreate("assets/blank_health_bar.bmp");
+    Assets->HealthBar = TextureCreate("assets/health_bar.bmp");
+
+    Assets->StartOn = TextureCreate("assets/start_on.bmp");
+    Assets->StartOff = TextureCreate("assets/start_off.bmp");
+
+    Assets->GameOver = TextureCreate("assets/gameover.bmp");
+    Assets->WinMenu = TextureCreate("assets/win_menu0.bmp");
+
+    Assets->ShopUI = TextureCreate("assets/shopui.bmp");
+    Assets->MaxHealth = AnimationCreate(Arena, "assets/maxhealthlevel", 5);
+    Assets->FasterRegen = AnimationCreate(Arena, "assets/fasterregen", 5);
+    Assets->Multishot = AnimationCreate(Arena, "assets/multishot", 5);
+
+    animation Fire = AnimationCreate(Arena, "assets/fire", 1);
+    animation Water = AnimationCreate(Arena, "assets/water", 1);
+
+    animation Ball = AnimationCreate(Arena, "assets/ball", 1);
+    animation FireBall = AnimationCreate(Arena, "assets/fireball", 1);
+    animation WaterBall = AnimationCreate(Arena, "assets/waterball", 1);
 
     animation Enemies[] =
     {
@@ -869,591 +999,1128 @@ s32 main(s32 ArgsCount, char **Args)
         Temple12,
     };
 
+    StaticAssert(SizeOf(Enemies) == SizeOf(Assets->Enemies));
+    StaticAssert(SizeOf(Projectiles) == SizeOf(Assets->Projectiles));
+    StaticAssert(SizeOf(MapAnimations) == SizeOf(Assets->MapAnimations));
+
+    MemoryCopy(Assets->Enemies, Enemies, SizeOf(Enemies));
+    MemoryCopy(Assets->Projectiles, Projectiles, SizeOf(Projectiles));
+    MemoryCopy(Assets->MapAnimations, MapAnimations, SizeOf(MapAnimations));
+
+    Assets->Font = FontCreate("assets/fontatlas2.bmp", 5, 5);
+}
+
+internal void
+GameInit(context *Context, memory_arena *Arena, u32 Seed)
+{
+    game_assets *Assets = &Context->Assets;
+
     b8 WalkableBlocks[] = 
     {
         3, 4, 5, 6,
     };
 
-    GlobalContext.Seed = 1847569;
+    Context->Seed = Seed;
+    Context->WaveRandom = RandomSeriesCreate(Seed, RandomStream_Waves);
+    Context->EnemiesSpawnedCount = 0;
+
+    random_series MapRandom = RandomSeriesCreate(Seed, RandomStream_Map);
 
     u32 MapSizeX = 28;
     u32 MapSizeY = 28;
     u32 MapMargin = 8;
 
-    tile_map IslandMap = TileMapCreate(&Arena, MapSizeX, MapSizeY, MapAnimations, ArrayCount(MapAnimations));
-    tile_map SeaMap = TileMapCreate(&Arena, MapSizeX, MapSizeY, MapAnimations, ArrayCount(MapAnimations));
-    tile_map OverlayMap = TileMapCreate(&Arena, MapSizeX, MapSizeY, MapAnimations, ArrayCount(MapAnimations));
-
-    TileMapFill(&SeaMap, 0, 0, MapSizeX, MapSizeY, 1);
+    Context->MapSizeX = MapSizeX;
+    Context->MapSizeY = MapSizeY;
+    Context->MapMargin = MapMargin;
 
-    TileMapFillRandom(&IslandMap, MapMargin, MapMargin, MapSizeX - MapMargin, MapSizeY - MapMargin, 3, 4);
+    tile_map *IslandMap = &Context->IslandMap;
+    tile_map *SeaMap = &Context->SeaMap;
+    tile_map *OverlayMap = &Context->OverlayMap;
 
-    TileMapFill(&IslandMap, MapMargin - 1, MapMargin, MapMargin, MapSizeY - MapMargin, 7 + 3);
-    TileMapFill(&IslandMap, MapSizeX - MapMargin, MapMargin, MapSizeX - MapMargin + 1, MapSizeY - MapMargin, 7 + 4);
+    *IslandMap = TileMapCreate(Arena, MapSizeX, MapSizeY, Assets->MapAnimations, ArrayCount(Assets->MapAnimations));
+    *SeaMap = TileMapCreate(Arena, MapSizeX, MapSizeY, Assets->MapAnimations, ArrayCount(Assets->MapAnimations));
+    *OverlayMap = TileMapCreate(Arena, MapSizeX, MapSizeY, Assets->MapAnimations, ArrayCount(Assets->MapAnimations));
 
-    TileMapFill(&IslandMap, MapMargin, MapMargin - 1, MapSizeY - MapMargin, MapMargin, 7 + 1);
-    TileMapFill(&IslandMap, MapMargin, MapSizeY - MapMargin, MapSizeY - MapMargin, MapSizeY - MapMargin + 1, 7 + 6);
+    TileMapFill(SeaMap, 0, 0, MapSizeX, MapSizeY, 1);
 
-    TileMapFill(&IslandMap, MapMargin - 1, MapMargin - 1, MapMargin, MapMargin, 7 + 0);
-    TileMapFill(&IslandMap, MapSizeY - MapMargin, MapMargin - 1, MapSizeY - MapMargin + 1, MapMargin, 7 + 2);
+    TileMapFillRandom(IslandMap, &MapRandom, MapMargin, MapMargin, MapSizeX - MapMargin, MapSizeY - MapMargin, 3, 4);
 
-    TileMapFill(&IslandMap, MapMargin - 1, MapSizeY - MapMargin, MapMargin, MapSizeY - MapMargin + 1, 7 + 5);
-    TileMapFill(&IslandMap, MapSizeY - MapMargin, MapSizeY - MapMargin, MapSizeY - MapMargin + 1, MapSizeY - MapMargin + 1, 7 + 7);
+    TileMapFill(IslandMap, MapMargin - 1, MapMargin, MapMargin, MapSizeY - MapMargin, 7 + 3);
+    TileMapFill(IslandMap, MapSizeX - MapMargin, MapMargin, MapSizeX - MapMargin + 1, MapSizeY - MapMargin, 7 + 4);
 
-    TileMapFillWithTexture(&OverlayMap, MapSizeY / 2 - 2, MapMargin - 3, MapSizeY / 2 + 2, MapMargin + 1, 15);
+    TileMapFill(IslandMap, MapMargin, MapMargin - 1, MapSizeY - MapMargin, MapMargin, 7 + 1);
+    TileMapFill(IslandMap, MapMargin, MapSizeY - MapMargin, MapSizeY - MapMargin, MapSizeY - MapMargin + 1, 7 + 6);
 
-    collision_map CollisionMap = CollisionMapCreate(&Arena, &IslandMap, WalkableBlocks, ArrayCount(WalkableBlocks));
-    CollisionMapIntersection(&CollisionMap, &OverlayMap, WalkableBlocks, ArrayCount(WalkableBlocks));
+    TileMapFill(IslandMap, MapMargin - 1, MapMargin - 1, MapMargin, MapMargin, 7 + 0);
+    TileMapFill(IslandMap, MapSizeY - MapMargin, MapMargin - 1, MapSizeY - MapMargin + 1, MapMargin, 7 + 2);
 
-    u32 SlowAnimFrame = 0;
-    u32 FastAnimFrame = 0;
+    TileMapFill(IslandMap, MapMargin - 1, MapSizeY - MapMargin, MapMargin, MapSizeY - MapMargin + 1, 7 + 5);
+    TileMapFill(IslandMap, MapSizeY - MapMargin, MapSizeY - MapMargin, MapSizeY - MapMargin + 1, MapSizeY - MapMargin + 1, 7 + 7);
 
-    GlobalContext.PlayerX = CollisionMap.SizeX / 2.0f;
-    GlobalContext.PlayerY = CollisionMap.SizeY / 2.0f;
+    TileMapFillWithTexture(OverlayMap, MapSizeY / 2 - 2, MapMargin - 3, MapSizeY / 2 + 2, MapMargin + 1, 15);
 
-    u64 StartTime = SDL_GetPerformanceCounter();
-    u64 LastTime = StartTime;
+    Context->CollisionMap = CollisionMapCreate(Arena, IslandMap, WalkableBlocks, ArrayCount(WalkableBlocks));
+    CollisionMapIntersection(&Context->CollisionMap, OverlayMap, WalkableBlocks, ArrayCount(WalkableBlocks));
 
-    GlobalContext.MovementSpeed = 5.0f;
-    GlobalContext.FireEnemySpeed = 2.0f;
-    GlobalContext.WaterEnemySpeed = 0.75f;
+    Context->PlayerX = Context->CollisionMap.SizeX / 2.0f;
+    Context->PlayerY = Context->CollisionMap.SizeY / 2.0f;
+    Context->LastPlayerX = Context->PlayerX;
+    Context->LastPlayerY = Context->PlayerY;
 
-    GlobalContext.EnemiesCapacity = 1024;
-    GlobalContext.Enemies = MemoryArenaPushArray(&Arena, enemy, 0, GlobalContext.EnemiesCapacity);
-    
-    GlobalContext.MaxHealth = 100.0f;
-    GlobalContext.Health = 100.0f;
-    GlobalContext.ProjectileDamage = 3;
-    GlobalContext.ProjectileSpeed = 7.0f;
-    GlobalContext.FireFireRate = 1.4f;
-    GlobalContext.FireFireRateRandomFactor = 0.8f;
-    GlobalContext.WaterFireRate = 0.9f;
-    GlobalContext.WaterFireRateRandomFactor = 0.6f;
-    GlobalContext.WaveCooldown = 8.0f;
-    GlobalContext.RegenRate = 2;
-    GlobalContext.ShotHealthCost = 4;
-    GlobalContext.MultishotCount = 3;
-    GlobalContext.MultishotAngleDifference = 5;
-    GlobalContext.ShotCooldown = 0.2f;
-    GlobalContext.MovementSpeedMultiplier = 1.0f;
-    GlobalContext.RegenLimit = 0.6f;
-    GlobalContext.GameState = 0;
-
-    font Font = FontCreate("assets/fontatlas2.bmp", 5, 5);
-
-    InitProjectiles(&Arena, 128);
+    Context->MovementSpeed = 5.0f;
+    Context->FireEnemySpeed = 2.0f;
+    Context->WaterEnemySpeed = 0.75f;
 
-    SDL_Cursor* PointerCursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_POINTER);
-    SDL_Cursor* ArrowCursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_DEFAULT);
+    Context->Enemies = MemoryArrayCreate(0, enemy, MaxEnemiesCount);
+    MemoryArenaName(&Context->Enemies.Arena, "enemies");
     
-    b32 Running = 1;
-    while(Running)
-    {
-        u64 CurrentTime = SDL_GetPerformanceCounter();
-        u64 Frequency = SDL_GetPerformanceFrequency();
-
-        f32 DeltaTime = (f32)(CurrentTime - LastTime) / (f32)Frequency;
-        if(DeltaTime > 1.0f) DeltaTime = 1.0f;
-        f32 Time = (f32)(CurrentTime - StartTime) / (f32)Frequency;
-
-        b32 DidClick = 0;
-        b32 ShouldRestart = 0;
-        b32 PressedSpace = 0;
-
-        SDL_Event Event;
-        while(SDL_PollEvent(&Event))
-        {
-            if(Event.type == SDL_EVENT_QUIT)
-            {
-                Running = 0;
-            }
+    Context->MaxHealth = 100.0f;
+    Context->Health = 100.0f;
+    Context->ProjectileDamage = 3;
+    Context->ProjectileSpeed = 7.0f;
+    Context->FireFireRate = 1.4f;
+    Context->FireFireRateRandomFactor = 0.8f;
+    Context->WaterFireRate = 0.9f;
+    Context->WaterFireRateRandomFactor = 0.6f;
+    Context->WaveCooldown = 8.0f;
+    Context->RegenRate = 2;
+    Context->ShotHealthCost = 4;
+    Context->MultishotCount = 3;
+    Context->MultishotAngleDifference = 5;
+    Context->ShotCooldown = 0.2f;
+    Context->MovementSpeedMultiplier = 1.0f;
+    Context->RegenLimit = 0.6f;
+    Context->GameState = 0;
+
+    InitProjectiles();
+}
 
-            if(!Event.key.repeat)
-            {
+// NOTE: The enemies and projectiles live outside of the game arena, so they are released separately
+internal void
+GameRelease(context *Context)
+{
+    MemoryArrayDestroy(&Context->Enemies);
+    MemoryPoolDestroy(&Context->Projectiles);
+}
 
-                if(Event.type == SDL_EVENT_KEY_UP)
-                {
-                    switch(Event.key.key)
-                    {
-                        case 'w':
-                        {
-                            GlobalContext.DirectionY += 1;
-                        } break;
-    
-                        case 's':
-                        {
-                            GlobalContext.DirectionY -= 1;
-                        } break;
-    
-                        case 'd':
-                        {
-                            GlobalContext.DirectionX -= 1;
-                        } break;
-    
-                        case 'a':
-                        {
-                            GlobalContext.DirectionX += 1;
-                        } break;
-                    }
-                }
-    
-                if(Event.type == SDL_EVENT_KEY_DOWN)
-                {
-                    switch(Event.key.key)
-                    {
-                        case 'w':
-                        {
-                            GlobalContext.DirectionY -= 1;
-                        } break;
-    
-                        case 's':
-                        {
-                            GlobalContext.DirectionY += 1;
-                        } break;
-    
-                        case 'd':
-                        {
-                            GlobalContext.DirectionX += 1;
-                        } break;
-    
-                        case 'a':
-                        {
-                            GlobalContext.DirectionX -= 1;
-                        } break;
+internal void
+GameUpdate(context *Context, game_input *Input, f32 DeltaTime)
+{
+    TIMED_FUNCTION;
 
-                        case 'r':
-                        {
-                            ShouldRestart = 1;
-                        } break;
+    game_assets *Assets = &Context->Assets;
+    collision_map *CollisionMap = &Context->CollisionMap;
 
-                        case ' ':
-                        {
-                            PressedSpace = 1;
-                        } break;
-                    }
-                }
-            }
+    // NOTE: Time is kept in f64 so a long session doesn't lose precision when adding small fixed steps
+    Context->Time += DeltaTime;
+    f32 Time = (f32)Context->Time;
 
-            if(Event.type == SDL_EVENT_MOUSE_MOTION)
-            {
-                GlobalContext.ViewDirection = Normalize(V2(Event.motion.x, Event.motion.y) - V2(WindowWidth / 2.0f, WindowHeight / 2.0f));
+    Context->LastPlayerX = Context->PlayerX;
+    Context->LastPlayerY = Context->PlayerY;
 
-                GlobalContext.MouseX = (u32)Event.motion.x;
-                GlobalContext.MouseY = (u32)Event.motion.y;
-            }
+    Context->DirectionX = Input->DirectionX;
+    Context->DirectionY = Input->DirectionY;
+    Context->ViewDirection = Input->ViewDirection;
+    Context->MouseX = Input->MouseX;
+    Context->MouseY = Input->MouseY;
 
-            if(Event.type == SDL_EVENT_MOUSE_BUTTON_DOWN && Event.button.button == SDL_BUTTON_LEFT)
-            {
-                DidClick = 1;
-            }
-        }
+    b32 DidClick = Input->DidClick;
+    b32 PressedSpace = Input->PressedSpace;
+    b32 ShouldRestart = Input->ShouldRestart;
 
-        SDL_ClearSurface(WindowSurface, 0, 0, 0, 1);
+    Context->IsPointer = 0;
+    Context->IsNearShop = 0;
 
-        switch(GlobalContext.GameState)
+    switch(Context->GameState)
+    {
+        case 0:
         {
-            case 0:
-            {
-                u32 TileMapX = (u32)(-GlobalContext.PlayerX * TilePixelSize + WindowWidth / 2);
-                u32 TileMapY = (u32)(-GlobalContext.PlayerY * TilePixelSize + WindowHeight / 2);
-
-                TileMapDraw(&SeaMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&IslandMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&OverlayMap, TileMapX, TileMapY, FastAnimFrame);
-
-                AnimationDraw(&CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+            u32 ButtonLeftX = 40;
+            u32 ButtonRightX = 189;
+            u32 ButtonTopY = 40;
+            u32 ButtonBottomY = 85;
 
-                u32 ButtonLeftX = 40;
-                u32 ButtonRightX = 189;
-                u32 ButtonTopY = 40;
-                u32 ButtonBottomY = 85;
+            u32 TopLeftX = WindowWidth / 2 - PixelScale * Assets->StartOff.Width / 2;
+            u32 TopLeftY = WindowHeight / 2 - PixelScale * Assets->StartOff.Height / 2;
 
-                u32 TopLeftX = WindowWidth / 2 - PixelScale * StartOff.Width / 2;
-                u32 TopLeftY = WindowHeight / 2 - PixelScale * StartOff.Height / 2;
-
-                if(GlobalContext.MouseX >= TopLeftX + ButtonLeftX * PixelScale && GlobalContext.MouseX <= TopLeftX + ButtonRightX * PixelScale && 
-                    GlobalContext.MouseY >= TopLeftY + ButtonTopY * PixelScale && GlobalContext.MouseY <= TopLeftY + ButtonBottomY * PixelScale)
-                {
-                    TextureDrawCustom(&StartOn, WindowWidth / 2 - PixelScale * StartOff.Width / 2, WindowHeight / 2 - PixelScale * StartOff.Height / 2);
-
-                    GlobalContext.IsPointer = 1;
+            if(Context->MouseX >= TopLeftX + ButtonLeftX * PixelScale && Context->MouseX <= TopLeftX + ButtonRightX * PixelScale && 
+                Context->MouseY >= TopLeftY + ButtonTopY * PixelScale && Context->MouseY <= TopLeftY + ButtonBottomY * PixelScale)
+            {
+                Context->IsPointer = 1;
 
-                    if(DidClick)
-                    {
-                        ShouldRestart = 1;
-                    }
-                }
-                else
+                if(DidClick)
                 {
-                    TextureDrawCustom(&StartOff, WindowWidth / 2 - PixelScale * StartOff.Width / 2, WindowHeight / 2 - PixelScale * StartOff.Height / 2);
+                    ShouldRestart = 1;
                 }
+            }
+        } break;
 
-            } break;
+        case 1:
+        {
+            f32 VelocityX = 0.0f;
+            f32 VelocityY = 0.0f;
 
-            case 1:
+            if(!Context->ShopOpen)
             {
-                f32 VelocityX = 0.0f;
-                f32 VelocityY = 0.0f;
-
-                if(!GlobalContext.ShopOpen)
-                {
-                    VelocityX = GlobalContext.DirectionX * DeltaTime * GlobalContext.MovementSpeed * GlobalContext.MovementSpeedMultiplier;
+                VelocityX = Context->DirectionX * DeltaTime * Context->MovementSpeed * Context->MovementSpeedMultiplier;
     
-                    GlobalContext.PlayerX += GlobalContext.DirectionX * DeltaTime * GlobalContext.MovementSpeed * GlobalContext.MovementSpeedMultiplier;
-                    if(GlobalContext.DirectionX > 0.0f)
+                Context->PlayerX += Context->DirectionX * DeltaTime * Context->MovementSpeed * Context->MovementSpeedMultiplier;
+                if(Context->DirectionX > 0.0f)
+                {
+                    if(!IsWalkable(CollisionMap, (u32)Context->PlayerX, (u32)Context->PlayerY))
                     {
-                        if(!IsWalkable(&CollisionMap, (u32)GlobalContext.PlayerX, (u32)GlobalContext.PlayerY))
-                        {
-                            GlobalContext.PlayerX = (u32)GlobalContext.PlayerX - 0.01f;
-                            VelocityX = 0.0f;
-                        }
+                        Context->PlayerX = (u32)Context->PlayerX - 0.01f;
+                        VelocityX = 0.0f;
                     }
-                    else if(GlobalContext.DirectionX < 0.0f)
+                }
+                else if(Context->DirectionX < 0.0f)
+                {
+                    if(!IsWalkable(CollisionMap, (u32)Context->PlayerX, (u32)Context->PlayerY))
                     {
-                        if(!IsWalkable(&CollisionMap, (u32)GlobalContext.PlayerX, (u32)GlobalContext.PlayerY))
-                        {
-                            GlobalContext.PlayerX = (u32)GlobalContext.PlayerX + 1.0f;
-                            VelocityX = 0.0f;
-                        }
+                        Context->PlayerX = (u32)Context->PlayerX + 1.0f;
+                        VelocityX = 0.0f;
                     }
+                }
     
-                    VelocityY = GlobalContext.DirectionY * DeltaTime * GlobalContext.MovementSpeed * GlobalContext.MovementSpeedMultiplier;
-                    
-                    GlobalContext.PlayerY += GlobalContext.DirectionY * DeltaTime * GlobalContext.MovementSpeed * GlobalContext.MovementSpeedMultiplier;
-                    if(GlobalContext.DirectionY > 0.0f)
+                VelocityY = Context->DirectionY * DeltaTime * Context->MovementSpeed * Context->MovementSpeedMultiplier;
+                
+                Context->PlayerY += Context->DirectionY * DeltaTime * Context->MovementSpeed * Context->MovementSpeedMultiplier;
+                if(Context->DirectionY > 0.0f)
+                {
+                    if(!IsWalkable(CollisionMap, (u32)Context->PlayerX, (u32)Context->PlayerY))
                     {
-                        if(!IsWalkable(&CollisionMap, (u32)GlobalContext.PlayerX, (u32)GlobalContext.PlayerY))
-                        {
-                            GlobalContext.PlayerY = (f32)(u32)GlobalContext.PlayerY - 0.01f;
-                            VelocityY = 0.0f;
-                        }
+                        Context->PlayerY = (f32)(u32)Context->PlayerY - 0.01f;
+                        VelocityY = 0.0f;
                     }
-                    else if(GlobalContext.DirectionY < 0.0f)
+                }
+                else if(Context->DirectionY < 0.0f)
+                {
+                    if(!IsWalkable(CollisionMap, (u32)Context->PlayerX, (u32)Context->PlayerY))
                     {
-                        if(!IsWalkable(&CollisionMap, (u32)GlobalContext.PlayerX, (u32)GlobalContext.PlayerY))
-                        {
-                            GlobalContext.PlayerY = (u32)GlobalContext.PlayerY + 1.0f;
-                            VelocityY = 0.0f;
-                        }
+                        Context->PlayerY = (u32)Context->PlayerY + 1.0f;
+                        VelocityY = 0.0f;
                     }
                 }
+            }
 
-                GlobalContext.MaxHealth = 100 + GlobalContext.MaxHealthLevel * 10.0f;
-                GlobalContext.MovementSpeedMultiplier = 1.0f - GlobalContext.MaxHealthLevel * 0.20f;
+            Context->MaxHealth = 100 + Context->MaxHealthLevel * 10.0f;
+            Context->MovementSpeedMultiplier = 1.0f - Context->MaxHealthLevel * 0.20f;
 
-                GlobalContext.RegenRate = 2.0f + GlobalContext.FasterRegenLevel * 1.0f;
-                GlobalContext.RegenLimit = 0.8f - GlobalContext.FasterRegenLevel * 0.1f;
+            Context->RegenRate = 2.0f + Context->FasterRegenLevel * 1.0f;
+            Context->RegenLimit = 0.8f - Context->FasterRegenLevel * 0.1f;
 
-                GlobalContext.MultishotCount = GlobalContext.MultishotLevel + 1;
-                GlobalContext.ShotCooldown = 0.2f + GlobalContext.MultishotLevel * 0.6f;
+            Context->MultishotCount = Context->MultishotLevel + 1;
+            Context->ShotCooldown = 0.2f + Context->MultishotLevel * 0.6f;
+
+            b32 ShouldRegenerateAngle = 0;
+            if(Context->TimeOfLastRegenerate + 1.0f < Time)
+            {
+                ShouldRegenerateAngle = 1;
+                Context->TimeOfLastRegenerate = Time;
+            }
 
-                u32 TileMapX = (u32)(-GlobalContext.PlayerX * TilePixelSize + WindowWidth / 2);
-                u32 TileMapY = (u32)(-GlobalContext.PlayerY * TilePixelSize + WindowHeight / 2);
+            {
+                TIMED_BLOCK("EnemyUpdate");
 
-                TileMapDraw(&SeaMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&IslandMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&OverlayMap, TileMapX, TileMapY, FastAnimFrame);
+                // NOTE: Movement runs 8 enemies at a time. Everything that draws random numbers or spawns projectiles
+                // stays in the loop after it, so that happens in the same order as before
+                f32x8 PlayerX = F32x8(Context->PlayerX);
+                f32x8 PlayerY = F32x8(Context->PlayerY);
+                f32x8 FireEnemySpeed = F32x8(Context->FireEnemySpeed);
+                f32x8 WaterEnemySpeed = F32x8(Context->WaterEnemySpeed);
 
-                b32 ShouldRegenerateAngle = 0;
-                if(GlobalContext.TimeOfLastRegenerate + 1.0f < Time)
+                for(u32 Index = 0;
+                    Index < Context->Enemies.Count;
+                    Index += 8)
                 {
-                    ShouldRegenerateAngle = 1;
-                    GlobalContext.TimeOfLastRegenerate = Time;
+                    enemy *First = MemoryArrayAtType(&Context->Enemies, enemy, Index);
+                    u32 LanesCount = (u32)Min(Context->Enemies.Count - Index, 8);
+
+                    b32x8 Alive = ~B32x8GatherStrided(&First->Dead, SizeOf(enemy), LanesCount);
+                    b32x8 Water = B32x8GatherStrided(&First->Type, SizeOf(enemy), LanesCount);
+                    f32x8 Angle = F32x8GatherStrided(&First->Angle, SizeOf(enemy), LanesCount);
+                    v2x8 Position = V2x8GatherStrided(&First->Position, SizeOf(enemy), LanesCount);
+                    v2x8 LastPosition = V2x8GatherStrided(&First->LastPosition, SizeOf(enemy), LanesCount);
+
+                    f32x8 AngleSin, AngleCos;
+                    SinCos(Angle, &AngleSin, &AngleCos);
+                    v2x8 Target = V2x8(PlayerX + AngleCos * 3, PlayerY + AngleSin * 3);
+
+                    v2x8 Delta = Normalize(Target - Position) * DeltaTime;
+                    Delta *= Select(Water, WaterEnemySpeed, FireEnemySpeed);
+
+                    V2x8ScatterStrided(&First->LastPosition, SizeOf(enemy), LanesCount, Select(Alive, Position, LastPosition));
+                    V2x8ScatterStrided(&First->Position, SizeOf(enemy), LanesCount, Select(Alive, Position + Delta, Position));
                 }
 
                 for(u32 Index = 0;
-                    Index < GlobalContext.EnemiesCount;
+                    Index < Context->Enemies.Count;
                     Index++)
                 {
-                    enemy *Enemy = &GlobalContext.Enemies[Index];
+                    enemy *Enemy = MemoryArrayAtType(&Context->Enemies, enemy, Index);
 
                     if(!Enemy->Dead)
                     {
-                        animation *Animation = &Enemies[Enemy->Type];
-            
-                        v2 Transformed = GetScreenPos(Enemy->Position);
-                        AnimationDraw(Animation, (u32)Transformed.X - TilePixelSize / 2, (u32)Transformed.Y - TilePixelSize / 2, SlowAnimFrame);
-            
-                        v2 Target = V2(GlobalContext.PlayerX + Cos(Enemy->Angle) * 3, GlobalContext.PlayerY + Sin(Enemy->Angle) * 3);
-                        
-                        v2 Delta = Normalize(Target - V2(Enemy->Position.X, Enemy->Position.Y)) * DeltaTime;
-                        if(Enemy->Type == 0)
-                        {
-                            Delta *= GlobalContext.FireEnemySpeed;
-                        }
-                        else
-                        {
-                            Delta *= GlobalContext.WaterEnemySpeed;
-                        }
-                        Enemy->Position.X += Delta.X;
-                        Enemy->Position.Y += Delta.Y;
-            
                         if(ShouldRegenerateAngle)
                         {
-                            Enemy->Angle = (f32)GetRandom() / (f32)MaxU32 * 2 * Pi;
+                            Enemy->Angle = RandomBetween(&Enemy->Random, 0.0f, 2.0f * Pi);
                         }
-            
+        
                         if(Time > Enemy->TimeOfNextShot)
                         {
                             if(Enemy->Type == 0)
                             {
-                                Enemy->TimeOfNextShot = Time + GlobalContext.FireFireRate + GlobalContext.FireFireRateRandomFactor * (f32)GetRandom() / (f32)MaxU32;
+                                Enemy->TimeOfNextShot = Time + Context->FireFireRate + Context->FireFireRateRandomFactor * RandomUnilateral(&Enemy->Random);
                             }
                             else
                             {
-                                Enemy->TimeOfNextShot = Time + GlobalContext.WaterFireRate + GlobalContext.WaterFireRateRandomFactor * (f32)GetRandom() / (f32)MaxU32;
+                                Enemy->TimeOfNextShot = Time + Context->WaterFireRate + Context->WaterFireRateRandomFactor * RandomUnilateral(&Enemy->Random);
                             }
-            
-                            v2 ShotDelta = Normalize(V2(GlobalContext.PlayerX, GlobalContext.PlayerY) - Enemy->Position) * GlobalContext.ProjectileSpeed;
-            
+        
+                            v2 ShotDelta = Normalize(V2(Context->PlayerX, Context->PlayerY) - Enemy->Position) * Context->ProjectileSpeed;
+        
                             ProjectileSpawn(Enemy->Position, ShotDelta, 1, Enemy->Type == 0 ? 1 : 2);
                         }
                     }
                 }
+            }
 
-                if(GlobalContext.Health <= GlobalContext.MaxHealth * GlobalContext.RegenLimit)
-                {
-                    GlobalContext.Health += DeltaTime * GlobalContext.RegenRate;
-                    if(GlobalContext.Health > GlobalContext.MaxHealth * GlobalContext.RegenLimit)
-                    {
-                        GlobalContext.Health = GlobalContext.MaxHealth * GlobalContext.RegenLimit;
-                    }
-                }
-                
-                ProjectileUpdate(DeltaTime);
-                
-                if(!GlobalContext.Health)
+            if(Context->Health <= Context->MaxHealth * Context->RegenLimit)
+            {
+                Context->Health += DeltaTime * Context->RegenRate;
+                if(Context->Health > Context->MaxHealth * Context->RegenLimit)
                 {
-                    GlobalContext.GameState = 3;
+                    Context->Health = Context->MaxHealth * Context->RegenLimit;
                 }
+            }
+            
+            ProjectileUpdate(DeltaTime);
+            
+            if(!Context->Health)
+            {
+                Context->GameState = 3;
+            }
 
-                for(projectile *Projectile = GlobalContext.Projectiles.Next;
-                    Projectile != &GlobalContext.Projectiles;
-                    Projectile = Projectile->Next)
-                    {
-                        v2 Transformed = GetScreenPos(Projectile->Position);
-                    animation *Animation = &Projectiles[Projectile->Type];
-                    AnimationDraw(Animation, (u32)Transformed.X - TilePixelSize / 2, (u32)Transformed.Y - TilePixelSize / 2, SlowAnimFrame);
-                }
+            if(DidClick && Context->Health > Context->ShotHealthCost && Context->TimeOfLastShot + Context->ShotCooldown < Time)
+            {
+                Context->TimeOfLastShot = Time;
+                Context->Health -= Context->ShotHealthCost;
 
-                if(DidClick && GlobalContext.Health > GlobalContext.ShotHealthCost && GlobalContext.TimeOfLastShot + GlobalContext.ShotCooldown < Time)
-                {
-                    GlobalContext.TimeOfLastShot = Time;
-                    GlobalContext.Health -= GlobalContext.ShotHealthCost;
+                Assert(Context->MultishotCount <= MaxMultishotCount);
 
-                    f32 Angle = -(GlobalContext.MultishotCount - 1.0f) * 0.5f * GlobalContext.MultishotAngleDifference;
+                v2 Directions[MaxMultishotCount];
+                f32 Angles[MaxMultishotCount];
+                v2 Rotated[MaxMultishotCount];
 
-                    for(u32 ProjectileIndex = 0;
-                        ProjectileIndex < GlobalContext.MultishotCount;
-                        ProjectileIndex++)
-                    {
-                        v2 Direction = GlobalContext.ViewDirection * GlobalContext.ProjectileSpeed;
-                        v2 Rotated = V2Rotate(Direction, Angle);
-                        
-                        ProjectileSpawn(V2(GlobalContext.PlayerX, GlobalContext.PlayerY) + V2(VelocityX, VelocityY), Rotated, 0, 0);
+                f32 Angle = -(Context->MultishotCount - 1.0f) * 0.5f * Context->MultishotAngleDifference;
 
-                        Angle += GlobalContext.MultishotAngleDifference;
-                    }
+                for(u32 ProjectileIndex = 0;
+                    ProjectileIndex < Context->MultishotCount;
+                    ProjectileIndex++)
+                {
+                    Directions[ProjectileIndex] = Context->ViewDirection * Context->ProjectileSpeed;
+                    Angles[ProjectileIndex] = Angle;
 
+                    Angle += Context->MultishotAngleDifference;
                 }
 
-                if(GlobalContext.EnemiesRemaining == 0 && !GlobalContext.IsWaitingForNextWave)
+                V2RotateArray(Directions, Angles, Rotated, Context->MultishotCount, MathAccuracy_Precise);
+
+                for(u32 ProjectileIndex = 0;
+                    ProjectileIndex < Context->MultishotCount;
+                    ProjectileIndex++)
                 {
-                    GlobalContext.TimeOfLastWaveEnd = Time;
-                    GlobalContext.IsWaitingForNextWave = 1;
-                    
-                    if(GlobalContext.WaveIndex == 10)
-                    {
-                        GlobalContext.GameState = 2;
-                    }
+                    ProjectileSpawn(V2(Context->PlayerX, Context->PlayerY) + V2(VelocityX, VelocityY), Rotated[ProjectileIndex], 0, 0);
                 }
 
-                if(GlobalContext.IsWaitingForNextWave && GlobalContext.TimeOfLastWaveEnd + GlobalContext.WaveCooldown < Time)
-                {
-                    GlobalContext.IsWaitingForNextWave = 0;
-
-                    SpawnEnemies((GlobalContext.WaveIndex + 1) * 2 + GetRandom() % 2, CollisionMap.SizeX / 2.0f, CollisionMap.SizeY / 2.0f, 7, Time);
-
-                    GlobalContext.WaveIndex++;
-                }
+            }
 
-                if(GlobalContext.DirectionX != 0 || GlobalContext.DirectionY != 0)
+            if(Context->EnemiesRemaining == 0 && !Context->IsWaitingForNextWave)
+            {
+                Context->TimeOfLastWaveEnd = Time;
+                Context->IsWaitingForNextWave = 1;
+                
+                if(Context->WaveIndex == 10)
                 {
-                    AnimationDraw(&CharacterWalkingAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
-                }
-                else{
-                    AnimationDraw(&CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+                    Context->GameState = 2;
                 }
+            }
 
-                TextureDrawCustomPartial(&HealthBar, WindowWidth / 2 - PixelScale * BlankHealthBar.Width / 2 + 1 * PixelScale, WindowHeight - 100 + 2 * PixelScale, (f32)GlobalContext.Health / (f32)GlobalContext.MaxHealth);
-                TextureDrawCustom(&BlankHealthBar, WindowWidth / 2 - PixelScale * BlankHealthBar.Width / 2, WindowHeight - 100);
+            if(Context->IsWaitingForNextWave && Context->TimeOfLastWaveEnd + Context->WaveCooldown < Time)
+            {
+                Context->IsWaitingForNextWave = 0;
 
-                if(GlobalContext.PlayerX >= MapSizeY / 2 - 3 && GlobalContext.PlayerX <= MapSizeY / 2 + 3 && GlobalContext.PlayerY >= MapMargin - 4 && GlobalContext.PlayerY <= MapMargin + 2)
-                {
-                    FontDraw(&Font, StringBundleZ("SPACE FOR MENU"), WindowWidth / 2, WindowHeight - 150, 1);
+                SpawnEnemies((Context->WaveIndex + 1) * 2 + RandomChoice(&Context->WaveRandom, 2), CollisionMap->SizeX / 2.0f, CollisionMap->SizeY / 2.0f, 7, Time);
 
-                    if(PressedSpace)
-                    {
-                        GlobalContext.ShopOpen = !GlobalContext.ShopOpen;
-                    }
-                }
+                Context->WaveIndex++;
+            }
+
+            if(Context->PlayerX >= Context->MapSizeY / 2 - 3 && Context->PlayerX <= Context->MapSizeY / 2 + 3 && Context->PlayerY >= Context->MapMargin - 4 && Context->PlayerY <= Context->MapMargin + 2)
+            {
+                Context->IsNearShop = 1;
 
-                if(GlobalContext.ShopOpen)
+                if(PressedSpace)
                 {
-                    u32 TopLeftX = WindowWidth / 2 - PixelScale * ShopUI.Width / 2;
-                    u32 TopLeftY = WindowHeight / 2 - PixelScale * ShopUI.Height / 2;
+                    Context->ShopOpen = !Context->ShopOpen;
+                }
+            }
 
-                    u32 CardX = TopLeftX + 5 * PixelScale;
-                    u32 CardY = TopLeftY + 5 * PixelScale;
+            if(Context->ShopOpen)
+            {
+                u32 TopLeftX = WindowWidth / 2 - PixelScale * Assets->ShopUI.Width / 2;
+                u32 TopLeftY = WindowHeight / 2 - PixelScale * Assets->ShopUI.Height / 2;
 
-                    TextureDrawCustom(&ShopUI, WindowWidth / 2 - PixelScale * ShopUI.Width / 2, WindowHeight / 2 - PixelScale * ShopUI.Height / 2);
+                u32 CardX = TopLeftX + 5 * PixelScale;
+                u32 CardY = TopLeftY + 5 * PixelScale;
 
-                    if(GlobalContext.MouseX >= CardX && GlobalContext.MouseX <= CardX + MaxHealth.Width * PixelScale && 
-                        GlobalContext.MouseY >= CardY && GlobalContext.MouseY <= CardY + MaxHealth.Height * PixelScale)
+                if(Context->MouseX >= CardX && Context->MouseX <= CardX + Assets->MaxHealth.Width * PixelScale && 
+                    Context->MouseY >= CardY && Context->MouseY <= CardY + Assets->MaxHealth.Height * PixelScale)
+                {
+                    if(DidClick)
                     {
-                        if(DidClick)
+                        Context->MaxHealthLevel++;
+                        if(Context->MaxHealthLevel > 4)
                         {
-                            GlobalContext.MaxHealthLevel++;
-                            if(GlobalContext.MaxHealthLevel > 4)
-                            {
-                                GlobalContext.MaxHealthLevel = 4;
-                            }
+                            Context->MaxHealthLevel = 4;
                         }
-
-                        GlobalContext.IsPointer = 1;
                     }
 
-                    TextureDrawCustom(&MaxHealth.Frames[GlobalContext.MaxHealthLevel], CardX, CardY);
-                    CardX += (MaxHealth.Width + 5) * PixelScale;
+                    Context->IsPointer = 1;
+                }
+
+                CardX += (Assets->MaxHealth.Width + 5) * PixelScale;
 
-                    if(GlobalContext.MouseX >= CardX && GlobalContext.MouseX <= CardX + FasterRegen.Width * PixelScale && 
-                        GlobalContext.MouseY >= CardY && GlobalContext.MouseY <= CardY + FasterRegen.Height * PixelScale)
+                if(Context->MouseX >= CardX && Context->MouseX <= CardX + Assets->FasterRegen.Width * PixelScale && 
+                    Context->MouseY >= CardY && Context->MouseY <= CardY + Assets->FasterRegen.Height * PixelScale)
+                {
+                    if(DidClick)
                     {
-                        if(DidClick)
+                        Context->FasterRegenLevel++;
+                        if(Context->FasterRegenLevel > 4)
                         {
-                            GlobalContext.FasterRegenLevel++;
-                            if(GlobalContext.FasterRegenLevel > 4)
-                            {
-                                GlobalContext.FasterRegenLevel = 4;
-                            }
+                            Context->FasterRegenLevel = 4;
                         }
-
-                        GlobalContext.IsPointer = 1;
                     }
 
-                    TextureDrawCustom(&FasterRegen.Frames[GlobalContext.FasterRegenLevel], CardX, CardY);
-                    CardX += (FasterRegen.Width + 5) * PixelScale;
+                    Context->IsPointer = 1;
+                }
+
+                CardX += (Assets->FasterRegen.Width + 5) * PixelScale;
 
-                    if(GlobalContext.MouseX >= CardX && GlobalContext.MouseX <= CardX + Multishot.Width * PixelScale && 
-                        GlobalContext.MouseY >= CardY && GlobalContext.MouseY <= CardY + Multishot.Height * PixelScale)
+                if(Context->MouseX >= CardX && Context->MouseX <= CardX + Assets->Multishot.Width * PixelScale && 
+                    Context->MouseY >= CardY && Context->MouseY <= CardY + Assets->Multishot.Height * PixelScale)
+                {
+                    if(DidClick)
                     {
-                        if(DidClick)
+                        Context->MultishotLevel++;
+                        if(Context->MultishotLevel > 4)
                         {
-                           GlobalContext.MultishotLevel++;
-                            if(GlobalContext.MultishotLevel > 4)
-                            {
-                                GlobalContext.MultishotLevel = 4;
-                            }
+                            Context->MultishotLevel = 4;
                         }
-
-                        GlobalContext.IsPointer = 1;
                     }
 
-                    TextureDrawCustom(&Multishot.Frames[GlobalContext.MultishotLevel], CardX, CardY);
-                    CardX += (Multishot.Width + 5) * PixelScale;
+                    Context->IsPointer = 1;
                 }
-            } break;
+            }
+        } break;
+    }
+
+    if(ShouldRestart && Context->GameState != 1)
+    {
+        Context->PlayerX = CollisionMap->SizeX / 2.0f;
+        Context->PlayerY = CollisionMap->SizeY / 2.0f;
+        Context->LastPlayerX = Context->PlayerX;
+        Context->LastPlayerY = Context->PlayerY;
+
+        Context->TimeOfLastRegenerate = 0;
+        Context->TimeOfLastWaveEnd = Time;
+
+        MemoryArrayClear(&Context->Enemies);
+        Context->EnemiesRemaining = 0;
+        Context->Health = Context->MaxHealth;
+
+        Context->MaxHealthLevel = 0;
+        Context->FasterRegenLevel = 0;
+        Context->MultishotLevel = 0;
+
+        MemoryPoolClear(&Context->Projectiles);
 
-            case 2:
+        Context->GameState = 1;
+        Context->WaveIndex = 0;
+    }
+}
+
+// NOTE: Alpha is how far we are between the previous and the current simulation tick, everything that moves is drawn interpolated by it
+
+internal void
+GameRender(context *Context, f32 Alpha)
+{
+    TIMED_FUNCTION;
+
+    game_assets *Assets = &Context->Assets;
+
+    f64 Time = Context->Time - (1.0f - Alpha) * SimulationDeltaTime;
+    u32 SlowAnimFrame = (u32)(Time * 2);
+    u32 FastAnimFrame = (u32)(Time * 3);
+
+    v2 Camera = Lerp(V2(Context->LastPlayerX, Context->LastPlayerY), V2(Context->PlayerX, Context->PlayerY), Alpha);
+
+    SDL_ClearSurface(Context->WindowSurface, 0, 0, 0, 1);
+
+    u32 TileMapX = (u32)(-Camera.X * TilePixelSize + WindowWidth / 2);
+    u32 TileMapY = (u32)(-Camera.Y * TilePixelSize + WindowHeight / 2);
+
+    TileMapDraw(&Context->SeaMap, TileMapX, TileMapY, FastAnimFrame);
+    TileMapDraw(&Context->IslandMap, TileMapX, TileMapY, FastAnimFrame);
+    TileMapDraw(&Context->OverlayMap, TileMapX, TileMapY, FastAnimFrame);
+
+    switch(Context->GameState)
+    {
+        case 0:
+        {
+            AnimationDraw(&Assets->CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+
+            if(Context->IsPointer)
+            {
+                TextureDrawCustom(&Assets->StartOn, WindowWidth / 2 - PixelScale * Assets->StartOff.Width / 2, WindowHeight / 2 - PixelScale * Assets->StartOff.Height / 2);
+            }
+            else
             {
-                u32 TileMapX = (u32)(-GlobalContext.PlayerX * TilePixelSize + WindowWidth / 2);
-                u32 TileMapY = (u32)(-GlobalContext.PlayerY * TilePixelSize + WindowHeight / 2);
+                TextureDrawCustom(&Assets->StartOff, WindowWidth / 2 - PixelScale * Assets->StartOff.Width / 2, WindowHeight / 2 - PixelScale * Assets->StartOff.Height / 2);
+            }
+        } break;
 
-                TileMapDraw(&SeaMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&IslandMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&OverlayMap, TileMapX, TileMapY, FastAnimFrame);
+        case 1:
+        {
+            for(u32 Index = 0;
+                Index < Context->Enemies.Count;
+                Index++)
+            {
+                enemy *Enemy = MemoryArrayAtType(&Context->Enemies, enemy, Index);
 
-                AnimationDraw(&CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+                if(!Enemy->Dead)
+                {
+                    animation *Animation = &Assets->Enemies[Enemy->Type];
+        
+                    v2 Transformed = GetScreenPos(Camera, Lerp(Enemy->LastPosition, Enemy->Position, Alpha));
+                    AnimationDraw(Animation, (u32)Transformed.X - TilePixelSize / 2, (u32)Transformed.Y - TilePixelSize / 2, SlowAnimFrame);
+                }
+            }
 
-                u32 TopLeftX = WindowWidth / 2 - PixelScale * WinMenu.Width / 2;
-                u32 TopLeftY = WindowHeight / 2 - PixelScale * WinMenu.Height / 2;
+            for(u32 ProjectileIndex = 0;
+                ProjectileIndex < MemoryPoolCount(&Context->Projectiles);
+                ProjectileIndex++)
+            {
+                projectile *Projectile = MemoryPoolAtType(&Context->Projectiles, projectile, ProjectileIndex);
+                v2 Transformed = GetScreenPos(Camera, Lerp(Projectile->LastPosition, Projectile->Position, Alpha));
+                animation *Animation = &Assets->Projectiles[Projectile->Type];
+                AnimationDraw(Animation, (u32)Transformed.X - TilePixelSize / 2, (u32)Transformed.Y - TilePixelSize / 2, SlowAnimFrame);
+            }
 
-                TextureDrawCustom(&WinMenu, WindowWidth / 2 - PixelScale * WinMenu.Width / 2, WindowHeight / 2 - PixelScale * WinMenu.Height / 2);
+            if(Context->DirectionX != 0 || Context->DirectionY != 0)
+            {
+                AnimationDraw(&Assets->CharacterWalkingAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+            }
+            else{
+                AnimationDraw(&Assets->CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+            }
+
+            TextureDrawCustomPartial(&Assets->HealthBar, WindowWidth / 2 - PixelScale * Assets->BlankHealthBar.Width / 2 + 1 * PixelScale, WindowHeight - 100 + 2 * PixelScale, (f32)Context->Health / (f32)Context->MaxHealth);
+            TextureDrawCustom(&Assets->BlankHealthBar, WindowWidth / 2 - PixelScale * Assets->BlankHealthBar.Width / 2, WindowHeight - 100);
 
-                FontDraw(&Font, StringBundleZ("PRESS R TO RESTART"), WindowWidth / 2, WindowHeight - 150, 1);
-            } break;
+            if(Context->IsNearShop)
+            {
+                FontDraw(&Assets->Font, StringBundleZ("SPACE FOR MENU"), WindowWidth / 2, WindowHeight - 150, 1);
+            }
 
-            case 3:
+            if(Context->ShopOpen)
             {
-                u32 TileMapX = (u32)(-GlobalContext.PlayerX * TilePixelSize + WindowWidth / 2);
-                u32 TileMapY = (u32)(-GlobalContext.PlayerY * TilePixelSize + WindowHeight / 2);
+                u32 TopLeftX = WindowWidth / 2 - PixelScale * Assets->ShopUI.Width / 2;
+                u32 TopLeftY = WindowHeight / 2 - PixelScale * Assets->ShopUI.Height / 2;
+
+                u32 CardX = TopLeftX + 5 * PixelScale;
+                u32 CardY = TopLeftY + 5 * PixelScale;
+
+                TextureDrawCustom(&Assets->ShopUI, WindowWidth / 2 - PixelScale * Assets->ShopUI.Width / 2, WindowHeight / 2 - PixelScale * Assets->ShopUI.Height / 2);
+
+                TextureDrawCustom(&Assets->MaxHealth.Frames[Context->MaxHealthLevel], CardX, CardY);
+                CardX += (Assets->MaxHealth.Width + 5) * PixelScale;
+
+                TextureDrawCustom(&Assets->FasterRegen.Frames[Context->FasterRegenLevel], CardX, CardY);
+                CardX += (Assets->FasterRegen.Width + 5) * PixelScale;
+
+                TextureDrawCustom(&Assets->Multishot.Frames[Context->MultishotLevel], CardX, CardY);
+                CardX += (Assets->Multishot.Width + 5) * PixelScale;
+            }
+        } break;
+
+        case 2:
+        {
+            AnimationDraw(&Assets->CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+
+            TextureDrawCustom(&Assets->WinMenu, WindowWidth / 2 - PixelScale * Assets->WinMenu.Width / 2, WindowHeight / 2 - PixelScale * Assets->WinMenu.Height / 2);
+
+            FontDraw(&Assets->Font, StringBundleZ("PRESS R TO RESTART"), WindowWidth / 2, WindowHeight - 150, 1);
+        } break;
+
+        case 3:
+        {
+            AnimationDraw(&Assets->CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+
+            TextureDrawCustom(&Assets->GameOver, WindowWidth / 2 - PixelScale * Assets->GameOver.Width / 2, WindowHeight / 2 - PixelScale * Assets->GameOver.Height / 2);
+
+            FontDraw(&Assets->Font, StringBundleZ("PRESS R TO RESTART"), WindowWidth / 2, WindowHeight - 150, 1);
+        } break;
+    }
+}
+
+#define ProfilerOverlayScale 2
+#define ProfilerGraphBarWidth 3
+#define ProfilerGraphHeight 80
+
+// NOTE: Timings are averaged over the frames in the profiler's ring buffer, the graph shows every one of those
+// frames against a 60 Hz budget line. The overlay's own text goes through FontDraw and shows up in its count.
+
+// NOTE: StringFormat doesn't pad to a field width, so columns are placed by glyph cell instead
+internal void
+ProfilerOverlayPrint(font *Font, u32 X, u32 Column, u32 Y, char *Format, ...)
+{
+    va_list Args;
+    va_start(Args, Format);
+    string Text = PushfList(MemoryFrameArena(&GlobalContext.FrameArenas), Format, Args);
+    va_end(Args);
+
+    X += Column * (Font->GlyphWidth + 1) * ProfilerOverlayScale;
+    FontDrawScaled(Font, Text, X, Y, ProfilerOverlayScale, 0);
+}
+
+internal void
+ProfilerOverlayDraw(context *Context)
+{
+    TIMED_FUNCTION;
+
+    font *Font = &Context->Assets.Font;
+    SDL_Surface *Surface = Context->WindowSurface;
+
+    profile_anchor Anchors[ProfilerAnchorsCount];
+    u64 FrameCycles;
+    u32 FramesCount = ProfilerAverageAnchors(Anchors, &FrameCycles);
+
+    u32 RowsCount = 2;
+    for(u32 AnchorIndex = 1;
+        AnchorIndex < ProfilerAnchorsCount;
+        AnchorIndex++)
+    {
+        if(GlobalProfiler.AnchorNames[AnchorIndex]) RowsCount++;
+    }
+
+    u32 LineHeight = (Font->GlyphHeight + 3) * ProfilerOverlayScale;
+    u32 Margin = 4 * ProfilerOverlayScale;
+
+    SDL_Rect Panel = {};
+    Panel.x = 0;
+    Panel.y = 0;
+    Panel.w = 50 * (Font->GlyphWidth + 1) * ProfilerOverlayScale + 2 * Margin;
+    Panel.h = RowsCount * LineHeight + ProfilerGraphHeight + 3 * Margin;
+    SDL_FillSurfaceRect(Surface, &Panel, SDL_MapSurfaceRGB(Surface, 0, 0, 0));
+
+    u32 X = Margin;
+    u32 Y = Margin;
 
-                TileMapDraw(&SeaMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&IslandMap, TileMapX, TileMapY, FastAnimFrame);
-                TileMapDraw(&OverlayMap, TileMapX, TileMapY, FastAnimFrame);
+    u64 FrameMicroseconds = 0;
+    if(GlobalProfiler.CyclesPerSecond > 0)
+    {
+        FrameMicroseconds = (u64)((f64)FrameCycles * 1000000.0 / GlobalProfiler.CyclesPerSecond);
+    }
 
-                AnimationDraw(&CharacterIdleAnimation, WindowWidth / 2 - TilePixelSize / 2, WindowHeight / 2 - TilePixelSize, SlowAnimFrame);
+    ProfilerOverlayPrint(Font, X, 0, Y, "FRAME %llu US %llu KCY OVER %u FRAMES", FrameMicroseconds, FrameCycles / 1000, FramesCount);
+    Y += LineHeight;
 
-                u32 TopLeftX = WindowWidth / 2 - PixelScale * GameOver.Width / 2;
-                u32 TopLeftY = WindowHeight / 2 - PixelScale * GameOver.Height / 2;
+    ProfilerOverlayPrint(Font, X, 0, Y, "BLOCK");
+    ProfilerOverlayPrint(Font, X, 25, Y, "EXCL KCY");
+    ProfilerOverlayPrint(Font, X, 35, Y, "INCL KCY");
+    ProfilerOverlayPrint(Font, X, 45, Y, "HITS");
+    Y += LineHeight;
 
-                TextureDrawCustom(&GameOver, WindowWidth / 2 - PixelScale * GameOver.Width / 2, WindowHeight / 2 - PixelScale * GameOver.Height / 2);
+    for(u32 AnchorIndex = 1;
+        AnchorIndex < ProfilerAnchorsCount;
+        AnchorIndex++)
+    {
+        char *Name = GlobalProfiler.AnchorNames[AnchorIndex];
+        if(Name)
+        {
+            profile_anchor *Anchor = &Anchors[AnchorIndex];
 
-                FontDraw(&Font, StringBundleZ("PRESS R TO RESTART"), WindowWidth / 2, WindowHeight - 150, 1);
-            } break;
+            ProfilerOverlayPrint(Font, X, 0, Y, "%s", Name);
+            ProfilerOverlayPrint(Font, X, 25, Y, "%llu", Anchor->CyclesExclusive / 1000);
+            ProfilerOverlayPrint(Font, X, 35, Y, "%llu", Anchor->CyclesInclusive / 1000);
+            ProfilerOverlayPrint(Font, X, 45, Y, "%u", Anchor->HitsCount);
+            Y += LineHeight;
         }
+    }
 
-        if(GlobalContext.IsPointer)
+    Y += Margin;
+
+    // NOTE: Full graph height is two 60 Hz frames, anything slower is clamped
+    f32 GraphSeconds = 2.0f / 60.0f;
+    u32 GraphBottom = Y + ProfilerGraphHeight;
+
+    u32 GoodColor = SDL_MapSurfaceRGB(Surface, 64, 192, 64);
+    u32 BadColor = SDL_MapSurfaceRGB(Surface, 224, 64, 64);
+
+    for(u32 Offset = FramesCount;
+        Offset >= 1;
+        Offset--)
+    {
+        profile_frame *Frame = &GlobalProfiler.Frames[(GlobalProfiler.FramesCount - Offset) % ProfilerFramesCount];
+
+        f32 Fraction = Clamp01(Frame->Seconds / GraphSeconds);
+
+        SDL_Rect Bar = {};
+        Bar.w = ProfilerGraphBarWidth - 1;
+        Bar.h = (s32)(Fraction * ProfilerGraphHeight);
+        Bar.x = X + (FramesCount - Offset) * ProfilerGraphBarWidth;
+        Bar.y = GraphBottom - Bar.h;
+        SDL_FillSurfaceRect(Surface, &Bar, Frame->Seconds > 1.0f / 60.0f ? BadColor : GoodColor);
+    }
+
+    SDL_Rect BudgetLine = {};
+    BudgetLine.x = X;
+    BudgetLine.y = GraphBottom - ProfilerGraphHeight / 2;
+    BudgetLine.w = (ProfilerFramesCount - 1) * ProfilerGraphBarWidth;
+    BudgetLine.h = 1;
+    SDL_FillSurfaceRect(Surface, &BudgetLine, SDL_MapSurfaceRGB(Surface, 255, 255, 255));
+}
+
+internal void
+HeadlessBotInput(context *Context, game_input *Input)
+{
+    // NOTE: Just enough of a player to keep the simulation busy, restart whenever we are not playing, walk in circles and shoot at the first enemy alive
+
+    Input->DidClick = 0;
+    Input->PressedSpace = 0;
+    Input->ShouldRestart = Context->GameState != 1;
+
+    u32 Step = (u32)Context->Time % 4;
+    Input->DirectionX = (Step == 0) ? 1.0f : (Step == 2) ? -1.0f : 0.0f;
+    Input->DirectionY = (Step == 1) ? 1.0f : (Step == 3) ? -1.0f : 0.0f;
+
+    for(u32 Index = 0;
+        Index < Context->Enemies.Count;
+        Index++)
+    {
+        enemy *Enemy = MemoryArrayAtType(&Context->Enemies, enemy, Index);
+
+        if(!Enemy->Dead)
         {
-            SDL_SetCursor(PointerCursor);
+            Input->ViewDirection = Normalize(Enemy->Position - V2(Context->PlayerX, Context->PlayerY));
+            Input->DidClick = 1;
+            break;
+        }
+    }
+}
+
+// NOTE: Replay and Record are optional, without a replay the bot plays, with one we run until it ends or TicksCount is hit
+
+internal s32
+HeadlessRun(memory_arena *Arena, u64 TicksCount, u32 Seed, replay_reader *Replay, replay_writer *Record)
+{
+    GameInit(&GlobalContext, Arena, Seed);
+
+    game_input Input = {};
+
+    u64 StartTime = SDL_GetPerformanceCounter();
+
+    u64 TickIndex = 0;
+    for(;
+        TickIndex < TicksCount;
+        TickIndex++)
+    {
+        if(Replay)
+        {
+            if(!ReplayReadInput(Replay, &Input))
+            {
+                break;
+            }
         }
         else
         {
-            SDL_SetCursor(ArrowCursor);
+            HeadlessBotInput(&GlobalContext, &Input);
+        }
+
+        if(Record)
+        {
+            ReplayWriteInput(Record, &Input);
+        }
+
+        GameUpdate(&GlobalContext, &Input, SimulationDeltaTime);
+
+        // NOTE: Every tick is a frame here, nothing gets rendered
+        MemoryFrameSwap(&GlobalContext.FrameArenas);
+    }
+
+    TicksCount = TickIndex;
+
+    u64 EndTime = SDL_GetPerformanceCounter();
+
+    f64 Seconds = (f64)(EndTime - StartTime) / (f64)SDL_GetPerformanceFrequency();
+
+    // NOTE: Zero ticks, or a run shorter than the counter resolution, would divide by zero
+    u64 TicksPerSecond = 0;
+    u64 NanosecondsPerTick = 0;
+    if(TicksCount && Seconds > 0.0)
+    {
+        TicksPerSecond = (u64)((f64)TicksCount / Seconds);
+        NanosecondsPerTick = (u64)(Seconds * 1e9 / (f64)TicksCount);
+    }
+
+    Outf("%llu ticks in %llu ms, %llu ticks/s, %llu ns/tick\n",
+         TicksCount, (u64)(Seconds * 1000.0), TicksPerSecond, NanosecondsPerTick);
+
+    u32 PlayerXBits;
+    u32 PlayerYBits;
+    MemoryCopy(&PlayerXBits, &GlobalContext.PlayerX, SizeOf(f32));
+    MemoryCopy(&PlayerYBits, &GlobalContext.PlayerY, SizeOf(f32));
+
+    Outf("final state: game state %u, wave %u, enemies remaining %u, player %08x %08x, enemies spawned %llu, wave random %08x\n",
+         GlobalContext.GameState, GlobalContext.WaveIndex, GlobalContext.EnemiesRemaining, PlayerXBits, PlayerYBits,
+         GlobalContext.EnemiesSpawnedCount, GlobalContext.WaveRandom.State[0]);
+
+    return(0);
+}
+
+// NOTE: Has to run before anything else in main. A CPU without what the build was compiled for gets a message instead
+// of crashing on an illegal instruction somewhere later, and the batch math moves to the fastest kernels there are
+internal b32
+CpuSetup(void)
+{
+    GlobalCpu = CpuInfoGet();
+
+    flag32(cpu_feature) Missing = CpuFeaturesRequired() & ~GlobalCpu.Features;
+    if(Missing)
+    {
+        Outf("This build needs a CPU with");
+        for(u32 Index = 0;
+            Index < CpuFeaturesCount;
+            Index++)
+        {
+            if(Missing & (1 << Index))
+            {
+                Outf(" %s", GlobalCpuFeatureNames[Index]);
+            }
         }
+        Outf("\n");
 
-        GlobalContext.IsPointer = 0;
+        return(0);
+    }
+
+    GlobalMathKernels = MathKernelsGet(GlobalCpu.Features);
+
+    return(1);
+}
+
+// NOTE: wombat_bench.cpp includes this file and brings its own main
+
+#ifndef WOMBAT_BENCH
+
+s32 main(s32 ArgsCount, char **Args)
+{
+    if(!CpuSetup())
+    {
+        return(1);
+    }
+
+    b32 Headless = 0;
+    u64 HeadlessTicksCount = 100000;
+
+    char *RecordPath = 0;
+    char *ReplayPath = 0;
+
+    for(s32 ArgIndex = 1;
+        ArgIndex < ArgsCount;
+        ArgIndex++)
+    {
+        if(StringEqualsZ(StringBundleZ(Args[ArgIndex]), "-headless"))
+        {
+            Headless = 1;
+
+            if(ArgIndex + 1 < ArgsCount)
+            {
+                u64 Value;
+                b32 Signed;
+                if(StringToInteger(StringBundleZ(Args[ArgIndex + 1]), &Value, &Signed, 10, 0) && !Signed)
+                {
+                    HeadlessTicksCount = Value;
+                    ArgIndex++;
+                }
+            }
+        }
+        else if(StringEqualsZ(StringBundleZ(Args[ArgIndex]), "-record") && ArgIndex + 1 < ArgsCount)
+        {
+            RecordPath = Args[++ArgIndex];
+        }
+        else if(StringEqualsZ(StringBundleZ(Args[ArgIndex]), "-replay") && ArgIndex + 1 < ArgsCount)
+        {
+            ReplayPath = Args[++ArgIndex];
+        }
+    }
+
+    // NOTE: Chained, so bigger maps and waves just add blocks instead of running into the first 8 MB. The map and
+    // entity arrays live here, huge pages cut the TLB misses when walking them and prefaulting keeps the page
+    // faults out of the first frames
+    memory_arena Arena = MemoryArenaCreate(0, MB(8), MemoryArenaFlag_Chained|MemoryArenaFlag_HugePages|MemoryArenaFlag_Prefault);
+    MemoryArenaName(&Arena, "game");
+
+    GlobalContext.FrameArenas = MemoryFrameArenasCreate(MB(16), 0, MemoryArenaFlag_OnlyCommitAsNeeded);
 
-        SDL_UpdateWindowSurface(Window);
+    // NOTE: Assets are loaded in headless mode as well, the UI hit testing in the update depends on their sizes
+    AssetsLoad(&GlobalContext.Assets, &Arena);
 
-        if(ShouldRestart && GlobalContext.GameState != 1)
+    u32 Seed = DefaultSeed;
+
+    replay_reader Replay = {};
+    b32 Replaying = 0;
+    if(ReplayPath)
+    {
+        Replaying = ReplayReaderOpen(&Replay, ReplayPath);
+        if(Replaying)
+        {
+            Seed = Replay.Seed;
+        }
+        else
         {
-            GlobalContext.PlayerX = CollisionMap.SizeX / 2.0f;
-            GlobalContext.PlayerY = CollisionMap.SizeY / 2.0f;
+            Outf("Failed to open replay: %s\n", ReplayPath);
+        }
+    }
+
+    replay_writer Record = {};
+    b32 Recording = 0;
+    if(RecordPath)
+    {
+        Recording = ReplayWriterOpen(&Record, RecordPath, Seed);
+        if(!Recording)
+        {
+            Outf("Failed to open replay for recording: %s\n", RecordPath);
+        }
+    }
+
+    if(Headless)
+    {
+        if(Replaying && HeadlessTicksCount == 100000)
+        {
+            HeadlessTicksCount = MaxU64;
+        }
+
+        s32 Result = HeadlessRun(&Arena, HeadlessTicksCount, Seed, Replaying ? &Replay : 0, Recording ? &Record : 0);
+
+        if(Recording)
+        {
+            ReplayWriterClose(&Record);
+        }
+
+        MemoryInstrumentReport();
+
+        return(Result);
+    }
+
+    SDL_Init(SDL_INIT_VIDEO);
+
+    SDL_Window *Window = SDL_CreateWindow("RoboElemental", WindowWidth, WindowHeight, 0);
+    SDL_Surface *WindowSurface = SDL_GetWindowSurface(Window);
+
+    GlobalContext.Window = Window;
+    GlobalContext.WindowSurface = WindowSurface;
+
+    GameInit(&GlobalContext, &Arena, Seed);
+
+    u64 LastTime = SDL_GetPerformanceCounter();
+    f32 Accumulator = 0.0f;
+
+    SDL_Cursor* PointerCursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_POINTER);
+    SDL_Cursor* ArrowCursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_DEFAULT);
+
+    game_input Input = {};
+
+    ProfilerInit();
+    
+    b32 Running = 1;
+    while(Running)
+    {
+        u64 CurrentTime = SDL_GetPerformanceCounter();
+        u64 Frequency = SDL_GetPerformanceFrequency();
+
+        // NOTE: A stall turns into a bounded number of fixed ticks instead of one huge step
+        f32 FrameTime = (f32)(CurrentTime - LastTime) / (f32)Frequency;
+        if(FrameTime > MaxFrameTime) FrameTime = MaxFrameTime;
+
+        Accumulator += FrameTime;
+
+        SDL_Event Event;
+        while(SDL_PollEvent(&Event))
+        {
+            if(Event.type == SDL_EVENT_QUIT)
+            {
+                Running = 0;
+            }
+
+            if(!Event.key.repeat)
+            {
+
+                if(Event.type == SDL_EVENT_KEY_UP)
+                {
+                    switch(Event.key.key)
+                    {
+                        case 'w':
+                        {
+                            Input.DirectionY += 1;
+                        } break;
+    
+                        case 's':
+                        {
+                            Input.DirectionY -= 1;
+                        } break;
+    
+                        case 'd':
+                        {
+                            Input.DirectionX -= 1;
+                        } break;
+    
+                        case 'a':
+                        {
+                            Input.DirectionX += 1;
+                        } break;
+                    }
+                }
+    
+                if(Event.type == SDL_EVENT_KEY_DOWN)
+                {
+                    switch(Event.key.key)
+                    {
+                        case 'w':
+                        {
+                            Input.DirectionY -= 1;
+                        } break;
+    
+                        case 's':
+                        {
+                            Input.DirectionY += 1;
+                        } break;
+    
+                        case 'd':
+                        {
+                            Input.DirectionX += 1;
+                        } break;
+    
+                        case 'a':
+                        {
+                            Input.DirectionX -= 1;
+                        } break;
 
-            GlobalContext.TimeOfLastRegenerate = 0;
-            GlobalContext.TimeOfLastWaveEnd = Time;
+                        case 'r':
+                        {
+                            Input.ShouldRestart = 1;
+                        } break;
 
-            GlobalContext.EnemiesCount = 0;
-            GlobalContext.EnemiesRemaining = 0;
-            GlobalContext.Health = GlobalContext.MaxHealth;
+                        case ' ':
+                        {
+                            Input.PressedSpace = 1;
+                        } break;
 
-            GlobalContext.MaxHealthLevel = 0;
-            GlobalContext.FasterRegenLevel = 0;
-            GlobalContext.MultishotLevel = 0;
+                        case SDLK_F1:
+                        {
+                            GlobalProfiler.OverlayVisible = !GlobalProfiler.OverlayVisible;
+                        } break;
+                    }
+                }
+            }
 
-            projectile *ProjectileNext = 0;
-            for(projectile *Projectile = GlobalContext.Projectiles.Next;
-                Projectile != &GlobalContext.Projectiles;
-                Projectile = ProjectileNext)
+            if(Event.type == SDL_EVENT_MOUSE_MOTION)
             {
-                ProjectileNext = Projectile->Next;
+                Input.ViewDirection = Normalize(V2(Event.motion.x, Event.motion.y) - V2(WindowWidth / 2.0f, WindowHeight / 2.0f));
 
-                DoublyLinkedListRemove(Projectile);
-                DoublyLinkedListInsertBefore(&GlobalContext.FreeProjectiles, Projectile);
+                Input.MouseX = (u32)Event.motion.x;
+                Input.MouseY = (u32)Event.motion.y;
             }
 
-            GlobalContext.GameState = 1;
-            GlobalContext.WaveIndex = 0;
+            if(Event.type == SDL_EVENT_MOUSE_BUTTON_DOWN && Event.button.button == SDL_BUTTON_LEFT)
+            {
+                Input.DidClick = 1;
+            }
         }
 
-        SlowAnimFrame = (u32)(Time * 2);
-        FastAnimFrame = (u32)(Time * 3);
+        while(Accumulator >= SimulationDeltaTime)
+        {
+            game_input *TickInput = &Input;
+
+            game_input ReplayInput;
+            if(Replaying)
+            {
+                if(ReplayReadInput(&Replay, &ReplayInput))
+                {
+                    TickInput = &ReplayInput;
+                }
+                else
+                {
+                    // NOTE: When the replay runs out the player takes over from where it ended
+                    ReplayReaderClose(&Replay);
+                    Replaying = 0;
+                }
+            }
+
+            if(Recording)
+            {
+                ReplayWriteInput(&Record, TickInput);
+            }
+
+            GameUpdate(&GlobalContext, TickInput, SimulationDeltaTime);
+            Accumulator -= SimulationDeltaTime;
+
+            // NOTE: One-shot inputs are consumed by exactly one tick, if no tick ran this frame they carry over to the next one
+            Input.DidClick = 0;
+            Input.ShouldRestart = 0;
+            Input.PressedSpace = 0;
+        }
+
+        GameRender(&GlobalContext, Accumulator / SimulationDeltaTime);
+
+        if(GlobalProfiler.OverlayVisible)
+        {
+            ProfilerOverlayDraw(&GlobalContext);
+        }
+
+        if(GlobalContext.IsPointer)
+        {
+            SDL_SetCursor(PointerCursor);
+        }
+        else
+        {
+            SDL_SetCursor(ArrowCursor);
+        }
+
+        {
+            TIMED_BLOCK("SDL_UpdateWindowSurface");
+            SDL_UpdateWindowSurface(Window);
+        }
+
+        ProfilerFrameEnd();
+        MemoryFrameSwap(&GlobalContext.FrameArenas);
 
         LastTime = CurrentTime;
     }
 
+    if(Recording)
+    {
+        ReplayWriterClose(&Record);
+    }
+
     SDL_Quit();
 
+    MemoryInstrumentReport();
+
     return(0);
-}
\ No newline at end of file
+}
+
+#endif // WOMBAT_BENCH
+
+ProfilerEndOfCompilationUnit;
@@ -0,0 +1,215 @@
+// NOTE: TIMED_BLOCK("Name") times the rest of the enclosing scope with rdtsc and attributes it to an anchor,
+// one anchor per call site. Blocks nest, time spent in a child is subtracted from the parent's exclusive
+// cycles, so every anchor has both an inclusive and an exclusive count. Anchors are accumulated per frame
+// and the last ProfilerFramesCount frames are kept in a ring buffer for the overlay.
+//
+// Compile with -DWOMBAT_PROFILER=0 to compile all blocks out.
+
+#ifndef WOMBAT_PROFILER
+#define WOMBAT_PROFILER 1
+#endif
+
+#define ProfilerAnchorsCount 32
+#define ProfilerFramesCount 128
+
+struct profile_anchor
+{
+    u64 CyclesInclusive;
+    u64 CyclesExclusive;
+    u32 HitsCount;
+};
+
+struct profile_frame
+{
+    u64 BeginCycles;
+    u64 EndCycles;
+    f32 Seconds;
+
+    profile_anchor Anchors[ProfilerAnchorsCount];
+};
+
+struct profiler
+{
+    // NOTE: Anchor 0 is the root, blocks opened outside of any other block report to it
+    char *AnchorNames[ProfilerAnchorsCount];
+    u32 ParentAnchor;
+
+    profile_frame Frames[ProfilerFramesCount];
+    u64 FramesCount;
+
+    u64 FrameBeginCounter;
+
+    u64 CalibrationCycles;
+    u64 CalibrationCounter;
+    f64 CyclesPerSecond;
+
+    b32 OverlayVisible;
+};
+
+global profiler GlobalProfiler;
+
+internal inline u64
+ProfilerReadCycles()
+{
+#if Architecture_ARM_64 && !Compiler_MSVC
+    // NOTE: The generic timer, it ticks slower than the CPU but the calibration takes care of that
+    u64 Result;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(Result));
+#else
+    u64 Result = __rdtsc();
+#endif
+    return(Result);
+}
+
+internal inline profile_frame *
+ProfilerCurrentFrame()
+{
+    profile_frame *Result = &GlobalProfiler.Frames[GlobalProfiler.FramesCount % ProfilerFramesCount];
+    return(Result);
+}
+
+struct timed_block
+{
+    u64 StartCycles;
+    u64 OldCyclesInclusive;
+    u32 AnchorIndex;
+    u32 ParentIndex;
+
+    timed_block(char *Name, u32 Index)
+    {
+        AnchorIndex = Index;
+        ParentIndex = GlobalProfiler.ParentAnchor;
+
+        GlobalProfiler.AnchorNames[AnchorIndex] = Name;
+        GlobalProfiler.ParentAnchor = AnchorIndex;
+
+        // NOTE: Restoring the old inclusive count at the end keeps recursive blocks from counting twice
+        OldCyclesInclusive = ProfilerCurrentFrame()->Anchors[AnchorIndex].CyclesInclusive;
+        StartCycles = ProfilerReadCycles();
+    }
+
+    ~timed_block()
+    {
+        u64 Elapsed = ProfilerReadCycles() - StartCycles;
+
+        GlobalProfiler.ParentAnchor = ParentIndex;
+
+        profile_frame *Frame = ProfilerCurrentFrame();
+        profile_anchor *Anchor = &Frame->Anchors[AnchorIndex];
+
+        Frame->Anchors[ParentIndex].CyclesExclusive -= Elapsed;
+        Anchor->CyclesExclusive += Elapsed;
+        Anchor->CyclesInclusive = OldCyclesInclusive + Elapsed;
+        Anchor->HitsCount++;
+    }
+};
+
+#if WOMBAT_PROFILER
+
+#define ProfilerConcatInternal(A, B) A##B
+#define ProfilerConcat(A, B) ProfilerConcatInternal(A, B)
+
+#define TIMED_BLOCK(Name) timed_block ProfilerConcat(TimedBlock, __LINE__)((char *)(Name), __COUNTER__ + 1)
+#define TIMED_FUNCTION TIMED_BLOCK(__FUNCTION__)
+
+// NOTE: Goes at the very end of the unity build, __COUNTER__ is then the number of anchors in use
+#define ProfilerEndOfCompilationUnit StaticAssert(__COUNTER__ < ProfilerAnchorsCount)
+
+#else
+
+#define TIMED_BLOCK(...)
+#define TIMED_FUNCTION
+#define ProfilerEndOfCompilationUnit
+
+#endif
+
+internal void
+ProfilerInit()
+{
+    ZeroStruct(&GlobalProfiler);
+
+    GlobalProfiler.CalibrationCycles = ProfilerReadCycles();
+    GlobalProfiler.CalibrationCounter = SDL_GetPerformanceCounter();
+
+    GlobalProfiler.FrameBeginCounter = GlobalProfiler.CalibrationCounter;
+    GlobalProfiler.Frames[0].BeginCycles = GlobalProfiler.CalibrationCycles;
+}
+
+// NOTE: Must be called outside of any TIMED_BLOCK, a block that spans a frame boundary ends up in the wrong frame
+internal void
+ProfilerFrameEnd()
+{
+    Assert(GlobalProfiler.ParentAnchor == 0);
+
+    u64 Cycles = ProfilerReadCycles();
+    u64 Counter = SDL_GetPerformanceCounter();
+    u64 Frequency = SDL_GetPerformanceFrequency();
+
+    profile_frame *Frame = ProfilerCurrentFrame();
+    Frame->EndCycles = Cycles;
+    Frame->Seconds = (f32)(Counter - GlobalProfiler.FrameBeginCounter) / (f32)Frequency;
+
+    // NOTE: rdtsc has no documented rate, measure it against the performance counter over the whole run
+    if(Counter > GlobalProfiler.CalibrationCounter)
+    {
+        GlobalProfiler.CyclesPerSecond = (f64)(Cycles - GlobalProfiler.CalibrationCycles) * (f64)Frequency / (f64)(Counter - GlobalProfiler.CalibrationCounter);
+    }
+
+    GlobalProfiler.FramesCount++;
+
+    profile_frame *NextFrame = ProfilerCurrentFrame();
+    ZeroStruct(NextFrame);
+    NextFrame->BeginCycles = Cycles;
+
+    GlobalProfiler.FrameBeginCounter = Counter;
+}
+
+// NOTE: Averages every anchor over the completed frames still in the ring buffer, returns how many frames that was
+internal u32
+ProfilerAverageAnchors(profile_anchor *Anchors, u64 *FrameCycles)
+{
+    u32 FramesCount = (u32)Min(GlobalProfiler.FramesCount, (u64)(ProfilerFramesCount - 1));
+
+    for(u32 AnchorIndex = 0;
+        AnchorIndex < ProfilerAnchorsCount;
+        AnchorIndex++)
+    {
+        ZeroStruct(&Anchors[AnchorIndex]);
+    }
+
+    *FrameCycles = 0;
+
+    for(u32 Offset = 1;
+        Offset <= FramesCount;
+        Offset++)
+    {
+        profile_frame *Frame = &GlobalProfiler.Frames[(GlobalProfiler.FramesCount - Offset) % ProfilerFramesCount];
+
+        *FrameCycles += Frame->EndCycles - Frame->BeginCycles;
+
+        for(u32 AnchorIndex = 1;
+            AnchorIndex < ProfilerAnchorsCount;
+            AnchorIndex++)
+        {
+            Anchors[AnchorIndex].CyclesInclusive += Frame->Anchors[AnchorIndex].CyclesInclusive;
+            Anchors[AnchorIndex].CyclesExclusive += Frame->Anchors[AnchorIndex].CyclesExclusive;
+            Anchors[AnchorIndex].HitsCount += Frame->Anchors[AnchorIndex].HitsCount;
+        }
+    }
+
+    if(FramesCount)
+    {
+        *FrameCycles /= FramesCount;
+
+        for(u32 AnchorIndex = 1;
+            AnchorIndex < ProfilerAnchorsCount;
+            AnchorIndex++)
+        {
+            Anchors[AnchorIndex].CyclesInclusive /= FramesCount;
+            Anchors[AnchorIndex].CyclesExclusive /= FramesCount;
+            Anchors[AnchorIndex].HitsCount /= FramesCount;
+        }
+    }
+
+    return(FramesCount);
+}
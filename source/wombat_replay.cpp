@@ -0,0 +1,319 @@
+// NOTE: A replay is a header followed by one record per simulation tick. Each record starts with a
+// change mask, then only the input fields that changed since the previous tick, so an idle tick costs
+// a single byte. Floats are stored as raw bits so playback is bit exact.
+
+#define ReplayMagic 0x4c505257 // NOTE: "WRPL"
+// NOTE: Bumped whenever the same seed and inputs stop producing the same game, 2 moved to per stream random numbers
+#define ReplayVersion 2
+
+#define ReplayRingSize KB(256)
+#define ReplayFlushSize KB(64)
+#define ReplayMaxRecordSize 16
+
+enum replay_change
+{
+    ReplayChange_Direction     = 1 << 0,
+    ReplayChange_ViewDirection = 1 << 1,
+    ReplayChange_Mouse         = 1 << 2,
+    ReplayChange_DidClick      = 1 << 3,
+    ReplayChange_PressedSpace  = 1 << 4,
+    ReplayChange_ShouldRestart = 1 << 5,
+};
+
+struct replay_header
+{
+    u32 Magic;
+    u32 Version;
+    u32 Seed;
+    u32 TickRate;
+};
+
+struct replay_writer
+{
+    SDL_IOStream *File;
+    SDL_Thread *Thread;
+
+    // NOTE: The game thread encodes records straight into the ring and wakes the writer thread every ReplayFlushSize
+    // bytes, which writes out whatever is there in one call since the ring never splits it at the wraparound
+    memory_ring Ring;
+    SDL_Semaphore *Flush;
+    SDL_Semaphore *Drained;
+    u64 FlushedPosition;
+
+    volatile b32 Closing;
+    b32 Failed;
+
+    game_input Last;
+    u64 TicksCount;
+};
+
+struct replay_reader
+{
+    buffer File;
+    umm Cursor;
+
+    u32 Seed;
+
+    game_input Last;
+    u64 TicksCount;
+};
+
+internal void
+ReplayWriterDrain(replay_writer *Writer)
+{
+    umm Size;
+    u8 *Data = MemoryRingReadBegin(&Writer->Ring, &Size);
+    if(Size)
+    {
+        if(SDL_WriteIO(Writer->File, Data, Size) != Size)
+        {
+            Writer->Failed = 1;
+        }
+
+        MemoryRingReadEnd(&Writer->Ring, Size);
+    }
+}
+
+internal s32 SDLCALL
+ReplayWriterThreadProc(void *Parameter)
+{
+    replay_writer *Writer = (replay_writer *)Parameter;
+
+    while(!Writer->Closing)
+    {
+        SDL_WaitSemaphore(Writer->Flush);
+        ReplayWriterDrain(Writer);
+        SDL_SignalSemaphore(Writer->Drained);
+    }
+
+    return(0);
+}
+
+internal void
+ReplayWriterFlush(replay_writer *Writer)
+{
+    Writer->FlushedPosition = Writer->Ring.WritePosition;
+    SDL_SignalSemaphore(Writer->Flush);
+}
+
+internal b32
+ReplayWriterOpen(replay_writer *Writer, char *Path, u32 Seed)
+{
+    ZeroStruct(Writer);
+
+    Writer->File = SDL_IOFromFile(Path, "wb");
+    if(Writer->File)
+    {
+        Writer->Ring = MemoryRingCreate(ReplayRingSize);
+        if(Writer->Ring.Memory)
+        {
+            Writer->Flush = SDL_CreateSemaphore(0);
+            Writer->Drained = SDL_CreateSemaphore(0);
+
+            replay_header Header = {};
+            Header.Magic = ReplayMagic;
+            Header.Version = ReplayVersion;
+            Header.Seed = Seed;
+            Header.TickRate = SimulationHz;
+
+            MemoryRingWrite(&Writer->Ring, &Header, SizeOf(Header));
+
+            Writer->Thread = SDL_CreateThread(ReplayWriterThreadProc, "ReplayWriter", Writer);
+        }
+    }
+
+    b32 Result = Writer->Thread != 0;
+    return(Result);
+}
+
+internal void
+ReplayWriteInput(replay_writer *Writer, game_input *Input)
+{
+    // NOTE: Only blocks if the writer thread is a whole ring behind
+    u8 *Start = MemoryRingWriteBegin(&Writer->Ring, ReplayMaxRecordSize);
+    while(!Start)
+    {
+        ReplayWriterFlush(Writer);
+        SDL_WaitSemaphore(Writer->Drained);
+        Start = MemoryRingWriteBegin(&Writer->Ring, ReplayMaxRecordSize);
+    }
+
+    u8 *At = Start + 1;
+
+    game_input *Last = &Writer->Last;
+    u8 Mask = 0;
+
+    if(Input->DirectionX != Last->DirectionX || Input->DirectionY != Last->DirectionY)
+    {
+        Assert(Input->DirectionX >= -128.0f && Input->DirectionX <= 127.0f);
+        Assert(Input->DirectionY >= -128.0f && Input->DirectionY <= 127.0f);
+
+        Mask |= ReplayChange_Direction;
+        *(s8 *)At++ = (s8)Input->DirectionX;
+        *(s8 *)At++ = (s8)Input->DirectionY;
+    }
+
+    u64 ViewDirectionBits;
+    u64 LastViewDirectionBits;
+    MemoryCopy(&ViewDirectionBits, &Input->ViewDirection, SizeOf(v2));
+    MemoryCopy(&LastViewDirectionBits, &Last->ViewDirection, SizeOf(v2));
+
+    if(ViewDirectionBits != LastViewDirectionBits)
+    {
+        Mask |= ReplayChange_ViewDirection;
+        MemoryCopy(At, &Input->ViewDirection, SizeOf(v2));
+        At += SizeOf(v2);
+    }
+
+    if(Input->MouseX != Last->MouseX || Input->MouseY != Last->MouseY)
+    {
+        Mask |= ReplayChange_Mouse;
+
+        u16 Mouse[2] = {(u16)Input->MouseX, (u16)Input->MouseY};
+        MemoryCopy(At, Mouse, SizeOf(Mouse));
+        At += SizeOf(Mouse);
+    }
+
+    if(Input->DidClick) Mask |= ReplayChange_DidClick;
+    if(Input->PressedSpace) Mask |= ReplayChange_PressedSpace;
+    if(Input->ShouldRestart) Mask |= ReplayChange_ShouldRestart;
+
+    *Start = Mask;
+
+    MemoryRingWriteEnd(&Writer->Ring, (umm)(At - Start));
+    Writer->Last = *Input;
+    Writer->TicksCount++;
+
+    if(Writer->Ring.WritePosition - Writer->FlushedPosition >= ReplayFlushSize)
+    {
+        ReplayWriterFlush(Writer);
+    }
+}
+
+internal b32
+ReplayWriterClose(replay_writer *Writer)
+{
+    b32 Result = 0;
+
+    if(Writer->Thread)
+    {
+        Writer->Closing = 1;
+        ReplayWriterFlush(Writer);
+
+        SDL_WaitThread(Writer->Thread, 0);
+
+        // NOTE: The thread may have seen Closing before the last records, whatever it left is ours now
+        ReplayWriterDrain(Writer);
+
+        SDL_DestroySemaphore(Writer->Flush);
+        SDL_DestroySemaphore(Writer->Drained);
+
+        Result = !Writer->Failed;
+    }
+
+    if(Writer->File)
+    {
+        Result = SDL_CloseIO(Writer->File) && Result;
+    }
+
+    MemoryRingDestroy(&Writer->Ring);
+
+    ZeroStruct(Writer);
+
+    return(Result);
+}
+
+internal b32
+ReplayReaderOpen(replay_reader *Reader, char *Path)
+{
+    ZeroStruct(Reader);
+
+    b32 Result = 0;
+
+    Reader->File = MemoryMapFile(Path);
+    if(Reader->File.Size >= SizeOf(replay_header))
+    {
+        replay_header *Header = (replay_header *)Reader->File.Data;
+        if(Header->Magic == ReplayMagic &&
+           Header->Version == ReplayVersion &&
+           Header->TickRate == SimulationHz)
+        {
+            Reader->Seed = Header->Seed;
+            Reader->Cursor = SizeOf(replay_header);
+
+            Result = 1;
+        }
+    }
+
+    if(!Result)
+    {
+        MemoryUnmapFile(&Reader->File);
+    }
+
+    return(Result);
+}
+
+internal b32
+ReplayReadInput(replay_reader *Reader, game_input *Input)
+{
+    b32 Result = 0;
+
+    if(Reader->Cursor < Reader->File.Size)
+    {
+        u8 *At = Reader->File.Data + Reader->Cursor;
+        u8 *End = Reader->File.Data + Reader->File.Size;
+
+        u8 Mask = *At++;
+
+        umm RecordSize = 0;
+        if(Mask & ReplayChange_Direction) RecordSize += 2;
+        if(Mask & ReplayChange_ViewDirection) RecordSize += SizeOf(v2);
+        if(Mask & ReplayChange_Mouse) RecordSize += 2 * SizeOf(u16);
+
+        if((umm)(End - At) >= RecordSize)
+        {
+            *Input = Reader->Last;
+
+            if(Mask & ReplayChange_Direction)
+            {
+                Input->DirectionX = (f32)*(s8 *)At++;
+                Input->DirectionY = (f32)*(s8 *)At++;
+            }
+
+            if(Mask & ReplayChange_ViewDirection)
+            {
+                MemoryCopy(&Input->ViewDirection, At, SizeOf(v2));
+                At += SizeOf(v2);
+            }
+
+            if(Mask & ReplayChange_Mouse)
+            {
+                u16 Mouse[2];
+                MemoryCopy(Mouse, At, SizeOf(Mouse));
+                At += SizeOf(Mouse);
+
+                Input->MouseX = Mouse[0];
+                Input->MouseY = Mouse[1];
+            }
+
+            Input->DidClick = (Mask & ReplayChange_DidClick) != 0;
+            Input->PressedSpace = (Mask & ReplayChange_PressedSpace) != 0;
+            Input->ShouldRestart = (Mask & ReplayChange_ShouldRestart) != 0;
+
+            Reader->Cursor = (umm)(At - Reader->File.Data);
+            Reader->Last = *Input;
+            Reader->TicksCount++;
+
+            Result = 1;
+        }
+    }
+
+    return(Result);
+}
+
+internal void
+ReplayReaderClose(replay_reader *Reader)
+{
+    MemoryUnmapFile(&Reader->File);
+    ZeroStruct(Reader);
+}